@@ -0,0 +1,176 @@
+#include "bench_harness.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string_view>
+
+#include <SDL3/SDL_timer.h>
+#include <spdlog/spdlog.h>
+
+#include "../src/engine/memory/allocation_tracker.h"
+
+// 替换全局 operator new，统计计时区间内的 C++ 堆分配次数（SDL 内部的 malloc 不在统计范围内）
+ENGINE_DEFINE_ALLOCATION_HOOKS();
+
+namespace bench {
+
+namespace {
+double percentile(const std::vector<double> &sorted, double fraction) {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+int parseInt(const char *text, int fallback) {
+	char *end = nullptr;
+	long value = std::strtol(text, &end, 10);
+	return end && *end == '\0' && value > 0 ? static_cast<int>(value) : fallback;
+}
+} // namespace
+
+Uint64 getAllocationCount() {
+	return engine::memory::AllocationTracker::getTotal().count;
+}
+
+BenchOptions BenchOptions::parse(int argc, char *argv[]) {
+	BenchOptions options;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		bool has_value = i + 1 < argc;
+		if (arg == "--frames" && has_value) {
+			options.frames = parseInt(argv[++i], options.frames);
+		} else if (arg == "--warmup" && has_value) {
+			options.warmup_frames = parseInt(argv[++i], options.warmup_frames);
+		} else if (arg == "--filter" && has_value) {
+			options.filter = argv[++i];
+		} else if (arg == "--output" && has_value) {
+			options.output_path = argv[++i];
+		} else if (arg == "--baseline" && has_value) {
+			options.baseline_path = argv[++i];
+		} else if (arg == "--tolerance" && has_value) {
+			options.tolerance = std::max(0.0, std::atof(argv[++i]));
+		} else if (arg == "--update-baseline") {
+			options.update_baseline = true;
+		} else {
+			spdlog::warn("Ignoring unknown or incomplete argument '{}'.", arg);
+		}
+	}
+	return options;
+}
+
+nlohmann::json runScene(BenchScene &scene, BenchContext &context, const BenchOptions &options) {
+	if (!scene.setUp(context)) {
+		spdlog::error("Scene '{}' failed to set up, skipped.", scene.getName());
+		scene.tearDown();
+		return {};
+	}
+
+	for (int i = 0; i < options.warmup_frames; ++i) {
+		scene.runFrame(context);
+	}
+
+	std::vector<double> frame_ms;
+	frame_ms.reserve(static_cast<size_t>(options.frames));
+	Uint64 total_items = 0;
+	Uint64 total_ns = 0;
+	Uint64 allocations_before = getAllocationCount();
+	for (int i = 0; i < options.frames; ++i) {
+		Uint64 start = SDL_GetTicksNS();
+		total_items += scene.runFrame(context);
+		Uint64 elapsed = SDL_GetTicksNS() - start;
+		total_ns += elapsed;
+		frame_ms.push_back(static_cast<double>(elapsed) * 0.000001);
+	}
+	// frame_ms 已预留容量，循环内不会产生额外分配
+	Uint64 allocations = getAllocationCount() - allocations_before;
+
+	std::vector<double> sorted = frame_ms;
+	std::sort(sorted.begin(), sorted.end());
+	double total_seconds = static_cast<double>(total_ns) * 0.000000001;
+	double frames = static_cast<double>(options.frames);
+
+	nlohmann::json metrics = nlohmann::json::object();
+	scene.report(metrics);
+	scene.tearDown();
+
+	nlohmann::json result = {
+		{ "name", scene.getName() },
+		{ "frames", options.frames },
+		{ "items_per_frame", static_cast<double>(total_items) / frames },
+		{ "items_per_sec", total_seconds > 0.0 ? static_cast<double>(total_items) / total_seconds : 0.0 },
+		{ "frame_ms", {
+				{ "mean", total_seconds * 1000.0 / frames },
+				{ "p50", percentile(sorted, 0.50) },
+				{ "p95", percentile(sorted, 0.95) },
+				{ "p99", percentile(sorted, 0.99) },
+				{ "max", sorted.back() },
+		} },
+		{ "allocs_per_frame", static_cast<double>(allocations) / frames },
+		{ "metrics", std::move(metrics) },
+	};
+	if (scene.requiresZeroAllocations()) {
+		result["zero_alloc_violation"] = allocations > 0;
+		if (allocations > 0) {
+			spdlog::error("Scene '{}' must not allocate in steady state but made {} allocation(s) in {} frames.", scene.getName(), allocations, options.frames);
+		}
+	}
+	spdlog::info("{:<36} {:>12.0f} items/s  p50 {:7.3f} ms  p95 {:7.3f} ms  {:.1f} allocs/frame",
+			scene.getName(), result["items_per_sec"].get<double>(), result["frame_ms"]["p50"].get<double>(),
+			result["frame_ms"]["p95"].get<double>(), result["allocs_per_frame"].get<double>());
+	return result;
+}
+
+int compareWithBaseline(const nlohmann::json &results, const nlohmann::json &baseline, double tolerance) {
+	int regressions = 0;
+	// 两个参数都是 const，缺少的键不能用 operator[] 访问，统一用 value() 取默认值
+	const nlohmann::json scenes = results.value("scenes", nlohmann::json::array());
+	for (const auto &expected : baseline.value("scenes", nlohmann::json::array())) {
+		std::string name = expected.value("name", "");
+		auto actual = std::find_if(scenes.begin(), scenes.end(), [&](const nlohmann::json &scene) {
+			return scene.value("name", "") == name;
+		});
+		if (actual == scenes.end()) {
+			continue;
+		}
+
+		double base_rate = expected.value("items_per_sec", 0.0);
+		double rate = actual->value("items_per_sec", 0.0);
+		double base_p95 = expected.value("frame_ms", nlohmann::json::object()).value("p95", 0.0);
+		double p95 = actual->value("frame_ms", nlohmann::json::object()).value("p95", 0.0);
+		double base_allocs = expected.value("allocs_per_frame", 0.0);
+		double allocs = actual->value("allocs_per_frame", 0.0);
+
+		// 三项指标分别检查并逐一报告，但每个场景最多计一次回归
+		bool regressed = false;
+		if (base_rate > 0.0 && rate < base_rate * (1.0 - tolerance)) {
+			spdlog::error("REGRESSION {}: {:.0f} items/s vs baseline {:.0f}.", name, rate, base_rate);
+			regressed = true;
+		}
+		if (base_p95 > 0.0 && p95 > base_p95 * (1.0 + tolerance)) {
+			spdlog::error("REGRESSION {}: p95 {:.3f} ms vs baseline {:.3f} ms.", name, p95, base_p95);
+			regressed = true;
+		}
+		if (allocs > base_allocs + 0.5) { // 分配次数是确定性的，不按比例放宽
+			spdlog::error("REGRESSION {}: {:.1f} allocs/frame vs baseline {:.1f}.", name, allocs, base_allocs);
+			regressed = true;
+		}
+		if (regressed) {
+			++regressions;
+		}
+	}
+	return regressions;
+}
+
+int countZeroAllocationViolations(const nlohmann::json &results) {
+	int violations = 0;
+	for (const auto &scene : results.value("scenes", nlohmann::json::array())) {
+		if (scene.value("zero_alloc_violation", false)) {
+			++violations;
+		}
+	}
+	return violations;
+}
+
+} // namespace bench
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+#include <nlohmann/json.hpp>
+
+struct SDL_Window;
+struct SDL_Renderer;
+
+namespace bench {
+
+/**
+ * @brief 所有场景共享的无头运行环境
+ */
+struct BenchContext {
+	SDL_Window *window = nullptr; ///< @brief 离屏窗口，回退到纯软件表面时为 nullptr
+	SDL_Renderer *sdl_renderer = nullptr;
+	int width = 1280;
+	int height = 720;
+};
+
+/**
+ * @brief 基准场景接口。
+ *
+ * setUp() 中完成所有加载，runFrame() 只包含需要计时的工作，并返回本帧处理的对象数量
+ * （精灵、粒子、碰撞体等），用于计算吞吐量。
+ */
+class BenchScene {
+public:
+	virtual ~BenchScene() = default;
+
+	virtual std::string getName() const = 0;
+	[[nodiscard]] virtual bool setUp(BenchContext &context) = 0;
+	virtual Uint64 runFrame(BenchContext &context) = 0;
+	virtual void tearDown() {}
+	virtual void report(nlohmann::json & /*metrics*/) const {} ///< @brief 附加场景特有的指标（如绘制调用数）
+	/// @brief 为 true 时计时区间内出现任何堆分配都视为失败，与基线无关
+	virtual bool requiresZeroAllocations() const { return false; }
+};
+
+using SceneList = std::vector<std::unique_ptr<BenchScene>>;
+
+struct BenchOptions {
+	int warmup_frames = 30;
+	int frames = 300;
+	std::string filter; ///< @brief 只运行名称包含该子串的场景
+	std::string output_path = "bench_results.json";
+	std::string baseline_path = "bench/baseline.json";
+	double tolerance = 0.15; ///< @brief 吞吐量下降或 p95 帧时间上升超过该比例视为退化
+	bool update_baseline = false;
+
+	static BenchOptions parse(int argc, char *argv[]);
+};
+
+/**
+ * @brief 运行单个场景：预热后逐帧计时，统计帧时间分位数、吞吐量与每帧分配次数
+ *
+ * 要求零分配的场景在计时区间内分配了内存时，结果中的 "zero_alloc_violation" 为 true。
+ *
+ * @return 场景结果；setUp 失败时返回 null
+ */
+nlohmann::json runScene(BenchScene &scene, BenchContext &context, const BenchOptions &options);
+
+/**
+ * @brief 与基线逐场景比较
+ *
+ * @return 退化的场景数量，基线中不存在的场景不参与比较
+ */
+int compareWithBaseline(const nlohmann::json &results, const nlohmann::json &baseline, double tolerance);
+
+/// @brief 违反零分配要求的场景数量
+int countZeroAllocationViolations(const nlohmann::json &results);
+
+Uint64 getAllocationCount(); ///< @brief 进程启动以来 operator new 的调用次数
+
+} // namespace bench
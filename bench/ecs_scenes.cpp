@@ -0,0 +1,231 @@
+#include <random>
+
+#include "../src/engine/core/job_system.h"
+#include "../src/engine/ecs/command_buffer.h"
+#include "../src/engine/ecs/systems.h"
+#include "../src/engine/ecs/world.h"
+#include "../src/engine/render/animation_library.h"
+#include "scenes.h"
+
+namespace bench {
+
+namespace {
+
+constexpr Uint32 SCENE_SEED = 1234;
+constexpr float FIXED_DELTA_TIME = 1.0f / 60.0f;
+constexpr const char *BENCH_SHEET = "assets/textures/Actors/frog.png";
+constexpr float BENCH_FRAME_WIDTH = 35.0f;
+constexpr float BENCH_FRAME_HEIGHT = 32.0f;
+
+/// @brief 编译测试用的精灵表片段，返回片段下标（0 = idle，1 = jump）
+void compileBenchClips(engine::render::AnimationLibrary &library) {
+	nlohmann::json clips = {
+		{ "idle", { { "row", 0 }, { "frames", { 0, 1, 2, 3 } }, { "duration", 100 } } },
+		{ "jump", { { "row", 0 }, { "frames", { 3, 2, 1 } }, { "duration", 50 }, { "loop", false } } },
+	};
+	library.compileSheet(BENCH_SHEET, clips, glm::vec2(BENCH_FRAME_WIDTH, BENCH_FRAME_HEIGHT));
+}
+
+/**
+ * @brief 固定步更新：位置快照 + 速度积分 + 动画推进，不含绘制。parallel 时动画按块分发到任务系统
+ */
+class EcsUpdateScene final : public BenchScene {
+private:
+	int entity_count;
+	bool parallel;
+	std::unique_ptr<engine::core::JobSystem> job_system;
+	std::unique_ptr<engine::render::AnimationLibrary> animation_library;
+	std::unique_ptr<engine::ecs::World> world;
+	std::unique_ptr<engine::ecs::PositionSnapshotSystem> snapshot_system;
+	std::unique_ptr<engine::ecs::MovementSystem> movement_system;
+	std::unique_ptr<engine::ecs::AnimationSystem> animation_system;
+
+public:
+	EcsUpdateScene(int entity_count, bool parallel) :
+			entity_count(entity_count), parallel(parallel) {}
+
+	std::string getName() const override { return "ecs/" + std::to_string(entity_count / 1000) + "k_entities_update" + (parallel ? "_parallel" : ""); }
+
+	bool setUp(BenchContext &) override {
+		if (parallel) {
+			job_system = std::make_unique<engine::core::JobSystem>();
+		}
+		animation_library = std::make_unique<engine::render::AnimationLibrary>();
+		compileBenchClips(*animation_library);
+		world = std::make_unique<engine::ecs::World>();
+		snapshot_system = std::make_unique<engine::ecs::PositionSnapshotSystem>(*world);
+		movement_system = std::make_unique<engine::ecs::MovementSystem>(*world);
+		animation_system = std::make_unique<engine::ecs::AnimationSystem>(*world, *animation_library, job_system.get());
+
+		std::mt19937 rng(SCENE_SEED);
+		std::uniform_real_distribution<float> coordinate(0.0f, 2000.0f);
+		std::uniform_real_distribution<float> speed(-60.0f, 60.0f);
+		engine::render::Sprite sprite(BENCH_SHEET, SDL_FRect{ 0.0f, 0.0f, BENCH_FRAME_WIDTH, BENCH_FRAME_HEIGHT });
+		for (int i = 0; i < entity_count; ++i) {
+			glm::vec2 position(coordinate(rng), coordinate(rng));
+			engine::ecs::Position position_component{ position, position };
+			engine::ecs::Velocity velocity{ glm::vec2(speed(rng), speed(rng)) };
+			// 一半实体带精灵与动画，形成两个原型
+			if (i % 2 == 0) {
+				engine::ecs::Animation animation{ 0, 0, static_cast<float>(i % 7) * 0.013f };
+				world->create(position_component, velocity, engine::ecs::SpriteComponent{ sprite }, animation);
+			} else {
+				world->create(position_component, velocity);
+			}
+		}
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		snapshot_system->update();
+		movement_system->update(FIXED_DELTA_TIME);
+		animation_system->update(FIXED_DELTA_TIME);
+		return static_cast<Uint64>(entity_count);
+	}
+
+	void tearDown() override {
+		animation_system.reset();
+		movement_system.reset();
+		snapshot_system.reset();
+		world.reset();
+		animation_library.reset();
+		job_system.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["entities"] = entity_count;
+		metrics["archetypes"] = world ? world->getArchetypeCount() : 0;
+		metrics["worker_threads"] = job_system ? job_system->getWorkerCount() : 0;
+	}
+};
+
+/**
+ * @brief 只推进动画：大量精灵播放不同相位的循环与单次片段，衡量批量推进本身的开销
+ */
+class EcsAnimationScene final : public BenchScene {
+private:
+	int sprite_count;
+	std::unique_ptr<engine::render::AnimationLibrary> animation_library;
+	std::unique_ptr<engine::ecs::World> world;
+	std::unique_ptr<engine::ecs::AnimationSystem> animation_system;
+	engine::ecs::Query<engine::ecs::Animation> animations;
+	int frame_index = 0;
+
+public:
+	explicit EcsAnimationScene(int sprite_count) :
+			sprite_count(sprite_count) {}
+
+	std::string getName() const override { return "ecs/" + std::to_string(sprite_count / 1000) + "k_animated_sprites"; }
+
+	bool setUp(BenchContext &) override {
+		animation_library = std::make_unique<engine::render::AnimationLibrary>();
+		compileBenchClips(*animation_library);
+		world = std::make_unique<engine::ecs::World>();
+		animation_system = std::make_unique<engine::ecs::AnimationSystem>(*world, *animation_library);
+		animations = engine::ecs::Query<engine::ecs::Animation>(*world);
+
+		engine::render::Sprite sprite(BENCH_SHEET, SDL_FRect{ 0.0f, 0.0f, BENCH_FRAME_WIDTH, BENCH_FRAME_HEIGHT });
+		for (int i = 0; i < sprite_count; ++i) {
+			// 每 8 个精灵中有 1 个播放单次片段，停在最后一帧后继续参与推进
+			engine::ecs::Animation animation{ static_cast<Uint16>(i % 8 == 0 ? 1 : 0), 0, static_cast<float>(i % 11) * 0.009f };
+			world->create(engine::ecs::Position{}, engine::ecs::SpriteComponent{ sprite }, animation);
+		}
+		frame_index = 0;
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		// 周期性地重新开始单次片段，模拟游戏中的片段切换
+		if (++frame_index % 60 == 0) {
+			animations.forEachChunk([](std::span<const engine::ecs::Entity>, std::span<engine::ecs::Animation> chunk) {
+				for (engine::ecs::Animation &animation : chunk) {
+					if (animation.clip == 1) {
+						animation.frame = 0;
+						animation.time = 0.0f;
+					}
+				}
+			});
+		}
+		animation_system->update(FIXED_DELTA_TIME);
+		return static_cast<Uint64>(sprite_count);
+	}
+
+	void tearDown() override {
+		animation_system.reset();
+		animations = {};
+		world.reset();
+		animation_library.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["sprites"] = sprite_count;
+		metrics["animation_bytes_per_sprite"] = sizeof(engine::ecs::Animation);
+		metrics["clips"] = animation_library ? animation_library->getClipCount() : 0;
+	}
+};
+
+/**
+ * @brief 结构性修改：每帧通过命令缓冲销毁并重建一批实体
+ */
+class EcsChurnScene final : public BenchScene {
+private:
+	int entity_count;
+	int churn_per_frame;
+	std::unique_ptr<engine::ecs::World> world;
+	std::unique_ptr<engine::ecs::CommandBuffer> commands;
+	std::vector<engine::ecs::Entity> entities;
+	size_t cursor = 0;
+
+public:
+	EcsChurnScene(int entity_count, int churn_per_frame) :
+			entity_count(entity_count), churn_per_frame(churn_per_frame) {}
+
+	std::string getName() const override { return "ecs/" + std::to_string(churn_per_frame) + "_entity_churn_per_frame"; }
+
+	bool setUp(BenchContext &) override {
+		world = std::make_unique<engine::ecs::World>();
+		commands = std::make_unique<engine::ecs::CommandBuffer>(*world);
+		entities.reserve(static_cast<size_t>(entity_count));
+		for (int i = 0; i < entity_count; ++i) {
+			entities.push_back(world->create(engine::ecs::Position{}, engine::ecs::Velocity{ glm::vec2(1.0f, 0.0f) }));
+		}
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		for (int i = 0; i < churn_per_frame; ++i) {
+			engine::ecs::Entity &slot = entities[cursor];
+			cursor = (cursor + 1) % entities.size();
+			commands->destroy(slot);
+			slot = commands->create();
+			commands->add(slot, engine::ecs::Position{});
+			commands->add(slot, engine::ecs::Velocity{ glm::vec2(1.0f, 0.0f) });
+		}
+		commands->apply();
+		return static_cast<Uint64>(churn_per_frame);
+	}
+
+	void tearDown() override {
+		commands.reset();
+		world.reset();
+		entities.clear();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["entities"] = entity_count;
+		metrics["churn_per_frame"] = churn_per_frame;
+	}
+};
+
+} // namespace
+
+SceneList makeEcsScenes() {
+	SceneList scenes;
+	scenes.push_back(std::make_unique<EcsUpdateScene>(100000, false));
+	scenes.push_back(std::make_unique<EcsUpdateScene>(100000, true));
+	scenes.push_back(std::make_unique<EcsAnimationScene>(10000));
+	scenes.push_back(std::make_unique<EcsChurnScene>(100000, 1000));
+	return scenes;
+}
+
+} // namespace bench
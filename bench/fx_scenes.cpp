@@ -0,0 +1,110 @@
+#include "../src/engine/render/camera.h"
+#include "../src/engine/render/particle_system.h"
+#include "../src/engine/render/renderer.h"
+#include "../src/engine/resource/resource_manager.h"
+#include "scenes.h"
+
+namespace bench {
+
+namespace {
+
+constexpr float FRAME_DELTA_TIME = 1.0f / 60.0f;
+constexpr int EMITTER_COUNT = 16;
+constexpr float MEAN_LIFETIME = 1.5f; ///< @brief 两种效果寿命范围的均值，决定稳态粒子数
+
+/**
+ * @brief 粒子场景：若干持续发射器保持约 N 个存活粒子，每帧更新并通过 RenderGeometry 绘制（每张纹理一次提交）
+ */
+class ParticleScene final : public BenchScene {
+private:
+	int particle_count;
+	std::unique_ptr<engine::resource::ResourceManager> resource_manager;
+	std::unique_ptr<engine::render::Renderer> renderer;
+	std::unique_ptr<engine::render::Camera> camera;
+	std::unique_ptr<engine::render::ParticleSystem> particles;
+	engine::render::ParticleStats last_stats;
+
+public:
+	explicit ParticleScene(int particle_count) :
+			particle_count(particle_count) {}
+
+	std::string getName() const override { return "fx/" + std::to_string(particle_count / 1000) + "k_particles"; }
+
+	bool setUp(BenchContext &context) override {
+		resource_manager = std::make_unique<engine::resource::ResourceManager>(context.sdl_renderer);
+		renderer = std::make_unique<engine::render::Renderer>(context.sdl_renderer, resource_manager.get());
+		renderer->setBatchingEnabled(true);
+		const glm::vec2 viewport(static_cast<float>(context.width), static_cast<float>(context.height));
+		camera = std::make_unique<engine::render::Camera>(viewport);
+		// 留出余量，稳态附近的波动不会因池满而丢弃粒子
+		particles = std::make_unique<engine::render::ParticleSystem>(*resource_manager, static_cast<size_t>(particle_count) * 5 / 4);
+
+		engine::render::ParticleEffectConfig spark;
+		spark.name = "bench_spark";
+		spark.texture = "assets/textures/FX/item-feedback.png";
+		spark.source = { 0.0f, 0.0f, 32.0f, 32.0f };
+		spark.lifetime = { 1.0f, 2.0f };
+		spark.speed = { 20.0f, 120.0f };
+		spark.gravity = { 0.0f, 60.0f };
+		spark.drag = 0.5f;
+		spark.scale = { 0.3f, 0.1f };
+		spark.color_end = { 1.0f, 0.6f, 0.2f, 0.0f };
+		// 每个发射器每秒产生 N / 平均寿命 / 发射器数 个粒子，稳态时约有 N 个存活
+		spark.rate = static_cast<float>(particle_count) / MEAN_LIFETIME / static_cast<float>(EMITTER_COUNT);
+
+		engine::render::ParticleEffectConfig puff = spark;
+		puff.name = "bench_puff";
+		puff.texture = "assets/textures/FX/enemy-deadth.png";
+		puff.source = {};
+		puff.frames = 6;
+		puff.scale = { 0.4f, 0.2f };
+
+		const engine::render::ParticleSystem::EffectId effects[2] = { particles->addEffect(spark), particles->addEffect(puff) };
+		if (effects[0] == engine::render::ParticleSystem::INVALID_EFFECT || effects[1] == engine::render::ParticleSystem::INVALID_EFFECT) {
+			return false;
+		}
+		for (int i = 0; i < EMITTER_COUNT; ++i) {
+			glm::vec2 position(viewport.x * (static_cast<float>(i % 4) + 0.5f) / 4.0f, viewport.y * (static_cast<float>(i / 4) + 0.5f) / 4.0f);
+			particles->startEmitter(effects[i % 2], position);
+		}
+		// 预热一个最长寿命，计时从稳态开始
+		for (int frame = 0; frame < static_cast<int>(spark.lifetime.y / FRAME_DELTA_TIME); ++frame) {
+			particles->update(FRAME_DELTA_TIME);
+		}
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		particles->update(FRAME_DELTA_TIME);
+		renderer->clearScreen();
+		particles->draw(*renderer, *camera);
+		renderer->present();
+		last_stats = particles->getStats();
+		return static_cast<Uint64>(last_stats.live);
+	}
+
+	void tearDown() override {
+		particles.reset();
+		camera.reset();
+		renderer.reset();
+		resource_manager.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["target_particles"] = particle_count;
+		metrics["live_particles"] = last_stats.live;
+		metrics["drawn_particles"] = last_stats.drawn;
+		metrics["dropped_particles"] = last_stats.dropped;
+		metrics["draw_calls"] = last_stats.batches;
+	}
+};
+
+} // namespace
+
+SceneList makeFxScenes() {
+	SceneList scenes;
+	scenes.push_back(std::make_unique<ParticleScene>(100000));
+	return scenes;
+}
+
+} // namespace bench
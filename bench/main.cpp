@@ -0,0 +1,125 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include "bench_harness.h"
+#include "scenes.h"
+
+// 无头基准：xmake run bench [--frames N] [--filter renderer/] [--baseline path] [--update-baseline]
+// 退出码：0 通过，1 存在退化或零分配场景发生了分配，2 环境初始化失败
+int main(int argc, char *argv[]) {
+	spdlog::set_level(spdlog::level::info);
+	bench::BenchOptions options = bench::BenchOptions::parse(argc, argv);
+
+	// 环境变量 SDL_VIDEO_DRIVER 的优先级高于这里的默认提示
+	SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen,dummy");
+	SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+	if (!SDL_Init(SDL_INIT_VIDEO)) {
+		spdlog::error("SDL could not initialize! SDL_Error: {}", SDL_GetError());
+		return 2;
+	}
+
+	bench::BenchContext context;
+	context.window = SDL_CreateWindow("bench", context.width, context.height, SDL_WINDOW_HIDDEN);
+	SDL_Surface *surface = nullptr;
+	if (context.window) {
+		context.sdl_renderer = SDL_CreateRenderer(context.window, "software");
+	} else {
+		// 没有可用的视频驱动时直接渲染到内存表面
+		spdlog::warn("Offscreen window unavailable ({}), rendering to a surface.", SDL_GetError());
+		surface = SDL_CreateSurface(context.width, context.height, SDL_PIXELFORMAT_RGBA32);
+		context.sdl_renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+	}
+	if (!context.sdl_renderer) {
+		spdlog::error("Software renderer could not be created! SDL_Error: {}", SDL_GetError());
+		SDL_Quit();
+		return 2;
+	}
+
+	nlohmann::json results = {
+		{ "video_driver", SDL_GetCurrentVideoDriver() ? SDL_GetCurrentVideoDriver() : "none" },
+		{ "renderer", SDL_GetRendererName(context.sdl_renderer) },
+		{ "width", context.width },
+		{ "height", context.height },
+		{ "frames", options.frames },
+		{ "scenes", nlohmann::json::array() },
+	};
+
+	bench::SceneList scenes = bench::makeRendererScenes();
+	for (auto &scene : bench::makeEcsScenes()) {
+		scenes.push_back(std::move(scene));
+	}
+	for (auto &scene : bench::makePhysicsScenes()) {
+		scenes.push_back(std::move(scene));
+	}
+	for (auto &scene : bench::makeFxScenes()) {
+		scenes.push_back(std::move(scene));
+	}
+	for (auto &scene : bench::makeNavScenes()) {
+		scenes.push_back(std::move(scene));
+	}
+	for (auto &scene : bench::makeMemoryScenes()) {
+		scenes.push_back(std::move(scene));
+	}
+	for (auto &scene : scenes) {
+		if (!options.filter.empty() && scene->getName().find(options.filter) == std::string::npos) {
+			continue;
+		}
+		nlohmann::json result = bench::runScene(*scene, context, options);
+		if (!result.is_null()) {
+			results["scenes"].push_back(std::move(result));
+		}
+	}
+
+	SDL_DestroyRenderer(context.sdl_renderer);
+	if (surface) {
+		SDL_DestroySurface(surface);
+	}
+	if (context.window) {
+		SDL_DestroyWindow(context.window);
+	}
+	SDL_Quit();
+
+	std::string dump = results.dump(2);
+	std::printf("%s\n", dump.c_str());
+	if (std::ofstream file(options.output_path); file) {
+		file << dump << '\n';
+	} else {
+		spdlog::warn("Failed to write results to '{}'.", options.output_path);
+	}
+
+	// 零分配是绝对要求，更新基线也不能绕过
+	int zero_alloc_violations = bench::countZeroAllocationViolations(results);
+	if (zero_alloc_violations > 0) {
+		spdlog::error("{} zero-allocation scene(s) allocated during timed frames.", zero_alloc_violations);
+		return 1;
+	}
+
+	if (options.update_baseline) {
+		std::ofstream baseline_file(options.baseline_path);
+		baseline_file << dump << '\n';
+		spdlog::info("Baseline updated: '{}'.", options.baseline_path);
+		return 0;
+	}
+
+	std::ifstream baseline_file(options.baseline_path);
+	if (!baseline_file) {
+		spdlog::info("No baseline at '{}', skipping regression check (run with --update-baseline to create one).", options.baseline_path);
+		return 0;
+	}
+	nlohmann::json baseline = nlohmann::json::parse(baseline_file, nullptr, false);
+	if (baseline.is_discarded()) {
+		spdlog::error("Baseline '{}' is not valid JSON.", options.baseline_path);
+		return 2;
+	}
+	int regressions = bench::compareWithBaseline(results, baseline, options.tolerance);
+	if (regressions > 0) {
+		spdlog::error("{} scene(s) regressed beyond {:.0f}% of the baseline.", regressions, options.tolerance * 100.0);
+		return 1;
+	}
+	spdlog::info("All scenes within {:.0f}% of the baseline.", options.tolerance * 100.0);
+	return 0;
+}
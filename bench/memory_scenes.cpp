@@ -0,0 +1,139 @@
+#include <array>
+
+#include "../src/engine/ecs/components.h"
+#include "../src/engine/ecs/world.h"
+#include "../src/engine/memory/frame_arena.h"
+#include "../src/engine/memory/pool_allocator.h"
+#include "../src/engine/render/camera.h"
+#include "../src/engine/render/renderer.h"
+#include "../src/engine/render/sprite.h"
+#include "../src/engine/resource/resource_manager.h"
+#include "scenes.h"
+
+namespace bench {
+
+namespace {
+
+constexpr size_t ARENA_BYTES = 64 * 1024;
+constexpr int ENTITY_COUNT = 10000;
+constexpr int CHURN_PER_FRAME = 500;
+constexpr int SPRITE_COUNT = 2000;
+constexpr size_t POOLED_OBJECTS = 256;
+constexpr const char *SPRITE_TEXTURE = "assets/textures/Actors/frog.png";
+constexpr const char *HUD_FONT = "assets/fonts/VonwaonBitmap-16px.ttf";
+
+/// @brief 池化的短生命周期对象，模拟每帧产生与回收的事件
+struct PooledEvent {
+	glm::vec2 position;
+	float lifetime = 0.0f;
+	Uint32 kind = 0;
+};
+
+/**
+ * @brief 主循环稳态：帧分配器重置与格式化、对象池收发、实体增删、批处理精灵与文字绘制。
+ *
+ * 这些路径在预热后都必须复用已有内存，计时区间内出现任何一次堆分配即视为失败。
+ */
+class SteadyStateFrameScene final : public BenchScene {
+private:
+	std::unique_ptr<engine::resource::ResourceManager> resource_manager;
+	std::unique_ptr<engine::render::Renderer> renderer;
+	std::unique_ptr<engine::render::Camera> camera;
+	std::unique_ptr<engine::ecs::World> world;
+	std::unique_ptr<engine::memory::FrameArena> frame_arena;
+	std::unique_ptr<engine::memory::ObjectPool<PooledEvent>> event_pool;
+	std::array<PooledEvent *, POOLED_OBJECTS> events{};
+	std::vector<engine::ecs::Entity> entities;
+	std::unique_ptr<engine::render::Sprite> sprite;
+	size_t cursor = 0;
+	Uint64 frame = 0;
+
+public:
+	std::string getName() const override { return "memory/steady_state_frame"; }
+	bool requiresZeroAllocations() const override { return true; }
+
+	bool setUp(BenchContext &context) override {
+		resource_manager = std::make_unique<engine::resource::ResourceManager>(context.sdl_renderer);
+		renderer = std::make_unique<engine::render::Renderer>(context.sdl_renderer, resource_manager.get());
+		renderer->setBatchingEnabled(true);
+		camera = std::make_unique<engine::render::Camera>(glm::vec2(static_cast<float>(context.width), static_cast<float>(context.height)));
+		world = std::make_unique<engine::ecs::World>();
+		frame_arena = std::make_unique<engine::memory::FrameArena>(ARENA_BYTES);
+		event_pool = std::make_unique<engine::memory::ObjectPool<PooledEvent>>(POOLED_OBJECTS);
+		sprite = std::make_unique<engine::render::Sprite>(SPRITE_TEXTURE);
+		if (!resource_manager->loadTexture(SPRITE_TEXTURE)) {
+			return false;
+		}
+
+		entities.reserve(ENTITY_COUNT);
+		for (int i = 0; i < ENTITY_COUNT; ++i) {
+			entities.push_back(world->create(engine::ecs::Position{ glm::vec2(static_cast<float>(i % 128) * 10.0f, static_cast<float>(i / 128) * 10.0f) },
+					engine::ecs::Velocity{ glm::vec2(1.0f, 0.0f) }));
+		}
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		frame_arena->reset();
+		++frame;
+
+		// 对象池：整批取出再全部归还
+		for (size_t i = 0; i < events.size(); ++i) {
+			events[i] = event_pool->create(PooledEvent{ glm::vec2(static_cast<float>(i), 0.0f), 1.0f, static_cast<Uint32>(i % 4) });
+		}
+		for (PooledEvent *event : events) {
+			event_pool->destroy(event);
+		}
+
+		// 实体增删：空出的块回到块池，空闲槽位被新实体复用
+		for (int i = 0; i < CHURN_PER_FRAME; ++i) {
+			engine::ecs::Entity &slot = entities[cursor];
+			cursor = (cursor + 1) % entities.size();
+			world->destroy(slot);
+			slot = world->create(engine::ecs::Position{}, engine::ecs::Velocity{ glm::vec2(1.0f, 0.0f) });
+		}
+
+		// 帧内临时数组与字符串
+		std::span<glm::vec2> positions = frame_arena->allocateArray<glm::vec2>(SPRITE_COUNT);
+		for (size_t i = 0; i < positions.size(); ++i) {
+			positions[i] = glm::vec2(static_cast<float>(i % 64) * 20.0f, static_cast<float>(i / 64) * 20.0f);
+		}
+		std::string_view hud = frame_arena->format("Score {}  HP {}", frame % 8, 3);
+		hud = frame_arena->append(hud, "  entities {}", entities.size());
+
+		renderer->clearScreen();
+		for (const glm::vec2 &position : positions) {
+			renderer->drawSprite(*camera, *sprite, position);
+		}
+		renderer->drawText(hud, HUD_FONT, 16, glm::vec2(8.0f, 8.0f), SDL_FColor{ 1.0f, 1.0f, 1.0f, 1.0f });
+		renderer->present();
+		return static_cast<Uint64>(POOLED_OBJECTS + CHURN_PER_FRAME + SPRITE_COUNT);
+	}
+
+	void tearDown() override {
+		entities.clear();
+		sprite.reset();
+		event_pool.reset();
+		frame_arena.reset();
+		world.reset();
+		camera.reset();
+		renderer.reset();
+		resource_manager.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["arena_peak_bytes"] = frame_arena->getPeakBytes();
+		metrics["arena_overflows"] = frame_arena->getOverflowCount();
+		metrics["pool_capacity"] = event_pool->getCapacity();
+	}
+};
+
+} // namespace
+
+SceneList makeMemoryScenes() {
+	SceneList scenes;
+	scenes.push_back(std::make_unique<SteadyStateFrameScene>());
+	return scenes;
+}
+
+} // namespace bench
@@ -0,0 +1,193 @@
+#include <random>
+
+#include "../src/engine/ecs/systems.h"
+#include "../src/engine/ecs/world.h"
+#include "../src/engine/map/map_loader.h"
+#include "../src/engine/map/tile_map.h"
+#include "../src/engine/nav/flow_field.h"
+#include "../src/engine/nav/nav_grid.h"
+#include "../src/engine/nav/path_finder.h"
+#include "../src/engine/physics/tile_collision_grid.h"
+#include "scenes.h"
+
+namespace bench {
+
+namespace {
+
+constexpr Uint32 SCENE_SEED = 8765;
+constexpr Uint32 EXPANSIONS_PER_FRAME = 2048; ///< @brief 与 GameApp 的固定步预算一致
+constexpr int TARGET_MOVE_INTERVAL = 10; ///< @brief 目标每隔多少帧换到一个新格子
+
+/// @brief 收集某个图层中所有可通过的格子，供随机选取生成点与目标
+std::vector<glm::ivec2> collectPassable(const engine::nav::NavGrid &grid, engine::nav::NavLayer layer) {
+	std::vector<glm::ivec2> cells;
+	for (int y = 0; y < grid.getHeight(); ++y) {
+		for (int x = 0; x < grid.getWidth(); ++x) {
+			if (grid.isPassable(layer, { x, y })) {
+				cells.push_back({ x, y });
+			}
+		}
+	}
+	return cells;
+}
+
+/**
+ * @brief 流场导航：大量飞行单位在 level1 上追踪一个不断移动的目标，流场按固定预算分帧重建，单位每帧 O(1) 采样
+ */
+class FlowFieldScene final : public BenchScene {
+private:
+	int agent_count;
+	std::unique_ptr<engine::map::TileMap> map;
+	std::unique_ptr<engine::physics::TileCollisionGrid> collision_grid;
+	std::unique_ptr<engine::nav::NavGrid> nav_grid;
+	std::unique_ptr<engine::nav::FlowField> field;
+	std::unique_ptr<engine::ecs::World> world;
+	std::unique_ptr<engine::ecs::NavigationSystem> navigation_system;
+	std::vector<glm::ivec2> targets;
+	std::mt19937 rng{ SCENE_SEED };
+	int frame = 0;
+
+public:
+	explicit FlowFieldScene(int agent_count) :
+			agent_count(agent_count) {}
+
+	std::string getName() const override { return "nav/" + std::to_string(agent_count) + "_flow_field_agents"; }
+
+	bool setUp(BenchContext &) override {
+		map = engine::map::MapLoader::load("assets/maps/level1.tmj");
+		if (!map) {
+			return false;
+		}
+		collision_grid = std::make_unique<engine::physics::TileCollisionGrid>(*map, "main");
+		nav_grid = std::make_unique<engine::nav::NavGrid>(*collision_grid);
+		field = std::make_unique<engine::nav::FlowField>(*nav_grid, engine::nav::NavLayer::Flying);
+		world = std::make_unique<engine::ecs::World>();
+		navigation_system = std::make_unique<engine::ecs::NavigationSystem>(*world, nullptr, field.get());
+
+		targets = collectPassable(*nav_grid, engine::nav::NavLayer::Flying);
+		if (targets.empty()) {
+			return false;
+		}
+		std::uniform_int_distribution<size_t> pick(0, targets.size() - 1);
+		for (int i = 0; i < agent_count; ++i) {
+			glm::vec2 position = nav_grid->cellCenter(targets[pick(rng)]);
+			engine::ecs::NavAgent agent;
+			agent.layer = engine::nav::NavLayer::Flying;
+			world->create(engine::ecs::Position{ position, position }, engine::ecs::Velocity{}, agent);
+		}
+		field->setTarget(targets[pick(rng)]);
+		field->rebuildNow();
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		if (++frame % TARGET_MOVE_INTERVAL == 0) {
+			std::uniform_int_distribution<size_t> pick(0, targets.size() - 1);
+			field->setTarget(targets[pick(rng)]);
+		}
+		field->update(EXPANSIONS_PER_FRAME);
+		navigation_system->update();
+		return static_cast<Uint64>(agent_count);
+	}
+
+	void tearDown() override {
+		navigation_system.reset();
+		world.reset();
+		field.reset();
+		nav_grid.reset();
+		collision_grid.reset();
+		map.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["agents"] = agent_count;
+		if (field) {
+			const engine::nav::FlowFieldStats &stats = field->getStats();
+			metrics["builds"] = stats.builds;
+			metrics["last_build_expansions"] = stats.last_build_expansions;
+			metrics["last_build_slices"] = stats.last_build_slices;
+			metrics["reachable_cells"] = stats.reachable_cells;
+		}
+	}
+};
+
+/**
+ * @brief 一次性寻路：每帧在随机格子之间做若干次飞行（JPS）与行走（A*）查询
+ */
+class PathQueryScene final : public BenchScene {
+private:
+	int query_count;
+	std::unique_ptr<engine::map::TileMap> map;
+	std::unique_ptr<engine::physics::TileCollisionGrid> collision_grid;
+	std::unique_ptr<engine::nav::NavGrid> nav_grid;
+	std::unique_ptr<engine::nav::PathFinder> path_finder;
+	std::vector<glm::ivec2> cells[engine::nav::NAV_LAYER_COUNT];
+	std::vector<glm::ivec2> path;
+	std::mt19937 rng{ SCENE_SEED };
+	Uint64 expanded[engine::nav::NAV_LAYER_COUNT] = {};
+	Uint64 queries[engine::nav::NAV_LAYER_COUNT] = {};
+	Uint64 found = 0;
+
+public:
+	explicit PathQueryScene(int query_count) :
+			query_count(query_count) {}
+
+	std::string getName() const override { return "nav/" + std::to_string(query_count) + "_path_queries"; }
+
+	bool setUp(BenchContext &) override {
+		map = engine::map::MapLoader::load("assets/maps/level1.tmj");
+		if (!map) {
+			return false;
+		}
+		collision_grid = std::make_unique<engine::physics::TileCollisionGrid>(*map, "main");
+		nav_grid = std::make_unique<engine::nav::NavGrid>(*collision_grid);
+		path_finder = std::make_unique<engine::nav::PathFinder>(*nav_grid);
+		for (size_t layer = 0; layer < engine::nav::NAV_LAYER_COUNT; ++layer) {
+			cells[layer] = collectPassable(*nav_grid, static_cast<engine::nav::NavLayer>(layer));
+			if (cells[layer].empty()) {
+				return false;
+			}
+		}
+		path.reserve(static_cast<size_t>(nav_grid->getWidth() + nav_grid->getHeight()) * 2);
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		for (int i = 0; i < query_count; ++i) {
+			const size_t layer = static_cast<size_t>(i) % engine::nav::NAV_LAYER_COUNT;
+			std::uniform_int_distribution<size_t> pick(0, cells[layer].size() - 1);
+			if (path_finder->findPath(static_cast<engine::nav::NavLayer>(layer), cells[layer][pick(rng)], cells[layer][pick(rng)], path)) {
+				++found;
+			}
+			expanded[layer] += path_finder->getLastStats().expanded;
+			++queries[layer];
+		}
+		return static_cast<Uint64>(query_count);
+	}
+
+	void tearDown() override {
+		path_finder.reset();
+		nav_grid.reset();
+		collision_grid.reset();
+		map.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		const Uint64 total = queries[0] + queries[1];
+		metrics["queries_per_frame"] = query_count;
+		metrics["found_fraction"] = total > 0 ? static_cast<double>(found) / static_cast<double>(total) : 0.0;
+		metrics["walking_avg_expanded"] = queries[0] > 0 ? static_cast<double>(expanded[0]) / static_cast<double>(queries[0]) : 0.0;
+		metrics["flying_avg_expanded"] = queries[1] > 0 ? static_cast<double>(expanded[1]) / static_cast<double>(queries[1]) : 0.0;
+	}
+};
+
+} // namespace
+
+SceneList makeNavScenes() {
+	SceneList scenes;
+	scenes.push_back(std::make_unique<FlowFieldScene>(5000));
+	scenes.push_back(std::make_unique<PathQueryScene>(200));
+	return scenes;
+}
+
+} // namespace bench
@@ -0,0 +1,193 @@
+#include <random>
+
+#include "../src/engine/ecs/systems.h"
+#include "../src/engine/ecs/world.h"
+#include "../src/engine/map/map_loader.h"
+#include "../src/engine/map/tile_map.h"
+#include "../src/engine/physics/spatial_hash.h"
+#include "../src/engine/physics/tile_collision_grid.h"
+#include "scenes.h"
+
+namespace bench {
+
+namespace {
+
+constexpr Uint32 SCENE_SEED = 4321;
+constexpr float FIXED_DELTA_TIME = 1.0f / 60.0f;
+constexpr float WALK_SPEED = 80.0f;
+constexpr float JUMP_SPEED = -320.0f;
+
+/**
+ * @brief 地形碰撞：大量角色在 level1 的 main 图层上行走、跳跃，撞墙后随机换向
+ */
+class TileCollisionScene final : public BenchScene {
+private:
+	int body_count;
+	std::unique_ptr<engine::map::TileMap> map;
+	std::unique_ptr<engine::physics::TileCollisionGrid> grid;
+	std::unique_ptr<engine::ecs::World> world;
+	std::unique_ptr<engine::ecs::PositionSnapshotSystem> snapshot_system;
+	std::unique_ptr<engine::ecs::TileCollisionSystem> collision_system;
+	engine::ecs::Query<engine::ecs::Velocity, engine::ecs::TileBody> steering_query;
+	std::mt19937 rng{ SCENE_SEED };
+	size_t grounded = 0;
+
+public:
+	explicit TileCollisionScene(int body_count) :
+			body_count(body_count) {}
+
+	std::string getName() const override { return "physics/" + std::to_string(body_count) + "_tile_bodies"; }
+
+	bool setUp(BenchContext &) override {
+		map = engine::map::MapLoader::load("assets/maps/level1.tmj");
+		if (!map) {
+			return false;
+		}
+		grid = std::make_unique<engine::physics::TileCollisionGrid>(*map, "main");
+		world = std::make_unique<engine::ecs::World>();
+		snapshot_system = std::make_unique<engine::ecs::PositionSnapshotSystem>(*world);
+		collision_system = std::make_unique<engine::ecs::TileCollisionSystem>(*world, *grid);
+		steering_query = engine::ecs::Query<engine::ecs::Velocity, engine::ecs::TileBody>(*world);
+
+		// 只在空格子上生成，避免一开始就嵌在地形里
+		const glm::vec2 &tile_size = grid->getTileSize();
+		std::uniform_int_distribution<int> column(0, grid->getWidth() - 1);
+		std::uniform_int_distribution<int> row(0, grid->getHeight() - 2);
+		std::bernoulli_distribution facing_right(0.5);
+		for (int spawned = 0; spawned < body_count;) {
+			int x = column(rng);
+			int y = row(rng);
+			if (grid->getCell(x, y).flags != engine::map::TILE_FLAG_NONE || grid->getCell(x, y + 1).flags != engine::map::TILE_FLAG_NONE) {
+				continue;
+			}
+			engine::ecs::TileBody body;
+			body.size = glm::vec2(11.0f, 19.0f); // 与 foxy 的碰撞框相同
+			glm::vec2 position(x * tile_size.x, y * tile_size.y);
+			world->create(engine::ecs::Position{ position, position }, engine::ecs::Velocity{ glm::vec2(facing_right(rng) ? WALK_SPEED : -WALK_SPEED, 0.0f) }, body);
+			++spawned;
+		}
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		snapshot_system->update();
+		collision_system->update(FIXED_DELTA_TIME);
+
+		grounded = 0;
+		std::bernoulli_distribution jump(0.01);
+		std::bernoulli_distribution facing_right(0.5);
+		steering_query.each([&](engine::ecs::Velocity &velocity, engine::ecs::TileBody &body) {
+			// 撞墙时系统已把水平速度清零，随机选择新方向
+			if (body.hit_wall) {
+				velocity.value.x = facing_right(rng) ? WALK_SPEED : -WALK_SPEED;
+			}
+			if (body.on_ground) {
+				++grounded;
+				if (jump(rng)) {
+					velocity.value.y = JUMP_SPEED;
+				}
+			}
+		});
+		return static_cast<Uint64>(body_count);
+	}
+
+	void tearDown() override {
+		steering_query = {};
+		collision_system.reset();
+		snapshot_system.reset();
+		world.reset();
+		grid.reset();
+		map.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["bodies"] = body_count;
+		metrics["grounded_fraction"] = body_count > 0 ? static_cast<double>(grounded) / body_count : 0.0;
+		if (grid) {
+			metrics["grid_width"] = grid->getWidth();
+			metrics["grid_height"] = grid->getHeight();
+		}
+	}
+};
+
+/**
+ * @brief 碰撞宽相：大量弹道/拾取物在一块区域内运动，每帧重建空间哈希并生成候选碰撞对
+ */
+class BroadPhaseScene final : public BenchScene {
+private:
+	struct Mover {
+		glm::vec2 position;
+		glm::vec2 velocity;
+		glm::vec2 size;
+		Uint32 layer;
+	};
+
+	static constexpr glm::vec2 AREA_SIZE = glm::vec2(2400.0f, 1200.0f);
+
+	int proxy_count;
+	std::vector<Mover> movers;
+	engine::physics::SpatialHash spatial_hash;
+	std::vector<engine::physics::BroadPhasePair> pairs;
+
+public:
+	explicit BroadPhaseScene(int proxy_count) :
+			proxy_count(proxy_count) {}
+
+	std::string getName() const override { return "physics/" + std::to_string(proxy_count) + "_broadphase_pairs"; }
+
+	bool setUp(BenchContext &) override {
+		std::mt19937 rng(SCENE_SEED);
+		std::uniform_real_distribution<float> x(0.0f, AREA_SIZE.x);
+		std::uniform_real_distribution<float> y(0.0f, AREA_SIZE.y);
+		std::uniform_real_distribution<float> speed(-120.0f, 120.0f);
+		std::uniform_real_distribution<float> extent(6.0f, 30.0f);
+		std::uniform_int_distribution<int> layer(0, 3);
+		movers.clear();
+		movers.reserve(static_cast<size_t>(proxy_count));
+		for (int i = 0; i < proxy_count; ++i) {
+			movers.push_back({ glm::vec2(x(rng), y(rng)), glm::vec2(speed(rng), speed(rng)), glm::vec2(extent(rng), extent(rng)), 1u << layer(rng) });
+		}
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		spatial_hash.clear();
+		for (Mover &mover : movers) {
+			mover.position += mover.velocity * FIXED_DELTA_TIME;
+			if (mover.position.x < 0.0f || mover.position.x > AREA_SIZE.x) {
+				mover.velocity.x = -mover.velocity.x;
+			}
+			if (mover.position.y < 0.0f || mover.position.y > AREA_SIZE.y) {
+				mover.velocity.y = -mover.velocity.y;
+			}
+			// 同层之间不配对（如弹道与弹道），其余组合都参与
+			spatial_hash.insert({ mover.position, mover.size }, mover.layer, engine::physics::COLLISION_LAYER_ALL & ~mover.layer);
+		}
+		spatial_hash.build();
+		pairs.clear();
+		spatial_hash.findPairs(pairs);
+		return static_cast<Uint64>(proxy_count);
+	}
+
+	void tearDown() override {
+		movers.clear();
+		spatial_hash.clear();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["proxies"] = proxy_count;
+		metrics["pairs_last_frame"] = pairs.size();
+		metrics["cell_entries"] = spatial_hash.getCellEntryCount();
+	}
+};
+
+} // namespace
+
+SceneList makePhysicsScenes() {
+	SceneList scenes;
+	scenes.push_back(std::make_unique<TileCollisionScene>(500));
+	scenes.push_back(std::make_unique<BroadPhaseScene>(5000));
+	return scenes;
+}
+
+} // namespace bench
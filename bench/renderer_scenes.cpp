@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <filesystem>
+#include <random>
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include "../src/engine/render/camera.h"
+#include "../src/engine/render/renderer.h"
+#include "../src/engine/render/sprite.h"
+#include "../src/engine/resource/resource_manager.h"
+#include "../src/engine/resource/texture_atlas.h"
+#include "scenes.h"
+
+namespace bench {
+
+namespace {
+
+constexpr const char *SPRITE_DIRECTORY = "assets/textures/Props";
+constexpr float SPRITE_SIZE = 32.0f; // 统一源矩形大小，使不同纹理的填充开销一致
+constexpr Uint32 SCENE_SEED = 1234;
+
+struct RendererSceneParams {
+	std::string name;
+	int sprite_count = 1000;
+	int texture_count = 1;
+	bool rotated = false;
+	int parallax_layers = 0;
+	float visible_fraction = 1.0f; ///< @brief 落在视口内的精灵比例，其余放在视口外以测试裁剪
+	bool batching = true;
+	bool atlas = false; ///< @brief 是否先把纹理打包进图集
+	bool batch_cull = false; ///< @brief 用 Camera::cullToScreen 批量变换裁剪，代替逐精灵 drawSprite
+};
+
+/**
+ * @brief N 个精灵 / M 张纹理的 Renderer 场景，每个场景使用独立的 ResourceManager 与 Renderer
+ */
+class RendererScene final : public BenchScene {
+private:
+	RendererSceneParams params;
+	std::unique_ptr<engine::resource::ResourceManager> resource_manager;
+	std::unique_ptr<engine::render::Renderer> renderer;
+	std::unique_ptr<engine::render::Camera> camera;
+	std::vector<engine::render::Sprite> textures; ///< @brief 每张纹理一个精灵模板
+	std::vector<engine::render::Sprite> parallax_layers;
+	std::vector<glm::vec2> positions;
+	std::vector<float> angles;
+	std::vector<Uint32> texture_indices;
+	std::vector<float> xs; ///< @brief batch_cull 使用的 SoA 输入
+	std::vector<float> ys;
+	std::vector<float> widths;
+	std::vector<float> heights;
+	std::vector<Uint32> visible_indices;
+	std::vector<SDL_FRect> screen_rects;
+	float camera_x = 0.0f;
+	int last_draw_calls = 0;
+
+public:
+	explicit RendererScene(RendererSceneParams params) :
+			params(std::move(params)) {}
+
+	std::string getName() const override { return params.name; }
+
+	bool setUp(BenchContext &context) override {
+		resource_manager = std::make_unique<engine::resource::ResourceManager>(context.sdl_renderer);
+		renderer = std::make_unique<engine::render::Renderer>(context.sdl_renderer, resource_manager.get());
+		renderer->setBatchingEnabled(params.batching);
+		camera = std::make_unique<engine::render::Camera>(glm::vec2(static_cast<float>(context.width), static_cast<float>(context.height)));
+
+		if (params.atlas) {
+			engine::resource::AtlasConfig config;
+			config.directories = { SPRITE_DIRECTORY };
+			if (!resource_manager->buildTextureAtlas(config)) {
+				return false;
+			}
+		}
+
+		std::vector<std::string> paths;
+		std::error_code ec;
+		for (const auto &entry : std::filesystem::directory_iterator(SPRITE_DIRECTORY, ec)) {
+			if (entry.path().extension() == ".png") {
+				paths.push_back(entry.path().generic_string());
+			}
+		}
+		std::sort(paths.begin(), paths.end()); // 目录遍历顺序不确定，排序保证各次运行一致
+		if (paths.empty()) {
+			spdlog::error("No textures found in '{}'.", SPRITE_DIRECTORY);
+			return false;
+		}
+
+		for (int i = 0; i < params.texture_count; ++i) {
+			const std::string &path = paths[static_cast<size_t>(i) % paths.size()];
+			auto handle = resource_manager->loadTextureHandle(path);
+			glm::vec2 size = resource_manager->getTextureSize(handle);
+			SDL_FRect source = { 0.0f, 0.0f, std::min(size.x, SPRITE_SIZE), std::min(size.y, SPRITE_SIZE) };
+			textures.emplace_back(handle, path, source);
+		}
+		for (int i = 0; i < params.parallax_layers; ++i) {
+			parallax_layers.emplace_back(i % 2 == 0 ? "assets/textures/Layers/back.png" : "assets/textures/Layers/middle.png");
+		}
+
+		std::mt19937 rng(SCENE_SEED);
+		std::uniform_real_distribution<float> x_dist(0.0f, static_cast<float>(context.width) - SPRITE_SIZE);
+		std::uniform_real_distribution<float> y_dist(0.0f, static_cast<float>(context.height) - SPRITE_SIZE);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		for (int i = 0; i < params.sprite_count; ++i) {
+			glm::vec2 position(x_dist(rng), y_dist(rng));
+			if (unit(rng) >= params.visible_fraction) {
+				position.y += static_cast<float>(context.height) * 4.0f; // 视口外
+			}
+			positions.push_back(position);
+			angles.push_back(params.rotated ? unit(rng) * 360.0f : 0.0f);
+			texture_indices.push_back(static_cast<Uint32>(i % params.texture_count));
+			const SDL_FRect &source = *textures[texture_indices.back()].getSourceRect();
+			xs.push_back(position.x);
+			ys.push_back(position.y);
+			widths.push_back(source.w);
+			heights.push_back(source.h);
+		}
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		// 相机来回平移，让视差层与裁剪每帧都有变化
+		camera_x = camera_x > 64.0f ? 0.0f : camera_x + 1.0f;
+		camera->setPosition(glm::vec2(camera_x, 0.0f));
+
+		renderer->clearScreen();
+		renderer->setLayer(0);
+		for (size_t i = 0; i < parallax_layers.size(); ++i) {
+			float factor = 0.25f * static_cast<float>(i + 1);
+			renderer->drawParallax(*camera, parallax_layers[i], glm::vec2(0.0f), glm::vec2(factor, factor * 0.5f));
+		}
+		renderer->setLayer(1);
+		if (params.batch_cull) {
+			size_t visible = camera->cullToScreen({ xs, ys, widths, heights, {}, {} }, visible_indices, screen_rects);
+			for (size_t v = 0; v < visible; ++v) {
+				Uint32 i = visible_indices[v];
+				renderer->drawSpriteScreen(textures[texture_indices[i]], screen_rects[v], angles[i]);
+			}
+		} else {
+			for (size_t i = 0; i < positions.size(); ++i) {
+				renderer->drawSprite(*camera, textures[texture_indices[i]], positions[i], glm::vec2(1.0f), angles[i]);
+			}
+		}
+		renderer->present();
+		last_draw_calls = renderer->getBatchStats().draw_calls;
+		return positions.size() + parallax_layers.size();
+	}
+
+	void tearDown() override {
+		textures.clear();
+		parallax_layers.clear();
+		positions.clear();
+		angles.clear();
+		texture_indices.clear();
+		xs.clear();
+		ys.clear();
+		widths.clear();
+		heights.clear();
+		camera.reset();
+		renderer.reset();
+		resource_manager.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		metrics["sprites"] = params.sprite_count;
+		metrics["textures"] = params.texture_count;
+		metrics["rotated"] = params.rotated;
+		metrics["parallax_layers"] = params.parallax_layers;
+		metrics["visible_fraction"] = params.visible_fraction;
+		metrics["batching"] = params.batching;
+		metrics["atlas"] = params.atlas;
+		metrics["batch_cull"] = params.batch_cull;
+		metrics["draw_calls"] = last_draw_calls; // 仅批处理模式下有意义
+	}
+};
+
+constexpr const char *HUD_FONT = "assets/fonts/VonwaonBitmap-16px.ttf";
+constexpr int HUD_FONT_SIZE = 16;
+
+/**
+ * @brief HUD 文本场景：每帧绘制若干行文本，dynamic 时每行都带逐帧变化的数字（排版缓存每帧未命中）
+ */
+class TextScene final : public BenchScene {
+private:
+	std::string name;
+	int line_count = 0;
+	bool dynamic = false;
+	std::unique_ptr<engine::resource::ResourceManager> resource_manager;
+	std::unique_ptr<engine::render::Renderer> renderer;
+	std::vector<std::string> lines;
+	std::string scratch;
+	Uint64 frame = 0;
+	int last_draw_calls = 0;
+	Uint64 glyphs_after_warmup = 0;
+
+public:
+	TextScene(std::string name, int line_count, bool dynamic) :
+			name(std::move(name)), line_count(line_count), dynamic(dynamic) {}
+
+	std::string getName() const override { return name; }
+
+	bool setUp(BenchContext &context) override {
+		resource_manager = std::make_unique<engine::resource::ResourceManager>(context.sdl_renderer);
+		renderer = std::make_unique<engine::render::Renderer>(context.sdl_renderer, resource_manager.get());
+		renderer->setBatchingEnabled(true);
+		if (!resource_manager->loadFont(HUD_FONT, HUD_FONT_SIZE)) {
+			return false;
+		}
+		for (int i = 0; i < line_count; ++i) {
+			lines.push_back(fmt::format("Score {:06d}  HP {}  Coins {}", i * 1250, 3 + i % 3, i * 7));
+		}
+		return true;
+	}
+
+	Uint64 runFrame(BenchContext &) override {
+		if (++frame == 2) { // 第一帧光栅化所有字形，之后的统计才反映稳态
+			glyphs_after_warmup = resource_manager->getTextCacheStats().glyphs_rasterized;
+		}
+		renderer->clearScreen();
+		for (int i = 0; i < line_count; ++i) {
+			glm::vec2 position(8.0f, 8.0f + static_cast<float>(i % 40) * 18.0f);
+			if (dynamic) {
+				scratch.clear();
+				fmt::format_to(std::back_inserter(scratch), "Time {:.2f}  Score {:06d}", static_cast<double>(frame) / 60.0, (frame + static_cast<Uint64>(i)) % 1000000);
+				renderer->drawText(scratch, HUD_FONT, HUD_FONT_SIZE, position);
+			} else {
+				renderer->drawText(lines[static_cast<size_t>(i)], HUD_FONT, HUD_FONT_SIZE, position);
+			}
+		}
+		renderer->present();
+		last_draw_calls = renderer->getBatchStats().draw_calls;
+		return static_cast<Uint64>(line_count);
+	}
+
+	void tearDown() override {
+		lines.clear();
+		renderer.reset();
+		resource_manager.reset();
+	}
+
+	void report(nlohmann::json &metrics) const override {
+		engine::resource::TextCacheStats stats = resource_manager ? resource_manager->getTextCacheStats() : engine::resource::TextCacheStats{};
+		metrics["lines"] = line_count;
+		metrics["dynamic"] = dynamic;
+		metrics["draw_calls"] = last_draw_calls;
+		metrics["steady_state_glyphs_rasterized"] = stats.glyphs_rasterized - std::min(stats.glyphs_rasterized, glyphs_after_warmup);
+		metrics["layout_hits"] = stats.layout_hits;
+		metrics["layout_misses"] = stats.layout_misses;
+	}
+};
+
+} // namespace
+
+SceneList makeRendererScenes() {
+	const std::vector<RendererSceneParams> params = {
+		{ .name = "renderer/1k_sprites_1_texture", .sprite_count = 1000, .texture_count = 1 },
+		{ .name = "renderer/10k_sprites_8_textures", .sprite_count = 10000, .texture_count = 8 },
+		{ .name = "renderer/10k_sprites_8_textures_rotated", .sprite_count = 10000, .texture_count = 8, .rotated = true },
+		{ .name = "renderer/10k_sprites_8_textures_atlas", .sprite_count = 10000, .texture_count = 8, .atlas = true },
+		{ .name = "renderer/10k_sprites_8_textures_unbatched", .sprite_count = 10000, .texture_count = 8, .batching = false },
+		{ .name = "renderer/10k_sprites_mostly_culled", .sprite_count = 10000, .texture_count = 8, .visible_fraction = 0.05f },
+		{ .name = "renderer/10k_sprites_mostly_culled_batch_cull", .sprite_count = 10000, .texture_count = 8, .visible_fraction = 0.05f, .batch_cull = true },
+		{ .name = "renderer/10k_sprites_8_textures_batch_cull", .sprite_count = 10000, .texture_count = 8, .batch_cull = true },
+		{ .name = "renderer/2k_sprites_4_parallax_layers", .sprite_count = 2000, .texture_count = 8, .parallax_layers = 4 },
+	};
+	SceneList scenes;
+	for (const auto &scene_params : params) {
+		scenes.push_back(std::make_unique<RendererScene>(scene_params));
+	}
+	scenes.push_back(std::make_unique<TextScene>("renderer/hud_text_64_lines", 64, false));
+	scenes.push_back(std::make_unique<TextScene>("renderer/hud_text_64_lines_dynamic", 64, true));
+	return scenes;
+}
+
+} // namespace bench
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "bench_harness.h"
+
+namespace bench {
+
+SceneList makeRendererScenes(); ///< @brief Renderer 吞吐量场景（见 renderer_scenes.cpp）
+SceneList makeEcsScenes(); ///< @brief ECS 更新与结构性修改场景（见 ecs_scenes.cpp）
+SceneList makePhysicsScenes(); ///< @brief 碰撞检测场景（见 physics_scenes.cpp）
+SceneList makeFxScenes(); ///< @brief 粒子场景（见 fx_scenes.cpp）
+SceneList makeNavScenes(); ///< @brief 流场与寻路场景（见 nav_scenes.cpp）
+SceneList makeMemoryScenes(); ///< @brief 稳态零分配场景（见 memory_scenes.cpp）
+
+} // namespace bench
@@ -0,0 +1,54 @@
+#include "command_line.h"
+
+#include <charconv>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+bool parseInt(std::string_view text, int &out) {
+	auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+	return ec == std::errc() && ptr == text.data() + text.size();
+}
+} // namespace
+
+CommandLine CommandLine::parse(int argc, char *argv[]) {
+	CommandLine result;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		bool has_value = i + 1 < argc;
+		if (arg == "--profiler") {
+			result.show_profiler = true;
+		} else if (arg == "--profile-dump" && has_value) {
+			if (!parseInt(argv[++i], result.profile_dump_frames) || result.profile_dump_frames < 0) {
+				spdlog::warn("Invalid frame count for --profile-dump: '{}'.", argv[i]);
+				result.profile_dump_frames = 0;
+			}
+		} else if (arg == "--profile-output" && has_value) {
+			result.profile_output_path = argv[++i];
+		} else if (arg == "--startup-report" && has_value) {
+			result.startup_report_path = argv[++i];
+		} else if (arg == "--record" && has_value) {
+			result.record_path = argv[++i];
+		} else if (arg == "--replay" && has_value) {
+			result.replay_path = argv[++i];
+		} else if (arg == "--headless") {
+			result.headless = true;
+		} else if (arg == "--max-ticks" && has_value) {
+			if (!parseInt(argv[++i], result.max_ticks) || result.max_ticks < 0) {
+				spdlog::warn("Invalid tick count for --max-ticks: '{}'.", argv[i]);
+				result.max_ticks = 0;
+			}
+		} else {
+			spdlog::warn("Ignoring unknown or incomplete argument '{}'.", arg);
+		}
+	}
+	if (result.headless && result.replay_path.empty() && result.max_ticks == 0) {
+		spdlog::warn("--headless without --replay or --max-ticks runs until the process is terminated.");
+	}
+	return result;
+}
+
+} // namespace engine::core
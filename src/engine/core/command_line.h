@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+namespace engine::core {
+
+/**
+ * @brief 启动参数。未识别的参数会被忽略并给出警告。
+ *
+ * --profiler                 启动时显示分析器叠加层（F3 切换）
+ * --profile-dump <frames>    退出时把最近若干帧导出为 Chrome 追踪文件（F4 随时导出）
+ * --profile-output <path>    追踪文件路径，默认 profile_trace.json
+ * --startup-report <path>    首帧后写出的启动耗时报告路径，默认 startup_report.json
+ * --record <path>            把每个固定步的输入录制到文件，退出时写出
+ * --replay <path>            按录制文件重放输入，重放结束后退出并校验模拟状态
+ * --headless                 不显示窗口、不渲染，固定步不限速地连续执行（快进），通常与 --replay 或 --max-ticks 一起使用
+ * --max-ticks <n>            执行 n 个固定步后退出
+ */
+struct CommandLine {
+	bool show_profiler = false;
+	int profile_dump_frames = 0; ///< @brief 0 表示退出时不导出
+	std::string profile_output_path = "profile_trace.json";
+	std::string startup_report_path = "startup_report.json";
+	std::string record_path; ///< @brief 为空表示不录制
+	std::string replay_path; ///< @brief 为空表示使用实时输入
+	bool headless = false;
+	int max_ticks = 0; ///< @brief 0 表示不限制
+
+	static CommandLine parse(int argc, char *argv[]);
+};
+
+} // namespace engine::core
@@ -0,0 +1,63 @@
+#include "config.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+Config::Config(const std::string &path) {
+	if (!loadFromFile(path)) {
+		spdlog::warn("Using default configuration.");
+	}
+}
+
+bool Config::loadFromFile(const std::string &path) {
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		spdlog::warn("Config file '{}' not found.", path);
+		return false;
+	}
+
+	auto json = nlohmann::json::parse(file, nullptr, false);
+	if (json.is_discarded() || !json.is_object()) {
+		spdlog::error("Failed to parse config file '{}'.", path);
+		return false;
+	}
+
+	if (auto it = json.find("window"); it != json.end() && it->is_object()) {
+		window_title = it->value("title", window_title);
+		window_width = it->value("width", window_width);
+		window_height = it->value("height", window_height);
+		window_resizable = it->value("resizable", window_resizable);
+	}
+	if (auto it = json.find("graphics"); it != json.end() && it->is_object()) {
+		vsync = it->value("vsync", vsync);
+		max_particles = std::max(0, it->value("max_particles", max_particles));
+		particle_effects = it->value("particle_effects", particle_effects);
+	}
+	if (auto it = json.find("performance"); it != json.end() && it->is_object()) {
+		target_fps = std::max(0, it->value("target_fps", target_fps));
+		fixed_update_hz = std::max(1, it->value("fixed_update_hz", fixed_update_hz));
+		max_fixed_steps = std::max(1, it->value("max_fixed_steps", max_fixed_steps));
+		worker_threads = std::max(-1, it->value("worker_threads", worker_threads));
+		frame_arena_kb = std::max(1, it->value("frame_arena_kb", frame_arena_kb));
+	}
+	if (auto it = json.find("resources"); it != json.end() && it->is_object()) {
+		asset_archive = it->value("asset_archive", asset_archive);
+		texture_budget_mb = std::max(0, it->value("texture_budget_mb", texture_budget_mb));
+		font_budget_mb = std::max(0, it->value("font_budget_mb", font_budget_mb));
+		cache_idle_frames = std::max(1, it->value("cache_idle_frames", cache_idle_frames));
+	}
+	if (auto it = json.find("audio"); it != json.end() && it->is_object()) {
+		music_volume = std::max(0.0f, it->value("music_volume", music_volume));
+		sound_volume = std::max(0.0f, it->value("sound_volume", sound_volume));
+	}
+
+	spdlog::debug("Config loaded from '{}': vsync={}, target_fps={}, fixed_update_hz={}.", path, vsync, target_fps, fixed_update_hz);
+	return true;
+}
+
+} // namespace engine::core
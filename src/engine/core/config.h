@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+
+namespace engine::core {
+
+/**
+ * @brief 引擎配置，从 assets/config.json 读取。
+ *
+ * 文件缺失或字段缺失时保留默认值，不会导致初始化失败。
+ */
+class Config final {
+public:
+	// 窗口
+	std::string window_title = "Platformer";
+	int window_width = 1280;
+	int window_height = 720;
+	bool window_resizable = true;
+
+	// 图形
+	bool vsync = true; ///< @brief 开启时由 present 阻塞限帧，关闭时使用 Time 的软件限帧
+	int max_particles = 20000; ///< @brief 粒子池容量，启动时一次性分配
+	std::string particle_effects = "assets/fx/particles.fx.json"; ///< @brief 粒子效果文件，为空字符串时不加载
+
+	// 性能
+	int target_fps = 60; ///< @brief 软件限帧目标，0 表示不限帧
+	int fixed_update_hz = 60; ///< @brief 固定步长逻辑更新频率
+	int max_fixed_steps = 5; ///< @brief 单帧最多追赶的固定步数，防止卡顿后陷入死亡螺旋
+	int worker_threads = -1; ///< @brief 任务系统工作线程数，-1 表示自动（硬件线程数 - 1），0 表示全部在主线程执行
+	int frame_arena_kb = 1024; ///< @brief 帧分配器初始容量，某帧用量超出时自动扩大
+
+	// 资源缓存
+	std::string asset_archive = "assets.pak"; ///< @brief 资源包路径，文件不存在或为空字符串时读取散文件
+	int texture_budget_mb = 0; ///< @brief 纹理缓存的内存预算，0 表示不限
+	int font_budget_mb = 0; ///< @brief 字体（含字形图集）缓存的内存预算，0 表示不限
+	int cache_idle_frames = 600; ///< @brief 超出预算时，只淘汰至少闲置这么多帧的条目
+
+	// 音频
+	float music_volume = 0.2f;
+	float sound_volume = 0.5f; ///< @brief 音效总线音量
+
+	Config() = default;
+	explicit Config(const std::string &path);
+
+	[[nodiscard]] bool loadFromFile(const std::string &path);
+};
+
+} // namespace engine::core
@@ -1,20 +1,55 @@
 #include "game_app.h"
 
 #include <SDL3/SDL_init.h>
+#include <SDL3/SDL_hints.h>
 #include <SDL3/SDL_render.h>
+#include <SDL3/SDL_timer.h>
 #include <SDL3/SDL_video.h>
 #include <spdlog/spdlog.h>
+#include <filesystem>
 #include <glm/glm.hpp>
-
+#include <utility>
+
+#include "../debug/profiler.h"
+#include "../debug/profiler_overlay.h"
+#include "../ecs/systems.h"
+#include "../ecs/world.h"
+#include "../input/input_recording.h"
+#include "../map/baked_level.h"
+#include "../map/map_loader.h"
+#include "../map/tile_map.h"
+#include "../memory/allocation_tracker.h"
+#include "../memory/frame_arena.h"
+#include "../nav/flow_field.h"
+#include "../nav/nav_grid.h"
+#include "../physics/spatial_hash.h"
+#include "../physics/tile_collision_grid.h"
+#include "../render/animation_library.h"
 #include "../render/camera.h"
+#include "../render/particle_system.h"
 #include "../render/renderer.h"
 #include "../render/sprite.h"
+#include "../render/tile_map_renderer.h"
+#include "../resource/asset_archive.h"
+#include "../resource/preload_manifest.h"
 #include "../resource/resource_manager.h"
+#include "../resource/texture_atlas.h"
+#include "config.h"
+#include "job_system.h"
+#include "startup_report.h"
 #include "time.h"
 
 
 namespace engine::core {
 
+namespace {
+constexpr const char *LEVEL_MAP_PATH = "assets/maps/level1.tmj";
+constexpr const char *LEVEL_BAKED_PATH = "assets/maps/level1.lvl";
+constexpr Uint32 NAV_EXPANSIONS_PER_STEP = 2048; ///< @brief 每个固定步每个流场最多展开的格子数，大地图的重建分摊到多帧
+constexpr float WALKING_ENEMY_SPEED = 40.0f; ///< @brief 像素/秒，可由图块属性 speed 覆盖
+constexpr float FLYING_ENEMY_SPEED = 60.0f;
+} // namespace
+
 GameApp::GameApp() = default;
 
 GameApp::~GameApp() {
@@ -32,43 +67,79 @@ void GameApp::run() {
 
 	//testResourceManager();
 
-	time->setTargetFPS(60);
-
+	PROFILE_THREAD_NAME("Main");
+	const Uint64 loop_start = SDL_GetTicksNS();
 	while (is_running) {
-		time->update();
-		float deltaTime = time->getDeltaTime();
-
+		PROFILE_FRAME_BEGIN();
+		frame_arena->reset();
 		handleEvents();
-		update(deltaTime);
-		render();
+		if (command_line.headless) {
+			// 快进：每次循环恰好一个固定步，不限帧、不渲染，逻辑与窗口模式逐步一致
+			runFixedStep();
+			update(time->getFixedDeltaTime());
+			ENGINE_ALLOC_SCOPE(Resources);
+			resource_manager->update();
+		} else {
+			time->update();
+			for (int step = 0; step < time->getFixedStepCount() && is_running; ++step) {
+				runFixedStep();
+			}
+			update(time->getDeltaTime());
+			render();
+		}
+		PROFILE_FRAME_END();
+		if (engine::memory::AllocationTracker::isInstalled()) {
+			engine::memory::AllocationTracker::endFrame();
+		}
+		if (startup_report) {
+			reportStartup();
+			engine::memory::AllocationTracker::resetSummary(); // 只统计稳态帧，首帧的懒加载不计入
+		}
 
 		//spdlog::info("Frame rendered. Delta Time: {:.3f} seconds", deltaTime);
 	}
 
+	if (command_line.headless) {
+		double wall_seconds = static_cast<double>(SDL_GetTicksNS() - loop_start) / 1000000000.0;
+		double simulated_seconds = static_cast<double>(simulated_ticks) * time->getFixedDeltaTime();
+		spdlog::info("Headless run: {} ticks ({:.1f} s simulated) in {:.2f} s, {:.1f}x real time.",
+				simulated_ticks, simulated_seconds, wall_seconds, wall_seconds > 0.0 ? simulated_seconds / wall_seconds : 0.0);
+	}
+	if (command_line.profile_dump_frames > 0) {
+		dumpProfile();
+	}
 	cleanup();
 }
 
 bool GameApp::init() {
 	spdlog::trace("Initializing game application...");
-
-	if (!initSDL()) {
-		return false;
-	}
-	if (!initTime()) {
-		return false;
-	}
-	if (!initResourceManager()) {
-		return false;
-	}
-
-	if (!initRenderer()) {
-		return false;
-	}
-
-	if (!initCamera()) {
-		return false;
+	startup_report = std::make_unique<StartupReport>();
+
+	// 各阶段依次执行并计时；关卡纹理在 Preload 阶段开始后台解码，与后续阶段重叠，在 Texture upload 阶段统一上传
+	using InitFunction = bool (GameApp::*)();
+	constexpr std::pair<const char *, InitFunction> phases[] = {
+		{ "Config", &GameApp::initConfig },
+		{ "SDL", &GameApp::initSDL },
+		{ "Time", &GameApp::initTime },
+		{ "Memory", &GameApp::initMemory },
+		{ "Job system", &GameApp::initJobSystem },
+		{ "Input", &GameApp::initInput },
+		{ "Resources", &GameApp::initResourceManager },
+		{ "Preload", &GameApp::beginLevelPreload },
+		{ "Renderer", &GameApp::initRenderer },
+		{ "Camera", &GameApp::initCamera },
+		{ "Tile map", &GameApp::initTileMap },
+		{ "Texture upload", &GameApp::finishLevelPreload },
+		{ "World", &GameApp::initWorld },
+		{ "Profiler", &GameApp::initProfiler },
+	};
+	for (const auto &[name, init_phase] : phases) {
+		if (!startup_report->measure(name, [&] { return (this->*init_phase)(); })) {
+			return false;
+		}
 	}
 
+	previous_camera_position = camera->getPosition();
 	is_running = true;
 
 	spdlog::trace("Game application initialized successfully.");
@@ -77,23 +148,111 @@ bool GameApp::init() {
 }
 
 void GameApp::handleEvents() {
+	PROFILE_SCOPE("GameApp::handleEvents");
+	ENGINE_ALLOC_SCOPE(Input);
 	SDL_Event event;
 	while (SDL_PollEvent(&event)) {
 		if (event.type == SDL_EVENT_QUIT) {
 			is_running = false;
+		} else if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat) {
+			// F3 切换分析器叠加层，F4 导出最近的帧
+			if (event.key.scancode == SDL_SCANCODE_F3 && profiler_overlay) {
+				profiler_overlay->toggle();
+			} else if (event.key.scancode == SDL_SCANCODE_F4 && profiler_overlay) {
+				dumpProfile();
+			}
+		} else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN && !input_replay) {
+			// 点击换算为渲染坐标后留到下一个固定步处理，录制与重放得到同样的输入
+			SDL_Event converted = event;
+			SDL_ConvertEventToRenderCoordinates(sdl_renderer, &converted);
+			pending_input.addClick({ glm::vec2(converted.button.x, converted.button.y), converted.button.button });
+		}
+	}
+}
+
+void GameApp::runFixedStep() {
+	// 步长只取决于固定步频率（录制文件头中保存，重放时强制采用），时间缩放只影响每帧的步数，
+	// 因此录制时无论是否慢放/快进，重放都逐步一致
+	const float fixed_delta_time = time->getFixedDeltaTime();
+	engine::input::InputFrame input;
+	if (input_replay) {
+		if (!input_replay->next(input)) {
+			is_running = false; // 重放结束，finishInput() 校验最终状态
+			return;
 		}
+	} else {
+		sampleInput(input);
+	}
+	if (input_recorder) {
+		input_recorder->record(input);
+	}
+	fixedUpdate(fixed_delta_time, input);
+	++simulated_ticks;
+	if (command_line.max_ticks > 0 && simulated_ticks >= static_cast<Uint64>(command_line.max_ticks)) {
+		is_running = false;
 	}
 }
+
+void GameApp::fixedUpdate(float fixed_delta_time, const engine::input::InputFrame &input) {
+	PROFILE_SCOPE("GameApp::fixedUpdate");
+	ENGINE_ALLOC_SCOPE(Simulation);
+	previous_camera_position = camera->getPosition();
+	testCamera(fixed_delta_time, input);
+	testParticles(input);
+	position_snapshot_system->update();
+	updateNavigation();
+	navigation_system->update();
+	if (tile_collision_system) {
+		tile_collision_system->update(fixed_delta_time);
+	}
+	movement_system->update(fixed_delta_time);
+	broad_phase_system->update();
+}
+
 void GameApp::update(float deltaTime) {
-	testCamera();
+	PROFILE_SCOPE("GameApp::update");
+	{
+		ENGINE_ALLOC_SCOPE(Animation);
+		animation_system->update(deltaTime);
+		if (tile_map_renderer) {
+			tile_map_renderer->update(deltaTime);
+		}
+	}
+	ENGINE_ALLOC_SCOPE(Particles);
+	particle_system->update(deltaTime);
 }
 
 void GameApp::render() {
+	PROFILE_SCOPE("GameApp::render");
+	// 0. 在预算时间内上传异步加载完成的纹理
+	{
+		ENGINE_ALLOC_SCOPE(Resources);
+		resource_manager->update();
+	}
+	ENGINE_ALLOC_SCOPE(Render);
+
 	// 1. 清除屏幕
 	renderer->clearScreen();
 
-	// 2. 具体渲染代码
+	// 2. 具体渲染代码（相机按固定步之间的插值位置渲染，逻辑频率与刷新率不同时画面依然平滑）
+	glm::vec2 simulated_camera_position = camera->getPosition();
+	camera->setPosition(glm::mix(previous_camera_position, simulated_camera_position, time->getInterpolationAlpha()));
+	renderer->setLayer(0);
+	if (tile_map_renderer) {
+		renderer->setLayer(tile_map_renderer->draw(*camera));
+	}
+	int entity_layer = renderer->getLayer();
+	sprite_render_system->draw(*renderer, *camera, entity_layer, time->getInterpolationAlpha());
+	renderer->setLayer(entity_layer + 1);
+	particle_system->draw(*renderer, *camera);
 	testRenderer();
+	camera->setPosition(simulated_camera_position);
+
+	// 叠加层直接用 SDL 绘制，需要先提交批处理命令
+	if (profiler_overlay && profiler_overlay->isVisible()) {
+		renderer->flush();
+		profiler_overlay->draw(*frame_arena);
+	}
 
 	// 3. 更新屏幕显示
 	renderer->present();
@@ -101,6 +260,41 @@ void GameApp::render() {
 void GameApp::cleanup() {
 	spdlog::trace("Close game application...");
 
+	engine::memory::AllocationTracker::logSummary();
+	finishInput();
+
+	// 区块纹理与叠加层文字纹理依赖 SDL_Renderer，必须先于渲染器销毁
+	profiler_overlay.reset();
+	particle_system.reset();
+	sprite_render_system.reset();
+	animation_system.reset();
+	broad_phase_system.reset();
+	movement_system.reset();
+	navigation_system.reset();
+	tile_collision_system.reset();
+	position_snapshot_system.reset();
+	world.reset();
+	flying_field.reset();
+	walking_field.reset();
+	nav_grid.reset();
+	collision_grid.reset();
+	tile_map_renderer.reset();
+	tile_map.reset();
+	job_system.reset(); // 系统持有的是裸指针，任务系统在它们之后停止
+
+	// 纹理与音频流必须在 SDL_DestroyRenderer / SDL_Quit 之前释放
+	if (resource_manager) {
+		engine::resource::AudioStats audio = resource_manager->getAudioStats();
+		spdlog::debug("Audio: {} voices started, {} stolen, {} dropped, latency avg {:.2f} ms, max {:.2f} ms, {} music underrun(s).",
+				audio.voices_started, audio.voices_stolen, audio.voices_dropped, audio.average_latency_ms, audio.max_latency_ms, audio.music_underruns);
+		engine::resource::ResourceCacheStats cache = resource_manager->getCacheStats();
+		spdlog::debug("Texture cache: {} entries, {:.2f} MB, hit rate {:.1f}%, {} eviction(s). Font cache: {} entries, {:.2f} MB, hit rate {:.1f}%, {} eviction(s).",
+				cache.textures.entries, static_cast<double>(cache.textures.bytes) / (1024.0 * 1024.0), cache.textures.getHitRate() * 100.0, cache.textures.evictions,
+				cache.fonts.entries, static_cast<double>(cache.fonts.bytes) / (1024.0 * 1024.0), cache.fonts.getHitRate() * 100.0, cache.fonts.evictions);
+	}
+	renderer.reset();
+	resource_manager.reset();
+
 	if (sdl_renderer) {
 		SDL_DestroyRenderer(sdl_renderer);
 		sdl_renderer = nullptr;
@@ -113,31 +307,64 @@ void GameApp::cleanup() {
 	is_running = false;
 }
 
+bool GameApp::initConfig() {
+	spdlog::trace("Initializing Config...");
+	try {
+		config = std::make_unique<Config>("assets/config.json");
+	} catch (const std::exception &e) {
+		spdlog::error("Failed to initialize Config: {}", e.what());
+		return false;
+	}
+	spdlog::trace("Config initialized successfully.");
+	return true;
+}
+
 bool GameApp::initSDL() {
 	spdlog::trace("Initializing SDL...");
+	if (command_line.headless) {
+		// 无头模式：离屏窗口 + 软件渲染器只用于创建纹理等资源，从不呈现；音频输出到空设备
+		SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen,dummy");
+		SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+	}
 	if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
 		spdlog::error("SDL could not initialize! SDL_Error: {}", SDL_GetError());
 		return false;
 	}
 
-	sdl_window = SDL_CreateWindow("Platformer", 1280, 720, SDL_WINDOW_RESIZABLE);
+	SDL_WindowFlags window_flags = command_line.headless ? SDL_WINDOW_HIDDEN : (config->window_resizable ? SDL_WINDOW_RESIZABLE : 0);
+	sdl_window = SDL_CreateWindow(config->window_title.c_str(), config->window_width, config->window_height, window_flags);
 	if (!sdl_window) {
 		spdlog::error("Window could not be created! SDL_Error: {}", SDL_GetError());
 		return false;
 	}
 
-	sdl_renderer = SDL_CreateRenderer(sdl_window, nullptr);
+	sdl_renderer = SDL_CreateRenderer(sdl_window, command_line.headless ? "software" : nullptr);
 	if (!sdl_renderer) {
 		spdlog::error("Renderer could not be created! SDL_Error: {}", SDL_GetError());
 		return false;
 	}
 
-	
+	// 垂直同步不可用时不视为错误，Time 会退回软件限帧
+	if (!SDL_SetRenderVSync(sdl_renderer, config->vsync && !command_line.headless ? 1 : SDL_RENDERER_VSYNC_DISABLED)) {
+		spdlog::warn("Failed to set VSync: {}", SDL_GetError());
+	}
 
 	spdlog::trace("SDL initialized successfully.");
 	return true;
 }
 
+bool GameApp::initJobSystem() {
+	spdlog::trace("Initializing JobSystem...");
+	try {
+		job_system = std::make_unique<JobSystem>(config->worker_threads);
+	} catch (const std::exception &e) {
+		spdlog::error("Failed to initialize JobSystem: {}", e.what());
+		return false;
+	}
+	spdlog::trace("JobSystem initialized successfully with {} workers.", job_system->getWorkerCount());
+	return true;
+}
+
 bool GameApp::initTime() {
 	spdlog::trace("Initializing Time ...");
 	try {
@@ -146,10 +373,119 @@ bool GameApp::initTime() {
 		spdlog::error("Failed to initialize Time: {}", e.what());
 		return false;
 	}
+
+	int vsync = 0;
+	bool vsync_enabled = config->vsync && !command_line.headless && SDL_GetRenderVSync(sdl_renderer, &vsync) && vsync != 0;
+	float refresh_rate = 0.0f;
+	if (const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(sdl_window))) {
+		refresh_rate = mode->refresh_rate;
+	}
+	time->setTargetFPS(config->target_fps);
+	time->setVSync(vsync_enabled, refresh_rate);
+	time->setFixedUpdateRate(config->fixed_update_hz);
+	time->setMaxFixedSteps(config->max_fixed_steps);
+	spdlog::debug("Frame pacing: vsync={}, refresh={:.2f}Hz, target_fps={}, fixed_update_hz={}.", vsync_enabled, refresh_rate, config->target_fps, config->fixed_update_hz);
 	spdlog::trace("Time initialized successfully.");
 	return true;
 }
 
+bool GameApp::initMemory() {
+	spdlog::trace("Initializing FrameArena...");
+	try {
+		frame_arena = std::make_unique<engine::memory::FrameArena>(static_cast<size_t>(config->frame_arena_kb) * 1024);
+	} catch (const std::exception &e) {
+		spdlog::error("Failed to initialize FrameArena: {}", e.what());
+		return false;
+	}
+	spdlog::debug("Frame arena: {} KB, allocation tracking {}.", config->frame_arena_kb,
+			engine::memory::AllocationTracker::isInstalled() ? "enabled" : "disabled");
+	return true;
+}
+
+bool GameApp::initInput() {
+	spdlog::trace("Initializing input...");
+	if (!command_line.replay_path.empty()) {
+		input_replay = engine::input::InputReplay::load(command_line.replay_path);
+		if (!input_replay) {
+			return false;
+		}
+		// 固定步长不同会得到不同的模拟结果，以录制时的频率为准
+		if (input_replay->getFixedUpdateHz() != config->fixed_update_hz) {
+			spdlog::warn("Replay was recorded at {} Hz, overriding fixed_update_hz={}.", input_replay->getFixedUpdateHz(), config->fixed_update_hz);
+			config->fixed_update_hz = input_replay->getFixedUpdateHz();
+			time->setFixedUpdateRate(config->fixed_update_hz);
+		}
+	}
+	if (!command_line.record_path.empty()) {
+		input_recorder = std::make_unique<engine::input::InputRecorder>(command_line.record_path, config->fixed_update_hz);
+	}
+	spdlog::trace("Input initialized successfully.");
+	return true;
+}
+
+void GameApp::sampleInput(engine::input::InputFrame &input) {
+	input = pending_input;
+	pending_input = {};
+	const bool *key_state = SDL_GetKeyboardState(nullptr);
+	constexpr std::pair<SDL_Scancode, engine::input::InputButton> bindings[] = {
+		{ SDL_SCANCODE_UP, engine::input::INPUT_BUTTON_UP },
+		{ SDL_SCANCODE_DOWN, engine::input::INPUT_BUTTON_DOWN },
+		{ SDL_SCANCODE_LEFT, engine::input::INPUT_BUTTON_LEFT },
+		{ SDL_SCANCODE_RIGHT, engine::input::INPUT_BUTTON_RIGHT },
+	};
+	for (const auto &[scancode, button] : bindings) {
+		if (key_state[scancode]) {
+			input.buttons |= button;
+		}
+	}
+}
+
+void GameApp::finishInput() {
+	if (!input_recorder && !input_replay) {
+		return;
+	}
+	const Uint64 state_hash = world && camera ? hashSimulationState() : 0;
+	if (input_recorder) {
+		if (!input_recorder->save(state_hash)) {
+			spdlog::warn("Input recording was not saved.");
+		}
+		input_recorder.reset();
+	}
+	if (input_replay) {
+		if (!input_replay->isFinished()) {
+			spdlog::info("Replay stopped at tick {} of {}.", input_replay->getTick(), input_replay->getTickCount());
+		} else if (input_replay->getStateHash() == 0) {
+			spdlog::info("Replay finished after {} ticks (no state hash recorded).", input_replay->getTickCount());
+		} else if (input_replay->getStateHash() == state_hash) {
+			spdlog::info("Replay finished after {} ticks, simulation state matches the recording.", input_replay->getTickCount());
+		} else {
+			spdlog::error("Replay finished after {} ticks, but the simulation state diverged from the recording ({:016x} != {:016x}).",
+					input_replay->getTickCount(), state_hash, input_replay->getStateHash());
+		}
+		input_replay.reset();
+	}
+}
+
+Uint64 GameApp::hashSimulationState() const {
+	constexpr Uint64 FNV_OFFSET = 14695981039346656037ull;
+	constexpr Uint64 FNV_PRIME = 1099511628211ull;
+	Uint64 hash = FNV_OFFSET;
+	auto mix = [&hash](const glm::vec2 &value) {
+		const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+		for (size_t i = 0; i < sizeof(value); ++i) {
+			hash = (hash ^ bytes[i]) * FNV_PRIME;
+		}
+	};
+	mix(camera->getPosition());
+	engine::ecs::Query<engine::ecs::Position> positions(*world);
+	positions.forEachChunk([&mix](std::span<const engine::ecs::Entity>, std::span<engine::ecs::Position> values) {
+		for (const engine::ecs::Position &position : values) {
+			mix(position.value);
+		}
+	});
+	return hash;
+}
+
 bool GameApp::initResourceManager() {
 	spdlog::trace("Initializing ResourceManager...");
 
@@ -160,6 +496,22 @@ bool GameApp::initResourceManager() {
 		return false;
 	}
 
+	// 资源包必须在加载任何资源之前挂载，缺失时直接读取 assets/ 下的散文件
+	if (!config->asset_archive.empty()) {
+		resource_manager->mountArchive(config->asset_archive);
+	}
+	resource_manager->setSoundVolume(config->sound_volume);
+	resource_manager->setMusicVolume(config->music_volume);
+	constexpr size_t MEGABYTE = 1024 * 1024;
+	const Uint32 idle_frames = static_cast<Uint32>(config->cache_idle_frames);
+	resource_manager->setTextureBudget({ static_cast<size_t>(config->texture_budget_mb) * MEGABYTE, idle_frames });
+	resource_manager->setFontBudget({ static_cast<size_t>(config->font_budget_mb) * MEGABYTE, idle_frames });
+
+	// 图集构建失败不是致命错误，图片会退回为独立纹理加载
+	if (!resource_manager->buildTextureAtlas(engine::resource::AtlasConfig{})) {
+		spdlog::warn("Texture atlas was not built, falling back to standalone textures.");
+	}
+
 	spdlog::trace("ResourceManager initialized successfully.");
 	return true;
 }
@@ -168,6 +520,7 @@ bool GameApp::initRenderer() {
 	spdlog::trace("Initializing Renderer...");
 	try {
 		renderer = std::make_unique<engine::render::Renderer>(sdl_renderer, resource_manager.get());
+		renderer->setBatchingEnabled(true);
 	} catch (const std::exception &e) {
 		spdlog::error("Failed to initialize Renderer: {}", e.what());
 		return false;
@@ -188,43 +541,313 @@ bool GameApp::initCamera() {
 	return true;
 }
 
+bool GameApp::initTileMap() {
+	spdlog::trace("Initializing TileMap...");
+	// 优先使用离线烘焙的二进制关卡，缺失时回退到 Tiled JSON；两者都会先查找资源包
+	const engine::resource::AssetArchive *archive = resource_manager->getArchive();
+	if ((archive && archive->find(LEVEL_BAKED_PATH)) || std::filesystem::exists(LEVEL_BAKED_PATH)) {
+		tile_map = engine::map::BakedLevelLoader::load(LEVEL_BAKED_PATH, archive);
+	}
+	if (!tile_map) {
+		tile_map = engine::map::MapLoader::load(LEVEL_MAP_PATH, archive);
+	}
+	if (!tile_map) { // 地图缺失不影响引擎运行
+		spdlog::warn("Failed to load tile map, continuing without a level.");
+		return true;
+	}
+	// 清单缺失或过期时，用地图实际引用的图片补齐预加载（已在加载中的会被跳过）
+	resource_manager->beginPreload(tile_map->collectImagePaths(), *job_system);
+	try {
+		tile_map_renderer = std::make_unique<engine::render::TileMapRenderer>(renderer.get(), resource_manager.get(), tile_map.get());
+	} catch (const std::exception &e) {
+		spdlog::error("Failed to initialize TileMapRenderer: {}", e.what());
+		return false;
+	}
+	camera->setLimitBounds({ glm::vec2(0.0f), glm::vec2(tile_map->width * tile_map->tile_width, tile_map->height * tile_map->tile_height) });
+	resource_manager->playMusic("assets/audio/platformer_level03_loop.ogg");
+	spdlog::trace("TileMap initialized successfully.");
+	return true;
+}
+
+bool GameApp::initWorld() {
+	spdlog::trace("Initializing World...");
+	try {
+		world = std::make_unique<engine::ecs::World>();
+		position_snapshot_system = std::make_unique<engine::ecs::PositionSnapshotSystem>(*world);
+		movement_system = std::make_unique<engine::ecs::MovementSystem>(*world);
+		if (tile_map) {
+			collision_grid = std::make_unique<engine::physics::TileCollisionGrid>(*tile_map, "main");
+			tile_collision_system = std::make_unique<engine::ecs::TileCollisionSystem>(*world, *collision_grid);
+			nav_grid = std::make_unique<engine::nav::NavGrid>(*collision_grid);
+			walking_field = std::make_unique<engine::nav::FlowField>(*nav_grid, engine::nav::NavLayer::Walking);
+			flying_field = std::make_unique<engine::nav::FlowField>(*nav_grid, engine::nav::NavLayer::Flying);
+		}
+		navigation_system = std::make_unique<engine::ecs::NavigationSystem>(*world, walking_field.get(), flying_field.get());
+		float cell_size = tile_map ? static_cast<float>(tile_map->tile_width) : 16.0f;
+		broad_phase_system = std::make_unique<engine::ecs::BroadPhaseSystem>(*world, cell_size);
+		animation_library = std::make_unique<engine::render::AnimationLibrary>();
+		animation_system = std::make_unique<engine::ecs::AnimationSystem>(*world, *animation_library, job_system.get());
+		sprite_render_system = std::make_unique<engine::ecs::SpriteRenderSystem>(*world, job_system.get());
+		particle_system = std::make_unique<engine::render::ParticleSystem>(*resource_manager, static_cast<size_t>(config->max_particles));
+		if (!config->particle_effects.empty()) {
+			particle_system->loadEffects(config->particle_effects);
+		}
+	} catch (const std::exception &e) {
+		spdlog::error("Failed to initialize World: {}", e.what());
+		return false;
+	}
+	int spawned = spawnMapObjects();
+	// 第一份流场在加载时完整构建，之后目标移动才按预算分摊
+	updateNavigation();
+	for (engine::nav::FlowField *field : { walking_field.get(), flying_field.get() }) {
+		if (field) {
+			field->rebuildNow();
+		}
+	}
+	spdlog::trace("World initialized successfully, {} entities spawned.", spawned);
+	return true;
+}
+
+int GameApp::spawnMapObjects() {
+	if (!tile_map) {
+		return 0;
+	}
+	int spawned = 0;
+	for (const auto &layer : tile_map->object_layers) {
+		for (const auto &object : layer.objects) {
+			if (object.gid == 0 || !object.visible) {
+				continue;
+			}
+			auto info = tile_map->resolveGid(object.gid);
+			if (!info || info->image.empty()) {
+				continue;
+			}
+
+			// 带动画属性的角色图块是按行排列的精灵表，每帧大小即对象大小；其余图块按对象大小缩放整张图片
+			const engine::map::TileData *data = info->data;
+			bool sheet_animated = data && data->properties.contains("animation");
+			glm::vec2 image_size(info->source_rect.w, info->source_rect.h);
+			glm::vec2 frame_size = sheet_animated ? object.size : image_size;
+			if (frame_size.x <= 0.0f || frame_size.y <= 0.0f) {
+				continue;
+			}
+
+			// 片段在第一次遇到该精灵表（或图块）时编译，之后的同类对象直接复用
+			Uint16 clip = engine::render::AnimationLibrary::INVALID_CLIP;
+			if (sheet_animated) {
+				clip = animation_library->compileSheet(info->image, data->properties["animation"], frame_size);
+			} else if (data && !data->animation.empty()) {
+				clip = animation_library->compileTileAnimation(*tile_map, *info);
+			}
+			bool animated = clip != engine::render::AnimationLibrary::INVALID_CLIP;
+			SDL_FRect source_rect = animated ? animation_library->getFrameRect(clip, 0)
+											 : SDL_FRect{ info->source_rect.x, info->source_rect.y, frame_size.x, frame_size.y };
+
+			engine::ecs::Position position;
+			position.value = object.position - glm::vec2(0.0f, object.size.y); // 图块对象以左下角为锚点
+			position.previous = position.value;
+
+			engine::ecs::SpriteComponent sprite{
+				engine::render::Sprite(std::string(info->image), source_rect, info->flip_horizontal),
+				sheet_animated ? glm::vec2(1.0f) : object.size / frame_size,
+			};
+
+			glm::vec2 sprite_scale = sprite.scale;
+			engine::ecs::Entity entity;
+			if (animated) {
+				entity = world->create(position, std::move(sprite), engine::ecs::Animation{ clip, 0, 0.0f });
+			} else {
+				entity = world->create(position, std::move(sprite));
+			}
+
+			// 受重力影响的角色使用图块碰撞框与地形碰撞（碰撞框相对于一帧的左上角）
+			bool gravity = data && data->properties.contains("gravity") && data->properties["gravity"].is_boolean() && data->properties["gravity"].get<bool>();
+			if (tile_collision_system && gravity && data->hitbox) {
+				engine::ecs::TileBody body;
+				body.offset = data->hitbox->position * sprite_scale;
+				body.size = data->hitbox->size * sprite_scale;
+				world->add(entity, engine::ecs::Velocity{});
+				world->add(entity, body);
+			}
+
+			// 带 tag 的角色图块按碰撞框参与角色间的碰撞宽相
+			Uint32 layer = engine::physics::COLLISION_LAYER_NONE;
+			if (data && data->properties.contains("tag") && data->properties["tag"].is_string()) {
+				layer = engine::physics::collisionLayerFromTag(data->properties["tag"].get<std::string>());
+			}
+			if (layer != engine::physics::COLLISION_LAYER_NONE && data->hitbox) {
+				engine::ecs::Collider collider;
+				collider.offset = data->hitbox->position * sprite_scale;
+				collider.size = data->hitbox->size * sprite_scale;
+				collider.layer = layer;
+				collider.mask = engine::physics::defaultCollisionMask(layer);
+				world->add(entity, collider);
+			}
+
+			// 敌人沿流场追踪玩家：受重力的走地面图层（采样脚下），其余的飞行（采样碰撞框中心）
+			if (layer == engine::physics::COLLISION_LAYER_PLAYER) {
+				player = entity;
+			} else if (layer == engine::physics::COLLISION_LAYER_ENEMY && nav_grid && data->hitbox) {
+				bool walking = world->get<engine::ecs::TileBody>(entity) != nullptr;
+				glm::vec2 box_position = data->hitbox->position * sprite_scale;
+				glm::vec2 box_size = data->hitbox->size * sprite_scale;
+				engine::ecs::NavAgent agent;
+				agent.layer = walking ? engine::nav::NavLayer::Walking : engine::nav::NavLayer::Flying;
+				agent.speed = walking ? WALKING_ENEMY_SPEED : FLYING_ENEMY_SPEED;
+				if (data->properties.contains("speed") && data->properties["speed"].is_number()) {
+					agent.speed = data->properties["speed"].get<float>();
+				}
+				agent.center = walking ? box_position + glm::vec2(box_size.x * 0.5f, box_size.y - 1.0f) : box_position + box_size * 0.5f;
+				if (!walking) {
+					world->add(entity, engine::ecs::Velocity{});
+				}
+				world->add(entity, agent);
+			}
+			++spawned;
+		}
+	}
+	spdlog::debug("Animation library: {} clips, {} frames.", animation_library->getClipCount(), animation_library->getFrameCount());
+	return spawned;
+}
+
+void GameApp::updateNavigation() {
+	if (!nav_grid || !player.isValid()) {
+		return;
+	}
+	PROFILE_SCOPE("GameApp::updateNavigation");
+	ENGINE_ALLOC_SCOPE(Navigation);
+	const engine::ecs::Position *position = world->get<engine::ecs::Position>(player);
+	if (!position) {
+		return;
+	}
+	glm::vec2 center = position->value;
+	glm::vec2 feet = position->value;
+	if (const engine::ecs::TileBody *body = world->get<engine::ecs::TileBody>(player)) {
+		center += body->offset + body->size * 0.5f;
+		feet += body->offset + glm::vec2(body->size.x * 0.5f, body->size.y - 1.0f);
+	}
+	// 目标所在格子不变时 setTarget 直接返回，玩家静止或在同一格内移动不会触发重建
+	walking_field->setTarget(nav_grid->findGround(nav_grid->worldToCell(feet)));
+	flying_field->setTargetWorld(center);
+	walking_field->update(NAV_EXPANSIONS_PER_STEP);
+	flying_field->update(NAV_EXPANSIONS_PER_STEP);
+}
+
+bool GameApp::initProfiler() {
+	if constexpr (!engine::debug::PROFILER_ENABLED) {
+		if (command_line.show_profiler || command_line.profile_dump_frames > 0) {
+			spdlog::warn("Profiler is compiled out, rebuild with the 'profiler' option to enable it.");
+		}
+		return true;
+	}
+	spdlog::trace("Initializing Profiler...");
+	try {
+		profiler_overlay = std::make_unique<engine::debug::ProfilerOverlay>(sdl_renderer, resource_manager.get());
+	} catch (const std::exception &e) {
+		spdlog::error("Failed to initialize ProfilerOverlay: {}", e.what());
+		return false;
+	}
+	if (config->target_fps > 0) {
+		profiler_overlay->setFrameBudget(1000.0 / config->target_fps);
+	}
+	profiler_overlay->setVisible(command_line.show_profiler);
+	spdlog::trace("Profiler initialized successfully.");
+	return true;
+}
+
+bool GameApp::beginLevelPreload() {
+	std::string manifest_path = engine::resource::PreloadManifest::getManifestPath(LEVEL_MAP_PATH);
+	auto manifest = engine::resource::PreloadManifest::load(manifest_path, resource_manager->getArchive());
+	if (!manifest) {
+		spdlog::debug("No preload manifest at '{}', textures will be preloaded after the map is parsed.", manifest_path);
+		return true;
+	}
+	size_t queued = resource_manager->beginPreload(manifest->textures, *job_system);
+	spdlog::debug("Preloading {} texture(s) from '{}'.", queued, manifest_path);
+	return true;
+}
+
+bool GameApp::finishLevelPreload() {
+	startup_report->addTextures(resource_manager->finishPreload());
+	return true;
+}
+
+void GameApp::reportStartup() {
+	startup_report->finish();
+	startup_report->log();
+	startup_report->writeJson(command_line.startup_report_path);
+	startup_report.reset();
+}
+
+void GameApp::dumpProfile() const {
+	int frames = command_line.profile_dump_frames > 0 ? command_line.profile_dump_frames : static_cast<int>(engine::debug::Profiler::FRAME_HISTORY);
+	if (!engine::debug::Profiler::get().dumpChromeTrace(command_line.profile_output_path, frames)) {
+		spdlog::warn("Failed to dump profile to '{}'.", command_line.profile_output_path);
+	}
+}
+
 // --- Test Functions ---
 
 void GameApp::testResourceManager() {
 	resource_manager->getTexture("assets/textures/Actors/eagle-attack.png");
 	resource_manager->getFont("assets/fonts/VonwaonBitmap-16px.ttf", 16);
+	resource_manager->playSound("assets/audio/button_click.wav");
 
 	resource_manager->unloadTexture("assets/textures/Actors/eagle-attack.png");
 	resource_manager->unloadFont("assets/fonts/VonwaonBitmap-16px.ttf", 16);
+	resource_manager->unloadSound("assets/audio/button_click.wav");
 }
 
 void GameApp::testRenderer() {
-	engine::render::Sprite sprite_world("assets/textures/Actors/frog.png");
-	engine::render::Sprite sprite_ui("assets/textures/UI/buttons/Start1.png");
-	engine::render::Sprite sprite_parallax("assets/textures/Layers/back.png");
+	// 静态对象只构造一次路径字符串，并在首次绘制后缓存纹理句柄
+	static const engine::render::Sprite sprite_world("assets/textures/Actors/frog.png");
+	static const engine::render::Sprite sprite_ui("assets/textures/UI/buttons/Start1.png");
 
 	static float rotation = 0.0f;
 	rotation += 0.1f;
 
-	// 注意渲染顺序
-	renderer->drawParallax(*camera, sprite_parallax, glm::vec2(100, 100), glm::vec2(0.5f, 0.5f), glm::bvec2(true, false));
+	// 注意渲染顺序（批处理模式下由层决定，视差背景由地图的图片图层绘制）
+	int layer = renderer->getLayer();
 	renderer->drawSprite(*camera, sprite_world, glm::vec2(200, 200), glm::vec2(1.0f, 1.0f), rotation);
+	renderer->setLayer(layer + 1);
 	renderer->drawUISprite(sprite_ui, glm::vec2(100, 100));
+	renderer->drawText(frame_arena->format("Score {}  HP {}", 0, 3), "assets/fonts/VonwaonBitmap-16px.ttf", 16, glm::vec2(8, 8), SDL_FColor{ 1.0f, 0.9f, 0.3f, 1.0f });
+}
+
+void GameApp::testParticles(const engine::input::InputFrame &input) {
+	// 左键：击中火花，右键：敌人死亡烟雾与碎屑，中键：拾取反馈
+	for (Uint8 i = 0; i < input.click_count; ++i) {
+		const engine::input::InputClick &click = input.clicks[i];
+		glm::vec2 position = camera->getPosition() + click.position;
+		auto emit = [&](std::string_view effect) {
+			particle_system->emit(particle_system->findEffect(effect), position);
+		};
+		if (click.button == SDL_BUTTON_LEFT) {
+			emit("hit_spark");
+		} else if (click.button == SDL_BUTTON_RIGHT) {
+			emit("death_puff");
+			emit("death_debris");
+		} else if (click.button == SDL_BUTTON_MIDDLE) {
+			emit("pickup_feedback");
+			emit("pickup_sparkle");
+		}
+	}
 }
 
-void GameApp::testCamera() {
-	auto key_state = SDL_GetKeyboardState(nullptr);
-	if (key_state[SDL_SCANCODE_UP]) {
-		camera->move(glm::vec2(0, -1));
+void GameApp::testCamera(float delta_time, const engine::input::InputFrame &input) {
+	constexpr float CAMERA_SPEED = 60.0f; // 像素/秒
+	float step = CAMERA_SPEED * delta_time;
+	if (input.isDown(engine::input::INPUT_BUTTON_UP)) {
+		camera->move(glm::vec2(0, -step));
 	}
-	if (key_state[SDL_SCANCODE_DOWN]) {
-		camera->move(glm::vec2(0, 1));
+	if (input.isDown(engine::input::INPUT_BUTTON_DOWN)) {
+		camera->move(glm::vec2(0, step));
 	}
-	if (key_state[SDL_SCANCODE_LEFT]) {
-		camera->move(glm::vec2(-1, 0));
+	if (input.isDown(engine::input::INPUT_BUTTON_LEFT)) {
+		camera->move(glm::vec2(-step, 0));
 	}
-	if (key_state[SDL_SCANCODE_RIGHT]) {
-		camera->move(glm::vec2(1, 0));
+	if (input.isDown(engine::input::INPUT_BUTTON_RIGHT)) {
+		camera->move(glm::vec2(step, 0));
 	}
 }
 
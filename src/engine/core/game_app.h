@@ -2,6 +2,12 @@
 
 #include <memory>
 
+#include <glm/vec2.hpp>
+
+#include "../ecs/entity.h"
+#include "../input/input_frame.h"
+#include "command_line.h"
+
 struct SDL_Window;
 struct SDL_Renderer;
 
@@ -12,11 +18,54 @@ namespace engine::resource {
 namespace engine::render{
 class Renderer;
 class Camera;
+class TileMapRenderer;
+class AnimationLibrary;
+class ParticleSystem;
+}
+
+namespace engine::map {
+class TileMap;
+}
+
+namespace engine::debug {
+class ProfilerOverlay;
 }
 
+namespace engine::physics {
+class TileCollisionGrid;
+}
+
+namespace engine::memory {
+class FrameArena;
+}
+
+namespace engine::input {
+class InputRecorder;
+class InputReplay;
+} // namespace engine::input
+
+namespace engine::nav {
+class NavGrid;
+class FlowField;
+} // namespace engine::nav
+
+namespace engine::ecs {
+class World;
+class PositionSnapshotSystem;
+class MovementSystem;
+class TileCollisionSystem;
+class NavigationSystem;
+class BroadPhaseSystem;
+class AnimationSystem;
+class SpriteRenderSystem;
+} // namespace engine::ecs
+
 namespace engine::core {
 
 class Time;
+class Config;
+class JobSystem;
+class StartupReport;
 
 class GameApp final {
 
@@ -24,18 +73,54 @@ private:
     SDL_Window *sdl_window;
 	SDL_Renderer *sdl_renderer;
     bool is_running = false;
+	CommandLine command_line;
+	std::unique_ptr<engine::core::StartupReport> startup_report; ///< @brief 首帧呈现后输出并释放
 
     //Engine Components
+    std::unique_ptr<engine::core::Config> config;
     std::unique_ptr<engine::core::Time> time;
+	std::unique_ptr<engine::core::JobSystem> job_system;
+	std::unique_ptr<engine::memory::FrameArena> frame_arena; ///< @brief 每次主循环开始时重置，存放只在本帧有效的临时数据
 	std::unique_ptr<engine::resource::ResourceManager> resource_manager;
 	std::unique_ptr<engine::render::Renderer> renderer;
 	std::unique_ptr<engine::render::Camera> camera;
+	std::unique_ptr<engine::debug::ProfilerOverlay> profiler_overlay; ///< @brief 仅在启用分析器的构建中创建
+
+	// Input
+	std::unique_ptr<engine::input::InputRecorder> input_recorder; ///< @brief 仅在 --record 时创建
+	std::unique_ptr<engine::input::InputReplay> input_replay; ///< @brief 仅在 --replay 时创建，存在时忽略实时输入
+	engine::input::InputFrame pending_input; ///< @brief 两个固定步之间收集的点击，归入下一个固定步
+	Uint64 simulated_ticks = 0;
+
+	// Level
+	std::unique_ptr<engine::map::TileMap> tile_map;
+	std::unique_ptr<engine::render::TileMapRenderer> tile_map_renderer;
+	std::unique_ptr<engine::physics::TileCollisionGrid> collision_grid;
+	std::unique_ptr<engine::render::AnimationLibrary> animation_library; ///< @brief 关卡中所有动画片段，生成实体时编译
+	std::unique_ptr<engine::nav::NavGrid> nav_grid; ///< @brief 以下三项仅在地图存在时创建
+	std::unique_ptr<engine::nav::FlowField> walking_field; ///< @brief 地面敌人追踪玩家
+	std::unique_ptr<engine::nav::FlowField> flying_field; ///< @brief 飞行敌人追踪玩家
+
+	// Entities
+	std::unique_ptr<engine::ecs::World> world;
+	std::unique_ptr<engine::ecs::PositionSnapshotSystem> position_snapshot_system;
+	std::unique_ptr<engine::ecs::MovementSystem> movement_system;
+	std::unique_ptr<engine::ecs::TileCollisionSystem> tile_collision_system; ///< @brief 仅在地图存在时创建
+	std::unique_ptr<engine::ecs::NavigationSystem> navigation_system;
+	std::unique_ptr<engine::ecs::BroadPhaseSystem> broad_phase_system;
+	std::unique_ptr<engine::ecs::AnimationSystem> animation_system;
+	std::unique_ptr<engine::ecs::SpriteRenderSystem> sprite_render_system;
+	std::unique_ptr<engine::render::ParticleSystem> particle_system;
+	engine::ecs::Entity player; ///< @brief 敌人导航的目标，地图中没有玩家时无效
+
+	glm::vec2 previous_camera_position = glm::vec2(0.0f); ///< @brief 上一个固定步的相机位置，用于渲染插值
 
 public:
 	GameApp();
 	~GameApp();
 
 	void run();
+	void setCommandLine(const CommandLine &options) { command_line = options; }
 
 	GameApp(const GameApp &) = delete;
 	GameApp &operator=(const GameApp &) = delete;
@@ -45,21 +130,41 @@ public:
 private:
 	[[nodiscard]] bool init();
 	void handleEvents();
+	void fixedUpdate(float fixed_delta_time, const engine::input::InputFrame &input); ///< @brief 固定步长逻辑更新，每帧执行 0 到 max_fixed_steps 次
+	void runFixedStep(); ///< @brief 取得本步输入（实时采样或重放）、录制并以不受时间缩放影响的固定步长执行一步
 	void update(float deltaTime);
 	void render();
 	void cleanup();
 
 
 	// Engine Component Initialization
+	[[nodiscard]] bool initConfig();
 	[[nodiscard]] bool initSDL();
 	[[nodiscard]] bool initTime();
+	[[nodiscard]] bool initMemory();
+	[[nodiscard]] bool initJobSystem();
+	[[nodiscard]] bool initInput(); ///< @brief 加载重放文件（并采用其固定步频率）或开始录制
 	[[nodiscard]] bool initResourceManager();
 	[[nodiscard]] bool initRenderer();
 	[[nodiscard]] bool initCamera();
+	[[nodiscard]] bool beginLevelPreload(); ///< @brief 读取关卡预加载清单，在工作线程上开始解码纹理
+	[[nodiscard]] bool initTileMap();
+	[[nodiscard]] bool finishLevelPreload(); ///< @brief 等待解码完成并一次性上传，耗时计入启动报告
+	[[nodiscard]] bool initWorld();
+	[[nodiscard]] bool initProfiler();
+
+	void dumpProfile() const; ///< @brief 把最近的帧导出为 Chrome 追踪文件
+	void reportStartup(); ///< @brief 首帧呈现后记录并写出启动报告
+	int spawnMapObjects(); ///< @brief 为对象图层中的图块对象创建实体，返回创建数量
+	void updateNavigation(); ///< @brief 把流场目标设为玩家位置，并在固定预算内推进流场构建
+	void sampleInput(engine::input::InputFrame &input); ///< @brief 从 SDL 键盘状态与待处理点击生成本步输入
+	void finishInput(); ///< @brief 写出录制文件并校验重放结果，需在销毁世界之前调用
+	[[nodiscard]] Uint64 hashSimulationState() const; ///< @brief 所有实体位置与相机位置的 FNV-1a 哈希，用于校验重放是否确定
 
 	//Test functions
 	void testResourceManager();
 	void testRenderer();
-	void testCamera();
+	void testCamera(float delta_time, const engine::input::InputFrame &input);
+	void testParticles(const engine::input::InputFrame &input); ///< @brief 鼠标点击处发射粒子效果
 };
 } // namespace engine::core
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "job_system.h"
+
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "../debug/profiler.h"
+
+namespace engine::core {
+
+namespace {
+
+constexpr int SPIN_BEFORE_SLEEP = 64; ///< @brief 工作线程休眠前的空转次数，降低短间隔任务的唤醒延迟
+constexpr size_t EXTERNAL_THREAD = static_cast<size_t>(-1);
+
+thread_local size_t current_queue = EXTERNAL_THREAD; ///< @brief 当前线程拥有的队列，其它线程（如纹理解码线程）为 EXTERNAL_THREAD
+thread_local const JobSystem *current_system = nullptr;
+
+} // namespace
+
+JobSystem::JobSystem(int worker_count) {
+	if (worker_count < 0) {
+		worker_count = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+	}
+	queues.reserve(static_cast<size_t>(worker_count) + 1);
+	for (int i = 0; i <= worker_count; ++i) {
+		queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	current_queue = 0;
+	current_system = this;
+	workers.reserve(static_cast<size_t>(worker_count));
+	for (int i = 1; i <= worker_count; ++i) {
+		workers.emplace_back(&JobSystem::workerLoop, this, static_cast<size_t>(i));
+	}
+	spdlog::debug("JobSystem started with {} worker threads.", worker_count);
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		running.store(false);
+	}
+	wake_cv.notify_all();
+	for (auto &worker : workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+	if (current_system == this) {
+		current_queue = EXTERNAL_THREAD;
+		current_system = nullptr;
+	}
+	spdlog::debug("JobSystem stopped.");
+}
+
+void JobSystem::run(Job job, JobCounter *counter) {
+	job.counter = counter;
+	if (counter) {
+		counter->pending.fetch_add(1, std::memory_order_relaxed);
+	}
+	push(job);
+}
+
+void JobSystem::runAfter(JobCounter &dependency, Job job, JobCounter *counter) {
+	job.counter = counter;
+	if (counter) {
+		counter->pending.fetch_add(1, std::memory_order_relaxed);
+	}
+	{
+		// 与 finish() 中的归零处理在同一把锁下进行，任务要么被挂起，要么看到依赖已完成
+		std::lock_guard<std::mutex> lock(dependency.mutex);
+		if (!dependency.isDone()) {
+			dependency.continuations.push_back(job);
+			return;
+		}
+	}
+	push(job);
+}
+
+void JobSystem::push(Job job) {
+	size_t index = current_system == this ? current_queue : EXTERNAL_THREAD;
+	if (index == EXTERNAL_THREAD) {
+		index = next_external_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+	}
+	{
+		std::lock_guard<std::mutex> lock(queues[index]->mutex);
+		queues[index]->jobs.push_back(job);
+	}
+	queued_jobs.fetch_add(1);
+	if (sleeping_workers.load() > 0) {
+		// 先持有再释放休眠锁，保证工作线程不会在检查条件与进入等待之间错过通知
+		{ std::lock_guard<std::mutex> lock(sleep_mutex); }
+		wake_cv.notify_one();
+	}
+}
+
+bool JobSystem::popOrSteal(size_t queue_index, Job &job) {
+	// 自己的队列从尾部取
+	if (queue_index != EXTERNAL_THREAD) {
+		WorkQueue &own = *queues[queue_index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty()) {
+			job = own.jobs.back();
+			own.jobs.pop_back();
+			queued_jobs.fetch_sub(1);
+			return true;
+		}
+	}
+	// 从其它队列头部窃取
+	const size_t queue_count = queues.size();
+	const size_t start = queue_index == EXTERNAL_THREAD ? 0 : queue_index + 1;
+	for (size_t offset = 0; offset < queue_count; ++offset) {
+		size_t victim = (start + offset) % queue_count;
+		if (victim == queue_index) {
+			continue;
+		}
+		WorkQueue &queue = *queues[victim];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			job = queue.jobs.front();
+			queue.jobs.pop_front();
+			queued_jobs.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool JobSystem::tryExecuteOne() {
+	if (queued_jobs.load(std::memory_order_relaxed) <= 0) {
+		return false;
+	}
+	Job job;
+	if (!popOrSteal(current_system == this ? current_queue : EXTERNAL_THREAD, job)) {
+		return false;
+	}
+	job.execute();
+	finish(job);
+	return true;
+}
+
+void JobSystem::finish(const Job &job) {
+	JobCounter *counter = job.counter;
+	if (!counter) {
+		return;
+	}
+	std::vector<Job> released;
+	{
+		std::lock_guard<std::mutex> lock(counter->mutex);
+		if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			released.swap(counter->continuations);
+		}
+	}
+	// 解锁之后不能再访问 counter：等待方可能已经返回并销毁它
+	for (const Job &continuation : released) {
+		push(continuation);
+	}
+}
+
+void JobSystem::wait(JobCounter &counter) {
+	PROFILE_SCOPE("JobSystem::wait");
+	while (!counter.isDone()) {
+		if (!tryExecuteOne()) {
+			std::this_thread::yield();
+		}
+	}
+	// 与最后一个 finish() 同步，确保它已释放计数器的锁
+	std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+void JobSystem::workerLoop(size_t queue_index) {
+	current_queue = queue_index;
+	current_system = this;
+	PROFILE_THREAD_NAME("Worker " + std::to_string(queue_index));
+
+	int idle_spins = 0;
+	while (running.load(std::memory_order_relaxed)) {
+		if (tryExecuteOne()) {
+			idle_spins = 0;
+			continue;
+		}
+		if (++idle_spins < SPIN_BEFORE_SLEEP) {
+			std::this_thread::yield();
+			continue;
+		}
+		idle_spins = 0;
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		sleeping_workers.fetch_add(1);
+		wake_cv.wait(lock, [this]() { return queued_jobs.load() > 0 || !running.load(); });
+		sleeping_workers.fetch_sub(1);
+	}
+}
+
+} // namespace engine::core
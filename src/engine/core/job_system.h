@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::core {
+
+class JobCounter;
+
+/**
+ * @brief 一个待执行的任务：函数指针 + 内联存放的可平凡复制闭包，入队与出队都不分配内存
+ */
+struct Job {
+	static constexpr size_t STORAGE_SIZE = 48;
+
+	void (*function)(const void *storage) = nullptr;
+	alignas(std::max_align_t) unsigned char storage[STORAGE_SIZE];
+	JobCounter *counter = nullptr; ///< @brief 完成时递减的计数器，可为空
+
+	/// @brief 从闭包构造任务。闭包需可平凡复制且不超过 STORAGE_SIZE（按引用捕获即可满足）
+	template <typename Func>
+	static Job make(Func &&func) {
+		using Closure = std::decay_t<Func>;
+		static_assert(std::is_trivially_copyable_v<Closure>, "Job closures must be trivially copyable, capture by reference or by value of trivial types.");
+		static_assert(sizeof(Closure) <= STORAGE_SIZE, "Job closure is too large.");
+		static_assert(alignof(Closure) <= alignof(std::max_align_t));
+		Job job;
+		::new (job.storage) Closure(std::forward<Func>(func));
+		job.function = [](const void *storage) { (*static_cast<const Closure *>(storage))(); };
+		return job;
+	}
+
+	void execute() const { function(storage); }
+};
+
+/**
+ * @brief 任务完成计数器。提交时递增、任务完成时递减，归零表示这批任务全部完成。
+ *
+ * 可以作为其它任务的前置依赖（JobSystem::runAfter），也可以由 JobSystem::wait 等待。
+ * 同一计数器可以在等待完成后重复使用；等待期间计数器必须保持存活。
+ */
+class JobCounter final {
+	friend class JobSystem;
+
+private:
+	std::atomic<int> pending = 0;
+	std::mutex mutex; ///< @brief 保护 continuations，并让等待方与最后一个完成方同步
+	std::vector<Job> continuations; ///< @brief 计数归零后才提交的任务
+
+public:
+	JobCounter() = default;
+	JobCounter(const JobCounter &) = delete;
+	JobCounter &operator=(const JobCounter &) = delete;
+	JobCounter(JobCounter &&) = delete;
+	JobCounter &operator=(JobCounter &&) = delete;
+
+	[[nodiscard]] bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+/**
+ * @brief 工作窃取任务系统。
+ *
+ * 每个线程（主线程占 0 号）有自己的双端队列：自己从尾部取（LIFO，缓存友好），
+ * 空闲线程从其它队列头部窃取。wait() 在等待期间由调用线程帮忙执行任务，不会空等。
+ * 工作线程数为 0 时所有任务都在 wait() 中由调用线程执行，行为与单线程一致。
+ */
+class JobSystem final {
+private:
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	std::vector<std::unique_ptr<WorkQueue>> queues; ///< @brief 0 号属于创建 JobSystem 的线程，其余各属于一个工作线程
+	std::vector<std::thread> workers;
+	std::atomic<bool> running = true;
+	std::atomic<int> queued_jobs = 0; ///< @brief 所有队列中的任务总数，用于决定工作线程是否休眠
+	std::atomic<int> sleeping_workers = 0;
+	std::atomic<unsigned> next_external_queue = 0;
+	std::mutex sleep_mutex;
+	std::condition_variable wake_cv;
+
+public:
+	/**
+	 * @brief 创建任务系统并启动工作线程
+	 *
+	 * @param worker_count 工作线程数，负数表示自动（硬件线程数 - 1）。
+	 */
+	explicit JobSystem(int worker_count = -1);
+	~JobSystem(); ///< @brief 停止并等待所有工作线程退出（未执行的任务被丢弃）
+
+	JobSystem(const JobSystem &) = delete;
+	JobSystem &operator=(const JobSystem &) = delete;
+	JobSystem(JobSystem &&) = delete;
+	JobSystem &operator=(JobSystem &&) = delete;
+
+	/// @brief 提交任务，counter 非空时先递增，任务完成后递减
+	void run(Job job, JobCounter *counter = nullptr);
+
+	template <typename Func>
+	void run(Func &&func, JobCounter *counter = nullptr) { run(Job::make(std::forward<Func>(func)), counter); }
+
+	/// @brief 在 dependency 归零后再提交任务（dependency 已归零时立即提交）
+	void runAfter(JobCounter &dependency, Job job, JobCounter *counter = nullptr);
+
+	template <typename Func>
+	void runAfter(JobCounter &dependency, Func &&func, JobCounter *counter = nullptr) { runAfter(dependency, Job::make(std::forward<Func>(func)), counter); }
+
+	/// @brief 等待计数器归零，期间调用线程参与执行任务
+	void wait(JobCounter &counter);
+
+	/**
+	 * @brief 把 [0, count) 切成若干段并行执行 func(begin, end)，返回时所有段都已完成
+	 *
+	 * @param grain 每段的最小元素数，0 表示自动：约为每个线程 4 段，兼顾负载均衡与调度开销。
+	 */
+	template <typename Func>
+	void parallelFor(size_t count, Func &&func, size_t grain = 0);
+
+	int getWorkerCount() const { return static_cast<int>(workers.size()); }
+	int getThreadCount() const { return static_cast<int>(workers.size()) + 1; } ///< @brief 工作线程 + 调用线程
+
+private:
+	void workerLoop(size_t queue_index);
+	void push(Job job);
+	bool tryExecuteOne(); ///< @brief 取出（或窃取）并执行一个任务，没有任务时返回 false
+	bool popOrSteal(size_t queue_index, Job &job);
+	void finish(const Job &job);
+};
+
+template <typename Func>
+void JobSystem::parallelFor(size_t count, Func &&func, size_t grain) {
+	if (count == 0) {
+		return;
+	}
+	const size_t threads = static_cast<size_t>(getThreadCount());
+	if (grain == 0) {
+		grain = std::max<size_t>(1, (count + threads * 4 - 1) / (threads * 4));
+	}
+	if (threads == 1 || count <= grain) {
+		func(size_t{ 0 }, count);
+		return;
+	}
+
+	JobCounter counter;
+	for (size_t begin = grain; begin < count; begin += grain) {
+		size_t end = std::min(count, begin + grain);
+		run([&func, begin, end]() { func(begin, end); }, &counter);
+	}
+	func(size_t{ 0 }, grain); // 第一段由调用线程直接执行
+	wait(counter);
+}
+
+} // namespace engine::core
@@ -0,0 +1,95 @@
+#include "startup_report.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+constexpr size_t LOGGED_TEXTURES = 5; ///< @brief 日志中列出的最慢纹理数，完整列表见 JSON
+
+double toMs(Uint64 ns) {
+	return static_cast<double>(ns) / 1000000.0;
+}
+} // namespace
+
+StartupReport::StartupReport() :
+		start_ns(SDL_GetTicksNS()) {}
+
+void StartupReport::addPhase(std::string_view name, Uint64 elapsed_ns) {
+	phases.push_back({ std::string(name), toMs(elapsed_ns) });
+}
+
+void StartupReport::addTextures(std::vector<engine::resource::TextureLoadTiming> timings) {
+	textures.insert(textures.end(), std::make_move_iterator(timings.begin()), std::make_move_iterator(timings.end()));
+	// 最慢的在前，方便直接看出该优化哪张图
+	std::sort(textures.begin(), textures.end(), [](const auto &a, const auto &b) {
+		return a.decode_ms + a.upload_ms > b.decode_ms + b.upload_ms;
+	});
+}
+
+void StartupReport::finish() {
+	if (finished) {
+		return;
+	}
+	Uint64 now = SDL_GetTicksNS();
+	double accounted_ms = 0.0;
+	for (const auto &phase : phases) {
+		accounted_ms += phase.ms;
+	}
+	time_to_first_frame_ms = toMs(now - start_ns);
+	phases.push_back({ "First frame", std::max(0.0, time_to_first_frame_ms - accounted_ms) });
+	finished = true;
+}
+
+void StartupReport::log() const {
+	spdlog::info("Time to first frame: {:.1f} ms", time_to_first_frame_ms);
+	for (const auto &phase : phases) {
+		spdlog::info("  {:<16} {:8.2f} ms", phase.name, phase.ms);
+	}
+	if (textures.empty()) {
+		return;
+	}
+	double decode_ms = 0.0, upload_ms = 0.0;
+	for (const auto &texture : textures) {
+		decode_ms += texture.decode_ms;
+		upload_ms += texture.upload_ms;
+	}
+	spdlog::info("  {} preloaded texture(s): {:.2f} ms decode (worker time), {:.2f} ms upload", textures.size(), decode_ms, upload_ms);
+	for (size_t i = 0; i < std::min(textures.size(), LOGGED_TEXTURES); ++i) {
+		const auto &texture = textures[i];
+		spdlog::info("    {:8.2f} ms decode {:6.2f} ms upload  {}", texture.decode_ms, texture.upload_ms, texture.path);
+	}
+}
+
+bool StartupReport::writeJson(const std::string &path) const {
+	nlohmann::json json;
+	json["time_to_first_frame_ms"] = time_to_first_frame_ms;
+	json["phases"] = nlohmann::json::array();
+	for (const auto &phase : phases) {
+		json["phases"].push_back({ { "name", phase.name }, { "ms", phase.ms } });
+	}
+	json["textures"] = nlohmann::json::array();
+	for (const auto &texture : textures) {
+		json["textures"].push_back({
+				{ "path", texture.path },
+				{ "decode_ms", texture.decode_ms },
+				{ "upload_ms", texture.upload_ms },
+				{ "bytes", texture.bytes },
+		});
+	}
+
+	std::ofstream file(path);
+	if (!file) {
+		spdlog::warn("Failed to open '{}' for writing the startup report.", path);
+		return false;
+	}
+	file << json.dump(4);
+	spdlog::debug("Startup report written to '{}'.", path);
+	return true;
+}
+
+} // namespace engine::core
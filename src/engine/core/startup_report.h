@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "../resource/async_texture_loader.h"
+
+namespace engine::core {
+
+/**
+ * @brief 启动耗时报告：把首帧前的时间按初始化阶段与纹理拆分，记录日志并写出 JSON
+ *
+ * 计时从构造开始，首帧呈现后调用 finish()。预加载在后台解码时与其它阶段重叠，
+ * 因此纹理的解码耗时是工作线程时间，不与阶段耗时相加。
+ */
+class StartupReport final {
+public:
+	struct Phase {
+		std::string name;
+		double ms = 0.0;
+	};
+
+private:
+	Uint64 start_ns = 0;
+	double time_to_first_frame_ms = 0.0;
+	bool finished = false;
+	std::vector<Phase> phases; ///< @brief 按执行顺序
+	std::vector<engine::resource::TextureLoadTiming> textures;
+
+public:
+	StartupReport();
+
+	/// @brief 计时执行一个阶段，返回阶段自身的返回值
+	template <typename Func>
+	auto measure(std::string_view name, Func &&func) {
+		Uint64 phase_start = SDL_GetTicksNS();
+		auto result = func();
+		addPhase(name, SDL_GetTicksNS() - phase_start);
+		return result;
+	}
+
+	void addPhase(std::string_view name, Uint64 elapsed_ns);
+	void addTextures(std::vector<engine::resource::TextureLoadTiming> timings);
+	void finish(); ///< @brief 首帧呈现后调用，记录首帧时间并追加 "First frame" 阶段
+
+	[[nodiscard]] bool isFinished() const { return finished; }
+	[[nodiscard]] double getTimeToFirstFrameMs() const { return time_to_first_frame_ms; }
+	[[nodiscard]] const std::vector<Phase> &getPhases() const { return phases; }
+
+	void log() const; ///< @brief 输出各阶段耗时与最慢的纹理
+	bool writeJson(const std::string &path) const;
+};
+
+} // namespace engine::core
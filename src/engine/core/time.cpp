@@ -1,35 +1,102 @@
 #include "time.h"
 #include "SDL3/SDL_stdinc.h"
 
+#include <cmath>
+
+#include <SDL3/SDL_atomic.h>
 #include <SDL3/SDL_timer.h>
 #include <spdlog/spdlog.h>
 
+#include "../debug/profiler.h"
+
 namespace engine::core {
 
+namespace {
+constexpr double NS_TO_SECONDS = 0.000000001;
+constexpr double MAX_DELTA_TIME = 0.25; // 断点调试或拖动窗口后的超长帧按该值截断
+constexpr double VSYNC_SNAP_TOLERANCE = 0.0002; // 与刷新周期整数倍相差 0.2ms 以内视为同一帧长
+} // namespace
+
 Time::Time() {
 	last_time = SDL_GetTicksNS();
 	frame_start_time = last_time;
 }
 
 void Time::update() {
+	PROFILE_SCOPE("Time::update");
+	limitFrameRate();
+
 	frame_start_time = SDL_GetTicksNS();
-	auto current_delta_time = static_cast<double>(frame_start_time - last_time) * 0.000000001; // Convert nanoseconds to seconds
+	delta_time = static_cast<double>(frame_start_time - last_time) * NS_TO_SECONDS; // Convert nanoseconds to seconds
+	last_time = frame_start_time;
 
-	if (target_frame_time > 0.0) {
-		limitFrameRate(current_delta_time);
-	} else {
-		delta_time = current_delta_time;
+	if (delta_time > MAX_DELTA_TIME) {
+		delta_time = MAX_DELTA_TIME;
+	}
+	if (vsync_enabled) {
+		snapToRefreshPeriod();
 	}
+	advanceAccumulator();
+}
 
-	last_time = SDL_GetTicksNS();
+void Time::setVSync(bool enabled, float refresh_rate) {
+	vsync_enabled = enabled;
+	refresh_period = refresh_rate > 0.0f ? 1.0 / refresh_rate : 0.0;
+}
+
+void Time::setFixedUpdateRate(int hz) {
+	fixed_delta_time = 1.0 / (hz > 0 ? hz : 60);
+	accumulator = 0.0;
+}
+
+void Time::limitFrameRate() {
+	if (target_frame_time_ns == 0) {
+		return;
+	}
+	// 垂直同步已按刷新率阻塞，只有目标帧率更低时才需要软件限帧
+	if (vsync_enabled && refresh_period > 0.0 && target_frame_time <= refresh_period + VSYNC_SNAP_TOLERANCE) {
+		return;
+	}
+	// 以上一帧开始时间为基准计算截止时间，而不是从本帧工作结束后再睡满剩余时间
+	waitUntil(last_time + target_frame_time_ns);
+}
+
+void Time::waitUntil(Uint64 deadline_ns) const {
+	Uint64 now = SDL_GetTicksNS();
+	if (now >= deadline_ns) {
+		return;
+	}
+	// 先粗粒度休眠到截止时间前的安全余量，再自旋到截止时间
+	if (deadline_ns - now > spin_threshold_ns) {
+		SDL_DelayNS(deadline_ns - now - spin_threshold_ns);
+	}
+	while (SDL_GetTicksNS() < deadline_ns) {
+		SDL_CPUPauseInstruction();
+	}
 }
 
-void Time::limitFrameRate(float current_delta_time) {
-    if (current_delta_time < target_frame_time) {
-        double time_to_wait = target_frame_time - current_delta_time;
-        Uint64 target_wait_time = static_cast<Uint64>(time_to_wait * 1000000000.0); // Convert seconds to nanoseconds
-        SDL_DelayNS(target_wait_time);
-        delta_time = static_cast<double>(SDL_GetTicksNS() - last_time) * 0.000000001; // Update delta_time after waiting
-    }
+void Time::snapToRefreshPeriod() {
+	if (refresh_period <= 0.0) {
+		return;
+	}
+	double frames = std::round(delta_time / refresh_period);
+	if (frames >= 1.0 && std::abs(delta_time - frames * refresh_period) < VSYNC_SNAP_TOLERANCE) {
+		delta_time = frames * refresh_period;
+	}
+}
+
+void Time::advanceAccumulator() {
+	accumulator += delta_time * time_scale; // 慢放/快进改变步数而不改变步长，逻辑结果与缩放无关
+	fixed_step_count = static_cast<int>(accumulator / fixed_delta_time);
+	if (fixed_step_count > max_fixed_steps) {
+		// 追赶不上时丢弃积压时间，宁可逻辑变慢也不让帧时间继续膨胀
+		dropped_steps += static_cast<Uint64>(fixed_step_count - max_fixed_steps);
+		spdlog::debug("Time: dropped {} fixed steps.", fixed_step_count - max_fixed_steps);
+		fixed_step_count = max_fixed_steps;
+		accumulator = fixed_step_count * fixed_delta_time + std::fmod(accumulator, fixed_delta_time);
+	}
+	accumulator -= fixed_step_count * fixed_delta_time;
+	interpolation_alpha = accumulator / fixed_delta_time;
 }
-} //namespace engine::core
\ No newline at end of file
+
+} //namespace engine::core
@@ -4,15 +4,37 @@
 
 namespace engine::core {
 
+/**
+ * @brief 帧计时、固定步长累加器与帧率限制。
+ *
+ * 每帧调用一次 update()：先按目标帧时间限帧（垂直同步开启时跳过），
+ * 再把真实帧间隔累加到固定步长累加器中。调用方执行 getFixedStepCount() 次
+ * 固定更新后，用 getInterpolationAlpha() 在上一步和当前步的状态之间插值渲染。
+ */
 class Time final {
 private:
-	Uint64 last_time;
+	Uint64 last_time; ///< @brief 上一帧开始的时间戳（纳秒）
 	Uint64 frame_start_time;
 	double delta_time = 0.0;
 	double time_scale = 1.0; // Default time scale is 1.0 (normal speed)
 
 	int target_fps = 0; // Default target FPS
 	double target_frame_time = 0.0; // Target frame time in seconds
+	Uint64 target_frame_time_ns = 0;
+	Uint64 spin_threshold_ns = 2000000; ///< @brief 距截止时间小于该值时改为自旋等待，吸收系统休眠精度误差
+
+	// 垂直同步
+	bool vsync_enabled = false;
+	double refresh_period = 0.0; ///< @brief 显示器刷新周期（秒），0 表示未知
+
+	// 固定步长
+	double fixed_delta_time = 1.0 / 60.0;
+	double accumulator = 0.0;
+	int max_fixed_steps = 5;
+	int fixed_step_count = 0;
+	double interpolation_alpha = 0.0;
+	Uint64 dropped_steps = 0; ///< @brief 因超过追赶上限而丢弃的固定步数
+
 public:
 	Time();
     Time(const Time &) = delete;
@@ -23,13 +45,21 @@ public:
 	void update();
 
 	float getDeltaTime() const {
-        return delta_time * time_scale;
+        return static_cast<float>(delta_time * time_scale);
     }
 
 	float getUnscaledDeltaTime() const {
-        return delta_time;
+        return static_cast<float>(delta_time);
     }
 
+	double getTimeScale() const {
+		return time_scale;
+	}
+
+	void setTimeScale(double scale) {
+		time_scale = scale > 0.0 ? scale : 0.0;
+	}
+
 	int getTargetFPS() const {
         return target_fps;
     }
@@ -37,10 +67,57 @@ public:
 	void setTargetFPS(int fps) {
         target_fps = fps;
         target_frame_time = target_fps > 0 ? 1.0 / target_fps : -1.0;
+		target_frame_time_ns = target_fps > 0 ? 1000000000ull / static_cast<Uint64>(target_fps) : 0;
     }
 
+	/**
+	 * @brief 设置垂直同步状态。
+	 *
+	 * 开启时 present 已经按刷新率阻塞，软件限帧仅在目标帧率低于刷新率时生效；
+	 * 帧间隔会吸附到刷新周期的整数倍，消除计时抖动。
+	 * @param enabled 渲染器是否成功开启了垂直同步
+	 * @param refresh_rate 显示器刷新率（Hz），未知时传 0
+	 */
+	void setVSync(bool enabled, float refresh_rate);
+
+	bool isVSyncEnabled() const {
+		return vsync_enabled;
+	}
+
+	void setSpinThreshold(double seconds) {
+		spin_threshold_ns = seconds > 0.0 ? static_cast<Uint64>(seconds * 1000000000.0) : 0;
+	}
+
+	// --- 固定步长 ---
+	void setFixedUpdateRate(int hz);
+	void setMaxFixedSteps(int steps) {
+		max_fixed_steps = steps > 0 ? steps : 1;
+	}
+
+	/** @brief 固定步长，不受时间缩放影响；缩放只改变每帧执行的固定步数 */
+	float getFixedDeltaTime() const {
+		return static_cast<float>(fixed_delta_time);
+	}
+
+	/** @brief 本帧需要执行的固定更新次数 */
+	int getFixedStepCount() const {
+		return fixed_step_count;
+	}
+
+	/** @brief 累加器剩余时间占一个固定步长的比例，范围 [0, 1) */
+	float getInterpolationAlpha() const {
+		return static_cast<float>(interpolation_alpha);
+	}
+
+	Uint64 getDroppedStepCount() const {
+		return dropped_steps;
+	}
+
 private:
-	void limitFrameRate(float current_delta_time);
+	void limitFrameRate();
+	void waitUntil(Uint64 deadline_ns) const;
+	void snapToRefreshPeriod();
+	void advanceAccumulator();
 };
 
 } // namespace engine::core
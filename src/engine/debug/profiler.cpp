@@ -0,0 +1,202 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <SDL3/SDL_timer.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::debug {
+
+static_assert((Profiler::EVENTS_PER_THREAD & (Profiler::EVENTS_PER_THREAD - 1)) == 0, "EVENTS_PER_THREAD must be a power of two.");
+
+namespace {
+constexpr double NS_TO_MS = 0.000001;
+constexpr Uint64 HITCH_WARMUP_FRAMES = 30; // 启动阶段的帧时间不稳定，不参与相对卡顿判断
+} // namespace
+
+Profiler &Profiler::get() {
+	static Profiler instance;
+	return instance;
+}
+
+Profiler::ThreadBuffer &Profiler::getThreadBuffer() {
+	thread_local ThreadBuffer *buffer = nullptr;
+	if (!buffer) {
+		// 每个线程只注册一次，缓冲区在进程结束前不会释放，线程退出后仍可导出
+		std::lock_guard lock(registry_mutex);
+		auto new_buffer = std::make_unique<ThreadBuffer>();
+		new_buffer->thread_index = static_cast<Uint32>(thread_buffers.size());
+		new_buffer->thread_name = "Thread " + std::to_string(new_buffer->thread_index);
+		new_buffer->events = std::make_unique<ProfileEvent[]>(EVENTS_PER_THREAD);
+		buffer = new_buffer.get();
+		thread_buffers.push_back(std::move(new_buffer));
+	}
+	return *buffer;
+}
+
+void Profiler::record(const char *name, Uint64 start_ns, Uint64 end_ns, Uint32 depth) {
+	ThreadBuffer &buffer = getThreadBuffer();
+	Uint64 index = buffer.write_index.load(std::memory_order_relaxed);
+	// 与 dumpChromeTrace() 中的 acquire 栅栏配对：读取方看到本次写入的内容时，一定也能看到至少 index 的 write_index
+	std::atomic_thread_fence(std::memory_order_release);
+	buffer.events[index & (EVENTS_PER_THREAD - 1)] = { name, start_ns, end_ns, depth };
+	buffer.write_index.store(index + 1, std::memory_order_release);
+}
+
+Uint32 Profiler::pushDepth() {
+	return getThreadBuffer().depth++;
+}
+
+void Profiler::popDepth() {
+	ThreadBuffer &buffer = getThreadBuffer();
+	if (buffer.depth > 0) {
+		--buffer.depth;
+	}
+}
+
+void Profiler::setThreadName(std::string_view name) {
+	ThreadBuffer &buffer = getThreadBuffer();
+	std::lock_guard lock(registry_mutex);
+	buffer.thread_name = name;
+}
+
+void Profiler::beginFrame() {
+	main_thread_buffer = &getThreadBuffer();
+	current_frame_start = SDL_GetTicksNS();
+	frame_event_cursor = main_thread_buffer->write_index.load(std::memory_order_relaxed);
+	pushDepth();
+}
+
+void Profiler::endFrame() {
+	if (!main_thread_buffer) {
+		return;
+	}
+	popDepth();
+	Uint64 end_ns = SDL_GetTicksNS();
+	record("Frame", current_frame_start, end_ns, 0);
+
+	FrameRecord frame{ current_frame_start, end_ns, false };
+	double frame_ms = frame.getMilliseconds();
+	double average_ms = getAverageFrameMs();
+	frame.hitch = frame_ms > hitch_threshold_ms || (frame_count > HITCH_WARMUP_FRAMES && frame_ms > average_ms * 2.0);
+	if (frame.hitch) {
+		++hitch_count;
+		spdlog::debug("Profiler: hitch detected, frame {} took {:.2f} ms (average {:.2f} ms).", frame_count, frame_ms, average_ms);
+	}
+	frames[frame_count % FRAME_HISTORY] = frame;
+	++frame_count;
+
+	accumulateFrameZones();
+}
+
+double Profiler::getAverageFrameMs() const {
+	Uint64 count = std::min<Uint64>(frame_count, FRAME_HISTORY);
+	if (count == 0) {
+		return 0.0;
+	}
+	double total = 0.0;
+	for (Uint64 i = 0; i < count; ++i) {
+		total += frames[i].getMilliseconds();
+	}
+	return total / static_cast<double>(count);
+}
+
+void Profiler::accumulateFrameZones() {
+	// 主线程读取自己的缓冲区，不存在并发写入
+	Uint64 end = main_thread_buffer->write_index.load(std::memory_order_relaxed);
+	Uint64 begin = std::max(frame_event_cursor, end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0);
+	for (Uint64 i = begin; i < end; ++i) {
+		const ProfileEvent &event = main_thread_buffer->events[i & (EVENTS_PER_THREAD - 1)];
+		ZoneAccumulator &accumulator = zone_accumulators[event.name];
+		accumulator.frame_ms += static_cast<double>(event.end_ns - event.start_ns) * NS_TO_MS;
+		++accumulator.calls;
+	}
+	for (auto &[name, accumulator] : zone_accumulators) {
+		accumulator.total_ms += accumulator.frame_ms;
+		accumulator.max_ms = std::max(accumulator.max_ms, accumulator.frame_ms);
+		accumulator.frame_ms = 0.0;
+	}
+
+	if (++stats_window_frames < STATS_WINDOW_FRAMES) {
+		return;
+	}
+	zone_stats.clear();
+	for (const auto &[name, accumulator] : zone_accumulators) {
+		zone_stats.push_back({ name, accumulator.total_ms / stats_window_frames, accumulator.max_ms,
+				static_cast<double>(accumulator.calls) / stats_window_frames });
+	}
+	std::sort(zone_stats.begin(), zone_stats.end(), [](const ZoneStats &a, const ZoneStats &b) {
+		return a.average_ms > b.average_ms;
+	});
+	zone_accumulators.clear();
+	stats_window_frames = 0;
+}
+
+bool Profiler::dumpChromeTrace(const std::string &path, int requested_frames) const {
+	Uint64 available = std::min<Uint64>(frame_count, FRAME_HISTORY);
+	if (available == 0) {
+		spdlog::warn("Profiler: no frames recorded, nothing to dump.");
+		return false;
+	}
+	Uint64 count = std::clamp<Uint64>(static_cast<Uint64>(std::max(requested_frames, 1)), 1, available);
+	Uint64 window_start = frames[(frame_count - count) % FRAME_HISTORY].start_ns;
+
+	nlohmann::json trace_events = nlohmann::json::array();
+	std::vector<ProfileEvent> snapshot;
+	{
+		std::lock_guard lock(registry_mutex);
+		for (const auto &buffer : thread_buffers) {
+			trace_events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", buffer->thread_index },
+					{ "args", { { "name", buffer->thread_name } } } });
+
+			// 类似 seqlock：写入方不会暂停，先复制，再根据复制后的 write_index 丢弃可能已被覆盖的记录。
+			// 写入方正在写的是下标 after 对应的槽位（尚未发布），所以 after + 1 - EVENTS_PER_THREAD 之前的记录都不可信
+			Uint64 end = buffer->write_index.load(std::memory_order_acquire);
+			Uint64 begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+			snapshot.clear();
+			for (Uint64 i = begin; i < end; ++i) {
+				snapshot.push_back(buffer->events[i & (EVENTS_PER_THREAD - 1)]);
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			Uint64 after = buffer->write_index.load(std::memory_order_relaxed);
+			Uint64 safe_begin = std::max(begin, after + 1 > EVENTS_PER_THREAD ? after + 1 - EVENTS_PER_THREAD : 0);
+
+			for (Uint64 i = safe_begin; i < end; ++i) {
+				const ProfileEvent &event = snapshot[i - begin];
+				if (!event.name || event.end_ns < window_start) {
+					continue;
+				}
+				double ts_us = (static_cast<double>(event.start_ns) - static_cast<double>(window_start)) * 0.001;
+				trace_events.push_back({ { "name", event.name }, { "ph", "X" }, { "pid", 1 }, { "tid", buffer->thread_index },
+						{ "ts", ts_us }, { "dur", static_cast<double>(event.end_ns - event.start_ns) * 0.001 } });
+			}
+		}
+	}
+
+	std::ofstream file(path, std::ios::trunc);
+	if (!file) {
+		spdlog::error("Profiler: failed to open '{}' for writing.", path);
+		return false;
+	}
+	file << nlohmann::json{ { "traceEvents", std::move(trace_events) }, { "displayTimeUnit", "ms" } }.dump();
+	spdlog::info("Profiler: dumped {} frames to '{}'.", count, path);
+	return static_cast<bool>(file);
+}
+
+// --- ProfileScope ---
+
+ProfileScope::ProfileScope(const char *name) :
+		name(name), start_ns(0), depth(Profiler::get().pushDepth()) {
+	start_ns = SDL_GetTicksNS();
+}
+
+ProfileScope::~ProfileScope() {
+	Uint64 end_ns = SDL_GetTicksNS();
+	Profiler &profiler = Profiler::get();
+	profiler.popDepth();
+	profiler.record(name, start_ns, end_ns, depth);
+}
+
+} // namespace engine::debug
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::debug {
+
+#if defined(ENGINE_PROFILE_ENABLED)
+inline constexpr bool PROFILER_ENABLED = true;
+#else
+inline constexpr bool PROFILER_ENABLED = false; ///< @brief 未定义 ENGINE_PROFILE_ENABLED 时所有分析区间宏展开为空
+#endif
+
+/**
+ * @brief 一个已结束的分析区间
+ */
+struct ProfileEvent {
+	const char *name = nullptr; ///< @brief 区间名称，必须是静态存储期的字符串（字面量或 __func__）
+	Uint64 start_ns = 0;
+	Uint64 end_ns = 0;
+	Uint32 depth = 0; ///< @brief 嵌套深度，0 为最外层
+};
+
+/**
+ * @brief 单个区间在统计窗口内的平均耗时
+ */
+struct ZoneStats {
+	std::string_view name;
+	double average_ms = 0.0; ///< @brief 平均每帧耗时（包含子区间）
+	double max_ms = 0.0; ///< @brief 窗口内单帧最大耗时
+	double calls_per_frame = 0.0;
+};
+
+/**
+ * @brief 帧记录，用于帧时间曲线和卡顿检测
+ */
+struct FrameRecord {
+	Uint64 start_ns = 0;
+	Uint64 end_ns = 0;
+	bool hitch = false;
+
+	double getMilliseconds() const { return static_cast<double>(end_ns - start_ns) * 0.000001; }
+};
+
+/**
+ * @brief 轻量级 CPU 分析器。
+ *
+ * 每个线程首次记录时注册一个固定容量的环形缓冲区，之后的记录只由所属线程写入，
+ * 写入路径无锁、无分配。主线程在 endFrame() 中汇总本线程的区间统计，
+ * dumpChromeTrace() 可以把最近若干帧所有线程的区间导出为 Chrome / Perfetto 可读的 JSON。
+ */
+class Profiler final {
+public:
+	static constexpr size_t EVENTS_PER_THREAD = 1 << 15; ///< @brief 每线程环形缓冲区容量，必须为 2 的幂
+	static constexpr size_t FRAME_HISTORY = 240; ///< @brief 保留的帧记录数量
+	static constexpr int STATS_WINDOW_FRAMES = 60; ///< @brief 区间统计每隔多少帧刷新一次
+
+private:
+	struct ThreadBuffer {
+		Uint32 thread_index = 0;
+		std::string thread_name;
+		std::unique_ptr<ProfileEvent[]> events;
+		std::atomic<Uint64> write_index{ 0 }; ///< @brief 只由所属线程递增，读取方以 acquire 读取
+		Uint32 depth = 0;
+	};
+
+	struct ZoneAccumulator {
+		double total_ms = 0.0;
+		double frame_ms = 0.0;
+		double max_ms = 0.0;
+		Uint64 calls = 0;
+	};
+
+	mutable std::mutex registry_mutex; ///< @brief 只保护线程注册与导出时的遍历
+	std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers;
+
+	std::array<FrameRecord, FRAME_HISTORY> frames{};
+	Uint64 frame_count = 0;
+	Uint64 current_frame_start = 0;
+	Uint64 frame_event_cursor = 0; ///< @brief 主线程缓冲区中尚未计入统计的第一个事件
+	ThreadBuffer *main_thread_buffer = nullptr;
+
+	double hitch_threshold_ms = 33.3; ///< @brief 超过该值或超过平均帧时间两倍的帧视为卡顿
+	Uint64 hitch_count = 0;
+
+	std::unordered_map<std::string_view, ZoneAccumulator> zone_accumulators;
+	int stats_window_frames = 0;
+	std::vector<ZoneStats> zone_stats; ///< @brief 上一个统计窗口的结果，按平均耗时降序
+
+	Profiler() = default;
+
+public:
+	static Profiler &get();
+
+	Profiler(const Profiler &) = delete;
+	Profiler &operator=(const Profiler &) = delete;
+	Profiler(Profiler &&) = delete;
+	Profiler &operator=(Profiler &&) = delete;
+
+	void beginFrame(); ///< @brief 主线程每帧开始时调用
+	void endFrame(); ///< @brief 主线程每帧结束时调用，汇总区间统计并检测卡顿
+
+	/// @brief 记录一个区间，可在任意线程调用
+	void record(const char *name, Uint64 start_ns, Uint64 end_ns, Uint32 depth);
+	Uint32 pushDepth(); ///< @brief 进入区间，返回当前线程的嵌套深度
+	void popDepth();
+	void setThreadName(std::string_view name); ///< @brief 为当前线程命名，显示在导出的追踪文件中
+
+	/**
+	 * @brief 把最近的若干帧导出为 Chrome Trace Event 格式的 JSON。
+	 *
+	 * @param path 输出文件路径。
+	 * @param frame_count 导出的帧数，超过 FRAME_HISTORY 时截断。
+	 * @return 写入成功返回 true。
+	 */
+	bool dumpChromeTrace(const std::string &path, int frame_count) const;
+
+	const std::array<FrameRecord, FRAME_HISTORY> &getFrames() const { return frames; } ///< @brief 帧记录环形数组，配合 getFrameCount() 定位最新帧
+	Uint64 getFrameCount() const { return frame_count; }
+	double getAverageFrameMs() const;
+	Uint64 getHitchCount() const { return hitch_count; }
+	void setHitchThreshold(double milliseconds) { hitch_threshold_ms = milliseconds; }
+	const std::vector<ZoneStats> &getZoneStats() const { return zone_stats; }
+
+private:
+	ThreadBuffer &getThreadBuffer();
+	void accumulateFrameZones();
+};
+
+/**
+ * @brief RAII 分析区间，构造时记录开始时间，析构时写入当前线程的缓冲区
+ */
+class ProfileScope final {
+private:
+	const char *name;
+	Uint64 start_ns;
+	Uint32 depth;
+
+public:
+	explicit ProfileScope(const char *name);
+	~ProfileScope();
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+	ProfileScope(ProfileScope &&) = delete;
+	ProfileScope &operator=(ProfileScope &&) = delete;
+};
+
+} // namespace engine::debug
+
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(ENGINE_PROFILE_ENABLED)
+#define PROFILE_SCOPE(name) ::engine::debug::ProfileScope ENGINE_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_THREAD_NAME(name) ::engine::debug::Profiler::get().setThreadName(name)
+#define PROFILE_FRAME_BEGIN() ::engine::debug::Profiler::get().beginFrame()
+#define PROFILE_FRAME_END() ::engine::debug::Profiler::get().endFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
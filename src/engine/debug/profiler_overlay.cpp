@@ -0,0 +1,162 @@
+#include "profiler_overlay.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <SDL3/SDL_render.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include "../memory/allocation_tracker.h"
+#include "../memory/frame_arena.h"
+#include "../resource/resource_manager.h"
+#include "profiler.h"
+
+namespace engine::debug {
+
+namespace {
+constexpr float MARGIN = 8.0f;
+constexpr float GRAPH_HEIGHT = 80.0f;
+constexpr float BAR_WIDTH = 1.0f;
+constexpr int TEXT_REFRESH_FRAMES = 30;
+constexpr size_t MAX_ZONE_LINES = 10;
+} // namespace
+
+void ProfilerOverlay::SDLTextureDeleter::operator()(SDL_Texture *texture) const {
+	if (texture) {
+		SDL_DestroyTexture(texture);
+	}
+}
+
+ProfilerOverlay::ProfilerOverlay(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager, std::string_view font_path, int font_size) :
+		renderer(sdl_renderer), resource_manager(resource_manager), font_path(font_path), font_size(font_size) {
+	if (!renderer || !resource_manager) {
+		throw std::runtime_error("ProfilerOverlay requires a valid SDL_Renderer and ResourceManager.");
+	}
+	normal_bars.reserve(Profiler::FRAME_HISTORY);
+	hitch_bars.reserve(Profiler::FRAME_HISTORY);
+}
+
+ProfilerOverlay::~ProfilerOverlay() = default;
+
+void ProfilerOverlay::draw(engine::memory::FrameArena &frame_arena) {
+	if (!visible) {
+		return;
+	}
+	const Profiler &profiler = Profiler::get();
+	if (!text_texture || profiler.getFrameCount() >= text_frame + TEXT_REFRESH_FRAMES) {
+		rebuildText(frame_arena);
+	}
+
+	Uint8 r, g, b, a;
+	SDL_BlendMode blend_mode;
+	SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+	SDL_GetRenderDrawBlendMode(renderer, &blend_mode);
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+	float graph_width = Profiler::FRAME_HISTORY * BAR_WIDTH;
+	SDL_FRect background = { MARGIN, MARGIN, std::max(graph_width, text_rect.w) + MARGIN * 2.0f, GRAPH_HEIGHT + text_rect.h + MARGIN * 3.0f };
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+	SDL_RenderFillRect(renderer, &background);
+
+	drawGraph(MARGIN * 2.0f, MARGIN * 2.0f);
+	if (text_texture) {
+		SDL_FRect dest = { MARGIN * 2.0f, MARGIN * 3.0f + GRAPH_HEIGHT, text_rect.w, text_rect.h };
+		SDL_RenderTexture(renderer, text_texture.get(), nullptr, &dest);
+	}
+
+	SDL_SetRenderDrawBlendMode(renderer, blend_mode);
+	SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+void ProfilerOverlay::drawGraph(float x, float y) {
+	const Profiler &profiler = Profiler::get();
+	const auto &frames = profiler.getFrames();
+	Uint64 frame_count = profiler.getFrameCount();
+	Uint64 count = std::min<Uint64>(frame_count, Profiler::FRAME_HISTORY);
+
+	// 纵轴至少容纳两倍帧预算，出现更长的帧时自动放大
+	double scale_ms = budget_ms * 2.0;
+	for (Uint64 i = 0; i < count; ++i) {
+		scale_ms = std::max(scale_ms, frames[i].getMilliseconds());
+	}
+
+	normal_bars.clear();
+	hitch_bars.clear();
+	Uint64 oldest = frame_count - count;
+	for (Uint64 i = 0; i < count; ++i) {
+		const FrameRecord &frame = frames[(oldest + i) % Profiler::FRAME_HISTORY];
+		float height = static_cast<float>(frame.getMilliseconds() / scale_ms) * GRAPH_HEIGHT;
+		SDL_FRect bar = { x + static_cast<float>(i) * BAR_WIDTH, y + GRAPH_HEIGHT - height, BAR_WIDTH, height };
+		(frame.hitch ? hitch_bars : normal_bars).push_back(bar);
+	}
+
+	SDL_SetRenderDrawColor(renderer, 80, 220, 120, 255);
+	SDL_RenderFillRects(renderer, normal_bars.data(), static_cast<int>(normal_bars.size()));
+	SDL_SetRenderDrawColor(renderer, 240, 60, 60, 255);
+	SDL_RenderFillRects(renderer, hitch_bars.data(), static_cast<int>(hitch_bars.size()));
+
+	float budget_y = y + GRAPH_HEIGHT - static_cast<float>(budget_ms / scale_ms) * GRAPH_HEIGHT;
+	SDL_SetRenderDrawColor(renderer, 255, 220, 0, 255);
+	SDL_RenderLine(renderer, x, budget_y, x + Profiler::FRAME_HISTORY * BAR_WIDTH, budget_y);
+}
+
+void ProfilerOverlay::rebuildText(engine::memory::FrameArena &frame_arena) {
+	const Profiler &profiler = Profiler::get();
+	text_frame = profiler.getFrameCount();
+
+	TTF_Font *font = resource_manager->getFont(font_path, font_size);
+	if (!font) {
+		visible = false; // 没有字体无法显示，避免每帧重复报错
+		spdlog::error("ProfilerOverlay: font '{}' is unavailable, overlay disabled.", font_path);
+		return;
+	}
+
+	double average_ms = profiler.getAverageFrameMs();
+	double max_ms = 0.0;
+	for (const auto &frame : profiler.getFrames()) {
+		max_ms = std::max(max_ms, frame.getMilliseconds());
+	}
+
+	// 每行都原地追加到帧分配器中上一行的末尾，整段文字连续存放
+	std::string_view text = frame_arena.format("Frame {:.2f} ms ({:.0f} FPS)  max {:.2f} ms  hitches {}\n",
+			average_ms, average_ms > 0.0 ? 1000.0 / average_ms : 0.0, max_ms, profiler.getHitchCount());
+	engine::resource::AudioStats audio = resource_manager->getAudioStats();
+	text = frame_arena.append(text, "Audio voices {}  latency {:.1f} ms  max {:.1f}  stolen {}  music buffer {:.0f} ms  underruns {}\n",
+			audio.active_voices, audio.average_latency_ms, audio.max_latency_ms, audio.voices_stolen, audio.music_buffered_ms, audio.music_underruns);
+	engine::resource::TextCacheStats text_cache = resource_manager->getTextCacheStats();
+	text = frame_arena.append(text, "Text glyphs {}  pages {}  layouts {} (hit {} / miss {})\n",
+			text_cache.glyphs_rasterized, text_cache.atlas_pages, text_cache.cached_layouts, text_cache.layout_hits, text_cache.layout_misses);
+	engine::resource::ResourceCacheStats cache = resource_manager->getCacheStats();
+	text = frame_arena.append(text, "Textures {} ({:.1f} MB, hit {:.0f}%, evicted {})  fonts {} ({:.1f} MB, evicted {})\n",
+			cache.textures.entries, static_cast<double>(cache.textures.bytes) / (1024.0 * 1024.0), cache.textures.getHitRate() * 100.0, cache.textures.evictions,
+			cache.fonts.entries, static_cast<double>(cache.fonts.bytes) / (1024.0 * 1024.0), cache.fonts.evictions);
+	text = frame_arena.append(text, "Frame arena {:.1f} / {:.0f} KB  peak {:.1f} KB  overflows {}\n",
+			static_cast<double>(frame_arena.getUsedBytes()) / 1024.0, static_cast<double>(frame_arena.getCapacity()) / 1024.0,
+			static_cast<double>(frame_arena.getPeakBytes()) / 1024.0, frame_arena.getOverflowCount());
+	if (engine::memory::AllocationTracker::isInstalled()) {
+		const engine::memory::AllocationSummary &allocations = engine::memory::AllocationTracker::getSummary();
+		double frames = static_cast<double>(std::max<Uint64>(allocations.frames, 1));
+		text = frame_arena.append(text, "Heap allocs {:.1f}/frame ({:.0f} B)  peak {}  frames with allocs {}\n",
+				static_cast<double>(allocations.total.count) / frames, static_cast<double>(allocations.total.bytes) / frames,
+				allocations.peak_frame.count, allocations.frames_with_allocations);
+	}
+	const auto &zones = profiler.getZoneStats();
+	for (size_t i = 0; i < std::min(zones.size(), MAX_ZONE_LINES); ++i) {
+		const ZoneStats &zone = zones[i];
+		text = frame_arena.append(text, "{:<28} {:6.2f} ms  max {:6.2f}  x{:.1f}\n", zone.name, zone.average_ms, zone.max_ms, zone.calls_per_frame);
+	}
+	text.remove_suffix(1);
+
+	SDL_Surface *surface = TTF_RenderText_Blended_Wrapped(font, text.data(), text.size(), SDL_Color{ 255, 255, 255, 255 }, 0);
+	if (!surface) {
+		spdlog::warn("ProfilerOverlay: failed to render text: {}", SDL_GetError());
+		return;
+	}
+	text_texture.reset(SDL_CreateTextureFromSurface(renderer, surface));
+	text_rect = { 0.0f, 0.0f, static_cast<float>(surface->w), static_cast<float>(surface->h) };
+	SDL_DestroySurface(surface);
+}
+
+} // namespace engine::debug
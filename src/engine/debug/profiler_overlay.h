@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_stdinc.h>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::memory {
+class FrameArena;
+}
+
+namespace engine::debug {
+
+/**
+ * @brief 分析器的屏幕叠加层：帧时间曲线、卡顿标记与各区间的平均耗时。
+ *
+ * 直接使用 SDL 绘制，需要在 Renderer 提交完批处理命令之后、present 之前调用 draw()。
+ * 文字通过 FontManager 的字体渲染为一张纹理，每隔若干帧才重新生成一次，拼接文字使用帧分配器，不产生堆分配。
+ */
+class ProfilerOverlay final {
+private:
+	struct SDLTextureDeleter {
+		void operator()(SDL_Texture *texture) const;
+	};
+
+	SDL_Renderer *renderer = nullptr; ///< @brief 非拥有指针
+	engine::resource::ResourceManager *resource_manager = nullptr; ///< @brief 非拥有指针
+	std::string font_path;
+	int font_size;
+
+	bool visible = false;
+	double budget_ms = 1000.0 / 60.0; ///< @brief 目标帧时间，在曲线上画一条参考线
+
+	std::unique_ptr<SDL_Texture, SDLTextureDeleter> text_texture;
+	SDL_FRect text_rect = { 0, 0, 0, 0 };
+	Uint64 text_frame = 0; ///< @brief 生成文字纹理时的帧号
+	std::vector<SDL_FRect> normal_bars; ///< @brief 帧时间柱（跨帧复用容量）
+	std::vector<SDL_FRect> hitch_bars;
+
+public:
+	/**
+	 * @brief 构造函数
+	 *
+	 * @param sdl_renderer 指向有效的 SDL_Renderer 的指针。不能为空。
+	 * @param resource_manager 指向有效的 ResourceManager 的指针。不能为空。
+	 * @throws std::runtime_error 如果任一指针为 nullptr。
+	 */
+	ProfilerOverlay(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager *resource_manager,
+			std::string_view font_path = "assets/fonts/VonwaonBitmap-16px.ttf", int font_size = 16);
+	~ProfilerOverlay();
+
+	void draw(engine::memory::FrameArena &frame_arena); ///< @brief 可见时绘制叠加层
+	void toggle() { visible = !visible; }
+	void setVisible(bool value) { visible = value; }
+	bool isVisible() const { return visible; }
+	void setFrameBudget(double milliseconds) { budget_ms = milliseconds; }
+
+	ProfilerOverlay(const ProfilerOverlay &) = delete;
+	ProfilerOverlay &operator=(const ProfilerOverlay &) = delete;
+	ProfilerOverlay(ProfilerOverlay &&) = delete;
+	ProfilerOverlay &operator=(ProfilerOverlay &&) = delete;
+
+private:
+	void rebuildText(engine::memory::FrameArena &frame_arena); ///< @brief 根据最新统计重新生成文字纹理
+	void drawGraph(float x, float y);
+};
+
+} // namespace engine::debug
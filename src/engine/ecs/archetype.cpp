@@ -0,0 +1,135 @@
+#include "archetype.h"
+
+#include <algorithm>
+#include <new>
+
+namespace engine::ecs {
+
+namespace {
+size_t alignUp(size_t value, size_t alignment) {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+void Chunk::Deleter::operator()(std::byte *data) const {
+	if (pool) {
+		pool->deallocate(data);
+	} else {
+		::operator delete(data, std::align_val_t(Archetype::CHUNK_ALIGNMENT));
+	}
+}
+
+Archetype::Archetype(ComponentMask mask, memory::PoolAllocator *chunk_pool) :
+		mask(mask), chunk_pool(chunk_pool) {
+	column_lookup.fill(-1);
+	size_t row_bytes = sizeof(Entity);
+	for (ComponentId id = 0; id < MAX_COMPONENTS; ++id) {
+		if (mask & (ComponentMask{ 1 } << id)) {
+			column_lookup[id] = static_cast<Sint16>(component_ids.size());
+			component_ids.push_back(id);
+			row_bytes += ComponentRegistry::getInfo(id).size;
+		}
+	}
+
+	// 先按每行总字节数估算容量，再按对齐要求布局；放不下时逐步减少容量
+	chunk_capacity = static_cast<Uint32>(std::max<size_t>(1, CHUNK_BYTES / row_bytes));
+	while (true) {
+		size_t offset = sizeof(Entity) * chunk_capacity;
+		column_offsets.clear();
+		for (ComponentId id : component_ids) {
+			const ComponentInfo &info = ComponentRegistry::getInfo(id);
+			offset = alignUp(offset, info.alignment);
+			column_offsets.push_back(offset);
+			offset += info.size * chunk_capacity;
+		}
+		if (offset <= CHUNK_BYTES || chunk_capacity == 1) {
+			chunk_bytes = alignUp(std::max<size_t>(offset, 1), CHUNK_ALIGNMENT);
+			break;
+		}
+		--chunk_capacity;
+	}
+}
+
+void Archetype::addChunk() {
+	if (spare_chunk) {
+		chunks.push_back(std::move(*spare_chunk));
+		spare_chunk.reset();
+		return;
+	}
+	// 原型之间共用块池：一个原型清空的块可以直接被另一个原型复用，稳态下增删实体不访问堆
+	Chunk chunk;
+	if (chunk_pool && chunk_bytes <= chunk_pool->getBlockSize()) {
+		chunk.data = { static_cast<std::byte *>(chunk_pool->allocate()), Chunk::Deleter{ chunk_pool } };
+	} else {
+		chunk.data.reset(static_cast<std::byte *>(::operator new(chunk_bytes, std::align_val_t(CHUNK_ALIGNMENT))));
+	}
+	chunk.entities = reinterpret_cast<Entity *>(chunk.data.get());
+	chunks.push_back(std::move(chunk));
+}
+
+Archetype::Location Archetype::allocate(Entity entity) {
+	if (chunks.empty() || chunks.back().count == chunk_capacity) {
+		addChunk();
+	}
+	Chunk &chunk = chunks.back();
+	Location location{ static_cast<Uint32>(chunks.size() - 1), chunk.count };
+	chunk.entities[chunk.count++] = entity;
+	++entity_count;
+	return location;
+}
+
+Entity Archetype::fillHole(Location location) {
+	Chunk &last_chunk = chunks.back();
+	Uint32 last_row = last_chunk.count - 1;
+	Entity moved;
+	if (location.chunk != chunks.size() - 1 || location.row != last_row) {
+		Chunk &chunk = chunks[location.chunk];
+		for (size_t column = 0; column < component_ids.size(); ++column) {
+			const ComponentInfo &info = ComponentRegistry::getInfo(component_ids[column]);
+			void *dst = getColumnData(chunk, column) + info.size * location.row;
+			void *src = getColumnData(last_chunk, column) + info.size * last_row;
+			info.move_construct(dst, src);
+			info.destroy(src);
+		}
+		moved = last_chunk.entities[last_row];
+		chunk.entities[location.row] = moved;
+	}
+	--last_chunk.count;
+	--entity_count;
+	// 空块移入备用位而不是释放，避免在块边界反复增删实体时频繁分配
+	if (last_chunk.count == 0) {
+		spare_chunk = std::move(last_chunk);
+		chunks.pop_back();
+	}
+	return moved;
+}
+
+Entity Archetype::remove(Location location) {
+	Chunk &chunk = chunks[location.chunk];
+	for (size_t column = 0; column < component_ids.size(); ++column) {
+		const ComponentInfo &info = ComponentRegistry::getInfo(component_ids[column]);
+		info.destroy(getColumnData(chunk, column) + info.size * location.row);
+	}
+	return fillHole(location);
+}
+
+void *Archetype::getComponent(Location location, ComponentId id) const {
+	Sint16 column = column_lookup[id];
+	if (column < 0) {
+		return nullptr;
+	}
+	const ComponentInfo &info = ComponentRegistry::getInfo(id);
+	return getColumnData(chunks[location.chunk], static_cast<size_t>(column)) + info.size * location.row;
+}
+
+Archetype *Archetype::getAddEdge(ComponentId id) const {
+	auto it = add_edges.find(id);
+	return it != add_edges.end() ? it->second : nullptr;
+}
+
+Archetype *Archetype::getRemoveEdge(ComponentId id) const {
+	auto it = remove_edges.find(id);
+	return it != remove_edges.end() ? it->second : nullptr;
+}
+
+} // namespace engine::ecs
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "../memory/pool_allocator.h"
+#include "component.h"
+#include "entity.h"
+
+namespace engine::ecs {
+
+/**
+ * @brief 原型中的一个内存块：实体数组与各组件列（SoA）连续存放在同一块内存中
+ */
+struct Chunk {
+	/// @brief 标准大小的块归还给 World 的块池，超大块（单行超过 CHUNK_BYTES）直接释放
+	struct Deleter {
+		memory::PoolAllocator *pool;
+		Deleter() noexcept :
+				pool(nullptr) {}
+		explicit Deleter(memory::PoolAllocator *pool) noexcept :
+				pool(pool) {}
+		void operator()(std::byte *data) const;
+	};
+
+	std::unique_ptr<std::byte, Deleter> data;
+	Entity *entities = nullptr; ///< @brief 位于块首，各组件列按 Archetype::column_offsets 依次排列
+	Uint32 count = 0;
+};
+
+/**
+ * @brief 原型：拥有相同组件集合的所有实体。
+ *
+ * 实体按插入顺序紧密存放在固定容量的块中，删除时用最后一个实体填补空位，
+ * 因此每个块的 [0, count) 区间始终是连续有效的数据，查询可以线性遍历。
+ */
+class Archetype final {
+public:
+	static constexpr size_t CHUNK_BYTES = 16 * 1024; ///< @brief 单个块的目标大小，接近 L1 缓存容量
+	static constexpr size_t CHUNK_ALIGNMENT = 64;
+
+	struct Location {
+		Uint32 chunk = 0;
+		Uint32 row = 0;
+	};
+
+private:
+	ComponentMask mask;
+	memory::PoolAllocator *chunk_pool; ///< @brief 块大小为 CHUNK_BYTES 的池，由 World 持有
+	std::vector<ComponentId> component_ids; ///< @brief 按 ID 升序
+	std::array<Sint16, MAX_COMPONENTS> column_lookup; ///< @brief ComponentId -> 列下标，不存在为 -1
+	std::vector<size_t> column_offsets; ///< @brief 各列在块内的字节偏移
+	Uint32 chunk_capacity = 0;
+	size_t chunk_bytes = 0;
+	std::vector<Chunk> chunks; ///< @brief 只有最后一个块可能未满，且不含空块
+	std::optional<Chunk> spare_chunk; ///< @brief 最近清空的块，下次扩容时复用
+	Uint32 entity_count = 0;
+
+	std::unordered_map<ComponentId, Archetype *> add_edges; ///< @brief 添加某组件后的目标原型缓存
+	std::unordered_map<ComponentId, Archetype *> remove_edges; ///< @brief 移除某组件后的目标原型缓存
+
+public:
+	Archetype(ComponentMask mask, memory::PoolAllocator *chunk_pool);
+
+	Archetype(const Archetype &) = delete;
+	Archetype &operator=(const Archetype &) = delete;
+	Archetype(Archetype &&) = delete;
+	Archetype &operator=(Archetype &&) = delete;
+
+	/// @brief 为实体分配一行，组件内存未初始化，需要调用方逐列构造
+	Location allocate(Entity entity);
+
+	/**
+	 * @brief 移走最后一行填补 location 处的空位（该处组件必须已经析构或移出）
+	 *
+	 * @return 被移动的实体；如果空位本身就是最后一行，返回无效实体
+	 */
+	Entity fillHole(Location location);
+
+	/// @brief 析构 location 处的全部组件并填补空位
+	Entity remove(Location location);
+
+	[[nodiscard]] void *getComponent(Location location, ComponentId id) const;
+	[[nodiscard]] bool hasComponent(ComponentId id) const { return column_lookup[id] >= 0; }
+
+	template <typename T>
+	std::span<T> getColumn(const Chunk &chunk) const {
+		return { reinterpret_cast<T *>(getColumnData(chunk, static_cast<size_t>(column_lookup[getComponentId<T>()]))), chunk.count };
+	}
+
+	ComponentMask getMask() const { return mask; }
+	const std::vector<ComponentId> &getComponentIds() const { return component_ids; }
+	const std::vector<Chunk> &getChunks() const { return chunks; }
+	Uint32 getChunkCapacity() const { return chunk_capacity; }
+	Uint32 getEntityCount() const { return entity_count; }
+
+	Archetype *getAddEdge(ComponentId id) const;
+	Archetype *getRemoveEdge(ComponentId id) const;
+	void setAddEdge(ComponentId id, Archetype *target) { add_edges[id] = target; }
+	void setRemoveEdge(ComponentId id, Archetype *target) { remove_edges[id] = target; }
+
+private:
+	void addChunk();
+	std::byte *getColumnData(const Chunk &chunk, size_t column) const { return chunk.data.get() + column_offsets[column]; }
+};
+
+} // namespace engine::ecs
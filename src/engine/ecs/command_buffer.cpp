@@ -0,0 +1,74 @@
+#include "command_buffer.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "world.h"
+
+namespace engine::ecs {
+
+CommandBuffer::CommandBuffer(World &world) :
+		world(&world) {}
+
+CommandBuffer::~CommandBuffer() {
+	reset();
+}
+
+Entity CommandBuffer::create() {
+	return world->create();
+}
+
+void CommandBuffer::destroy(Entity entity) {
+	commands.push_back({ CommandType::Destroy, 0, entity, nullptr });
+}
+
+void *CommandBuffer::allocate(size_t size, size_t alignment) {
+	while (true) {
+		if (current_block == blocks.size()) {
+			size_t block_size = std::max(BLOCK_BYTES, size + alignment);
+			blocks.push_back({ std::make_unique<std::byte[]>(block_size), block_size });
+			block_offset = 0;
+		}
+		Block &block = blocks[current_block];
+		auto base = reinterpret_cast<uintptr_t>(block.data.get());
+		size_t aligned = ((base + block_offset + alignment - 1) & ~(alignment - 1)) - base;
+		if (aligned + size <= block.size) {
+			block_offset = aligned + size;
+			return block.data.get() + aligned;
+		}
+		++current_block;
+		block_offset = 0;
+	}
+}
+
+void CommandBuffer::apply() {
+	// World 的修改不会向本缓冲区追加命令，可以直接遍历
+	for (Command &command : commands) {
+		switch (command.type) {
+			case CommandType::Destroy:
+				world->destroy(command.entity);
+				break;
+			case CommandType::Add:
+				world->addComponent(command.entity, command.component, command.payload);
+				break;
+			case CommandType::Remove:
+				world->removeComponent(command.entity, command.component);
+				break;
+		}
+	}
+	reset();
+}
+
+void CommandBuffer::reset() {
+	// Add 命令的组件值无论是否被移走都需要析构（移走后处于有效的已移出状态）
+	for (const Command &command : commands) {
+		if (command.type == CommandType::Add) {
+			ComponentRegistry::getInfo(command.component).destroy(command.payload);
+		}
+	}
+	commands.clear();
+	current_block = 0;
+	block_offset = 0;
+}
+
+} // namespace engine::ecs
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "component.h"
+#include "entity.h"
+
+namespace engine::ecs {
+
+class World;
+
+/**
+ * @brief 延迟的结构性修改（销毁实体、添加/移除组件），在遍历结束后由 apply() 按记录顺序执行。
+ *
+ * 组件值暂存在按块分配的内存池中，apply() 之后内存保留给下一帧复用。
+ * create() 会立即在空原型中创建实体，以便后续命令引用它；查询不会遍历空原型，因此遍历期间调用是安全的。
+ */
+class CommandBuffer final {
+private:
+	enum class CommandType : Uint8 {
+		Destroy,
+		Add,
+		Remove,
+	};
+
+	struct Command {
+		CommandType type;
+		ComponentId component;
+		Entity entity;
+		void *payload; ///< @brief Add 命令的组件值
+	};
+
+	static constexpr size_t BLOCK_BYTES = 16 * 1024;
+
+	struct Block {
+		std::unique_ptr<std::byte[]> data;
+		size_t size = 0;
+	};
+
+	World *world;
+	std::vector<Command> commands;
+	std::vector<Block> blocks;
+	size_t current_block = 0;
+	size_t block_offset = 0;
+
+public:
+	/**
+	 * @brief 构造函数
+	 *
+	 * @param world 命令作用的 World。
+	 */
+	explicit CommandBuffer(World &world);
+	~CommandBuffer();
+
+	CommandBuffer(const CommandBuffer &) = delete;
+	CommandBuffer &operator=(const CommandBuffer &) = delete;
+	CommandBuffer(CommandBuffer &&) = delete;
+	CommandBuffer &operator=(CommandBuffer &&) = delete;
+
+	Entity create(); ///< @brief 立即创建空实体，组件通过 add() 延迟添加
+	void destroy(Entity entity);
+
+	template <typename T>
+	void add(Entity entity, T component) {
+		void *payload = allocate(sizeof(T), alignof(T));
+		::new (payload) T(std::move(component));
+		commands.push_back({ CommandType::Add, getComponentId<T>(), entity, payload });
+	}
+
+	template <typename T>
+	void remove(Entity entity) {
+		commands.push_back({ CommandType::Remove, getComponentId<T>(), entity, nullptr });
+	}
+
+	void apply(); ///< @brief 执行并清空所有命令，作用于已失效实体的命令会被忽略
+	bool isEmpty() const { return commands.empty(); }
+
+private:
+	void *allocate(size_t size, size_t alignment);
+	void reset(); ///< @brief 析构未执行的组件值并回收内存池
+};
+
+} // namespace engine::ecs
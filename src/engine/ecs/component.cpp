@@ -0,0 +1,37 @@
+#include "component.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace engine::ecs {
+
+namespace {
+// 固定容量数组：注册只追加，已发布的条目不会移动，读取无需加锁
+std::array<ComponentInfo, MAX_COMPONENTS> component_infos;
+std::atomic<ComponentId> component_count{ 0 };
+std::mutex registry_mutex;
+} // namespace
+
+ComponentId ComponentRegistry::registerComponent(const ComponentInfo &info) {
+	std::lock_guard lock(registry_mutex);
+	ComponentId id = component_count.load(std::memory_order_relaxed);
+	if (id >= MAX_COMPONENTS) {
+		throw std::runtime_error("Too many ECS component types (max " + std::to_string(MAX_COMPONENTS) + ").");
+	}
+	component_infos[id] = info;
+	component_count.store(id + 1, std::memory_order_release);
+	return id;
+}
+
+const ComponentInfo &ComponentRegistry::getInfo(ComponentId id) {
+	return component_infos[id];
+}
+
+ComponentId ComponentRegistry::getCount() {
+	return component_count.load(std::memory_order_acquire);
+}
+
+} // namespace engine::ecs
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::ecs {
+
+using ComponentId = Uint32;
+using ComponentMask = Uint64; ///< @brief 组件集合的位掩码，同一掩码的实体属于同一原型
+inline constexpr ComponentId MAX_COMPONENTS = 64;
+
+/**
+ * @brief 类型擦除后的组件信息，原型按它在块内布局与搬移组件
+ */
+struct ComponentInfo {
+	size_t size = 0;
+	size_t alignment = 1;
+	void (*move_construct)(void *dst, void *src) = nullptr; ///< @brief 在 dst 处移动构造 src
+	void (*destroy)(void *ptr) = nullptr;
+	const char *name = nullptr;
+
+	template <typename T>
+	static ComponentInfo of(const char *name) {
+		static_assert(std::is_nothrow_move_constructible_v<T>, "Components must be nothrow move constructible.");
+		return {
+			sizeof(T),
+			alignof(T),
+			[](void *dst, void *src) { ::new (dst) T(std::move(*static_cast<T *>(src))); },
+			[](void *ptr) { static_cast<T *>(ptr)->~T(); },
+			name,
+		};
+	}
+};
+
+/**
+ * @brief 全局组件注册表。每种组件类型首次使用时分配一个从 0 开始的 ID
+ */
+class ComponentRegistry final {
+public:
+	static ComponentId registerComponent(const ComponentInfo &info); ///< @brief 超过 MAX_COMPONENTS 时抛出 std::runtime_error
+	static const ComponentInfo &getInfo(ComponentId id);
+	static ComponentId getCount();
+};
+
+/// @brief 获取组件类型的 ID，同一类型在整个程序中只注册一次
+template <typename T>
+ComponentId getComponentId() {
+	static const ComponentId id = ComponentRegistry::registerComponent(ComponentInfo::of<T>(typeid(T).name()));
+	return id;
+}
+
+template <typename T>
+ComponentMask getComponentMask() {
+	return ComponentMask{ 1 } << getComponentId<T>();
+}
+
+} // namespace engine::ecs
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include "../nav/nav_grid.h"
+#include "../render/sprite.h"
+
+namespace engine::ecs {
+
+/// @brief 世界坐标位置。previous 为上一个固定步的位置，渲染时按插值系数混合
+struct Position {
+	glm::vec2 value = glm::vec2(0.0f);
+	glm::vec2 previous = glm::vec2(0.0f);
+};
+
+/// @brief 速度（像素/秒）
+struct Velocity {
+	glm::vec2 value = glm::vec2(0.0f);
+};
+
+/// @brief 可绘制的精灵
+struct SpriteComponent {
+	engine::render::Sprite sprite;
+	glm::vec2 scale = glm::vec2(1.0f);
+	float angle = 0.0f;
+	int layer = 0; ///< @brief 相对于实体绘制基准层的偏移
+};
+
+/**
+ * @brief 正在播放的动画片段（8 字节）
+ *
+ * 帧矩形与帧时长存放在 AnimationLibrary 的扁平表中，AnimationSystem 每帧批量推进并把当前帧写入 SpriteComponent 的源矩形。
+ * 切换片段时把 frame 与 time 清零即可。
+ */
+struct Animation {
+	Uint16 clip = 0; ///< @brief AnimationLibrary 中的片段下标
+	Uint16 frame = 0; ///< @brief 片段内的当前帧
+	float time = 0.0f; ///< @brief 当前帧已播放的时间（秒）
+};
+static_assert(sizeof(Animation) == 8);
+
+/// @brief 与瓦片碰撞网格交互的碰撞体，由 TileCollisionSystem 代替 MovementSystem 积分位置
+struct TileBody {
+	glm::vec2 offset = glm::vec2(0.0f); ///< @brief 碰撞框相对 Position 的偏移
+	glm::vec2 size = glm::vec2(0.0f);
+	float gravity_scale = 1.0f; ///< @brief 0 表示不受重力
+	bool drop_through = false; ///< @brief 输入：穿过单向平台
+	bool climbing = false; ///< @brief 输入：攀爬梯子（不受重力）
+	bool on_ground = false; ///< @brief 以下为上一步的接触状态
+	bool on_slope = false;
+	bool on_ladder = false;
+	bool hit_wall = false;
+	bool hit_ceiling = false;
+	bool in_hazard = false;
+};
+
+/// @brief 参与角色间碰撞宽相的碰撞框，layer / mask 取值见 engine::physics::CollisionLayer
+struct Collider {
+	glm::vec2 offset = glm::vec2(0.0f); ///< @brief 碰撞框相对 Position 的偏移
+	glm::vec2 size = glm::vec2(0.0f);
+	Uint32 layer = 0;
+	Uint32 mask = 0;
+};
+
+/// @brief 沿流场追踪目标的单位，由 NavigationSystem 按所在格子的方向设置速度
+struct NavAgent {
+	engine::nav::NavLayer layer = engine::nav::NavLayer::Walking;
+	float speed = 40.0f; ///< @brief 像素/秒
+	glm::vec2 center = glm::vec2(0.0f); ///< @brief 采样流场的点相对 Position 的偏移（通常为碰撞框中心）
+};
+
+} // namespace engine::ecs
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::ecs {
+
+/**
+ * @brief 实体 ID：指向 World 实体记录数组的代际索引
+ *
+ * 实体销毁后记录的代数递增，旧 ID 随之失效，不会误指向复用该槽位的新实体。
+ */
+struct Entity {
+	static constexpr Uint32 INVALID_INDEX = 0xFFFFFFFFu;
+
+	Uint32 index = INVALID_INDEX; ///< @brief 实体记录索引
+	Uint32 generation = 0; ///< @brief 记录代数，实体销毁时递增
+
+	[[nodiscard]] bool isValid() const { return index != INVALID_INDEX; }
+
+	bool operator==(const Entity &other) const = default;
+};
+
+} // namespace engine::ecs
@@ -0,0 +1,227 @@
+#include "systems.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include "../debug/profiler.h"
+#include "../nav/flow_field.h"
+#include "../physics/tile_collision_grid.h"
+#include "../render/animation_library.h"
+#include "../render/camera.h"
+#include "../render/renderer.h"
+
+namespace engine::ecs {
+
+void PositionSnapshotSystem::update() {
+	PROFILE_SCOPE("PositionSnapshotSystem::update");
+	query.forEachChunk([](std::span<const Entity>, std::span<Position> positions) {
+		for (Position &position : positions) {
+			position.previous = position.value;
+		}
+	});
+}
+
+void MovementSystem::update(float fixed_delta_time) {
+	PROFILE_SCOPE("MovementSystem::update");
+	query.forEachChunk([fixed_delta_time](std::span<const Entity> entities, std::span<Position> positions, std::span<Velocity> velocities) {
+		for (size_t i = 0; i < entities.size(); ++i) {
+			positions[i].value += velocities[i].value * fixed_delta_time;
+		}
+	});
+}
+
+void TileCollisionSystem::update(float fixed_delta_time) {
+	PROFILE_SCOPE("TileCollisionSystem::update");
+	query.forEachChunk([this, fixed_delta_time](std::span<const Entity> entities, std::span<Position> positions, std::span<Velocity> velocities, std::span<TileBody> bodies) {
+		for (size_t i = 0; i < entities.size(); ++i) {
+			TileBody &body = bodies[i];
+			glm::vec2 &velocity = velocities[i].value;
+			if (!body.climbing) {
+				velocity.y = std::min(velocity.y + gravity * body.gravity_scale * fixed_delta_time, max_fall_speed);
+			}
+
+			engine::physics::TileMoveOptions options;
+			options.was_on_ground = body.on_ground;
+			options.drop_through = body.drop_through;
+			options.climbing = body.climbing;
+			engine::physics::TileMoveResult result = grid->move({ positions[i].value + body.offset, body.size }, velocity * fixed_delta_time, options);
+
+			positions[i].value = result.position - body.offset;
+			if ((result.on_ground && velocity.y > 0.0f) || (result.hit_ceiling && velocity.y < 0.0f)) {
+				velocity.y = 0.0f;
+			}
+			if (result.hit_left || result.hit_right) {
+				velocity.x = 0.0f;
+			}
+			body.on_ground = result.on_ground;
+			body.on_slope = result.on_slope;
+			body.on_ladder = result.on_ladder;
+			body.hit_wall = result.hit_left || result.hit_right;
+			body.hit_ceiling = result.hit_ceiling;
+			body.in_hazard = result.in_hazard;
+		}
+	});
+}
+
+glm::vec2 NavigationSystem::sample(const NavAgent &agent, const glm::vec2 &position) const {
+	const engine::nav::FlowField *field = fields[static_cast<size_t>(agent.layer)];
+	return field ? field->sampleDirection(position + agent.center) : glm::vec2(0.0f);
+}
+
+void NavigationSystem::update() {
+	PROFILE_SCOPE("NavigationSystem::update");
+	walkers.forEachChunk([this](std::span<const Entity> entities, std::span<Position> positions, std::span<Velocity> velocities, std::span<NavAgent> agents, std::span<TileBody> bodies) {
+		for (size_t i = 0; i < entities.size(); ++i) {
+			const NavAgent &agent = agents[i];
+			const glm::vec2 direction = sample(agent, positions[i].value);
+			TileBody &body = bodies[i];
+			glm::vec2 &velocity = velocities[i].value;
+			velocity.x = direction.x * agent.speed;
+			const bool climbing = body.on_ladder && direction.x == 0.0f && direction.y != 0.0f;
+			if (climbing) {
+				velocity.y = direction.y * agent.speed;
+			} else if (body.climbing) {
+				velocity.y = 0.0f; // 离开梯子，交还给重力
+			}
+			body.climbing = climbing;
+			body.drop_through = climbing && direction.y > 0.0f;
+		}
+	});
+	flyers.forEachChunk([this](std::span<const Entity> entities, std::span<Position> positions, std::span<Velocity> velocities, std::span<NavAgent> agents) {
+		for (size_t i = 0; i < entities.size(); ++i) {
+			velocities[i].value = sample(agents[i], positions[i].value) * agents[i].speed;
+		}
+	});
+}
+
+void BroadPhaseSystem::update() {
+	PROFILE_SCOPE("BroadPhaseSystem::update");
+	spatial_hash.clear();
+	proxy_entities.clear();
+	query.forEachChunk([this](std::span<const Entity> entities, std::span<Position> positions, std::span<Collider> colliders) {
+		for (size_t i = 0; i < entities.size(); ++i) {
+			const Collider &collider = colliders[i];
+			spatial_hash.insert({ positions[i].value + collider.offset, collider.size }, collider.layer, collider.mask);
+			proxy_entities.push_back(entities[i]);
+		}
+	});
+	spatial_hash.build();
+
+	proxy_pairs.clear();
+	spatial_hash.findPairs(proxy_pairs);
+	pairs.clear();
+	for (const engine::physics::BroadPhasePair &pair : proxy_pairs) {
+		pairs.push_back({ proxy_entities[pair.first], proxy_entities[pair.second] });
+	}
+}
+
+void AnimationSystem::update(float delta_time) {
+	PROFILE_SCOPE("AnimationSystem::update");
+	const std::span<const engine::render::AnimationClip> clips = library.getClips();
+	const SDL_FRect *frame_rects = library.getFrameRects().data();
+	const float *frame_durations = library.getFrameDurations().data();
+	auto advance = [delta_time, clips, frame_rects, frame_durations](std::span<Animation> animations, std::span<SpriteComponent> sprites) {
+		for (size_t i = 0; i < animations.size(); ++i) {
+			Animation &animation = animations[i];
+			if (animation.clip >= clips.size()) {
+				continue;
+			}
+			const engine::render::AnimationClip &clip = clips[animation.clip];
+			const float *durations = frame_durations + clip.first_frame;
+			Uint16 frame = animation.frame < clip.frame_count ? animation.frame : 0;
+			float time = animation.time + delta_time;
+
+			// 超过整段时长的部分先整段折叠掉，保证下面的循环次数不超过帧数
+			if (time >= clip.duration) {
+				if (clip.loop) {
+					time = std::fmod(time, clip.duration);
+				} else {
+					frame = static_cast<Uint16>(clip.frame_count - 1);
+					time = 0.0f;
+				}
+			}
+			while (time >= durations[frame]) {
+				time -= durations[frame];
+				if (++frame == clip.frame_count) {
+					if (!clip.loop) {
+						frame = static_cast<Uint16>(clip.frame_count - 1);
+						time = 0.0f;
+						break;
+					}
+					frame = 0;
+				}
+			}
+
+			// 片段可能在外部被切换，因此总是写回源矩形（16 字节，比判断是否变化更便宜）
+			animation.frame = frame;
+			animation.time = time;
+			sprites[i].sprite.setSourceRect(frame_rects[clip.first_frame + frame]);
+		}
+	};
+
+	if (job_system) {
+		query.parallelForEachChunk(*job_system, [&advance](size_t, std::span<const Entity>, std::span<Animation> animations, std::span<SpriteComponent> sprites) {
+			advance(animations, sprites);
+		});
+	} else {
+		query.forEachChunk([&advance](std::span<const Entity>, std::span<Animation> animations, std::span<SpriteComponent> sprites) {
+			advance(animations, sprites);
+		});
+	}
+}
+
+void SpriteRenderSystem::draw(engine::render::Renderer &renderer, const engine::render::Camera &camera, int base_layer, float alpha) {
+	PROFILE_SCOPE("SpriteRenderSystem::draw");
+	const size_t count = query.count();
+	xs.resize(count);
+	ys.resize(count);
+	widths.resize(count);
+	heights.resize(count);
+	sprite_refs.resize(count);
+
+	// 1. 插值并写入 SoA 缓冲（无副作用，可并行）。没有源矩形的精灵尺寸未知，给一个极大的尺寸使其只按左上角裁剪
+	auto prepare = [&](size_t first_entity, std::span<Position> positions, std::span<SpriteComponent> sprites) {
+		for (size_t i = 0; i < positions.size(); ++i) {
+			size_t index = first_entity + i;
+			glm::vec2 position = glm::mix(positions[i].previous, positions[i].value, alpha);
+			const SpriteComponent &sprite = sprites[i];
+			const auto &source = sprite.sprite.getSourceRect();
+			xs[index] = position.x;
+			ys[index] = position.y;
+			widths[index] = source ? source->w * sprite.scale.x : std::numeric_limits<float>::max();
+			heights[index] = source ? source->h * sprite.scale.y : std::numeric_limits<float>::max();
+			sprite_refs[index] = &sprite;
+		}
+	};
+	if (job_system) {
+		query.parallelForEachChunk(*job_system, [&prepare](size_t first_entity, std::span<const Entity>, std::span<Position> positions, std::span<SpriteComponent> sprites) {
+			prepare(first_entity, positions, sprites);
+		});
+	} else {
+		size_t first_entity = 0;
+		query.forEachChunk([&](std::span<const Entity> entities, std::span<Position> positions, std::span<SpriteComponent> sprites) {
+			prepare(first_entity, positions, sprites);
+			first_entity += entities.size();
+		});
+	}
+
+	// 2. 批量相机变换与视口裁剪
+	size_t visible = camera.cullToScreen({ xs, ys, widths, heights, {}, {} }, visible_indices, screen_rects);
+
+	// 3. 按遍历顺序提交可见精灵（Renderer 不是线程安全的）
+	for (size_t v = 0; v < visible; ++v) {
+		Uint32 index = visible_indices[v];
+		const SpriteComponent &sprite = *sprite_refs[index];
+		renderer.setLayer(base_layer + sprite.layer);
+		if (sprite.sprite.getSourceRect()) {
+			renderer.drawSpriteScreen(sprite.sprite, screen_rects[v], sprite.angle);
+		} else {
+			renderer.drawSprite(camera, sprite.sprite, glm::vec2(xs[index], ys[index]), sprite.scale, sprite.angle);
+		}
+	}
+}
+
+} // namespace engine::ecs
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <vector>
+
+#include "../physics/spatial_hash.h"
+#include "components.h"
+#include "world.h"
+
+namespace engine::render {
+class AnimationLibrary;
+class Camera;
+class Renderer;
+} // namespace engine::render
+
+namespace engine::physics {
+class TileCollisionGrid;
+}
+
+namespace engine::nav {
+class FlowField;
+}
+
+
+namespace engine::ecs {
+
+/// @brief 在每个固定步开始时记录位置快照，供渲染插值使用
+class PositionSnapshotSystem final {
+private:
+	Query<Position> query;
+
+public:
+	explicit PositionSnapshotSystem(World &world) :
+			query(world) {}
+	void update();
+};
+
+/// @brief 按速度积分位置（固定步长），带 TileBody 的实体由 TileCollisionSystem 处理
+class MovementSystem final {
+private:
+	Query<Position, Velocity> query;
+
+public:
+	explicit MovementSystem(World &world) :
+			query(world) { query.exclude<TileBody>(); }
+	void update(float fixed_delta_time);
+};
+
+/// @brief 施加重力并通过瓦片碰撞网格移动 TileBody 实体（固定步长）
+class TileCollisionSystem final {
+private:
+	Query<Position, Velocity, TileBody> query;
+	const engine::physics::TileCollisionGrid *grid = nullptr;
+	float gravity = 980.0f; ///< @brief 像素/秒²
+	float max_fall_speed = 500.0f;
+
+public:
+	/// @param grid 碰撞网格，生命周期需长于本系统
+	TileCollisionSystem(World &world, const engine::physics::TileCollisionGrid &grid, float gravity = 980.0f, float max_fall_speed = 500.0f) :
+			query(world), grid(&grid), gravity(gravity), max_fall_speed(max_fall_speed) {}
+	void update(float fixed_delta_time);
+};
+
+/**
+ * @brief 按流场设置 NavAgent 的速度（固定步长，在碰撞与移动之前执行）
+ *
+ * 每个单位只查一次所在格子的方向，开销与单位数量成正比，与目标距离和地图大小无关。
+ * 行走单位（带 TileBody）只设置水平速度，竖直方向交给重力；流场指向上下且位于梯子上时切换为攀爬。
+ * 飞行单位直接按方向设置速度。对应图层没有流场时单位停下。
+ */
+class NavigationSystem final {
+private:
+	Query<Position, Velocity, NavAgent, TileBody> walkers;
+	Query<Position, Velocity, NavAgent> flyers;
+	const engine::nav::FlowField *fields[engine::nav::NAV_LAYER_COUNT] = {};
+
+public:
+	/// @param walking / flying 两个图层的流场，可以为空，生命周期需长于本系统
+	NavigationSystem(World &world, const engine::nav::FlowField *walking, const engine::nav::FlowField *flying) :
+			walkers(world), flyers(world), fields{ walking, flying } { flyers.exclude<TileBody>(); }
+	void update();
+
+private:
+	glm::vec2 sample(const NavAgent &agent, const glm::vec2 &position) const;
+};
+
+/// @brief 候选碰撞实体对，供窄相与游戏逻辑使用
+struct CollisionPair {
+	Entity first;
+	Entity second;
+};
+
+/// @brief 每个固定步用空间哈希重建 Collider 的宽相，输出去重后的候选碰撞对
+class BroadPhaseSystem final {
+private:
+	Query<Position, Collider> query;
+	engine::physics::SpatialHash spatial_hash;
+	std::vector<Entity> proxy_entities; ///< @brief 代理索引 -> 实体
+	std::vector<engine::physics::BroadPhasePair> proxy_pairs;
+	std::vector<CollisionPair> pairs;
+
+public:
+	explicit BroadPhaseSystem(World &world, float cell_size = 16.0f) :
+			query(world), spatial_hash(cell_size) {}
+	void update();
+
+	const std::vector<CollisionPair> &getPairs() const { return pairs; }
+	const engine::physics::SpatialHash &getSpatialHash() const { return spatial_hash; }
+	Entity getProxyEntity(Uint32 proxy) const { return proxy_entities[proxy]; } ///< @brief 将 SpatialHash::query 的结果映射回实体
+};
+
+/**
+ * @brief 批量推进所有动画并更新精灵的源矩形，提供 JobSystem 时按块并行
+ *
+ * 每个实体只读写 8 字节的 Animation 与精灵的源矩形，片段数据只读地共享自 AnimationLibrary，更新过程不分配内存。
+ */
+class AnimationSystem final {
+private:
+	Query<Animation, SpriteComponent> query;
+	const engine::render::AnimationLibrary &library;
+	engine::core::JobSystem *job_system = nullptr;
+
+public:
+	AnimationSystem(World &world, const engine::render::AnimationLibrary &library, engine::core::JobSystem *job_system = nullptr) :
+			query(world), library(library), job_system(job_system) {}
+	void update(float delta_time);
+};
+
+/**
+ * @brief 在两次固定步之间插值位置并提交精灵绘制
+ *
+ * 插值按块并行写入 SoA 缓冲（提供 JobSystem 时），再由 Camera::cullToScreen 一次完成
+ * 相机变换与视口裁剪，最后按遍历顺序只为可见精灵解析纹理并提交，绘制顺序与单线程一致。
+ */
+class SpriteRenderSystem final {
+private:
+	Query<Position, SpriteComponent> query;
+	engine::core::JobSystem *job_system = nullptr;
+
+	// 按查询遍历顺序排列的 SoA 缓冲，跨帧复用容量
+	std::vector<float> xs;
+	std::vector<float> ys;
+	std::vector<float> widths;
+	std::vector<float> heights;
+	std::vector<const SpriteComponent *> sprite_refs;
+	std::vector<Uint32> visible_indices;
+	std::vector<SDL_FRect> screen_rects;
+
+public:
+	explicit SpriteRenderSystem(World &world, engine::core::JobSystem *job_system = nullptr) :
+			query(world), job_system(job_system) {}
+
+	/**
+	 * @brief 绘制所有精灵实体
+	 *
+	 * @param base_layer 实体绘制的基准层，SpriteComponent::layer 为相对偏移。
+	 * @param alpha 固定步插值系数，见 Time::getInterpolationAlpha()。
+	 */
+	void draw(engine::render::Renderer &renderer, const engine::render::Camera &camera, int base_layer, float alpha);
+};
+
+} // namespace engine::ecs
@@ -0,0 +1,145 @@
+#include "world.h"
+
+#include <spdlog/spdlog.h>
+
+namespace engine::ecs {
+
+World::World() {
+	empty_archetype = getOrCreateArchetype(0);
+}
+
+World::~World() {
+	clear();
+}
+
+Archetype *World::getOrCreateArchetype(ComponentMask mask) {
+	auto it = archetype_lookup.find(mask);
+	if (it != archetype_lookup.end()) {
+		return it->second;
+	}
+	archetypes.push_back(std::make_unique<Archetype>(mask, &chunk_pool));
+	Archetype *archetype = archetypes.back().get();
+	archetype_lookup.emplace(mask, archetype);
+	spdlog::trace("ECS: created archetype {:#x} ({} per chunk).", mask, archetype->getChunkCapacity());
+	return archetype;
+}
+
+Entity World::allocateEntity() {
+	if (!free_indices.empty()) {
+		Uint32 index = free_indices.back();
+		free_indices.pop_back();
+		return { index, records[index].generation };
+	}
+	records.emplace_back();
+	return { static_cast<Uint32>(records.size() - 1), records.back().generation };
+}
+
+void World::placeEntity(Entity entity, Archetype *archetype) {
+	EntityRecord &record = records[entity.index];
+	record.archetype = archetype;
+	record.location = archetype->allocate(entity);
+}
+
+void World::onEntityMoved(Entity moved, Archetype::Location location) {
+	if (moved.isValid()) {
+		records[moved.index].location = location;
+	}
+}
+
+Entity World::create() {
+	Entity entity = allocateEntity();
+	placeEntity(entity, empty_archetype);
+	return entity;
+}
+
+void World::destroy(Entity entity) {
+	if (!isAlive(entity)) {
+		return;
+	}
+	EntityRecord &record = records[entity.index];
+	Archetype::Location location = record.location;
+	Archetype *archetype = record.archetype;
+	record.archetype = nullptr;
+	++record.generation; // 旧 ID 失效
+	free_indices.push_back(entity.index);
+	onEntityMoved(archetype->remove(location), location);
+}
+
+bool World::isAlive(Entity entity) const {
+	return entity.index < records.size() && records[entity.index].archetype && records[entity.index].generation == entity.generation;
+}
+
+void World::clear() {
+	for (Uint32 index = 0; index < records.size(); ++index) {
+		if (records[index].archetype) {
+			destroy({ index, records[index].generation });
+		}
+	}
+}
+
+void World::moveEntity(Entity entity, Archetype *target) {
+	EntityRecord &record = records[entity.index];
+	Archetype *source = record.archetype;
+	Archetype::Location old_location = record.location;
+	Archetype::Location new_location = target->allocate(entity);
+
+	for (ComponentId id : source->getComponentIds()) {
+		const ComponentInfo &info = ComponentRegistry::getInfo(id);
+		void *src = source->getComponent(old_location, id);
+		if (target->hasComponent(id)) {
+			info.move_construct(target->getComponent(new_location, id), src);
+		}
+		info.destroy(src);
+	}
+
+	record.archetype = target;
+	record.location = new_location;
+	onEntityMoved(source->fillHole(old_location), old_location);
+}
+
+void *World::addComponent(Entity entity, ComponentId id, void *value) {
+	if (!isAlive(entity)) {
+		return nullptr;
+	}
+	const ComponentInfo &info = ComponentRegistry::getInfo(id);
+	EntityRecord &record = records[entity.index];
+	if (void *existing = record.archetype->getComponent(record.location, id)) {
+		info.destroy(existing);
+		info.move_construct(existing, value);
+		return existing;
+	}
+
+	Archetype *source = record.archetype;
+	Archetype *target = source->getAddEdge(id);
+	if (!target) {
+		target = getOrCreateArchetype(source->getMask() | (ComponentMask{ 1 } << id));
+		source->setAddEdge(id, target);
+	}
+	moveEntity(entity, target);
+	void *component = target->getComponent(records[entity.index].location, id);
+	info.move_construct(component, value);
+	return component;
+}
+
+void World::removeComponent(Entity entity, ComponentId id) {
+	if (!isAlive(entity) || !records[entity.index].archetype->hasComponent(id)) {
+		return;
+	}
+	Archetype *source = records[entity.index].archetype;
+	Archetype *target = source->getRemoveEdge(id);
+	if (!target) {
+		target = getOrCreateArchetype(source->getMask() & ~(ComponentMask{ 1 } << id));
+		source->setRemoveEdge(id, target);
+	}
+	moveEntity(entity, target);
+}
+
+void *World::getComponent(Entity entity, ComponentId id) const {
+	if (!isAlive(entity)) {
+		return nullptr;
+	}
+	const EntityRecord &record = records[entity.index];
+	return record.archetype->getComponent(record.location, id);
+}
+
+} // namespace engine::ecs
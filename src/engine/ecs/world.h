@@ -0,0 +1,243 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../core/job_system.h"
+#include "archetype.h"
+#include "component.h"
+#include "entity.h"
+
+namespace engine::ecs {
+
+class World;
+
+/**
+ * @brief 组件查询：缓存所有包含 Ts... 的原型，按块线性遍历各组件列。
+ *
+ * 原型只增不减，查询在每次遍历前只检查新增的原型，因此可以作为系统的成员长期持有，
+ * 遍历过程本身不产生分配。遍历期间不允许直接修改实体的组件集合，请使用 CommandBuffer。
+ */
+template <typename... Ts>
+class Query final {
+	static_assert(sizeof...(Ts) > 0, "A query needs at least one component.");
+
+private:
+	World *world = nullptr;
+	ComponentMask required = 0;
+	ComponentMask excluded = 0;
+	std::vector<Archetype *> matches;
+	size_t scanned_archetypes = 0;
+
+	struct ChunkRef {
+		Archetype *archetype;
+		const Chunk *chunk;
+		size_t first_entity; ///< @brief 块内第一个实体在整个查询遍历顺序中的序号
+	};
+	std::vector<ChunkRef> chunk_refs; ///< @brief parallelForEachChunk 使用的块列表（复用容量）
+
+public:
+	Query() = default;
+	explicit Query(World &world) :
+			world(&world), required((getComponentMask<Ts>() | ...)) {}
+
+	/// @brief 排除带有 Us... 中任一组件的原型，返回自身以便链式调用
+	template <typename... Us>
+	Query &exclude() {
+		excluded |= (getComponentMask<Us>() | ...);
+		matches.clear();
+		scanned_archetypes = 0;
+		return *this;
+	}
+
+	/// @brief 逐块回调 f(std::span<const Entity>, std::span<Ts>...)
+	template <typename Func>
+	void forEachChunk(Func &&func);
+
+	/**
+	 * @brief 以块为单位并行回调 f(size_t first_entity, std::span<const Entity>, std::span<Ts>...)
+	 *
+	 * first_entity 是块内第一个实体在顺序遍历（forEachChunk）中的序号，可用来写入按实体排列的输出数组。
+	 * 回调在多个线程上同时执行，只能修改本块的组件与自己负责的输出区间。
+	 */
+	template <typename Func>
+	void parallelForEachChunk(engine::core::JobSystem &job_system, Func &&func);
+
+	/// @brief 逐实体回调 f(Ts&...)
+	template <typename Func>
+	void each(Func &&func) {
+		forEachChunk([&func](std::span<const Entity> entities, std::span<Ts>... columns) {
+			for (size_t i = 0; i < entities.size(); ++i) {
+				func(columns[i]...);
+			}
+		});
+	}
+
+	/// @brief 逐实体回调 f(Entity, Ts&...)
+	template <typename Func>
+	void eachWithEntity(Func &&func) {
+		forEachChunk([&func](std::span<const Entity> entities, std::span<Ts>... columns) {
+			for (size_t i = 0; i < entities.size(); ++i) {
+				func(entities[i], columns[i]...);
+			}
+		});
+	}
+
+	size_t count();
+
+private:
+	void refresh();
+};
+
+/**
+ * @brief 实体与组件的容器。
+ *
+ * 同组件集合的实体存放在同一原型的块中（SoA）。实体 ID 带代数，销毁后旧 ID 自动失效。
+ * 添加/移除组件会把实体搬到另一个原型，原型之间的转换关系会被缓存。
+ */
+class World final {
+	template <typename... Ts>
+	friend class Query;
+
+private:
+	struct EntityRecord {
+		Archetype *archetype = nullptr; ///< @brief 为 nullptr 表示槽位空闲
+		Archetype::Location location;
+		Uint32 generation = 1;
+	};
+
+	std::vector<EntityRecord> records;
+	std::vector<Uint32> free_indices;
+	memory::PoolAllocator chunk_pool{ Archetype::CHUNK_BYTES, Archetype::CHUNK_ALIGNMENT, 8 }; ///< @brief 所有原型共用的块池，须先于 archetypes 声明
+	std::vector<std::unique_ptr<Archetype>> archetypes; ///< @brief 只增不减，Query 依赖这一点做增量匹配
+	std::unordered_map<ComponentMask, Archetype *> archetype_lookup;
+	Archetype *empty_archetype = nullptr;
+
+public:
+	World();
+	~World();
+
+	World(const World &) = delete;
+	World &operator=(const World &) = delete;
+	World(World &&) = delete;
+	World &operator=(World &&) = delete;
+
+	Entity create(); ///< @brief 创建一个没有组件的实体
+
+	/// @brief 创建实体并一次性放入最终原型，避免逐个添加组件时的多次搬移
+	template <typename... Ts>
+	Entity create(Ts &&...components);
+
+	void destroy(Entity entity); ///< @brief 销毁实体，已失效的 ID 会被忽略
+	[[nodiscard]] bool isAlive(Entity entity) const;
+	void clear(); ///< @brief 销毁所有实体（保留原型与块内存）
+
+	/// @brief 添加组件，已存在时直接赋值。返回组件地址，实体已失效时返回 nullptr
+	template <typename T>
+	T *add(Entity entity, T component);
+
+	template <typename T>
+	void remove(Entity entity) { removeComponent(entity, getComponentId<T>()); }
+
+	/// @brief 获取组件，实体失效或没有该组件时返回 nullptr
+	template <typename T>
+	[[nodiscard]] T *get(Entity entity) const { return static_cast<T *>(getComponent(entity, getComponentId<T>())); }
+
+	template <typename T>
+	[[nodiscard]] bool has(Entity entity) const { return getComponent(entity, getComponentId<T>()) != nullptr; }
+
+	template <typename... Ts>
+	Query<Ts...> query() { return Query<Ts...>(*this); }
+
+	// --- 类型擦除接口（供 CommandBuffer 使用）---
+	void *addComponent(Entity entity, ComponentId id, void *value); ///< @brief 从 value 移动构造组件（已存在时先析构旧值），返回组件地址
+	void removeComponent(Entity entity, ComponentId id);
+	[[nodiscard]] void *getComponent(Entity entity, ComponentId id) const;
+
+	size_t getEntityCount() const { return records.size() - free_indices.size(); }
+	size_t getArchetypeCount() const { return archetypes.size(); }
+
+private:
+	Archetype *getOrCreateArchetype(ComponentMask mask);
+	Entity allocateEntity();
+	void placeEntity(Entity entity, Archetype *archetype); ///< @brief 在原型中分配一行并更新记录（组件未构造）
+	void moveEntity(Entity entity, Archetype *target); ///< @brief 把共有组件移动到目标原型，丢弃目标中没有的组件
+	void onEntityMoved(Entity moved, Archetype::Location location); ///< @brief fillHole 之后修正被移动实体的记录
+};
+
+// --- 模板实现 ---
+
+template <typename... Ts>
+Entity World::create(Ts &&...components) {
+	Entity entity = allocateEntity();
+	Archetype *archetype = getOrCreateArchetype((getComponentMask<std::decay_t<Ts>>() | ... | ComponentMask{ 0 }));
+	placeEntity(entity, archetype);
+	Archetype::Location location = records[entity.index].location;
+	(::new (archetype->getComponent(location, getComponentId<std::decay_t<Ts>>())) std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+	return entity;
+}
+
+template <typename T>
+T *World::add(Entity entity, T component) {
+	if (T *existing = get<T>(entity)) {
+		*existing = std::move(component);
+		return existing;
+	}
+	return static_cast<T *>(addComponent(entity, getComponentId<T>(), &component));
+}
+
+template <typename... Ts>
+void Query<Ts...>::refresh() {
+	for (; scanned_archetypes < world->archetypes.size(); ++scanned_archetypes) {
+		Archetype *archetype = world->archetypes[scanned_archetypes].get();
+		if ((archetype->getMask() & required) == required && (archetype->getMask() & excluded) == 0) {
+			matches.push_back(archetype);
+		}
+	}
+}
+
+template <typename... Ts>
+template <typename Func>
+void Query<Ts...>::forEachChunk(Func &&func) {
+	refresh();
+	for (Archetype *archetype : matches) {
+		for (const Chunk &chunk : archetype->getChunks()) {
+			func(std::span<const Entity>(chunk.entities, chunk.count), archetype->template getColumn<Ts>(chunk)...);
+		}
+	}
+}
+
+template <typename... Ts>
+template <typename Func>
+void Query<Ts...>::parallelForEachChunk(engine::core::JobSystem &job_system, Func &&func) {
+	refresh();
+	chunk_refs.clear();
+	size_t first_entity = 0;
+	for (Archetype *archetype : matches) {
+		for (const Chunk &chunk : archetype->getChunks()) {
+			chunk_refs.push_back({ archetype, &chunk, first_entity });
+			first_entity += chunk.count;
+		}
+	}
+	job_system.parallelFor(chunk_refs.size(), [this, &func](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const ChunkRef &ref = chunk_refs[i];
+			func(ref.first_entity, std::span<const Entity>(ref.chunk->entities, ref.chunk->count), ref.archetype->template getColumn<Ts>(*ref.chunk)...);
+		}
+	});
+}
+
+template <typename... Ts>
+size_t Query<Ts...>::count() {
+	refresh();
+	size_t total = 0;
+	for (Archetype *archetype : matches) {
+		total += archetype->getEntityCount();
+	}
+	return total;
+}
+
+} // namespace engine::ecs
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+
+#include <SDL3/SDL_stdinc.h>
+#include <glm/vec2.hpp>
+
+namespace engine::input {
+
+/// @brief 按住类输入，每个固定步采样一次状态
+enum InputButton : Uint16 {
+	INPUT_BUTTON_UP = 1u << 0,
+	INPUT_BUTTON_DOWN = 1u << 1,
+	INPUT_BUTTON_LEFT = 1u << 2,
+	INPUT_BUTTON_RIGHT = 1u << 3,
+};
+
+/// @brief 一次鼠标点击
+struct InputClick {
+	glm::vec2 position = glm::vec2(0.0f); ///< @brief 渲染（逻辑）坐标，与窗口大小和缩放无关
+	Uint8 button = 0; ///< @brief SDL_BUTTON_LEFT 等
+};
+
+/**
+ * @brief 一个固定步的输入快照
+ *
+ * 模拟只从快照读取输入，不直接访问 SDL 的事件与键盘状态，因此录制的快照序列可以逐步重放出相同的结果。
+ * 两个固定步之间发生的点击归入下一个固定步。
+ */
+struct InputFrame {
+	static constexpr size_t MAX_CLICKS = 4; ///< @brief 一个固定步内多余的点击被丢弃
+
+	Uint16 buttons = 0; ///< @brief InputButton 位掩码
+	Uint8 click_count = 0;
+	std::array<InputClick, MAX_CLICKS> clicks{};
+
+	bool isDown(InputButton button) const { return (buttons & button) != 0; }
+
+	/// @return 点击已满时返回 false
+	bool addClick(const InputClick &click) {
+		if (click_count >= MAX_CLICKS) {
+			return false;
+		}
+		clicks[click_count++] = click;
+		return true;
+	}
+};
+
+} // namespace engine::input
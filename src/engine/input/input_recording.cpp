@@ -0,0 +1,149 @@
+#include "input_recording.h"
+
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::input {
+
+using namespace recording;
+
+namespace {
+
+template <typename T>
+void append(std::vector<std::byte> &out, const T &value) {
+	const auto *bytes = reinterpret_cast<const std::byte *>(&value);
+	out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T read(const std::vector<std::byte> &data, size_t offset) {
+	T value;
+	std::memcpy(&value, data.data() + offset, sizeof(T));
+	return value;
+}
+
+} // namespace
+
+// --- InputRecorder ---
+
+InputRecorder::InputRecorder(std::string path, int fixed_update_hz) :
+		path(std::move(path)), fixed_update_hz(static_cast<Uint32>(fixed_update_hz > 0 ? fixed_update_hz : 60)) {
+	// 约每秒一次按键变化时，一小时的录制也不需要扩容
+	records.reserve(64 * 1024);
+}
+
+void InputRecorder::record(const InputFrame &frame) {
+	if (frame.buttons != previous_buttons || frame.click_count > 0) {
+		append(records, ChangeRecord{ tick_count, frame.buttons, frame.click_count, 0 });
+		for (Uint8 i = 0; i < frame.click_count; ++i) {
+			const InputClick &click = frame.clicks[i];
+			append(records, ClickRecord{ click.position.x, click.position.y, click.button });
+		}
+		previous_buttons = frame.buttons;
+		++record_count;
+	}
+	++tick_count;
+}
+
+bool InputRecorder::save(Uint64 state_hash) const {
+	Header header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.fixed_update_hz = fixed_update_hz;
+	header.tick_count = tick_count;
+	header.record_count = record_count;
+	header.state_hash = state_hash;
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		spdlog::error("Failed to open input recording '{}' for writing.", path);
+		return false;
+	}
+	file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+	file.write(reinterpret_cast<const char *>(records.data()), static_cast<std::streamsize>(records.size()));
+	if (!file) {
+		spdlog::error("Failed to write input recording '{}'.", path);
+		return false;
+	}
+	spdlog::info("Input recording written to '{}': {} ticks, {} changes, {} bytes.", path, tick_count, record_count, sizeof(Header) + records.size());
+	return true;
+}
+
+// --- InputReplay ---
+
+std::unique_ptr<InputReplay> InputReplay::load(const std::string &path) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		spdlog::error("Failed to open input recording '{}'.", path);
+		return nullptr;
+	}
+	std::unique_ptr<InputReplay> replay(new InputReplay());
+	replay->data.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char *>(replay->data.data()), static_cast<std::streamsize>(replay->data.size()))) {
+		spdlog::error("Failed to read input recording '{}'.", path);
+		return nullptr;
+	}
+
+	const std::vector<std::byte> &data = replay->data;
+	if (data.size() < sizeof(Header)) {
+		spdlog::error("Input recording '{}' is too small.", path);
+		return nullptr;
+	}
+	Header &header = replay->header;
+	header = read<Header>(data, 0);
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.fixed_update_hz == 0) {
+		spdlog::error("Input recording '{}' has an invalid header or version (expected v{}).", path, VERSION);
+		return nullptr;
+	}
+
+	// 加载时完整校验一遍，重放过程中不再做边界检查
+	size_t offset = sizeof(Header);
+	Uint32 next_tick = 0;
+	for (Uint32 i = 0; i < header.record_count; ++i) {
+		if (offset + sizeof(ChangeRecord) > data.size()) {
+			spdlog::error("Input recording '{}' is truncated at record {}.", path, i);
+			return nullptr;
+		}
+		const ChangeRecord record = read<ChangeRecord>(data, offset);
+		offset += sizeof(ChangeRecord) + record.click_count * sizeof(ClickRecord);
+		if (record.tick < next_tick || record.tick >= header.tick_count || record.click_count > InputFrame::MAX_CLICKS || offset > data.size()) {
+			spdlog::error("Input recording '{}' has an invalid record {} (tick {}).", path, i, record.tick);
+			return nullptr;
+		}
+		next_tick = record.tick + 1;
+	}
+	if (offset != data.size()) {
+		spdlog::warn("Input recording '{}' has {} trailing byte(s).", path, data.size() - offset);
+	}
+	spdlog::info("Input recording '{}' loaded: {} ticks at {} Hz, {} changes.", path, header.tick_count, header.fixed_update_hz, header.record_count);
+	return replay;
+}
+
+bool InputReplay::next(InputFrame &frame) {
+	if (isFinished()) {
+		return false;
+	}
+	frame = {};
+	if (records_read < header.record_count) {
+		const ChangeRecord record = read<ChangeRecord>(data, offset);
+		if (record.tick == tick) {
+			offset += sizeof(ChangeRecord);
+			buttons = record.buttons;
+			for (Uint8 i = 0; i < record.click_count; ++i) {
+				const ClickRecord click = read<ClickRecord>(data, offset);
+				offset += sizeof(ClickRecord);
+				frame.addClick({ { click.x, click.y }, static_cast<Uint8>(click.button) });
+			}
+			++records_read;
+		}
+	}
+	frame.buttons = buttons;
+	++tick;
+	return true;
+}
+
+} // namespace engine::input
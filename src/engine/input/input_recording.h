@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "input_frame.h"
+
+namespace engine::input {
+
+/**
+ * @brief 输入录制格式（.inrec）
+ *
+ * 小端序、4 字节对齐。文件以 Header 开头，随后是按固定步编号递增的变化记录：
+ * 只有按键状态改变或有点击的固定步才写入一条 ChangeRecord，后面紧跟 click_count 个 ClickRecord，
+ * 其余固定步沿用上一条记录的按键状态。十分钟的录制通常只有几 KB。
+ */
+namespace recording {
+
+constexpr char MAGIC[4] = { 'S', 'I', 'N', 'P' };
+constexpr Uint32 VERSION = 1;
+
+struct Header {
+	char magic[4];
+	Uint32 version;
+	Uint32 fixed_update_hz; ///< @brief 录制时的固定步频率，重放时必须一致
+	Uint32 tick_count; ///< @brief 录制的固定步总数
+	Uint32 record_count;
+	Uint32 reserved;
+	Uint64 state_hash; ///< @brief 录制结束时的模拟状态哈希，重放结束时用于校验确定性，0 表示未记录
+};
+
+struct ChangeRecord {
+	Uint32 tick;
+	Uint16 buttons;
+	Uint8 click_count;
+	Uint8 reserved;
+};
+
+struct ClickRecord {
+	float x;
+	float y;
+	Uint32 button;
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(ChangeRecord) == 8 && sizeof(ClickRecord) == 12);
+
+} // namespace recording
+
+/**
+ * @brief 把每个固定步的输入快照录制到内存，退出时一次写入文件
+ */
+class InputRecorder final {
+private:
+	std::string path;
+	Uint32 fixed_update_hz;
+	std::vector<std::byte> records;
+	Uint32 tick_count = 0;
+	Uint32 record_count = 0;
+	Uint16 previous_buttons = 0;
+
+public:
+	InputRecorder(std::string path, int fixed_update_hz);
+
+	InputRecorder(const InputRecorder &) = delete;
+	InputRecorder &operator=(const InputRecorder &) = delete;
+	InputRecorder(InputRecorder &&) = delete;
+	InputRecorder &operator=(InputRecorder &&) = delete;
+
+	void record(const InputFrame &frame); ///< @brief 每个固定步调用一次
+	/// @param state_hash 录制结束时的模拟状态哈希，见 GameApp::hashSimulationState()
+	[[nodiscard]] bool save(Uint64 state_hash) const;
+
+	Uint32 getTickCount() const { return tick_count; }
+	const std::string &getPath() const { return path; }
+};
+
+/**
+ * @brief 逐个固定步读出录制的输入快照
+ */
+class InputReplay final {
+private:
+	recording::Header header{};
+	std::vector<std::byte> data;
+	size_t offset = sizeof(recording::Header); ///< @brief 下一条变化记录的位置
+	Uint32 records_read = 0;
+	Uint32 tick = 0;
+	Uint16 buttons = 0;
+
+	InputReplay() = default;
+
+public:
+	/// @brief 读取并校验录制文件，失败时返回 nullptr
+	static std::unique_ptr<InputReplay> load(const std::string &path);
+
+	InputReplay(const InputReplay &) = delete;
+	InputReplay &operator=(const InputReplay &) = delete;
+	InputReplay(InputReplay &&) = delete;
+	InputReplay &operator=(InputReplay &&) = delete;
+
+	/// @brief 取出下一个固定步的输入
+	/// @return 录制已全部重放时返回 false
+	bool next(InputFrame &frame);
+
+	bool isFinished() const { return tick >= header.tick_count; }
+	Uint32 getTick() const { return tick; }
+	Uint32 getTickCount() const { return header.tick_count; }
+	int getFixedUpdateHz() const { return static_cast<int>(header.fixed_update_hz); }
+	Uint64 getStateHash() const { return header.state_hash; }
+};
+
+} // namespace engine::input
@@ -0,0 +1,486 @@
+#include "baked_level.h"
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../resource/asset_archive.h"
+#include "../utils/mapped_file.h"
+#include "tile_map.h"
+
+namespace engine::map {
+
+// 记录按原样写入并原地读取，只支持小端平台
+static_assert(std::endian::native == std::endian::little, "Baked level format requires a little-endian host.");
+
+namespace {
+
+using namespace baked;
+
+class StringTable {
+private:
+	std::vector<char> data;
+	std::unordered_map<std::string, Uint32> offsets;
+
+public:
+	Uint32 add(std::string_view value) {
+		if (value.empty()) {
+			return NO_STRING;
+		}
+		auto it = offsets.find(std::string(value));
+		if (it != offsets.end()) {
+			return it->second;
+		}
+		Uint32 offset = static_cast<Uint32>(data.size());
+		data.insert(data.end(), value.begin(), value.end());
+		data.push_back('\0');
+		offsets.emplace(std::string(value), offset);
+		return offset;
+	}
+
+	const std::vector<char> &getData() const { return data; }
+};
+
+template <typename T>
+void appendSection(std::vector<std::byte> &out, Section &section, const std::vector<T> &records) {
+	static_assert(std::is_trivially_copyable_v<T>);
+	while (out.size() % 4 != 0) {
+		out.push_back(std::byte{ 0 });
+	}
+	section.offset = static_cast<Uint32>(out.size());
+	section.count = static_cast<Uint32>(records.size());
+	const auto *bytes = reinterpret_cast<const std::byte *>(records.data());
+	out.insert(out.end(), bytes, bytes + records.size() * sizeof(T));
+}
+
+// 映射内存的只读视图，所有访问都经过边界与对齐检查
+class BlobView {
+private:
+	const std::byte *data;
+	size_t size;
+
+public:
+	BlobView(const std::byte *data, size_t size) :
+			data(data), size(size) {}
+
+	template <typename T>
+	bool view(const Section &section, std::span<const T> &out) const {
+		size_t bytes = static_cast<size_t>(section.count) * sizeof(T);
+		if (section.offset > size || bytes > size - section.offset || section.offset % alignof(T) != 0) {
+			return false;
+		}
+		out = std::span<const T>(reinterpret_cast<const T *>(data + section.offset), section.count);
+		return true;
+	}
+};
+
+/// @brief 把自定义属性编译为 PropertyRecord 追加到 out，返回起始记录；非标量值无法表示，跳过并警告
+Uint32 addProperties(std::vector<PropertyRecord> &out, StringTable &strings, const nlohmann::json &properties) {
+	Uint32 first = static_cast<Uint32>(out.size());
+	if (!properties.is_object()) {
+		return first;
+	}
+	for (const auto &[name, value] : properties.items()) {
+		PropertyRecord record{};
+		record.name = strings.add(name);
+		if (value.is_boolean()) {
+			record.type = static_cast<Uint32>(PropertyType::Bool);
+			record.value[0] = value.get<bool>() ? 1 : 0;
+		} else if (value.is_number_integer()) {
+			record.type = static_cast<Uint32>(PropertyType::Int);
+			Sint64 number = value.get<Sint64>();
+			std::memcpy(record.value, &number, sizeof(number));
+		} else if (value.is_number_float()) {
+			record.type = static_cast<Uint32>(PropertyType::Float);
+			double number = value.get<double>();
+			std::memcpy(record.value, &number, sizeof(number));
+		} else if (value.is_string()) {
+			record.type = static_cast<Uint32>(PropertyType::String);
+			record.value[0] = strings.add(value.get_ref<const std::string &>());
+		} else {
+			spdlog::warn("Property '{}' is not a scalar and cannot be baked, skipped.", name);
+			continue;
+		}
+		out.push_back(record);
+	}
+	return first;
+}
+
+std::string readString(std::span<const char> strings, Uint32 offset) {
+	if (offset == NO_STRING || offset >= strings.size()) {
+		return {};
+	}
+	const char *begin = strings.data() + offset;
+	const void *end = std::memchr(begin, '\0', strings.size() - offset);
+	return end ? std::string(begin, static_cast<const char *>(end)) : std::string();
+}
+
+/// @brief 由 PropertyRecord 构建属性对象（只拷贝值，不解析文本），区间越界返回 false
+bool readProperties(std::span<const PropertyRecord> records, std::span<const char> strings, Uint32 first, Uint32 count, nlohmann::json &out) {
+	if (first > records.size() || count > records.size() - first) {
+		return false;
+	}
+	out = nlohmann::json::object();
+	for (const auto &record : records.subspan(first, count)) {
+		std::string name = readString(strings, record.name);
+		switch (static_cast<PropertyType>(record.type)) {
+			case PropertyType::Bool:
+				out[name] = record.value[0] != 0;
+				break;
+			case PropertyType::Int: {
+				Sint64 number;
+				std::memcpy(&number, record.value, sizeof(number));
+				out[name] = number;
+				break;
+			}
+			case PropertyType::Float: {
+				double number;
+				std::memcpy(&number, record.value, sizeof(number));
+				out[name] = number;
+				break;
+			}
+			case PropertyType::String:
+				out[name] = readString(strings, record.value[0]);
+				break;
+			default:
+				return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+// --- BakedLevelWriter ---
+
+std::vector<std::byte> BakedLevelWriter::serialize(const TileMap &map) {
+	StringTable strings;
+	std::vector<TilesetRecord> tilesets;
+	std::vector<TileRecord> tiles;
+	std::vector<AnimationFrameRecord> frames;
+	std::vector<TileLayerRecord> tile_layers;
+	std::vector<Uint32> gids;
+	std::vector<ImageLayerRecord> image_layers;
+	std::vector<ObjectLayerRecord> object_layers;
+	std::vector<ObjectRecord> objects;
+	std::vector<LayerOrderRecord> layer_order;
+	std::vector<PropertyRecord> properties;
+
+	for (const auto &tileset : map.tilesets) {
+		TilesetRecord record{};
+		record.name = strings.add(tileset.name);
+		record.firstgid = tileset.firstgid;
+		record.tile_count = tileset.tile_count;
+		record.columns = tileset.columns;
+		record.tile_width = tileset.tile_width;
+		record.tile_height = tileset.tile_height;
+		record.margin = tileset.margin;
+		record.spacing = tileset.spacing;
+		record.image = strings.add(tileset.image);
+		record.first_tile = static_cast<Uint32>(tiles.size());
+		for (const auto &[id, data] : tileset.tiles) {
+			TileRecord tile{};
+			tile.local_id = id;
+			tile.image = strings.add(data.image);
+			tile.image_width = data.image_width;
+			tile.image_height = data.image_height;
+			if (data.hitbox) {
+				tile.has_hitbox = 1;
+				tile.hitbox[0] = data.hitbox->position.x;
+				tile.hitbox[1] = data.hitbox->position.y;
+				tile.hitbox[2] = data.hitbox->size.x;
+				tile.hitbox[3] = data.hitbox->size.y;
+			}
+			tile.first_property = addProperties(properties, strings, data.properties);
+			tile.property_count = static_cast<Uint32>(properties.size()) - tile.first_property;
+			tile.first_frame = static_cast<Uint32>(frames.size());
+			tile.frame_count = static_cast<Uint32>(data.animation.size());
+			for (const auto &frame : data.animation) {
+				frames.push_back({ frame.tile_id, frame.duration_ms });
+			}
+			tiles.push_back(tile);
+		}
+		record.tile_record_count = static_cast<Uint32>(tiles.size()) - record.first_tile;
+		tilesets.push_back(record);
+	}
+
+	for (const auto &layer : map.tile_layers) {
+		TileLayerRecord record{};
+		record.name = strings.add(layer.name);
+		record.width = layer.width;
+		record.height = layer.height;
+		record.offset[0] = layer.offset.x;
+		record.offset[1] = layer.offset.y;
+		record.opacity = layer.opacity;
+		record.visible = layer.visible ? 1 : 0;
+		record.first_gid = static_cast<Uint32>(gids.size());
+		gids.insert(gids.end(), layer.gids.begin(), layer.gids.end());
+		tile_layers.push_back(record);
+	}
+
+	for (const auto &layer : map.image_layers) {
+		ImageLayerRecord record{};
+		record.name = strings.add(layer.name);
+		record.image = strings.add(layer.image);
+		record.offset[0] = layer.offset.x;
+		record.offset[1] = layer.offset.y;
+		record.parallax[0] = layer.parallax.x;
+		record.parallax[1] = layer.parallax.y;
+		record.repeat_x = layer.repeat.x ? 1 : 0;
+		record.repeat_y = layer.repeat.y ? 1 : 0;
+		record.opacity = layer.opacity;
+		record.visible = layer.visible ? 1 : 0;
+		image_layers.push_back(record);
+	}
+
+	for (const auto &layer : map.object_layers) {
+		ObjectLayerRecord record{};
+		record.name = strings.add(layer.name);
+		record.visible = layer.visible ? 1 : 0;
+		record.first_object = static_cast<Uint32>(objects.size());
+		for (const auto &object : layer.objects) {
+			ObjectRecord object_record{};
+			object_record.id = object.id;
+			object_record.name = strings.add(object.name);
+			object_record.type = strings.add(object.type);
+			object_record.gid = object.gid;
+			object_record.position[0] = object.position.x;
+			object_record.position[1] = object.position.y;
+			object_record.size[0] = object.size.x;
+			object_record.size[1] = object.size.y;
+			object_record.rotation = object.rotation;
+			object_record.visible = object.visible ? 1 : 0;
+			object_record.point = object.point ? 1 : 0;
+			object_record.first_property = addProperties(properties, strings, object.properties);
+			object_record.property_count = static_cast<Uint32>(properties.size()) - object_record.first_property;
+			objects.push_back(object_record);
+		}
+		record.object_count = static_cast<Uint32>(objects.size()) - record.first_object;
+		object_layers.push_back(record);
+	}
+
+	for (const auto &layer_ref : map.layer_order) {
+		layer_order.push_back({ static_cast<Uint32>(layer_ref.type), static_cast<Uint32>(layer_ref.index) });
+	}
+
+	std::vector<TileProperties> tile_properties(map.tile_properties.begin(), map.tile_properties.end());
+
+	Header header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.width = map.width;
+	header.height = map.height;
+	header.tile_width = map.tile_width;
+	header.tile_height = map.tile_height;
+
+	std::vector<std::byte> out(sizeof(Header));
+	appendSection(out, header.strings, strings.getData());
+	appendSection(out, header.tilesets, tilesets);
+	appendSection(out, header.tiles, tiles);
+	appendSection(out, header.animation_frames, frames);
+	appendSection(out, header.tile_properties, tile_properties);
+	appendSection(out, header.tile_layers, tile_layers);
+	appendSection(out, header.gids, gids);
+	appendSection(out, header.image_layers, image_layers);
+	appendSection(out, header.object_layers, object_layers);
+	appendSection(out, header.objects, objects);
+	appendSection(out, header.layer_order, layer_order);
+	appendSection(out, header.properties, properties);
+	header.file_size = static_cast<Uint32>(out.size());
+	std::memcpy(out.data(), &header, sizeof(Header));
+	return out;
+}
+
+bool BakedLevelWriter::write(const TileMap &map, const std::string &output_path) {
+	std::vector<std::byte> blob = serialize(map);
+	std::ofstream file(output_path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		spdlog::error("Failed to open '{}' for writing.", output_path);
+		return false;
+	}
+	file.write(reinterpret_cast<const char *>(blob.data()), static_cast<std::streamsize>(blob.size()));
+	if (!file) {
+		spdlog::error("Failed to write baked level '{}'.", output_path);
+		return false;
+	}
+	spdlog::debug("Baked level written to '{}' ({} bytes).", output_path, blob.size());
+	return true;
+}
+
+// --- BakedLevelLoader ---
+
+std::unique_ptr<TileMap> BakedLevelLoader::load(const std::string &path, const engine::resource::AssetArchive *archive) {
+	// 资源包中的关卡直接引用包的映射（数据块 16 字节对齐），否则单独映射文件
+	std::shared_ptr<const engine::utils::MappedFile> file;
+	std::span<const std::byte> data;
+	if (const engine::resource::pak::EntryRecord *entry = archive ? archive->find(path) : nullptr) {
+		file = archive->getBackingFile();
+		data = archive->getStoredBytes(*entry);
+	} else {
+		auto mapped = std::make_shared<engine::utils::MappedFile>();
+		if (!mapped->open(path)) {
+			return nullptr;
+		}
+		data = { mapped->getData(), mapped->getSize() };
+		file = std::move(mapped);
+	}
+	if (data.size() < sizeof(Header)) {
+		spdlog::error("Baked level '{}' is too small.", path);
+		return nullptr;
+	}
+
+	Header header;
+	std::memcpy(&header, data.data(), sizeof(Header));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.file_size != data.size()) {
+		spdlog::error("Baked level '{}' has an invalid header or version (expected v{}).", path, VERSION);
+		return nullptr;
+	}
+
+	BlobView blob(data.data(), data.size());
+	std::span<const char> strings;
+	std::span<const TilesetRecord> tileset_records;
+	std::span<const TileRecord> tile_records;
+	std::span<const AnimationFrameRecord> frame_records;
+	std::span<const TileProperties> tile_properties;
+	std::span<const TileLayerRecord> tile_layer_records;
+	std::span<const Uint32> gids;
+	std::span<const ImageLayerRecord> image_layer_records;
+	std::span<const ObjectLayerRecord> object_layer_records;
+	std::span<const ObjectRecord> object_records;
+	std::span<const LayerOrderRecord> order_records;
+	std::span<const PropertyRecord> property_records;
+	if (!blob.view(header.strings, strings) || !blob.view(header.tilesets, tileset_records) || !blob.view(header.tiles, tile_records) ||
+			!blob.view(header.animation_frames, frame_records) || !blob.view(header.tile_properties, tile_properties) ||
+			!blob.view(header.tile_layers, tile_layer_records) || !blob.view(header.gids, gids) ||
+			!blob.view(header.image_layers, image_layer_records) || !blob.view(header.object_layers, object_layer_records) ||
+			!blob.view(header.objects, object_records) || !blob.view(header.layer_order, order_records) ||
+			!blob.view(header.properties, property_records)) {
+		spdlog::error("Baked level '{}' has a corrupt section table.", path);
+		return nullptr;
+	}
+
+	auto map = std::make_unique<TileMap>();
+	map->path = path;
+	map->width = header.width;
+	map->height = header.height;
+	map->tile_width = header.tile_width;
+	map->tile_height = header.tile_height;
+
+	for (const auto &record : tileset_records) {
+		Tileset tileset;
+		tileset.name = readString(strings, record.name);
+		tileset.firstgid = record.firstgid;
+		tileset.tile_count = record.tile_count;
+		tileset.columns = record.columns;
+		tileset.tile_width = record.tile_width;
+		tileset.tile_height = record.tile_height;
+		tileset.margin = record.margin;
+		tileset.spacing = record.spacing;
+		tileset.image = readString(strings, record.image);
+		if (record.first_tile > tile_records.size() || record.tile_record_count > tile_records.size() - record.first_tile) {
+			spdlog::error("Baked level '{}' has an out of range tile table.", path);
+			return nullptr;
+		}
+		for (const auto &tile : tile_records.subspan(record.first_tile, record.tile_record_count)) {
+			TileData data;
+			data.image = readString(strings, tile.image);
+			data.image_width = tile.image_width;
+			data.image_height = tile.image_height;
+			if (tile.has_hitbox) {
+				data.hitbox = engine::utils::Rect{ glm::vec2(tile.hitbox[0], tile.hitbox[1]), glm::vec2(tile.hitbox[2], tile.hitbox[3]) };
+			}
+			if (!readProperties(property_records, strings, tile.first_property, tile.property_count, data.properties)) {
+				spdlog::error("Baked level '{}' has an invalid tile property table.", path);
+				return nullptr;
+			}
+			if (tile.first_frame <= frame_records.size() && tile.frame_count <= frame_records.size() - tile.first_frame) {
+				for (const auto &frame : frame_records.subspan(tile.first_frame, tile.frame_count)) {
+					data.animation.push_back({ frame.tile_id, frame.duration_ms });
+				}
+			}
+			tileset.tiles.emplace(tile.local_id, std::move(data));
+		}
+		map->tilesets.push_back(std::move(tileset));
+	}
+
+	for (const auto &record : tile_layer_records) {
+		size_t count = static_cast<size_t>(record.width) * record.height;
+		if (record.width < 0 || record.height < 0 || record.first_gid > gids.size() || count > gids.size() - record.first_gid) {
+			spdlog::error("Baked level '{}' has an out of range tile layer.", path);
+			return nullptr;
+		}
+		TileLayer layer;
+		layer.name = readString(strings, record.name);
+		layer.width = record.width;
+		layer.height = record.height;
+		layer.offset = glm::vec2(record.offset[0], record.offset[1]);
+		layer.opacity = record.opacity;
+		layer.visible = record.visible != 0;
+		layer.gids = gids.subspan(record.first_gid, count); // 原地引用映射内存
+		map->tile_layers.push_back(std::move(layer));
+	}
+
+	for (const auto &record : image_layer_records) {
+		ImageLayer layer;
+		layer.name = readString(strings, record.name);
+		layer.image = readString(strings, record.image);
+		layer.offset = glm::vec2(record.offset[0], record.offset[1]);
+		layer.parallax = glm::vec2(record.parallax[0], record.parallax[1]);
+		layer.repeat = glm::bvec2(record.repeat_x != 0, record.repeat_y != 0);
+		layer.opacity = record.opacity;
+		layer.visible = record.visible != 0;
+		map->image_layers.push_back(std::move(layer));
+	}
+
+	for (const auto &record : object_layer_records) {
+		if (record.first_object > object_records.size() || record.object_count > object_records.size() - record.first_object) {
+			spdlog::error("Baked level '{}' has an out of range object layer.", path);
+			return nullptr;
+		}
+		ObjectLayer layer;
+		layer.name = readString(strings, record.name);
+		layer.visible = record.visible != 0;
+		for (const auto &object_record : object_records.subspan(record.first_object, record.object_count)) {
+			MapObject object;
+			object.id = object_record.id;
+			object.name = readString(strings, object_record.name);
+			object.type = readString(strings, object_record.type);
+			object.gid = object_record.gid;
+			object.position = glm::vec2(object_record.position[0], object_record.position[1]);
+			object.size = glm::vec2(object_record.size[0], object_record.size[1]);
+			object.rotation = object_record.rotation;
+			object.visible = object_record.visible != 0;
+			object.point = object_record.point != 0;
+			if (!readProperties(property_records, strings, object_record.first_property, object_record.property_count, object.properties)) {
+				spdlog::error("Baked level '{}' has an invalid object property table.", path);
+				return nullptr;
+			}
+			layer.objects.push_back(std::move(object));
+		}
+		map->object_layers.push_back(std::move(layer));
+	}
+
+	for (const auto &record : order_records) {
+		auto type = static_cast<LayerType>(record.type);
+		size_t limit = type == LayerType::Tile ? map->tile_layers.size() : type == LayerType::Image ? map->image_layers.size() : map->object_layers.size();
+		if (record.type > static_cast<Uint32>(LayerType::Object) || record.index >= limit) {
+			spdlog::error("Baked level '{}' has an invalid layer order entry.", path);
+			return nullptr;
+		}
+		map->layer_order.push_back({ type, record.index });
+	}
+
+	map->tile_properties = tile_properties; // 原地引用映射内存
+	map->backing_file = std::move(file);
+	spdlog::debug("Mapped baked level '{}': {}x{} tiles, {} tile layers.", path, map->width, map->height, map->tile_layers.size());
+	return map;
+}
+
+} // namespace engine::map
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::resource {
+class AssetArchive;
+}
+
+namespace engine::map {
+
+class TileMap;
+
+/**
+ * @brief 二进制关卡格式（.lvl）
+ *
+ * 小端序、4 字节对齐的定长记录，由离线工具 level_baker 从 .tmj/.tsj 编译而来：
+ * firstgid 已解析，solid/unisolid/slope/ladder 等属性已编译为按 gid 索引的 TileProperties 表，
+ * 其余自定义属性编译为带类型标记的 PropertyRecord。
+ * 运行时把文件映射到内存后，gid 数组与属性表直接原地引用，不做任何解析。
+ *
+ * 文件布局：BakedLevelHeader，随后是 header 中各 BakedSection 指向的记录数组，字符串表为以 '\0' 结尾的字符串拼接。
+ */
+namespace baked {
+
+constexpr char MAGIC[4] = { 'S', 'L', 'V', 'L' };
+constexpr Uint32 VERSION = 2;
+constexpr Uint32 NO_STRING = 0xFFFFFFFFu; ///< @brief 字符串引用为空
+
+struct Section {
+	Uint32 offset; ///< @brief 相对文件开头的字节偏移
+	Uint32 count; ///< @brief 记录数（字符串表为字节数）
+};
+
+struct Header {
+	char magic[4];
+	Uint32 version;
+	Uint32 file_size;
+	Sint32 width;
+	Sint32 height;
+	Sint32 tile_width;
+	Sint32 tile_height;
+	Section strings;
+	Section tilesets; ///< @brief TilesetRecord
+	Section tiles; ///< @brief TileRecord
+	Section animation_frames; ///< @brief AnimationFrameRecord
+	Section tile_properties; ///< @brief TileProperties，按 gid 索引
+	Section tile_layers; ///< @brief TileLayerRecord
+	Section gids; ///< @brief Uint32，所有图块图层的 gid 依次拼接
+	Section image_layers; ///< @brief ImageLayerRecord
+	Section object_layers; ///< @brief ObjectLayerRecord
+	Section objects; ///< @brief ObjectRecord
+	Section layer_order; ///< @brief LayerOrderRecord
+	Section properties; ///< @brief PropertyRecord，图块与对象的自定义属性
+};
+
+enum class PropertyType : Uint32 {
+	Bool,
+	Int,
+	Float,
+	String,
+};
+
+/**
+ * @brief 一条自定义属性（Tiled 属性均为标量）
+ *
+ * value 按 type 解释：Bool 为 0/1，Int 为 Sint64，Float 为 double（按位拷贝），String 为字符串表偏移。
+ * 用两个 Uint32 存放 8 字节值，保持记录 4 字节对齐。
+ */
+struct PropertyRecord {
+	Uint32 name;
+	Uint32 type; ///< @brief PropertyType
+	Uint32 value[2];
+};
+
+struct TilesetRecord {
+	Uint32 name;
+	Uint32 firstgid;
+	Sint32 tile_count;
+	Sint32 columns;
+	Sint32 tile_width;
+	Sint32 tile_height;
+	Sint32 margin;
+	Sint32 spacing;
+	Uint32 image;
+	Uint32 first_tile; ///< @brief 在 tiles 段中的起始记录
+	Uint32 tile_record_count;
+};
+
+struct TileRecord {
+	Sint32 local_id;
+	Uint32 image;
+	Sint32 image_width;
+	Sint32 image_height;
+	Uint32 has_hitbox;
+	float hitbox[4]; ///< @brief x, y, w, h
+	Uint32 first_property; ///< @brief 自定义属性（动画、标签等非碰撞属性）在 properties 段中的起始记录
+	Uint32 property_count;
+	Uint32 first_frame;
+	Uint32 frame_count;
+};
+
+struct AnimationFrameRecord {
+	Sint32 tile_id;
+	Sint32 duration_ms;
+};
+
+struct TileLayerRecord {
+	Uint32 name;
+	Sint32 width;
+	Sint32 height;
+	float offset[2];
+	float opacity;
+	Uint32 visible;
+	Uint32 first_gid; ///< @brief 在 gids 段中的起始下标
+};
+
+struct ImageLayerRecord {
+	Uint32 name;
+	Uint32 image;
+	float offset[2];
+	float parallax[2];
+	Uint32 repeat_x;
+	Uint32 repeat_y;
+	float opacity;
+	Uint32 visible;
+};
+
+struct ObjectLayerRecord {
+	Uint32 name;
+	Uint32 visible;
+	Uint32 first_object;
+	Uint32 object_count;
+};
+
+struct ObjectRecord {
+	Sint32 id;
+	Uint32 name;
+	Uint32 type;
+	Uint32 gid;
+	float position[2];
+	float size[2];
+	float rotation;
+	Uint32 visible;
+	Uint32 point;
+	Uint32 first_property;
+	Uint32 property_count;
+};
+
+struct LayerOrderRecord {
+	Uint32 type; ///< @brief LayerType
+	Uint32 index;
+};
+
+} // namespace baked
+
+/**
+ * @brief 把已加载的 TileMap 编译为二进制关卡
+ */
+class BakedLevelWriter final {
+public:
+	/// @brief 序列化地图，成功返回 true
+	static bool write(const TileMap &map, const std::string &output_path);
+	static std::vector<std::byte> serialize(const TileMap &map);
+};
+
+/**
+ * @brief 通过内存映射加载二进制关卡
+ */
+class BakedLevelLoader final {
+public:
+	/**
+	 * @brief 映射并加载关卡
+	 *
+	 * 返回的 TileMap 中 gid 数组和图块属性表直接指向映射内存（由 TileMap::backing_file 保持映射存活），
+	 * 只有图块集、图层、对象等少量元数据会被拷贝为 C++ 对象。失败时返回 nullptr。
+	 * 传入资源包且包内有该路径时，直接引用包的映射内存，不再单独打开文件。
+	 */
+	static std::unique_ptr<TileMap> load(const std::string &path, const engine::resource::AssetArchive *archive = nullptr);
+};
+
+} // namespace engine::map
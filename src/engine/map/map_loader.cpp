@@ -0,0 +1,237 @@
+#include "map_loader.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../resource/asset_archive.h"
+#include "tile_map.h"
+
+namespace engine::map {
+
+namespace {
+
+bool readJsonFile(const std::string &path, nlohmann::json &out, const engine::resource::AssetArchive *archive) {
+	if (const engine::resource::pak::EntryRecord *entry = archive ? archive->find(path) : nullptr) {
+		auto bytes = archive->getStoredBytes(*entry);
+		const char *begin = reinterpret_cast<const char *>(bytes.data());
+		try {
+			out = nlohmann::json::parse(begin, begin + bytes.size());
+		} catch (const nlohmann::json::parse_error &e) {
+			spdlog::error("Failed to parse '{}' from asset archive: {}", path, e.what());
+			return false;
+		}
+		return true;
+	}
+
+	std::ifstream file(path);
+	if (!file) {
+		spdlog::error("Failed to open map file: {}", path);
+		return false;
+	}
+	try {
+		file >> out;
+	} catch (const nlohmann::json::parse_error &e) {
+		spdlog::error("Failed to parse '{}': {}", path, e.what());
+		return false;
+	}
+	return true;
+}
+
+// Tiled 的属性数组 [{name, type, value}] 转换为 { name: value }
+nlohmann::json parseProperties(const nlohmann::json &json) {
+	nlohmann::json properties = nlohmann::json::object();
+	if (json.contains("properties") && json["properties"].is_array()) {
+		for (const auto &property : json["properties"]) {
+			if (property.contains("name") && property.contains("value")) {
+				properties[property["name"].get<std::string>()] = property["value"];
+			}
+		}
+	}
+	return properties;
+}
+
+} // namespace
+
+std::unique_ptr<TileMap> MapLoader::load(const std::string &map_path, const engine::resource::AssetArchive *archive) {
+	nlohmann::json json;
+	if (!readJsonFile(map_path, json, archive)) {
+		return nullptr;
+	}
+
+	auto map = std::make_unique<TileMap>();
+	map->path = map_path;
+	try {
+		if (json.value("infinite", false)) {
+			spdlog::error("Infinite maps are not supported: {}", map_path);
+			return nullptr;
+		}
+		map->width = json.at("width").get<int>();
+		map->height = json.at("height").get<int>();
+		map->tile_width = json.at("tilewidth").get<int>();
+		map->tile_height = json.at("tileheight").get<int>();
+
+		// 1. 图块集：外部 .tsj 相对地图文件解析，内嵌图块集相对地图文件解析图片
+		for (const auto &tileset_ref : json.value("tilesets", nlohmann::json::array())) {
+			Tileset tileset;
+			tileset.firstgid = tileset_ref.at("firstgid").get<Uint32>();
+			if (tileset_ref.contains("source")) {
+				std::string tileset_path = resolvePath(map_path, tileset_ref["source"].get<std::string>());
+				nlohmann::json tileset_json;
+				if (!readJsonFile(tileset_path, tileset_json, archive) || !loadTileset(tileset_json, tileset_path, tileset)) {
+					return nullptr;
+				}
+			} else if (!loadTileset(tileset_ref, map_path, tileset)) {
+				return nullptr;
+			}
+			map->tilesets.push_back(std::move(tileset));
+		}
+		std::sort(map->tilesets.begin(), map->tilesets.end(), [](const Tileset &a, const Tileset &b) {
+			return a.firstgid < b.firstgid;
+		});
+
+		// 2. 图层
+		if (!loadLayers(json.value("layers", nlohmann::json::array()), map_path, *map)) {
+			return nullptr;
+		}
+
+		// 3. 编译按 gid 索引的图块属性表
+		map->buildTileProperties();
+	} catch (const nlohmann::json::exception &e) {
+		spdlog::error("Invalid map data in '{}': {}", map_path, e.what());
+		return nullptr;
+	}
+
+	spdlog::debug("Loaded map '{}': {}x{} tiles, {} tilesets, {} tile layers, {} image layers, {} object layers",
+			map_path, map->width, map->height, map->tilesets.size(), map->tile_layers.size(), map->image_layers.size(), map->object_layers.size());
+	return map;
+}
+
+bool MapLoader::loadTileset(const nlohmann::json &json, const std::string &base_path, Tileset &tileset) {
+	tileset.name = json.value("name", "");
+	tileset.tile_count = json.value("tilecount", 0);
+	tileset.columns = json.value("columns", 0);
+	tileset.tile_width = json.value("tilewidth", 0);
+	tileset.tile_height = json.value("tileheight", 0);
+	tileset.margin = json.value("margin", 0);
+	tileset.spacing = json.value("spacing", 0);
+	if (json.contains("image")) {
+		tileset.image = resolvePath(base_path, json["image"].get<std::string>());
+	}
+
+	for (const auto &tile_json : json.value("tiles", nlohmann::json::array())) {
+		int id = tile_json.at("id").get<int>();
+		TileData data;
+		if (tile_json.contains("image")) {
+			data.image = resolvePath(base_path, tile_json["image"].get<std::string>());
+			data.image_width = tile_json.value("imagewidth", 0);
+			data.image_height = tile_json.value("imageheight", 0);
+		}
+		data.properties = parseProperties(tile_json);
+
+		if (tile_json.contains("objectgroup")) {
+			for (const auto &object : tile_json["objectgroup"].value("objects", nlohmann::json::array())) {
+				if (object.value("point", false) || object.value("ellipse", false) || object.contains("polygon")) {
+					continue;
+				}
+				data.hitbox = engine::utils::Rect{
+					glm::vec2(object.value("x", 0.0f), object.value("y", 0.0f)),
+					glm::vec2(object.value("width", 0.0f), object.value("height", 0.0f))
+				};
+				break;
+			}
+		}
+
+		for (const auto &frame : tile_json.value("animation", nlohmann::json::array())) {
+			data.animation.push_back({ frame.at("tileid").get<int>(), frame.at("duration").get<int>() });
+		}
+		tileset.tiles.emplace(id, std::move(data));
+	}
+
+	if (tileset.image.empty() && tileset.tiles.empty()) {
+		spdlog::error("Tileset '{}' has neither an image nor tiles.", tileset.name);
+		return false;
+	}
+	return true;
+}
+
+bool MapLoader::loadLayers(const nlohmann::json &layers, const std::string &map_path, TileMap &map) {
+	for (const auto &layer_json : layers) {
+		const std::string type = layer_json.value("type", "");
+		const std::string name = layer_json.value("name", "");
+		const bool visible = layer_json.value("visible", true);
+
+		if (type == "tilelayer") {
+			if (layer_json.contains("encoding") && layer_json["encoding"] != "csv") {
+				spdlog::error("Tile layer '{}' uses unsupported encoding '{}', export the map with CSV layer format.", name, layer_json["encoding"].get<std::string>());
+				return false;
+			}
+			TileLayer layer;
+			layer.name = name;
+			layer.width = layer_json.at("width").get<int>();
+			layer.height = layer_json.at("height").get<int>();
+			layer.opacity = layer_json.value("opacity", 1.0f);
+			layer.visible = visible;
+			layer.offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+			layer.gid_storage = layer_json.at("data").get<std::vector<Uint32>>();
+			layer.gids = layer.gid_storage;
+			if (layer.gids.size() != static_cast<size_t>(layer.width) * layer.height) {
+				spdlog::error("Tile layer '{}' has {} gids, expected {}x{}.", name, layer.gids.size(), layer.width, layer.height);
+				return false;
+			}
+			map.layer_order.push_back({ LayerType::Tile, map.tile_layers.size() });
+			map.tile_layers.push_back(std::move(layer));
+		} else if (type == "imagelayer") {
+			ImageLayer layer;
+			layer.name = name;
+			layer.image = resolvePath(map_path, layer_json.value("image", ""));
+			layer.offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+			layer.parallax = glm::vec2(layer_json.value("parallaxx", 1.0f), layer_json.value("parallaxy", 1.0f));
+			layer.repeat = glm::bvec2(layer_json.value("repeatx", false), layer_json.value("repeaty", false));
+			layer.opacity = layer_json.value("opacity", 1.0f);
+			layer.visible = visible;
+			map.layer_order.push_back({ LayerType::Image, map.image_layers.size() });
+			map.image_layers.push_back(std::move(layer));
+		} else if (type == "objectgroup") {
+			ObjectLayer layer;
+			layer.name = name;
+			layer.visible = visible;
+			for (const auto &object_json : layer_json.value("objects", nlohmann::json::array())) {
+				MapObject object;
+				object.id = object_json.value("id", 0);
+				object.name = object_json.value("name", "");
+				object.type = object_json.value("type", "");
+				object.gid = object_json.value("gid", 0u);
+				object.position = glm::vec2(object_json.value("x", 0.0f), object_json.value("y", 0.0f));
+				object.size = glm::vec2(object_json.value("width", 0.0f), object_json.value("height", 0.0f));
+				object.rotation = object_json.value("rotation", 0.0f);
+				object.visible = object_json.value("visible", true);
+				object.point = object_json.value("point", false);
+				object.properties = parseProperties(object_json);
+				layer.objects.push_back(std::move(object));
+			}
+			map.layer_order.push_back({ LayerType::Object, map.object_layers.size() });
+			map.object_layers.push_back(std::move(layer));
+		} else if (type == "group") { // 图层组展开为平铺的图层
+			if (!loadLayers(layer_json.value("layers", nlohmann::json::array()), map_path, map)) {
+				return false;
+			}
+		} else {
+			spdlog::warn("Skipping unsupported layer '{}' of type '{}'.", name, type);
+		}
+	}
+	return true;
+}
+
+std::string MapLoader::resolvePath(const std::string &base_file, std::string_view relative_path) {
+	if (relative_path.empty()) {
+		return {};
+	}
+	std::filesystem::path base = std::filesystem::path(base_file).parent_path();
+	return (base / relative_path).lexically_normal().generic_string();
+}
+
+} // namespace engine::map
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json_fwd.hpp>
+
+namespace engine::resource {
+class AssetArchive;
+}
+
+namespace engine::map {
+
+class TileMap;
+struct Tileset;
+
+/**
+ * @brief Tiled JSON 地图（.tmj / .tsj）加载器
+ *
+ * 解析图块图层（含翻转位的 gid）、图片图层、对象图层以及通过 firstgid 引用的外部或内嵌图块集。
+ * 所有图片路径都会相对其所在文件解析并规范化，与 ResourceManager 使用的路径一致。
+ */
+class MapLoader final {
+public:
+	/**
+	 * @brief 加载地图，失败时返回 nullptr 并记录错误
+	 *
+	 * @param archive 可选的资源包，地图与外部图块集优先从中读取，包内没有时回退到散文件。
+	 */
+	static std::unique_ptr<TileMap> load(const std::string &map_path, const engine::resource::AssetArchive *archive = nullptr);
+
+private:
+	static bool loadTileset(const nlohmann::json &json, const std::string &base_path, Tileset &tileset);
+	static bool loadLayers(const nlohmann::json &layers, const std::string &map_path, TileMap &map);
+	static std::string resolvePath(const std::string &base_file, std::string_view relative_path); ///< @brief 相对 base_file 所在目录解析路径
+};
+
+} // namespace engine::map
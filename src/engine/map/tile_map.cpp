@@ -0,0 +1,147 @@
+#include "tile_map.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace engine::map {
+
+std::optional<TileInfo> TileMap::resolveGid(Uint32 gid) const {
+	Uint32 bare_gid = gid & TILE_GID_MASK;
+	if (bare_gid == 0) {
+		return std::nullopt;
+	}
+	const Tileset *tileset = findTileset(bare_gid);
+	if (!tileset) {
+		return std::nullopt;
+	}
+
+	TileInfo info;
+	info.tileset = tileset;
+	info.local_id = static_cast<int>(bare_gid - tileset->firstgid);
+	info.data = tileset->findTile(info.local_id);
+	info.flip_horizontal = (gid & FLIPPED_HORIZONTALLY_FLAG) != 0;
+	info.flip_vertical = (gid & FLIPPED_VERTICALLY_FLAG) != 0;
+	info.flip_diagonal = (gid & FLIPPED_DIAGONALLY_FLAG) != 0;
+
+	if (!tileset->image.empty()) { // 单图图块集：按行列计算源矩形
+		if (tileset->columns <= 0 || info.local_id >= tileset->tile_count) {
+			return std::nullopt;
+		}
+		int column = info.local_id % tileset->columns;
+		int row = info.local_id / tileset->columns;
+		info.image = tileset->image;
+		info.source_rect = {
+			static_cast<float>(tileset->margin + column * (tileset->tile_width + tileset->spacing)),
+			static_cast<float>(tileset->margin + row * (tileset->tile_height + tileset->spacing)),
+			static_cast<float>(tileset->tile_width),
+			static_cast<float>(tileset->tile_height)
+		};
+	} else { // 图片集合：每个图块是一张独立图片
+		if (!info.data || info.data->image.empty()) {
+			return std::nullopt;
+		}
+		info.image = info.data->image;
+		info.source_rect = { 0, 0, static_cast<float>(info.data->image_width), static_cast<float>(info.data->image_height) };
+	}
+	return info;
+}
+
+const Tileset *TileMap::findTileset(Uint32 gid) const {
+	// 找到最后一个 firstgid <= gid 的图块集
+	auto it = std::upper_bound(tilesets.begin(), tilesets.end(), gid, [](Uint32 value, const Tileset &tileset) {
+		return value < tileset.firstgid;
+	});
+	if (it == tilesets.begin()) {
+		return nullptr;
+	}
+	return &*(it - 1);
+}
+
+const TileLayer *TileMap::findTileLayer(std::string_view name) const {
+	for (const auto &layer : tile_layers) {
+		if (layer.name == name) {
+			return &layer;
+		}
+	}
+	return nullptr;
+}
+
+void TileMap::buildTileProperties() {
+	Uint32 gid_count = 1;
+	for (const auto &tileset : tilesets) {
+		Uint32 last = tileset.firstgid + static_cast<Uint32>(tileset.tile_count);
+		for (const auto &[id, data] : tileset.tiles) { // 图片集合的 id 可能不连续，以实际最大 id 为准
+			last = std::max(last, tileset.firstgid + static_cast<Uint32>(id) + 1);
+		}
+		gid_count = std::max(gid_count, last);
+	}
+
+	tile_property_storage.assign(gid_count, TileProperties{});
+	for (const auto &tileset : tilesets) {
+		for (const auto &[id, data] : tileset.tiles) {
+			TileProperties &props = tile_property_storage[tileset.firstgid + id];
+			const auto &json = data.properties;
+			if (json.value("solid", false)) {
+				props.flags |= TILE_FLAG_SOLID;
+			}
+			if (json.value("unisolid", false)) {
+				props.flags |= TILE_FLAG_UNISOLID;
+			}
+			if (json.value("ladder", false)) {
+				props.flags |= TILE_FLAG_LADDER;
+			}
+			if (json.value("hazard", false)) {
+				props.flags |= TILE_FLAG_HAZARD;
+			}
+			if (!data.animation.empty()) {
+				props.flags |= TILE_FLAG_ANIMATED;
+			}
+			if (json.contains("slope") && json["slope"].is_string()) {
+				int left = 0, right = 0;
+				if (std::sscanf(json["slope"].get<std::string>().c_str(), "%d_%d", &left, &right) == 2) {
+					props.flags |= TILE_FLAG_SLOPE;
+					props.slope_left = static_cast<Uint8>(std::clamp(left, 0, 2));
+					props.slope_right = static_cast<Uint8>(std::clamp(right, 0, 2));
+				}
+			}
+		}
+	}
+	tile_properties = tile_property_storage;
+}
+
+glm::ivec2 TileMap::getMaxTileImageSize() const {
+	glm::ivec2 max_size(tile_width, tile_height);
+	for (const auto &tileset : tilesets) {
+		max_size.x = std::max(max_size.x, tileset.tile_width);
+		max_size.y = std::max(max_size.y, tileset.tile_height);
+		for (const auto &[id, data] : tileset.tiles) {
+			max_size.x = std::max(max_size.x, data.image_width);
+			max_size.y = std::max(max_size.y, data.image_height);
+		}
+	}
+	return max_size;
+}
+
+std::vector<std::string> TileMap::collectImagePaths() const {
+	std::vector<std::string> paths;
+	for (const auto &tileset : tilesets) {
+		if (!tileset.image.empty()) {
+			paths.push_back(tileset.image);
+		}
+		for (const auto &[id, data] : tileset.tiles) {
+			if (!data.image.empty()) {
+				paths.push_back(data.image);
+			}
+		}
+	}
+	for (const auto &layer : image_layers) {
+		if (!layer.image.empty()) {
+			paths.push_back(layer.image);
+		}
+	}
+	std::sort(paths.begin(), paths.end());
+	paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+	return paths;
+}
+
+} // namespace engine::map
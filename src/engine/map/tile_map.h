@@ -0,0 +1,219 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_stdinc.h>
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+
+#include "../utils/math.h"
+
+namespace engine::utils {
+class MappedFile;
+}
+
+namespace engine::map {
+
+// Tiled 在 gid 的高位存放翻转标志
+constexpr Uint32 FLIPPED_HORIZONTALLY_FLAG = 0x80000000u;
+constexpr Uint32 FLIPPED_VERTICALLY_FLAG = 0x40000000u;
+constexpr Uint32 FLIPPED_DIAGONALLY_FLAG = 0x20000000u;
+constexpr Uint32 ROTATED_HEXAGONAL_120_FLAG = 0x10000000u;
+constexpr Uint32 TILE_GID_MASK = ~(FLIPPED_HORIZONTALLY_FLAG | FLIPPED_VERTICALLY_FLAG | FLIPPED_DIAGONALLY_FLAG | ROTATED_HEXAGONAL_120_FLAG);
+
+/// @brief 由图块自定义属性编译出的标志位
+enum TileFlags : Uint16 {
+	TILE_FLAG_NONE = 0,
+	TILE_FLAG_SOLID = 1 << 0, ///< @brief solid：完全阻挡
+	TILE_FLAG_UNISOLID = 1 << 1, ///< @brief unisolid：单向平台，只从上方阻挡
+	TILE_FLAG_SLOPE = 1 << 2, ///< @brief slope：斜坡，高度见 slope_left / slope_right
+	TILE_FLAG_LADDER = 1 << 3, ///< @brief ladder：梯子区域
+	TILE_FLAG_HAZARD = 1 << 4, ///< @brief hazard：伤害区域
+	TILE_FLAG_ANIMATED = 1 << 5, ///< @brief 图块带 Tiled 动画
+};
+
+/**
+ * @brief 按 gid 索引的紧凑图块属性，供碰撞等运行时系统直接查表
+ *
+ * 斜坡属性 "a_b" 表示左右两端的高度，以半个图块为单位（0 = 底部，2 = 顶部）。
+ */
+struct TileProperties {
+	Uint16 flags = TILE_FLAG_NONE;
+	Uint8 slope_left = 0;
+	Uint8 slope_right = 0;
+};
+static_assert(sizeof(TileProperties) == 4);
+
+/// @brief Tiled 原生瓦片动画的一帧
+struct TileAnimationFrame {
+	int tile_id = 0; ///< @brief 图块集内的本地 id
+	int duration_ms = 0;
+};
+
+/// @brief 图块集中单个图块的附加数据（属性、独立图片、碰撞框、动画）
+struct TileData {
+	std::string image; ///< @brief 图片集合类图块集的独立图片路径（已规范化），单图图块集为空
+	int image_width = 0;
+	int image_height = 0;
+	nlohmann::json properties = nlohmann::json::object(); ///< @brief 自定义属性 name -> value
+	std::optional<engine::utils::Rect> hitbox; ///< @brief objectgroup 中的第一个矩形（相对图块左上角）
+	std::vector<TileAnimationFrame> animation;
+};
+
+/// @brief 图块集，来自 .tsj 文件（或内嵌在地图中）
+struct Tileset {
+	std::string name;
+	Uint32 firstgid = 1;
+	int tile_count = 0;
+	int columns = 0;
+	int tile_width = 0;
+	int tile_height = 0;
+	int margin = 0;
+	int spacing = 0;
+	std::string image; ///< @brief 单图图块集的图片路径（已规范化），图片集合类图块集为空
+	std::unordered_map<int, TileData> tiles; ///< @brief 本地 id -> 附加数据，只包含 Tiled 中有额外信息的图块
+
+	const TileData *findTile(int local_id) const {
+		auto it = tiles.find(local_id);
+		return it != tiles.end() ? &it->second : nullptr;
+	}
+};
+
+/// @brief gid 解析结果：图块所在的图块集、本地 id、源矩形与翻转标志
+struct TileInfo {
+	const Tileset *tileset = nullptr;
+	const TileData *data = nullptr; ///< @brief 可能为空
+	int local_id = 0;
+	std::string_view image; ///< @brief 用于绘制的图片路径（指向 Tileset 或 TileData 中的字符串）
+	SDL_FRect source_rect = { 0, 0, 0, 0 }; ///< @brief 图片中的源矩形，图片集合类图块为整张图片
+	bool flip_horizontal = false;
+	bool flip_vertical = false;
+	bool flip_diagonal = false;
+};
+
+/**
+ * @brief 瓦片图层，gid 按行优先存放（含翻转位）
+ *
+ * gids 是只读视图：JSON 加载时指向 gid_storage，二进制关卡中直接指向映射的文件内存。
+ */
+struct TileLayer {
+	std::string name;
+	int width = 0;
+	int height = 0;
+	float opacity = 1.0f;
+	bool visible = true;
+	glm::vec2 offset = glm::vec2(0.0f);
+	std::vector<Uint32> gid_storage; ///< @brief 自有存储（可能为空）
+	std::span<const Uint32> gids;
+
+	TileLayer() = default;
+	TileLayer(TileLayer &&) noexcept = default; ///< @brief 移动 vector 不会改变其缓冲区，gids 视图保持有效
+	TileLayer &operator=(TileLayer &&) noexcept = default;
+	TileLayer(const TileLayer &) = delete;
+	TileLayer &operator=(const TileLayer &) = delete;
+
+	Uint32 getGid(int x, int y) const {
+		if (x < 0 || y < 0 || x >= width || y >= height) {
+			return 0;
+		}
+		return gids[static_cast<size_t>(y) * width + x];
+	}
+};
+
+/// @brief 图片图层（视差背景）
+struct ImageLayer {
+	std::string name;
+	std::string image; ///< @brief 已规范化的图片路径
+	glm::vec2 offset = glm::vec2(0.0f);
+	glm::vec2 parallax = glm::vec2(1.0f);
+	glm::bvec2 repeat = glm::bvec2(false, false);
+	float opacity = 1.0f;
+	bool visible = true;
+};
+
+/// @brief 对象图层中的一个对象
+struct MapObject {
+	int id = 0;
+	std::string name;
+	std::string type;
+	Uint32 gid = 0; ///< @brief 图块对象的 gid（含翻转位），普通对象为 0
+	glm::vec2 position = glm::vec2(0.0f); ///< @brief Tiled 坐标：图块对象为左下角，其余为左上角
+	glm::vec2 size = glm::vec2(0.0f);
+	float rotation = 0.0f;
+	bool visible = true;
+	bool point = false;
+	nlohmann::json properties = nlohmann::json::object();
+};
+
+struct ObjectLayer {
+	std::string name;
+	bool visible = true;
+	std::vector<MapObject> objects;
+};
+
+enum class LayerType {
+	Tile,
+	Image,
+	Object,
+};
+
+/// @brief 图层在地图中的绘制顺序，index 指向对应类型的数组
+struct LayerRef {
+	LayerType type;
+	size_t index;
+};
+
+/**
+ * @brief 加载后的 Tiled 地图
+ */
+class TileMap final {
+public:
+	std::string path;
+	int width = 0; ///< @brief 以图块为单位
+	int height = 0;
+	int tile_width = 0;
+	int tile_height = 0;
+
+	std::vector<Tileset> tilesets; ///< @brief 按 firstgid 升序
+	std::vector<TileLayer> tile_layers;
+	std::vector<ImageLayer> image_layers;
+	std::vector<ObjectLayer> object_layers;
+	std::vector<LayerRef> layer_order; ///< @brief 所有图层按 Tiled 中的顺序（自下而上）
+
+	std::vector<TileProperties> tile_property_storage; ///< @brief 自有存储（可能为空）
+	std::span<const TileProperties> tile_properties; ///< @brief 按不含翻转位的 gid 索引，0 号为空图块
+
+	std::shared_ptr<const engine::utils::MappedFile> backing_file; ///< @brief 二进制关卡的映射内存，上面的视图可能指向其中
+
+	/// @brief 查询 gid（可含翻转位）的属性，超出范围返回空属性
+	TileProperties getTileProperties(Uint32 gid) const {
+		Uint32 bare_gid = gid & TILE_GID_MASK;
+		return bare_gid < tile_properties.size() ? tile_properties[bare_gid] : TileProperties{};
+	}
+
+	/// @brief 由图块集的自定义属性编译 tile_properties（JSON 加载路径使用）
+	void buildTileProperties();
+
+	/// @brief 解析 gid（可含翻转位），gid 为 0 或不属于任何图块集时返回 std::nullopt
+	std::optional<TileInfo> resolveGid(Uint32 gid) const;
+
+	/// @brief 查找 gid 所属的图块集（按 firstgid 二分查找）
+	const Tileset *findTileset(Uint32 gid) const;
+
+	const TileLayer *findTileLayer(std::string_view name) const;
+
+	/// @brief 所有图块中最大的图片尺寸（像素），用于估计大图块越过格子的范围
+	glm::ivec2 getMaxTileImageSize() const;
+
+	/// @brief 地图引用的所有图片路径（图块集、图片集合中的图块、图片图层），已排序去重，用于生成预加载清单
+	std::vector<std::string> collectImagePaths() const;
+};
+
+} // namespace engine::map
@@ -0,0 +1,141 @@
+#include "allocation_tracker.h"
+
+#include <atomic>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::memory {
+
+namespace {
+
+constexpr size_t CATEGORY_COUNT = static_cast<size_t>(AllocationCategory::COUNT);
+
+// 全局 operator new 可能在任何静态对象构造之前被调用，这里只使用常量初始化的状态
+constinit std::atomic<Uint64> allocation_counts[CATEGORY_COUNT]{};
+constinit std::atomic<Uint64> allocation_bytes[CATEGORY_COUNT]{};
+constinit std::atomic<bool> installed{ false };
+constinit thread_local AllocationCategory current_category = AllocationCategory::Other;
+
+// 以下只在主线程的 endFrame() 中访问
+constinit FrameAllocationStats last_snapshot{};
+constinit AllocationSummary summary{};
+
+FrameAllocationStats takeSnapshot() noexcept {
+	FrameAllocationStats snapshot;
+	for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+		snapshot.categories[i].count = allocation_counts[i].load(std::memory_order_relaxed);
+		snapshot.categories[i].bytes = allocation_bytes[i].load(std::memory_order_relaxed);
+		snapshot.total.count += snapshot.categories[i].count;
+		snapshot.total.bytes += snapshot.categories[i].bytes;
+	}
+	return snapshot;
+}
+
+} // namespace
+
+std::string_view getAllocationCategoryName(AllocationCategory category) {
+	switch (category) {
+		case AllocationCategory::Other:
+			return "other";
+		case AllocationCategory::Input:
+			return "input";
+		case AllocationCategory::Simulation:
+			return "simulation";
+		case AllocationCategory::Navigation:
+			return "navigation";
+		case AllocationCategory::Animation:
+			return "animation";
+		case AllocationCategory::Particles:
+			return "particles";
+		case AllocationCategory::Render:
+			return "render";
+		case AllocationCategory::Resources:
+			return "resources";
+		case AllocationCategory::COUNT:
+			break;
+	}
+	return "unknown";
+}
+
+void AllocationTracker::recordAllocation(size_t bytes) noexcept {
+	const size_t index = static_cast<size_t>(current_category);
+	allocation_counts[index].fetch_add(1, std::memory_order_relaxed);
+	allocation_bytes[index].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::markInstalled() noexcept {
+	installed.store(true, std::memory_order_relaxed);
+}
+
+bool AllocationTracker::isInstalled() noexcept {
+	return installed.load(std::memory_order_relaxed);
+}
+
+AllocationCategory AllocationTracker::setCategory(AllocationCategory category) noexcept {
+	AllocationCategory previous = current_category;
+	current_category = category;
+	return previous;
+}
+
+AllocationCounters AllocationTracker::getTotal() noexcept {
+	return takeSnapshot().total;
+}
+
+FrameAllocationStats AllocationTracker::endFrame() noexcept {
+	const FrameAllocationStats snapshot = takeSnapshot();
+	FrameAllocationStats frame;
+	for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+		frame.categories[i].count = snapshot.categories[i].count - last_snapshot.categories[i].count;
+		frame.categories[i].bytes = snapshot.categories[i].bytes - last_snapshot.categories[i].bytes;
+		summary.categories[i].count += frame.categories[i].count;
+		summary.categories[i].bytes += frame.categories[i].bytes;
+	}
+	frame.total.count = snapshot.total.count - last_snapshot.total.count;
+	frame.total.bytes = snapshot.total.bytes - last_snapshot.total.bytes;
+	last_snapshot = snapshot;
+
+	++summary.frames;
+	summary.total.count += frame.total.count;
+	summary.total.bytes += frame.total.bytes;
+	if (frame.total.count > 0) {
+		++summary.frames_with_allocations;
+	}
+	if (frame.total.count > summary.peak_frame.count) {
+		summary.peak_frame = frame.total;
+	}
+	return frame;
+}
+
+void AllocationTracker::resetSummary() noexcept {
+	last_snapshot = takeSnapshot();
+	summary = {};
+}
+
+const AllocationSummary &AllocationTracker::getSummary() noexcept {
+	return summary;
+}
+
+void AllocationTracker::logSummary() {
+	if (!isInstalled()) {
+		return;
+	}
+	const AllocationSummary &result = summary;
+	if (result.frames == 0) {
+		spdlog::info("Allocation tracking: no frames recorded.");
+		return;
+	}
+	const double frames = static_cast<double>(result.frames);
+	spdlog::info("Allocation tracking over {} frames: {:.2f} allocs/frame, {:.0f} bytes/frame, {} frame(s) allocated, peak {} allocs ({} bytes).",
+			result.frames, static_cast<double>(result.total.count) / frames, static_cast<double>(result.total.bytes) / frames,
+			result.frames_with_allocations, result.peak_frame.count, result.peak_frame.bytes);
+	for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+		const AllocationCounters &counters = result.categories[i];
+		if (counters.count == 0) {
+			continue;
+		}
+		spdlog::info("  {:<12} {:8.2f} allocs/frame {:10.0f} bytes/frame", getAllocationCategoryName(static_cast<AllocationCategory>(i)),
+				static_cast<double>(counters.count) / frames, static_cast<double>(counters.bytes) / frames);
+	}
+}
+
+} // namespace engine::memory
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::memory {
+
+/**
+ * @brief 分配归属的子系统，由 AllocationScope 在当前线程上设置
+ */
+enum class AllocationCategory : Uint8 {
+	Other,
+	Input,
+	Simulation,
+	Navigation,
+	Animation,
+	Particles,
+	Render,
+	Resources,
+	COUNT
+};
+
+std::string_view getAllocationCategoryName(AllocationCategory category);
+
+struct AllocationCounters {
+	Uint64 count = 0;
+	Uint64 bytes = 0;
+};
+
+/// @brief 一帧内各子系统的分配量
+struct FrameAllocationStats {
+	std::array<AllocationCounters, static_cast<size_t>(AllocationCategory::COUNT)> categories{};
+	AllocationCounters total;
+};
+
+/// @brief 自上次 resetSummary() 以来的累计统计
+struct AllocationSummary {
+	Uint64 frames = 0;
+	std::array<AllocationCounters, static_cast<size_t>(AllocationCategory::COUNT)> categories{};
+	AllocationCounters total;
+	AllocationCounters peak_frame; ///< @brief 分配次数最多的一帧
+	Uint64 frames_with_allocations = 0;
+};
+
+/**
+ * @brief 可选的全局分配统计
+ *
+ * 只有在某个翻译单元中展开 ENGINE_DEFINE_ALLOCATION_HOOKS() 替换了全局 operator new 时才生效
+ * （游戏通过 xmake f --alloc_tracking=y 开启，基准程序总是开启）。统计本身不分配内存：
+ * 计数器是按子系统划分的原子变量，归属由线程局部的当前子系统决定，工作线程上的分配计入 Other。
+ * SDL 与第三方库内部的 malloc 不在统计范围内。
+ */
+class AllocationTracker final {
+public:
+	AllocationTracker() = delete;
+
+	static void recordAllocation(size_t bytes) noexcept;
+	static void markInstalled() noexcept;
+	[[nodiscard]] static bool isInstalled() noexcept;
+
+	/// @brief 设置当前线程的归属子系统，返回之前的值
+	static AllocationCategory setCategory(AllocationCategory category) noexcept;
+
+	/// @brief 进程启动以来所有子系统的分配总量
+	[[nodiscard]] static AllocationCounters getTotal() noexcept;
+
+	/// @brief 结束一帧：计算自上一次调用以来的增量并累计到汇总中
+	static FrameAllocationStats endFrame() noexcept;
+	static void resetSummary() noexcept; ///< @brief 清空汇总，下一次 endFrame() 从当前计数开始
+	[[nodiscard]] static const AllocationSummary &getSummary() noexcept;
+	static void logSummary(); ///< @brief 输出每帧平均分配次数与字节数（按子系统）
+};
+
+/**
+ * @brief 在作用域内把当前线程的分配归入指定子系统，离开时恢复
+ */
+class AllocationScope final {
+private:
+	AllocationCategory previous;
+
+public:
+	explicit AllocationScope(AllocationCategory category) noexcept :
+			previous(AllocationTracker::setCategory(category)) {}
+	~AllocationScope() { AllocationTracker::setCategory(previous); }
+
+	AllocationScope(const AllocationScope &) = delete;
+	AllocationScope &operator=(const AllocationScope &) = delete;
+	AllocationScope(AllocationScope &&) = delete;
+	AllocationScope &operator=(AllocationScope &&) = delete;
+};
+
+namespace detail {
+
+inline void *trackedAllocate(size_t size) {
+	AllocationTracker::recordAllocation(size);
+	if (void *ptr = std::malloc(size ? size : 1)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+inline void *trackedAllocateAligned(size_t size, std::align_val_t alignment) {
+	AllocationTracker::recordAllocation(size);
+	const size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+	void *ptr = _aligned_malloc(size ? size : 1, align);
+#else
+	// aligned_alloc 要求大小是对齐的整数倍
+	void *ptr = std::aligned_alloc(align, ((size ? size : 1) + align - 1) & ~(align - 1));
+#endif
+	if (ptr) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+inline void trackedFreeAligned(void *ptr) noexcept {
+#ifdef _WIN32
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+} // namespace detail
+
+} // namespace engine::memory
+
+#define ENGINE_ALLOC_CONCAT_IMPL(a, b) a##b
+#define ENGINE_ALLOC_CONCAT(a, b) ENGINE_ALLOC_CONCAT_IMPL(a, b)
+
+/// @brief 把当前作用域内的分配归入 engine::memory::AllocationCategory::category
+#define ENGINE_ALLOC_SCOPE(category) \
+	::engine::memory::AllocationScope ENGINE_ALLOC_CONCAT(engine_alloc_scope_, __LINE__)(::engine::memory::AllocationCategory::category)
+
+/**
+ * @brief 替换全局 operator new/delete 以开启分配统计，只能在一个翻译单元的全局作用域展开一次
+ */
+#define ENGINE_DEFINE_ALLOCATION_HOOKS()                                                                              \
+	namespace {                                                                                                       \
+	const bool engine_allocation_hooks_installed = (::engine::memory::AllocationTracker::markInstalled(), true);      \
+	}                                                                                                                 \
+	void *operator new(std::size_t size) { return ::engine::memory::detail::trackedAllocate(size); }                  \
+	void *operator new[](std::size_t size) { return ::engine::memory::detail::trackedAllocate(size); }                \
+	void *operator new(std::size_t size, std::align_val_t alignment) {                                                \
+		return ::engine::memory::detail::trackedAllocateAligned(size, alignment);                                     \
+	}                                                                                                                 \
+	void *operator new[](std::size_t size, std::align_val_t alignment) {                                              \
+		return ::engine::memory::detail::trackedAllocateAligned(size, alignment);                                     \
+	}                                                                                                                 \
+	void operator delete(void *ptr) noexcept { std::free(ptr); }                                                      \
+	void operator delete[](void *ptr) noexcept { std::free(ptr); }                                                    \
+	void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }                                         \
+	void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }                                       \
+	void operator delete(void *ptr, std::align_val_t) noexcept { ::engine::memory::detail::trackedFreeAligned(ptr); } \
+	void operator delete[](void *ptr, std::align_val_t) noexcept {                                                    \
+		::engine::memory::detail::trackedFreeAligned(ptr);                                                            \
+	}                                                                                                                 \
+	void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {                                         \
+		::engine::memory::detail::trackedFreeAligned(ptr);                                                            \
+	}                                                                                                                 \
+	void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {                                       \
+		::engine::memory::detail::trackedFreeAligned(ptr);                                                            \
+	}                                                                                                                 \
+	static_assert(true, "")
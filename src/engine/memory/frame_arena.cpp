@@ -0,0 +1,64 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::memory {
+
+FrameArena::FrameArena(size_t capacity) :
+		buffer(std::make_unique<std::byte[]>(capacity)), capacity(capacity) {
+	overflow_blocks.reserve(16);
+}
+
+void FrameArena::reset() {
+	peak_bytes = std::max(peak_bytes, getUsedBytes());
+	if (overflow_bytes > 0) {
+		// 一次性扩大到峰值并留出余量，之后的帧回到零分配
+		size_t new_capacity = std::max(capacity * 2, peak_bytes + peak_bytes / 4);
+		spdlog::debug("FrameArena: {} bytes overflowed last frame, growing from {} to {} bytes.", overflow_bytes, capacity, new_capacity);
+		buffer = std::make_unique<std::byte[]>(new_capacity);
+		capacity = new_capacity;
+		overflow_blocks.clear();
+		overflow_bytes = 0;
+	}
+	offset = 0;
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+	const size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+	if (aligned + size <= capacity) {
+		offset = aligned + size;
+		return buffer.get() + aligned;
+	}
+	return allocateOverflow(size);
+}
+
+void *FrameArena::allocateOverflow(size_t size) {
+	// operator new[] 返回的内存满足 alignof(std::max_align_t)
+	overflow_blocks.push_back(std::make_unique<std::byte[]>(std::max<size_t>(size, 1)));
+	overflow_bytes += size;
+	++overflow_count;
+	return overflow_blocks.back().get();
+}
+
+std::string_view FrameArena::copyString(std::string_view text) {
+	return appendRaw({}, text);
+}
+
+std::string_view FrameArena::appendRaw(std::string_view text, std::string_view suffix) {
+	const auto *end = reinterpret_cast<const std::byte *>(text.data() + text.size());
+	if (!text.empty() && end == buffer.get() + offset && offset + suffix.size() <= capacity) {
+		std::memcpy(buffer.get() + offset, suffix.data(), suffix.size());
+		offset += suffix.size();
+		return { text.data(), text.size() + suffix.size() };
+	}
+	const size_t size = text.size() + suffix.size();
+	char *out = static_cast<char *>(allocate(size, 1));
+	std::memcpy(out, text.data(), text.size());
+	std::memcpy(out + text.size(), suffix.data(), suffix.size());
+	return { out, size };
+}
+
+} // namespace engine::memory
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <spdlog/fmt/fmt.h>
+
+namespace engine::memory {
+
+/**
+ * @brief 帧作用域的线性分配器
+ *
+ * 分配只是移动偏移量，reset() 一次性回收本帧的全部内存，不逐个释放，也不调用析构函数（只接受可平凡析构的类型）。
+ * 用于只在一帧内有效的临时数据：格式化的临时字符串、临时数组等。指针在下一次 reset() 后失效。
+ *
+ * 容量不足时本帧的多余分配退回到堆上单独申请，下一次 reset() 把主缓冲扩大到峰值用量，之后的帧不再溢出，
+ * 稳态下不产生任何堆分配。非线程安全，只在主线程使用。
+ */
+class FrameArena final {
+private:
+	std::unique_ptr<std::byte[]> buffer;
+	size_t capacity = 0;
+	size_t offset = 0;
+	size_t peak_bytes = 0; ///< @brief 自创建以来单帧的最大用量（含溢出）
+	std::vector<std::unique_ptr<std::byte[]>> overflow_blocks;
+	size_t overflow_bytes = 0; ///< @brief 本帧溢出到堆上的字节数
+	size_t overflow_count = 0; ///< @brief 累计溢出的分配次数
+	fmt::memory_buffer scratch; ///< @brief 格式化的中间缓冲，容量跨帧保留
+
+public:
+	explicit FrameArena(size_t capacity);
+
+	FrameArena(const FrameArena &) = delete;
+	FrameArena &operator=(const FrameArena &) = delete;
+	FrameArena(FrameArena &&) = delete;
+	FrameArena &operator=(FrameArena &&) = delete;
+
+	/// @brief 开始新的一帧，回收上一帧的全部分配；上一帧溢出时扩大主缓冲
+	void reset();
+
+	/// @brief 分配未初始化的内存，alignment 必须是 2 的幂且不超过 alignof(std::max_align_t)
+	[[nodiscard]] void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	template <typename T, typename... Args>
+	[[nodiscard]] T *create(Args &&...args) {
+		static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors.");
+		return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+	}
+
+	/// @brief 分配 count 个值初始化的元素
+	template <typename T>
+	[[nodiscard]] std::span<T> allocateArray(size_t count) {
+		static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors.");
+		T *data = static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+		std::uninitialized_value_construct_n(data, count);
+		return { data, count };
+	}
+
+	[[nodiscard]] std::string_view copyString(std::string_view text);
+
+	/// @brief 格式化为本帧有效的临时字符串（不以 '\0' 结尾）
+	template <typename... Args>
+	[[nodiscard]] std::string_view format(fmt::format_string<Args...> format_text, Args &&...args) {
+		return append({}, format_text, std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief 在 text 后追加格式化内容
+	 *
+	 * text 是本帧最近一次分配时原地扩展，不复制已有内容；逐行拼接多行文字时只需不断把返回值传回。
+	 */
+	template <typename... Args>
+	[[nodiscard]] std::string_view append(std::string_view text, fmt::format_string<Args...> format_text, Args &&...args) {
+		scratch.clear();
+		fmt::vformat_to(std::back_inserter(scratch), fmt::string_view(format_text), fmt::make_format_args(args...));
+		return appendRaw(text, { scratch.data(), scratch.size() });
+	}
+
+	size_t getUsedBytes() const { return offset + overflow_bytes; }
+	size_t getCapacity() const { return capacity; }
+	size_t getPeakBytes() const { return peak_bytes; }
+	size_t getOverflowCount() const { return overflow_count; }
+
+private:
+	std::string_view appendRaw(std::string_view text, std::string_view suffix);
+	void *allocateOverflow(size_t size);
+};
+
+} // namespace engine::memory
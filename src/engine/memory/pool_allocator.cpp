@@ -0,0 +1,58 @@
+#include "pool_allocator.h"
+
+#include <algorithm>
+
+namespace engine::memory {
+
+namespace {
+struct OddSized {
+	float x, y, z;
+};
+} // namespace
+
+// 12 字节、4 字节对齐的类型：对齐先提升到指针对齐，块大小再取整，保证每个块都能放下对齐的链表节点
+static_assert(PoolAllocator::effectiveAlignment(alignof(OddSized)) == alignof(void *), "Pool alignment must cover the free-list node.");
+static_assert(PoolAllocator::effectiveBlockSize(sizeof(OddSized), alignof(OddSized)) % alignof(void *) == 0,
+		"Pool blocks must be a multiple of the effective alignment.");
+static_assert(PoolAllocator::effectiveBlockSize(sizeof(OddSized), alignof(OddSized)) >= sizeof(OddSized), "Pool blocks must fit the object.");
+
+PoolAllocator::PoolAllocator(size_t block_size, size_t alignment, size_t blocks_per_page) :
+		alignment(effectiveAlignment(alignment)),
+		block_size(effectiveBlockSize(block_size, alignment)),
+		blocks_per_page(std::max<size_t>(blocks_per_page, 1)) {}
+
+PoolAllocator::~PoolAllocator() {
+	for (std::byte *page : pages) {
+		::operator delete(page, std::align_val_t(alignment));
+	}
+}
+
+void *PoolAllocator::allocate() {
+	if (!free_list) {
+		addPage();
+	}
+	FreeBlock *block = free_list;
+	free_list = block->next;
+	++used_blocks;
+	return block;
+}
+
+void PoolAllocator::deallocate(void *block) {
+	auto *free_block = static_cast<FreeBlock *>(block);
+	free_block->next = free_list;
+	free_list = free_block;
+	--used_blocks;
+}
+
+void PoolAllocator::addPage() {
+	auto *page = static_cast<std::byte *>(::operator new(block_size * blocks_per_page, std::align_val_t(alignment)));
+	pages.push_back(page);
+	// 倒序入链，分配顺序与地址顺序一致
+	for (size_t i = blocks_per_page; i-- > 0;) {
+		auto *block = reinterpret_cast<FreeBlock *>(page + i * block_size);
+		block->next = free_list;
+		free_list = block;
+	}
+}
+
+} // namespace engine::memory
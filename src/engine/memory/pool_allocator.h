@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace engine::memory {
+
+/**
+ * @brief 定长块池
+ *
+ * 每次向堆申请一页（blocks_per_page 个块），释放的块挂入侵入式空闲链表，之后的分配直接取链表头，
+ * 分配与释放都是 O(1) 且不访问堆。页只在池销毁时归还。非线程安全。
+ */
+class PoolAllocator final {
+private:
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	size_t alignment; // 先于 block_size 声明：块大小按修正后的对齐取整
+	size_t block_size;
+	size_t blocks_per_page;
+	FreeBlock *free_list = nullptr;
+	std::vector<std::byte *> pages;
+	size_t used_blocks = 0;
+
+public:
+	/**
+	 * @param block_size 块大小，不小于一个指针并向上取整到实际对齐的倍数
+	 * @param alignment 块对齐，2 的幂；小于指针对齐时按指针对齐
+	 */
+	PoolAllocator(size_t block_size, size_t alignment = alignof(std::max_align_t), size_t blocks_per_page = 64);
+	~PoolAllocator();
+
+	PoolAllocator(const PoolAllocator &) = delete;
+	PoolAllocator &operator=(const PoolAllocator &) = delete;
+	PoolAllocator(PoolAllocator &&) = delete;
+	PoolAllocator &operator=(PoolAllocator &&) = delete;
+
+	[[nodiscard]] void *allocate();
+	void deallocate(void *block); ///< @brief block 必须来自本池
+
+	/// @brief 实际使用的对齐：不小于空闲链表节点的对齐
+	static constexpr size_t effectiveAlignment(size_t alignment) { return std::max(alignment, alignof(FreeBlock)); }
+	/// @brief 实际块大小：不小于空闲链表节点，并向上取整到 effectiveAlignment() 的倍数
+	static constexpr size_t effectiveBlockSize(size_t block_size, size_t alignment) {
+		const size_t align = effectiveAlignment(alignment);
+		return (std::max(block_size, sizeof(FreeBlock)) + align - 1) & ~(align - 1);
+	}
+
+	size_t getBlockSize() const { return block_size; }
+	size_t getAlignment() const { return alignment; }
+	size_t getUsedCount() const { return used_blocks; }
+	size_t getCapacity() const { return pages.size() * blocks_per_page; }
+
+private:
+	void addPage();
+};
+
+/**
+ * @brief 类型化的对象池：在 PoolAllocator 的块上构造与析构 T
+ */
+template <typename T>
+class ObjectPool final {
+private:
+	PoolAllocator allocator;
+
+public:
+	explicit ObjectPool(size_t objects_per_page = 64) :
+			allocator(sizeof(T), alignof(T), objects_per_page) {}
+
+	template <typename... Args>
+	[[nodiscard]] T *create(Args &&...args) {
+		void *block = allocator.allocate();
+		try {
+			return ::new (block) T(std::forward<Args>(args)...);
+		} catch (...) {
+			allocator.deallocate(block);
+			throw;
+		}
+	}
+
+	void destroy(T *object) {
+		if (object) {
+			object->~T();
+			allocator.deallocate(object);
+		}
+	}
+
+	size_t getUsedCount() const { return allocator.getUsedCount(); }
+	size_t getCapacity() const { return allocator.getCapacity(); }
+};
+
+} // namespace engine::memory
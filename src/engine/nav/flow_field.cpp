@@ -0,0 +1,141 @@
+#include "flow_field.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../debug/profiler.h"
+
+namespace engine::nav {
+
+FlowField::FlowField(const NavGrid &grid, NavLayer layer, Uint32 max_cost) :
+		grid(grid), layer(layer), max_cost(max_cost) {
+	const size_t count = grid.getCellCount();
+	for (Field *field : { &front, &back }) {
+		field->costs.assign(count, UNREACHABLE);
+		field->directions.assign(count, NAV_NO_DIRECTION);
+	}
+	// 惰性删除：每个格子最多在堆中出现的次数等于其入边数，按最坏情况预留，重建时不再扩容
+	heap.reserve(count * NAV_DIRECTION_COUNT);
+}
+
+void FlowField::setTarget(glm::ivec2 cell) {
+	if (!grid.isPassable(layer, cell)) {
+		return;
+	}
+	const glm::ivec2 latest = has_pending ? pending_target : (building ? back.target : front.target);
+	if (cell == latest) {
+		return;
+	}
+	if (building) {
+		pending_target = cell; // 当前构建完成后再开始
+		has_pending = true;
+	} else {
+		beginBuild(cell);
+	}
+}
+
+void FlowField::beginBuild(glm::ivec2 target) {
+	std::fill(back.costs.begin(), back.costs.end(), UNREACHABLE);
+	std::fill(back.directions.begin(), back.directions.end(), static_cast<Uint8>(NAV_NO_DIRECTION));
+	back.target = target;
+	heap.clear();
+	const Uint32 index = grid.toIndex(target);
+	back.costs[index] = 0;
+	heap.push_back({ 0, index });
+	building = true;
+	build_expansions = 0;
+	build_slices = 0;
+}
+
+bool FlowField::update(Uint32 max_expansions) {
+	if (!building) {
+		return false;
+	}
+	PROFILE_SCOPE("FlowField::update");
+	++build_slices;
+	Uint32 expanded = 0;
+	while (!heap.empty() && expanded < max_expansions) {
+		std::pop_heap(heap.begin(), heap.end(), NavHeapGreater{});
+		const NavHeapEntry entry = heap.back();
+		heap.pop_back();
+		if (entry.cost != back.costs[entry.index]) {
+			continue; // 已被更短的路径更新过的旧条目
+		}
+		++expanded;
+
+		// 反向扩展：入边掩码中的每个邻居都可以一步走到本格
+		const glm::ivec2 cell = grid.toCell(entry.index);
+		const Uint8 sources = grid.getIncoming(layer, entry.index);
+		for (Uint8 direction = 0; direction < NAV_DIRECTION_COUNT; ++direction) {
+			if (!(sources & (1u << direction))) {
+				continue;
+			}
+			const Uint8 step = oppositeDirection(direction); // 邻居走向本格的方向
+			const Uint32 cost = entry.cost + getStepCost(step);
+			if (cost > max_cost) {
+				continue;
+			}
+			const Uint32 neighbor = grid.toIndex(cell + NAV_DIRECTION_OFFSETS[direction]);
+			if (cost < back.costs[neighbor]) {
+				back.costs[neighbor] = cost;
+				back.directions[neighbor] = step;
+				heap.push_back({ cost, neighbor });
+				std::push_heap(heap.begin(), heap.end(), NavHeapGreater{});
+			}
+		}
+	}
+	build_expansions += expanded;
+
+	if (!heap.empty()) {
+		return false;
+	}
+	publish();
+	if (has_pending) {
+		has_pending = false;
+		if (pending_target != front.target) {
+			beginBuild(pending_target);
+		}
+	}
+	return true;
+}
+
+void FlowField::rebuildNow() {
+	while (building) {
+		update(UNREACHABLE);
+	}
+}
+
+void FlowField::publish() {
+	std::swap(front, back);
+	has_front = true;
+	building = false;
+	++stats.builds;
+	stats.last_build_expansions = build_expansions;
+	stats.last_build_slices = build_slices;
+	stats.reachable_cells = static_cast<Uint32>(std::count_if(front.costs.begin(), front.costs.end(), [](Uint32 cost) { return cost != UNREACHABLE; }));
+}
+
+Uint8 FlowField::getDirection(glm::ivec2 cell) const {
+	if (!has_front || !grid.contains(cell)) {
+		return NAV_NO_DIRECTION;
+	}
+	return front.directions[grid.toIndex(cell)];
+}
+
+glm::vec2 FlowField::sampleDirection(const glm::vec2 &position) const {
+	const Uint8 direction = getDirection(grid.worldToCell(position));
+	if (direction == NAV_NO_DIRECTION) {
+		return glm::vec2(0.0f);
+	}
+	const glm::vec2 offset(NAV_DIRECTION_OFFSETS[direction]);
+	return direction >= NAV_SOUTH_EAST ? offset * 0.70710678f : offset;
+}
+
+Uint32 FlowField::getCost(glm::ivec2 cell) const {
+	if (!has_front || !grid.contains(cell)) {
+		return UNREACHABLE;
+	}
+	return front.costs[grid.toIndex(cell)];
+}
+
+} // namespace engine::nav
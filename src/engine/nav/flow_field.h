@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "nav_grid.h"
+
+namespace engine::nav {
+
+/// @brief 流场构建统计
+struct FlowFieldStats {
+	Uint32 builds = 0; ///< @brief 已发布的流场数量
+	Uint32 last_build_expansions = 0; ///< @brief 上一次构建展开的格子数
+	Uint32 last_build_slices = 0; ///< @brief 上一次构建分摊到的 update() 次数
+	Uint32 reachable_cells = 0; ///< @brief 当前流场中能到达目标的格子数
+};
+
+/**
+ * @brief 朝向一个目标格子的流场（Dijkstra 积分场 + 每格下一步方向）
+ *
+ * 从目标沿导航网格的入边反向扩展，得到每个格子到目标的代价与应走的方向。任意数量的单位按所在格子 O(1) 查表即可，
+ * 不需要逐单位寻路。
+ *
+ * 目标移动时不会立即重算：新流场在后台缓冲中构建，每次 update() 最多展开给定数量的格子，完成后与前台缓冲交换，
+ * 构建期间单位继续使用上一份流场。构建过程中目标再次移动只记录最新目标，当前构建完成后再开始下一次，
+ * 因此目标持续移动时流场以固定的预算追赶，而不会反复从头开始。所有缓冲按格子数一次分配，之后的构建不分配内存。
+ */
+class FlowField final {
+public:
+	static constexpr Uint32 UNREACHABLE = 0xFFFFFFFFu;
+
+private:
+	struct Field {
+		std::vector<Uint32> costs;
+		std::vector<Uint8> directions;
+		glm::ivec2 target = glm::ivec2(-1);
+	};
+
+	const NavGrid &grid;
+	NavLayer layer;
+	Uint32 max_cost; ///< @brief 只展开代价不超过该值的格子，限制大地图上的构建范围
+
+	Field front; ///< @brief 单位查询使用的流场
+	Field back; ///< @brief 正在构建的流场
+	std::vector<NavHeapEntry> heap;
+	bool has_front = false;
+	bool building = false;
+	bool has_pending = false;
+	glm::ivec2 pending_target = glm::ivec2(-1);
+	Uint32 build_expansions = 0;
+	Uint32 build_slices = 0;
+	FlowFieldStats stats;
+
+public:
+	FlowField(const NavGrid &grid, NavLayer layer, Uint32 max_cost = UNREACHABLE);
+
+	FlowField(const FlowField &) = delete;
+	FlowField &operator=(const FlowField &) = delete;
+	FlowField(FlowField &&) = delete;
+	FlowField &operator=(FlowField &&) = delete;
+
+	/// @brief 设置目标格子；与当前（或正在构建的）目标相同时忽略，越界或不可通过的格子也被忽略
+	void setTarget(glm::ivec2 cell);
+	void setTargetWorld(const glm::vec2 &position) { setTarget(grid.worldToCell(position)); }
+
+	/**
+	 * @brief 继续构建，最多展开 max_expansions 个格子
+	 * @return 本次调用是否发布了新的流场
+	 */
+	bool update(Uint32 max_expansions);
+	void rebuildNow(); ///< @brief 立即完成当前（或待处理的）构建，用于加载时
+
+	/// @brief 格子的下一步方向（NavDirection），目标格子、不可达或尚无流场时返回 NAV_NO_DIRECTION
+	Uint8 getDirection(glm::ivec2 cell) const;
+	/// @brief 世界坐标处应移动的单位方向向量，无方向时返回零向量
+	glm::vec2 sampleDirection(const glm::vec2 &position) const;
+	/// @brief 格子到目标的代价（NAV_STRAIGHT_COST 为一格），不可达时返回 UNREACHABLE
+	Uint32 getCost(glm::ivec2 cell) const;
+
+	bool isReady() const { return has_front; }
+	bool isBuilding() const { return building; }
+	glm::ivec2 getTarget() const { return front.target; }
+	NavLayer getLayer() const { return layer; }
+	const FlowFieldStats &getStats() const { return stats; }
+
+private:
+	void beginBuild(glm::ivec2 target);
+	void publish();
+};
+
+} // namespace engine::nav
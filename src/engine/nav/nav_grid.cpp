@@ -0,0 +1,139 @@
+#include "nav_grid.h"
+
+#include <cmath>
+
+#include <spdlog/spdlog.h>
+
+#include "../map/tile_map.h"
+#include "../physics/tile_collision_grid.h"
+
+namespace engine::nav {
+
+namespace {
+
+constexpr Uint16 SUPPORT_FLAGS = engine::map::TILE_FLAG_SOLID | engine::map::TILE_FLAG_UNISOLID | engine::map::TILE_FLAG_SLOPE | engine::map::TILE_FLAG_LADDER;
+
+bool isSolid(const engine::physics::TileCollisionGrid &grid, int x, int y) {
+	// 网格外视为实心，单位不会走出地图
+	if (x < 0 || y < 0 || x >= grid.getWidth() || y >= grid.getHeight()) {
+		return true;
+	}
+	return (grid.getCell(x, y).flags & engine::map::TILE_FLAG_SOLID) != 0;
+}
+
+bool hasFlag(const engine::physics::TileCollisionGrid &grid, int x, int y, Uint16 flag) {
+	return (grid.getCell(x, y).flags & flag) != 0;
+}
+
+} // namespace
+
+NavGrid::NavGrid(const engine::physics::TileCollisionGrid &grid) :
+		width(grid.getWidth()), height(grid.getHeight()), tile_size(grid.getTileSize()) {
+	const size_t count = getCellCount();
+	for (size_t layer = 0; layer < NAV_LAYER_COUNT; ++layer) {
+		outgoing[layer].assign(count, 0);
+		incoming[layer].assign(count, 0);
+		passable[layer].assign(count, 0);
+	}
+	buildWalking(grid);
+	buildFlying(grid);
+	buildIncoming(NavLayer::Walking);
+	buildIncoming(NavLayer::Flying);
+	spdlog::debug("NavGrid: {}x{} cells.", width, height);
+}
+
+glm::ivec2 NavGrid::worldToCell(const glm::vec2 &position) const {
+	return { static_cast<int>(std::floor(position.x / tile_size.x)), static_cast<int>(std::floor(position.y / tile_size.y)) };
+}
+
+glm::ivec2 NavGrid::findGround(glm::ivec2 cell) const {
+	constexpr Uint8 FALLING = 1u << NAV_SOUTH;
+	while (isPassable(NavLayer::Walking, cell) && getOutgoing(NavLayer::Walking, toIndex(cell)) == FALLING) {
+		++cell.y;
+	}
+	return cell;
+}
+
+void NavGrid::buildWalking(const engine::physics::TileCollisionGrid &grid) {
+	std::vector<Uint8> &links = outgoing[static_cast<size_t>(NavLayer::Walking)];
+	std::vector<Uint8> &open = passable[static_cast<size_t>(NavLayer::Walking)];
+	auto isOpen = [&](int x, int y) { return !isSolid(grid, x, y); };
+	auto isSupported = [&](int x, int y) {
+		return isOpen(x, y) && (hasFlag(grid, x, y, engine::map::TILE_FLAG_SLOPE | engine::map::TILE_FLAG_LADDER) || y + 1 >= height || (grid.getCell(x, y + 1).flags & SUPPORT_FLAGS) != 0);
+	};
+
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			if (!isOpen(x, y)) {
+				continue;
+			}
+			const Uint32 index = toIndex({ x, y });
+			open[index] = 1;
+			Uint8 mask = 0;
+			if (isSupported(x, y)) {
+				for (Uint8 side : { NAV_EAST, NAV_WEST }) {
+					const int nx = x + NAV_DIRECTION_OFFSETS[side].x;
+					if (isOpen(nx, y)) {
+						mask |= 1u << side; // 走到边缘外时由目标格子的下落出边接管
+					} else if (hasFlag(grid, x, y, engine::map::TILE_FLAG_SLOPE) && isSupported(nx, y - 1) && isOpen(x, y - 1)) {
+						mask |= 1u << (side == NAV_EAST ? NAV_NORTH_EAST : NAV_NORTH_WEST); // 沿斜坡向上
+					}
+				}
+				if (hasFlag(grid, x, y, engine::map::TILE_FLAG_LADDER) && isOpen(x, y - 1)) {
+					mask |= 1u << NAV_NORTH;
+				}
+				if (isOpen(x, y + 1) && hasFlag(grid, x, y + 1, engine::map::TILE_FLAG_LADDER)) {
+					mask |= 1u << NAV_SOUTH; // 在梯子上或梯子顶端向下爬
+				}
+			} else if (isOpen(x, y + 1)) {
+				mask |= 1u << NAV_SOUTH; // 悬空时只能下落
+			}
+			links[index] = mask;
+		}
+	}
+}
+
+void NavGrid::buildFlying(const engine::physics::TileCollisionGrid &grid) {
+	std::vector<Uint8> &links = outgoing[static_cast<size_t>(NavLayer::Flying)];
+	std::vector<Uint8> &open = passable[static_cast<size_t>(NavLayer::Flying)];
+	// 斜坡格子被部分填充，飞行单位绕开
+	auto isOpen = [&](int x, int y) { return !isSolid(grid, x, y) && !hasFlag(grid, x, y, engine::map::TILE_FLAG_SLOPE); };
+
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			if (!isOpen(x, y)) {
+				continue;
+			}
+			const Uint32 index = toIndex({ x, y });
+			open[index] = 1;
+			Uint8 mask = 0;
+			for (Uint8 direction = 0; direction < NAV_DIRECTION_COUNT; ++direction) {
+				const glm::ivec2 offset = NAV_DIRECTION_OFFSETS[direction];
+				if (!isOpen(x + offset.x, y + offset.y)) {
+					continue;
+				}
+				if (offset.x != 0 && offset.y != 0 && (!isOpen(x + offset.x, y) || !isOpen(x, y + offset.y))) {
+					continue; // 不切角
+				}
+				mask |= 1u << direction;
+			}
+			links[index] = mask;
+		}
+	}
+}
+
+void NavGrid::buildIncoming(NavLayer layer) {
+	const std::vector<Uint8> &links = outgoing[static_cast<size_t>(layer)];
+	std::vector<Uint8> &reverse = incoming[static_cast<size_t>(layer)];
+	for (Uint32 index = 0; index < links.size(); ++index) {
+		const glm::ivec2 cell = toCell(index);
+		for (Uint8 direction = 0; direction < NAV_DIRECTION_COUNT; ++direction) {
+			if (links[index] & (1u << direction)) {
+				// 本格可以向 direction 走到邻居，对邻居而言本格位于反方向
+				reverse[toIndex(cell + NAV_DIRECTION_OFFSETS[direction])] |= 1u << oppositeDirection(direction);
+			}
+		}
+	}
+}
+
+} // namespace engine::nav
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+#include <glm/vec2.hpp>
+
+namespace engine::physics {
+class TileCollisionGrid;
+}
+
+namespace engine::nav {
+
+/// @brief 导航图层：不同移动方式在同一张网格上的连通关系
+enum class NavLayer : Uint8 {
+	Walking = 0, ///< @brief 受重力的地面单位：左右行走、爬梯子、从边缘落下（不含跳跃）
+	Flying = 1, ///< @brief 飞行单位：8 方向，斜向移动不能切过实心格的角
+};
+constexpr size_t NAV_LAYER_COUNT = 2;
+
+/**
+ * @brief 8 个移动方向。编号成对排列，d ^ 1 即为反方向
+ */
+enum NavDirection : Uint8 {
+	NAV_EAST = 0,
+	NAV_WEST = 1,
+	NAV_SOUTH = 2,
+	NAV_NORTH = 3,
+	NAV_SOUTH_EAST = 4,
+	NAV_NORTH_WEST = 5,
+	NAV_SOUTH_WEST = 6,
+	NAV_NORTH_EAST = 7,
+	NAV_DIRECTION_COUNT = 8,
+	NAV_NO_DIRECTION = 0xFF,
+};
+
+constexpr glm::ivec2 NAV_DIRECTION_OFFSETS[NAV_DIRECTION_COUNT] = {
+	{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, -1 }, { -1, 1 }, { 1, -1 },
+};
+
+constexpr Uint32 NAV_STRAIGHT_COST = 10; ///< @brief 横竖移动一格的代价
+constexpr Uint32 NAV_DIAGONAL_COST = 14; ///< @brief 斜向移动一格的代价（≈ 10√2）
+
+constexpr Uint8 oppositeDirection(Uint8 direction) {
+	return direction ^ 1u;
+}
+
+constexpr Uint32 getStepCost(Uint8 direction) {
+	return direction >= NAV_SOUTH_EAST ? NAV_DIAGONAL_COST : NAV_STRAIGHT_COST;
+}
+
+/// @brief 8 方向网格上的距离（octile），是两种图层代价的可采纳下界
+constexpr Uint32 getOctileDistance(glm::ivec2 a, glm::ivec2 b) {
+	const Uint32 dx = static_cast<Uint32>(a.x > b.x ? a.x - b.x : b.x - a.x);
+	const Uint32 dy = static_cast<Uint32>(a.y > b.y ? a.y - b.y : b.y - a.y);
+	const Uint32 diagonal = dx < dy ? dx : dy;
+	return NAV_DIAGONAL_COST * diagonal + NAV_STRAIGHT_COST * (dx + dy - 2 * diagonal);
+}
+
+/// @brief 寻路与流场共用的开放列表元素，配合 NavHeapGreater 在 std::vector 上组成最小堆
+struct NavHeapEntry {
+	Uint32 cost;
+	Uint32 index; ///< @brief 格子下标
+};
+
+struct NavHeapGreater {
+	bool operator()(const NavHeapEntry &a, const NavHeapEntry &b) const {
+		return a.cost > b.cost;
+	}
+};
+
+/**
+ * @brief 导航网格：把瓦片碰撞网格的 solid / unisolid / slope / ladder 标志编译为每格每图层 1 字节的出边掩码
+ *
+ * 行走图层的规则：
+ * - 有支撑（脚下是实心、单向平台、斜坡或梯子顶端，或自身是斜坡/梯子）的格子可以向左右走，在斜坡上可以斜向上走；
+ * - 梯子格子可以上下移动，站在梯子顶端可以向下爬；
+ * - 没有支撑的格子只能向下落。
+ * 飞行图层中非实心、非斜坡的格子 8 方向连通，斜向移动要求两侧的横竖格子都可通过。
+ *
+ * 同时保存入边掩码（哪些邻居可以一步走到本格），流场从目标反向扩展时直接使用。
+ */
+class NavGrid final {
+private:
+	int width = 0;
+	int height = 0;
+	glm::vec2 tile_size = glm::vec2(16.0f);
+	std::array<std::vector<Uint8>, NAV_LAYER_COUNT> outgoing; ///< @brief 第 d 位：可以向方向 d 走一步
+	std::array<std::vector<Uint8>, NAV_LAYER_COUNT> incoming; ///< @brief 第 d 位：方向 d 上的邻居可以一步走到本格
+	std::array<std::vector<Uint8>, NAV_LAYER_COUNT> passable; ///< @brief 格子能否容纳该图层的单位
+
+public:
+	explicit NavGrid(const engine::physics::TileCollisionGrid &grid);
+
+	NavGrid(const NavGrid &) = delete;
+	NavGrid &operator=(const NavGrid &) = delete;
+	NavGrid(NavGrid &&) = delete;
+	NavGrid &operator=(NavGrid &&) = delete;
+
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+	size_t getCellCount() const { return static_cast<size_t>(width) * height; }
+	const glm::vec2 &getTileSize() const { return tile_size; }
+
+	bool contains(glm::ivec2 cell) const { return cell.x >= 0 && cell.y >= 0 && cell.x < width && cell.y < height; }
+	Uint32 toIndex(glm::ivec2 cell) const { return static_cast<Uint32>(cell.y) * static_cast<Uint32>(width) + static_cast<Uint32>(cell.x); }
+	glm::ivec2 toCell(Uint32 index) const { return { static_cast<int>(index % static_cast<Uint32>(width)), static_cast<int>(index / static_cast<Uint32>(width)) }; }
+	glm::ivec2 worldToCell(const glm::vec2 &position) const;
+	glm::vec2 cellCenter(glm::ivec2 cell) const { return (glm::vec2(cell) + 0.5f) * tile_size; }
+
+	/// @brief 格子能否容纳该图层的单位，越界返回 false
+	bool isPassable(NavLayer layer, glm::ivec2 cell) const {
+		return contains(cell) && passable[static_cast<size_t>(layer)][toIndex(cell)] != 0;
+	}
+	Uint8 getOutgoing(NavLayer layer, Uint32 index) const { return outgoing[static_cast<size_t>(layer)][index]; }
+	Uint8 getIncoming(NavLayer layer, Uint32 index) const { return incoming[static_cast<size_t>(layer)][index]; }
+
+	/// @brief 从行走图层的格子沿下落边向下，返回第一个有支撑的格子；用于把跳在空中的目标投影到落点
+	glm::ivec2 findGround(glm::ivec2 cell) const;
+
+private:
+	void buildWalking(const engine::physics::TileCollisionGrid &grid);
+	void buildFlying(const engine::physics::TileCollisionGrid &grid);
+	void buildIncoming(NavLayer layer);
+};
+
+} // namespace engine::nav
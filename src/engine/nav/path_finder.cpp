@@ -0,0 +1,252 @@
+#include "path_finder.h"
+
+#include <algorithm>
+
+#include "../debug/profiler.h"
+
+namespace engine::nav {
+
+namespace {
+
+constexpr Uint32 NO_PARENT = 0xFFFFFFFFu;
+
+int sign(int value) {
+	return (value > 0) - (value < 0);
+}
+
+} // namespace
+
+PathFinder::PathFinder(const NavGrid &grid) :
+		grid(grid) {
+	const size_t count = grid.getCellCount();
+	g_costs.assign(count, 0);
+	parents.assign(count, NO_PARENT);
+	visit_stamps.assign(count, 0);
+	closed_stamps.assign(count, 0);
+	heap.reserve(count);
+}
+
+bool PathFinder::findPath(NavLayer layer, glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2> &path) {
+	PROFILE_SCOPE("PathFinder::findPath");
+	path.clear();
+	last_stats = {};
+	if (!grid.isPassable(layer, start) || !grid.isPassable(layer, goal)) {
+		return false;
+	}
+	if (start == goal) {
+		path.push_back(start);
+		last_stats.found = true;
+		return true;
+	}
+
+	beginSearch();
+	const bool found = layer == NavLayer::Flying ? searchJumpPoint(start, goal) : searchAStar(layer, start, goal);
+	if (found) {
+		last_stats.found = true;
+		last_stats.cost = g_costs[grid.toIndex(goal)];
+		reconstruct(start, goal, path);
+	}
+	return found;
+}
+
+void PathFinder::beginSearch() {
+	if (++generation == 0) {
+		// 代数回绕时清空标记，避免与很久以前的查询混淆
+		std::fill(visit_stamps.begin(), visit_stamps.end(), 0u);
+		std::fill(closed_stamps.begin(), closed_stamps.end(), 0u);
+		generation = 1;
+	}
+	heap.clear();
+}
+
+void PathFinder::relax(Uint32 index, Uint32 parent, Uint32 g_cost, glm::ivec2 goal) {
+	if (closed_stamps[index] == generation) {
+		return;
+	}
+	if (visit_stamps[index] == generation && g_costs[index] <= g_cost) {
+		return;
+	}
+	visit_stamps[index] = generation;
+	g_costs[index] = g_cost;
+	parents[index] = parent;
+	heap.push_back({ g_cost + getOctileDistance(grid.toCell(index), goal), index });
+	std::push_heap(heap.begin(), heap.end(), NavHeapGreater{});
+}
+
+bool PathFinder::searchAStar(NavLayer layer, glm::ivec2 start, glm::ivec2 goal) {
+	const Uint32 goal_index = grid.toIndex(goal);
+	relax(grid.toIndex(start), NO_PARENT, 0, goal);
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), NavHeapGreater{});
+		const Uint32 index = heap.back().index;
+		heap.pop_back();
+		if (closed_stamps[index] == generation) {
+			continue; // 已按更低代价展开过的旧条目
+		}
+		closed_stamps[index] = generation;
+		++last_stats.expanded;
+		if (index == goal_index) {
+			return true;
+		}
+
+		const glm::ivec2 cell = grid.toCell(index);
+		const Uint8 links = grid.getOutgoing(layer, index);
+		for (Uint8 direction = 0; direction < NAV_DIRECTION_COUNT; ++direction) {
+			if (links & (1u << direction)) {
+				relax(grid.toIndex(cell + NAV_DIRECTION_OFFSETS[direction]), index, g_costs[index] + getStepCost(direction), goal);
+			}
+		}
+	}
+	return false;
+}
+
+bool PathFinder::searchJumpPoint(glm::ivec2 start, glm::ivec2 goal) {
+	const Uint32 goal_index = grid.toIndex(goal);
+	relax(grid.toIndex(start), NO_PARENT, 0, goal);
+
+	// 剪枝后的邻居方向，最多 5 个
+	glm::ivec2 directions[NAV_DIRECTION_COUNT];
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), NavHeapGreater{});
+		const Uint32 index = heap.back().index;
+		heap.pop_back();
+		if (closed_stamps[index] == generation) {
+			continue;
+		}
+		closed_stamps[index] = generation;
+		++last_stats.expanded;
+		if (index == goal_index) {
+			return true;
+		}
+
+		const glm::ivec2 cell = grid.toCell(index);
+		size_t count = 0;
+		if (parents[index] == NO_PARENT) {
+			const Uint8 links = grid.getOutgoing(NavLayer::Flying, index);
+			for (Uint8 direction = 0; direction < NAV_DIRECTION_COUNT; ++direction) {
+				if (links & (1u << direction)) {
+					directions[count++] = NAV_DIRECTION_OFFSETS[direction];
+				}
+			}
+		} else {
+			const glm::ivec2 parent = grid.toCell(parents[index]);
+			const int dx = sign(cell.x - parent.x);
+			const int dy = sign(cell.y - parent.y);
+			if (dx != 0 && dy != 0) {
+				const bool open_x = isOpen({ cell.x + dx, cell.y });
+				const bool open_y = isOpen({ cell.x, cell.y + dy });
+				if (open_x) {
+					directions[count++] = { dx, 0 };
+				}
+				if (open_y) {
+					directions[count++] = { 0, dy };
+				}
+				if (open_x && open_y) {
+					directions[count++] = { dx, dy };
+				}
+			} else if (dx != 0) {
+				// 横向移动：上下方向可通过时加入（斜向只在前方也可通过时加入，不切角）
+				const bool next = isOpen({ cell.x + dx, cell.y });
+				const bool down = isOpen({ cell.x, cell.y + 1 });
+				const bool up = isOpen({ cell.x, cell.y - 1 });
+				if (next) {
+					directions[count++] = { dx, 0 };
+					if (down) {
+						directions[count++] = { dx, 1 };
+					}
+					if (up) {
+						directions[count++] = { dx, -1 };
+					}
+				}
+				if (down) {
+					directions[count++] = { 0, 1 };
+				}
+				if (up) {
+					directions[count++] = { 0, -1 };
+				}
+			} else {
+				const bool next = isOpen({ cell.x, cell.y + dy });
+				const bool right = isOpen({ cell.x + 1, cell.y });
+				const bool left = isOpen({ cell.x - 1, cell.y });
+				if (next) {
+					directions[count++] = { 0, dy };
+					if (right) {
+						directions[count++] = { 1, dy };
+					}
+					if (left) {
+						directions[count++] = { -1, dy };
+					}
+				}
+				if (right) {
+					directions[count++] = { 1, 0 };
+				}
+				if (left) {
+					directions[count++] = { -1, 0 };
+				}
+			}
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			glm::ivec2 jump_point;
+			if (jump(cell, directions[i], goal, jump_point)) {
+				relax(grid.toIndex(jump_point), index, g_costs[index] + getOctileDistance(cell, jump_point), goal);
+			}
+		}
+	}
+	return false;
+}
+
+bool PathFinder::jump(glm::ivec2 from, glm::ivec2 direction, glm::ivec2 goal, glm::ivec2 &jump_point) const {
+	if (direction.x == 0 || direction.y == 0) {
+		return jumpStraight(from + direction, direction, goal, jump_point);
+	}
+	glm::ivec2 cell = from + direction;
+	glm::ivec2 unused;
+	while (isOpen(cell)) {
+		// 斜向跳跃的每一步都向两个分量方向做直线跳跃，任一方向遇到跳点则本格是跳点
+		if (cell == goal || jumpStraight({ cell.x + direction.x, cell.y }, { direction.x, 0 }, goal, unused) || jumpStraight({ cell.x, cell.y + direction.y }, { 0, direction.y }, goal, unused)) {
+			jump_point = cell;
+			return true;
+		}
+		if (!isOpen({ cell.x + direction.x, cell.y }) || !isOpen({ cell.x, cell.y + direction.y })) {
+			return false; // 不切角
+		}
+		cell += direction;
+	}
+	return false;
+}
+
+bool PathFinder::jumpStraight(glm::ivec2 cell, glm::ivec2 direction, glm::ivec2 goal, glm::ivec2 &jump_point) const {
+	while (isOpen(cell)) {
+		if (cell == goal) {
+			jump_point = cell;
+			return true;
+		}
+		// 强迫邻居：侧面可通过而侧后方被挡住，最优路径可能在此转向
+		bool forced;
+		if (direction.x != 0) {
+			forced = (isOpen({ cell.x, cell.y - 1 }) && !isOpen({ cell.x - direction.x, cell.y - 1 })) || (isOpen({ cell.x, cell.y + 1 }) && !isOpen({ cell.x - direction.x, cell.y + 1 }));
+		} else {
+			forced = (isOpen({ cell.x - 1, cell.y }) && !isOpen({ cell.x - 1, cell.y - direction.y })) || (isOpen({ cell.x + 1, cell.y }) && !isOpen({ cell.x + 1, cell.y - direction.y }));
+		}
+		if (forced) {
+			jump_point = cell;
+			return true;
+		}
+		cell += direction;
+	}
+	return false;
+}
+
+void PathFinder::reconstruct(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2> &path) const {
+	Uint32 index = grid.toIndex(goal);
+	const Uint32 start_index = grid.toIndex(start);
+	while (index != start_index) {
+		path.push_back(grid.toCell(index));
+		index = parents[index];
+	}
+	path.push_back(start);
+	std::reverse(path.begin(), path.end());
+}
+
+} // namespace engine::nav
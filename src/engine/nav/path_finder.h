@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "nav_grid.h"
+
+namespace engine::nav {
+
+/// @brief 上一次寻路的统计
+struct PathStats {
+	Uint32 expanded = 0; ///< @brief 从开放表取出并展开的节点数
+	Uint32 cost = 0; ///< @brief 路径代价（NAV_STRAIGHT_COST 为一格），未找到时为 0
+	bool found = false;
+};
+
+/**
+ * @brief 一次性点到点寻路
+ *
+ * 飞行图层是代价统一的 8 方向网格，使用跳点搜索（JPS，不切角的变体）：沿直线与对角线跳跃，只把有强迫邻居的格子放入开放表，
+ * 展开的节点数比普通 A* 少一个数量级。行走图层的边有方向（下落不可逆），不满足 JPS 的对称性前提，使用普通 A*。
+ *
+ * 搜索状态按格子数一次分配并以代数标记区分各次查询，重复查询不清空数组、不分配内存（输出路径的容量除外）。
+ */
+class PathFinder final {
+private:
+	const NavGrid &grid;
+	std::vector<Uint32> g_costs;
+	std::vector<Uint32> parents;
+	std::vector<Uint32> visit_stamps; ///< @brief 等于 generation 时 g_costs / parents 有效
+	std::vector<Uint32> closed_stamps;
+	std::vector<NavHeapEntry> heap; ///< @brief cost 为 f = g + h
+	Uint32 generation = 0;
+	PathStats last_stats;
+
+public:
+	explicit PathFinder(const NavGrid &grid);
+
+	PathFinder(const PathFinder &) = delete;
+	PathFinder &operator=(const PathFinder &) = delete;
+	PathFinder(PathFinder &&) = delete;
+	PathFinder &operator=(PathFinder &&) = delete;
+
+	/**
+	 * @brief 查找从 start 到 goal 的路径
+	 *
+	 * @param path 输出路径点（含起点与终点）。行走图层为逐格路径；飞行图层为跳点，相邻两点之间是一段横、竖或 45° 斜线。
+	 * @return 是否找到路径，未找到时 path 为空
+	 */
+	bool findPath(NavLayer layer, glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2> &path);
+
+	const PathStats &getLastStats() const { return last_stats; }
+
+private:
+	void beginSearch();
+	bool isOpen(glm::ivec2 cell) const { return grid.isPassable(NavLayer::Flying, cell); }
+	/// @brief 访问一个节点，代价更低时更新并放入开放表
+	void relax(Uint32 index, Uint32 parent, Uint32 g_cost, glm::ivec2 goal);
+	bool searchAStar(NavLayer layer, glm::ivec2 start, glm::ivec2 goal);
+	bool searchJumpPoint(glm::ivec2 start, glm::ivec2 goal);
+	/// @brief 从 from 沿 direction 跳跃，返回遇到的跳点；没有跳点时返回 false
+	bool jump(glm::ivec2 from, glm::ivec2 direction, glm::ivec2 goal, glm::ivec2 &jump_point) const;
+	bool jumpStraight(glm::ivec2 cell, glm::ivec2 direction, glm::ivec2 goal, glm::ivec2 &jump_point) const;
+	void reconstruct(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2> &path) const;
+};
+
+} // namespace engine::nav
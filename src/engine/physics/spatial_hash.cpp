@@ -0,0 +1,170 @@
+#include "spatial_hash.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace engine::physics {
+
+namespace {
+
+bool overlaps(const engine::utils::Rect &a, const engine::utils::Rect &b) {
+	return a.position.x < b.position.x + b.size.x && b.position.x < a.position.x + a.size.x &&
+			a.position.y < b.position.y + b.size.y && b.position.y < a.position.y + a.size.y;
+}
+
+} // namespace
+
+Uint32 collisionLayerFromTag(std::string_view tag) {
+	if (tag == "player") {
+		return COLLISION_LAYER_PLAYER;
+	}
+	if (tag == "enemy") {
+		return COLLISION_LAYER_ENEMY;
+	}
+	if (tag == "item") {
+		return COLLISION_LAYER_ITEM;
+	}
+	if (tag == "hazard") {
+		return COLLISION_LAYER_HAZARD;
+	}
+	return COLLISION_LAYER_NONE;
+}
+
+Uint32 defaultCollisionMask(Uint32 layer) {
+	if (layer & COLLISION_LAYER_PLAYER) {
+		return COLLISION_LAYER_ENEMY | COLLISION_LAYER_ITEM | COLLISION_LAYER_HAZARD;
+	}
+	return layer == COLLISION_LAYER_NONE ? COLLISION_LAYER_NONE : COLLISION_LAYER_PLAYER;
+}
+
+SpatialHash::SpatialHash(float cell_size) :
+		cell_size(cell_size), inverse_cell_size(1.0f / cell_size) {
+	if (cell_size <= 0.0f) {
+		throw std::runtime_error("SpatialHash cell size must be positive");
+	}
+}
+
+int SpatialHash::toCell(float value) const {
+	return static_cast<int>(std::floor(value * inverse_cell_size));
+}
+
+Uint32 SpatialHash::bucketOf(int x, int y) const {
+	return ((static_cast<Uint32>(x) * 73856093u) ^ (static_cast<Uint32>(y) * 19349663u)) & bucket_mask;
+}
+
+void SpatialHash::clear() {
+	proxies.clear();
+	entries.clear();
+	built = false;
+}
+
+Uint32 SpatialHash::insert(const engine::utils::Rect &box, Uint32 layer, Uint32 mask) {
+	Proxy proxy;
+	proxy.box = box;
+	proxy.layer = layer;
+	proxy.mask = mask;
+	proxy.min_x = toCell(box.position.x);
+	proxy.min_y = toCell(box.position.y);
+	// 右/下边界是开区间，恰好落在格线上的边不占下一格
+	proxy.max_x = std::max(proxy.min_x, static_cast<int>(std::ceil((box.position.x + box.size.x) * inverse_cell_size)) - 1);
+	proxy.max_y = std::max(proxy.min_y, static_cast<int>(std::ceil((box.position.y + box.size.y) * inverse_cell_size)) - 1);
+	proxies.push_back(proxy);
+	built = false;
+	return static_cast<Uint32>(proxies.size() - 1);
+}
+
+void SpatialHash::build() {
+	scratch.clear();
+	for (Uint32 i = 0; i < proxies.size(); ++i) {
+		const Proxy &proxy = proxies[i];
+		for (int y = proxy.min_y; y <= proxy.max_y; ++y) {
+			for (int x = proxy.min_x; x <= proxy.max_x; ++x) {
+				scratch.push_back({ x, y, i });
+			}
+		}
+	}
+
+	// 桶数量取不小于条目数 2 倍的 2 的幂，保持桶内冲突很少
+	Uint32 bucket_count = std::bit_ceil(std::max<Uint32>(64, static_cast<Uint32>(scratch.size() * 2)));
+	bucket_mask = bucket_count - 1;
+	bucket_starts.assign(bucket_count + 1, 0);
+	for (const CellEntry &entry : scratch) {
+		++bucket_starts[bucketOf(entry.x, entry.y) + 1];
+	}
+	for (Uint32 i = 0; i < bucket_count; ++i) {
+		bucket_starts[i + 1] += bucket_starts[i];
+	}
+
+	// 计数排序：按桶散列到 entries，桶内保持插入顺序
+	entries.resize(scratch.size());
+	bucket_cursor.assign(bucket_starts.begin(), bucket_starts.end() - 1);
+	for (const CellEntry &entry : scratch) {
+		entries[bucket_cursor[bucketOf(entry.x, entry.y)]++] = entry;
+	}
+	built = true;
+}
+
+void SpatialHash::findPairs(std::vector<BroadPhasePair> &pairs) const {
+	if (!built) {
+		return;
+	}
+	const Uint32 bucket_count = bucket_mask + 1;
+	for (Uint32 bucket = 0; bucket < bucket_count; ++bucket) {
+		Uint32 begin = bucket_starts[bucket];
+		Uint32 end = bucket_starts[bucket + 1];
+		for (Uint32 i = begin; i + 1 < end; ++i) {
+			const CellEntry &a = entries[i];
+			const Proxy &proxy_a = proxies[a.proxy];
+			for (Uint32 j = i + 1; j < end; ++j) {
+				const CellEntry &b = entries[j];
+				if (a.x != b.x || a.y != b.y) {
+					continue; // 哈希冲突的不同格子
+				}
+				const Proxy &proxy_b = proxies[b.proxy];
+				if (!(proxy_a.layer & proxy_b.mask) || !(proxy_b.layer & proxy_a.mask)) {
+					continue;
+				}
+				// 只在两者覆盖范围交集的左上格报告，避免跨越多个格子时重复
+				if (a.x != std::max(proxy_a.min_x, proxy_b.min_x) || a.y != std::max(proxy_a.min_y, proxy_b.min_y)) {
+					continue;
+				}
+				if (!overlaps(proxy_a.box, proxy_b.box)) {
+					continue;
+				}
+				pairs.push_back({ std::min(a.proxy, b.proxy), std::max(a.proxy, b.proxy) });
+			}
+		}
+	}
+}
+
+void SpatialHash::query(const engine::utils::Rect &area, Uint32 mask, std::vector<Uint32> &results) const {
+	if (!built) {
+		return;
+	}
+	int min_x = toCell(area.position.x);
+	int min_y = toCell(area.position.y);
+	int max_x = std::max(min_x, static_cast<int>(std::ceil((area.position.x + area.size.x) * inverse_cell_size)) - 1);
+	int max_y = std::max(min_y, static_cast<int>(std::ceil((area.position.y + area.size.y) * inverse_cell_size)) - 1);
+	for (int y = min_y; y <= max_y; ++y) {
+		for (int x = min_x; x <= max_x; ++x) {
+			Uint32 bucket = bucketOf(x, y);
+			for (Uint32 i = bucket_starts[bucket]; i < bucket_starts[bucket + 1]; ++i) {
+				const CellEntry &entry = entries[i];
+				if (entry.x != x || entry.y != y) {
+					continue;
+				}
+				const Proxy &proxy = proxies[entry.proxy];
+				if (!(proxy.layer & mask) || x != std::max(proxy.min_x, min_x) || y != std::max(proxy.min_y, min_y)) {
+					continue;
+				}
+				if (overlaps(proxy.box, area)) {
+					results.push_back(entry.proxy);
+				}
+			}
+		}
+	}
+}
+
+} // namespace engine::physics
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include "../utils/math.h"
+
+namespace engine::physics {
+
+/// @brief 碰撞层，代理只与 mask 中包含自己所在层、且自己的 mask 包含对方层的代理配对
+enum CollisionLayer : Uint32 {
+	COLLISION_LAYER_NONE = 0,
+	COLLISION_LAYER_PLAYER = 1u << 0,
+	COLLISION_LAYER_ENEMY = 1u << 1,
+	COLLISION_LAYER_ITEM = 1u << 2,
+	COLLISION_LAYER_HAZARD = 1u << 3,
+	COLLISION_LAYER_ALL = 0xFFFFFFFFu,
+};
+
+/// @brief 由 actor 图块的 "tag" 属性推断碰撞层（player / enemy / item / hazard），未知时返回 NONE
+Uint32 collisionLayerFromTag(std::string_view tag);
+
+/// @brief 默认的碰撞掩码：玩家与敌人、道具、伤害区相交，其余层只关心玩家
+Uint32 defaultCollisionMask(Uint32 layer);
+
+/// @brief 候选碰撞对（代理索引，first < second）
+struct BroadPhasePair {
+	Uint32 first = 0;
+	Uint32 second = 0;
+};
+
+/**
+ * @brief 动态碰撞宽相：以格子大小（默认与 16px 瓦片一致）划分的均匀空间哈希。
+ *
+ * 每个逻辑帧 clear() 后重新 insert() 所有代理，再调用 build()。build() 用计数排序把
+ * 代理覆盖的格子按哈希桶连续存放，整个过程是 O(代理覆盖的格子数)，不涉及逐帧的内存分配（容量稳定后）。
+ * findPairs() 只在两个 AABB 交集左上角所在的格子里报告一次配对，因此无需哈希集合去重。
+ */
+class SpatialHash final {
+private:
+	struct Proxy {
+		engine::utils::Rect box;
+		Uint32 layer = COLLISION_LAYER_NONE;
+		Uint32 mask = COLLISION_LAYER_NONE;
+		int min_x = 0; ///< @brief 覆盖的格子范围（含）
+		int min_y = 0;
+		int max_x = 0;
+		int max_y = 0;
+	};
+
+	struct CellEntry {
+		int x = 0;
+		int y = 0;
+		Uint32 proxy = 0;
+	};
+
+	float cell_size;
+	float inverse_cell_size;
+	std::vector<Proxy> proxies;
+	std::vector<Uint32> bucket_starts; ///< @brief 桶 i 的条目范围为 [bucket_starts[i], bucket_starts[i + 1])
+	std::vector<CellEntry> entries; ///< @brief 按桶排序
+	std::vector<CellEntry> scratch; ///< @brief 未排序的条目
+	std::vector<Uint32> bucket_cursor;
+	Uint32 bucket_mask = 0;
+	bool built = false;
+
+public:
+	explicit SpatialHash(float cell_size = 16.0f);
+
+	void clear(); ///< @brief 移除所有代理（保留容量）
+
+	/// @brief 加入一个代理并返回其索引（按插入顺序从 0 递增）
+	Uint32 insert(const engine::utils::Rect &box, Uint32 layer, Uint32 mask);
+
+	void build(); ///< @brief 插入完成后构建格子索引
+
+	/// @brief 输出所有层/掩码匹配且 AABB 相交的代理对，每对只出现一次（需要先 build）
+	void findPairs(std::vector<BroadPhasePair> &pairs) const;
+
+	/// @brief 输出与区域相交且所在层包含在 mask 中的代理（需要先 build）
+	void query(const engine::utils::Rect &area, Uint32 mask, std::vector<Uint32> &results) const;
+
+	size_t getProxyCount() const { return proxies.size(); }
+	size_t getCellEntryCount() const { return entries.size(); }
+	float getCellSize() const { return cell_size; }
+
+private:
+	int toCell(float value) const;
+	Uint32 bucketOf(int x, int y) const;
+};
+
+} // namespace engine::physics
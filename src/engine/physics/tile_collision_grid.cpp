@@ -0,0 +1,271 @@
+#include "tile_collision_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace engine::physics {
+
+namespace {
+
+constexpr float EPSILON = 0.001f;
+constexpr float NO_SURFACE = std::numeric_limits<float>::infinity();
+
+int toCell(float value, float cell_size) {
+	return static_cast<int>(std::floor(value / cell_size));
+}
+
+} // namespace
+
+TileCollisionGrid::TileCollisionGrid(const engine::map::TileMap &map, std::string_view layer_name) :
+		tile_size(static_cast<float>(map.tile_width), static_cast<float>(map.tile_height)) {
+	const engine::map::TileLayer *layer = map.findTileLayer(layer_name);
+	if (!layer) {
+		spdlog::warn("TileCollisionGrid: map '{}' has no tile layer '{}', grid is empty.", map.path, layer_name);
+		return;
+	}
+
+	width = layer->width;
+	height = layer->height;
+	cells.resize(static_cast<size_t>(width) * height);
+
+	int solid_count = 0;
+	for (size_t i = 0; i < cells.size(); ++i) {
+		Uint32 gid = layer->gids[i];
+		engine::map::TileProperties properties = map.getTileProperties(gid);
+		// 水平翻转的斜坡左右高度互换
+		if ((properties.flags & engine::map::TILE_FLAG_SLOPE) && (gid & engine::map::FLIPPED_HORIZONTALLY_FLAG)) {
+			std::swap(properties.slope_left, properties.slope_right);
+		}
+		properties.flags &= ~engine::map::TILE_FLAG_ANIMATED; // 与碰撞无关
+		if (properties.flags != engine::map::TILE_FLAG_NONE) {
+			++solid_count;
+		}
+		cells[i] = properties;
+	}
+	spdlog::debug("TileCollisionGrid: {}x{} cells, {} non-empty.", width, height, solid_count);
+}
+
+const engine::map::TileProperties &TileCollisionGrid::getCell(int x, int y) const {
+	static const engine::map::TileProperties EMPTY{};
+	if (x < 0 || y < 0 || x >= width || y >= height) {
+		return EMPTY;
+	}
+	return cells[static_cast<size_t>(y) * width + x];
+}
+
+float TileCollisionGrid::getSlopeSurface(int x, int y, float world_x) const {
+	const engine::map::TileProperties &cell = getCell(x, y);
+	float t = std::clamp((world_x - x * tile_size.x) / tile_size.x, 0.0f, 1.0f);
+	float height_units = static_cast<float>(cell.slope_left) + (static_cast<float>(cell.slope_right) - cell.slope_left) * t;
+	return (y + 1) * tile_size.y - height_units * tile_size.y * 0.5f;
+}
+
+bool TileCollisionGrid::overlaps(const engine::utils::Rect &box, Uint16 flags) const {
+	int left = toCell(box.position.x, tile_size.x);
+	int right = toCell(box.position.x + box.size.x - EPSILON, tile_size.x);
+	int top = toCell(box.position.y, tile_size.y);
+	int bottom = toCell(box.position.y + box.size.y - EPSILON, tile_size.y);
+	for (int y = top; y <= bottom; ++y) {
+		for (int x = left; x <= right; ++x) {
+			if (getCell(x, y).flags & flags) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+float TileCollisionGrid::getBlockingSurface(int x, int y, bool moving_right) const {
+	const engine::map::TileProperties &cell = getCell(x, y);
+	if (cell.flags & engine::map::TILE_FLAG_SOLID) {
+		return y * tile_size.y;
+	}
+	if (cell.flags & engine::map::TILE_FLAG_SLOPE) {
+		// 从左侧进入时看左边缘高度，反之看右边缘
+		Uint8 entry_height = moving_right ? cell.slope_left : cell.slope_right;
+		return (y + 1) * tile_size.y - entry_height * tile_size.y * 0.5f;
+	}
+	return NO_SURFACE;
+}
+
+bool TileCollisionGrid::isPlatformTop(int x, int y, const TileMoveOptions &options) const {
+	if (options.drop_through) {
+		return false;
+	}
+	const engine::map::TileProperties &cell = getCell(x, y);
+	if (cell.flags & engine::map::TILE_FLAG_UNISOLID) {
+		return true;
+	}
+	// 梯子最上面一格的顶部可以站立，攀爬时不阻挡
+	return !options.climbing && (cell.flags & engine::map::TILE_FLAG_LADDER) && !(getCell(x, y - 1).flags & engine::map::TILE_FLAG_LADDER);
+}
+
+TileMoveResult TileCollisionGrid::move(const engine::utils::Rect &box, const glm::vec2 &displacement, const TileMoveOptions &options) const {
+	TileMoveResult result;
+	glm::vec2 position = box.position;
+	const glm::vec2 &size = box.size;
+
+	TileMoveOptions resolved = options;
+	if (resolved.step_height < 0.0f) {
+		resolved.step_height = tile_size.y * 0.5f;
+	}
+	if (resolved.snap_distance < 0.0f) {
+		resolved.snap_distance = tile_size.y * 0.5f;
+	}
+
+	if (displacement.x != 0.0f) {
+		sweepX(position, size, displacement.x, resolved, result);
+	}
+	sweepY(position, size, displacement.y, resolved, result);
+
+	// 下坡吸附：上一步着地、本步没有向上运动却离开了地面时，向下探测一小段距离
+	if (!result.on_ground && resolved.was_on_ground && displacement.y >= 0.0f) {
+		TileMoveResult probe;
+		glm::vec2 probe_position = position;
+		sweepY(probe_position, size, resolved.snap_distance, resolved, probe);
+		result.cells_checked += probe.cells_checked;
+		if (probe.on_ground) {
+			position = probe_position;
+			result.on_ground = true;
+			result.on_slope = probe.on_slope;
+		}
+	}
+
+	engine::utils::Rect final_box{ position, size };
+	result.on_ladder = overlaps(final_box, engine::map::TILE_FLAG_LADDER);
+	result.in_hazard = overlaps(final_box, engine::map::TILE_FLAG_HAZARD);
+	result.position = position;
+	return result;
+}
+
+void TileCollisionGrid::sweepX(glm::vec2 &position, const glm::vec2 &size, float dx, const TileMoveOptions &options, TileMoveResult &result) const {
+	const bool moving_right = dx > 0.0f;
+	const float leading_edge = moving_right ? position.x + size.x : position.x;
+	// 只检查前沿新跨入的格子列，当前已覆盖的列不再检查
+	int first_column = moving_right ? toCell(leading_edge - EPSILON, tile_size.x) + 1 : toCell(leading_edge, tile_size.x) - 1;
+	int last_column = moving_right ? toCell(leading_edge + dx - EPSILON, tile_size.x) : toCell(leading_edge + dx, tile_size.x);
+	const int step = moving_right ? 1 : -1;
+
+	for (int x = first_column; moving_right ? x <= last_column : x >= last_column; x += step) {
+		float bottom = position.y + size.y;
+		int top_row = toCell(position.y, tile_size.y);
+		int bottom_row = toCell(bottom - EPSILON, tile_size.y);
+
+		// 这一列中阻挡物的最高表面
+		float surface = NO_SURFACE;
+		for (int y = top_row; y <= bottom_row; ++y) {
+			surface = std::min(surface, getBlockingSurface(x, y, moving_right));
+		}
+		result.cells_checked += bottom_row - top_row + 1;
+
+		if (surface >= bottom - EPSILON) {
+			continue; // 表面不高于脚底（斜坡起点、平地）
+		}
+
+		// 台阶：着地时可以跨上不超过 step_height 的高度，前提是抬升后这一列有足够的空间
+		float rise = bottom - surface;
+		if (options.was_on_ground && rise <= options.step_height) {
+			int lifted_top = toCell(surface - size.y, tile_size.y);
+			int lifted_bottom = toCell(surface - EPSILON, tile_size.y);
+			result.cells_checked += lifted_bottom - lifted_top + 1;
+			float lifted_surface = NO_SURFACE;
+			for (int y = lifted_top; y <= lifted_bottom; ++y) {
+				lifted_surface = std::min(lifted_surface, getBlockingSurface(x, y, moving_right));
+			}
+			if (lifted_surface >= surface - EPSILON) {
+				position.y = surface - size.y;
+				continue;
+			}
+		}
+
+		if (moving_right) {
+			position.x = x * tile_size.x - size.x;
+			result.hit_right = true;
+		} else {
+			position.x = (x + 1) * tile_size.x;
+			result.hit_left = true;
+		}
+		return;
+	}
+
+	position.x += dx;
+}
+
+void TileCollisionGrid::sweepY(glm::vec2 &position, const glm::vec2 &size, float dy, const TileMoveOptions &options, TileMoveResult &result) const {
+	int left_column = toCell(position.x, tile_size.x);
+	int right_column = toCell(position.x + size.x - EPSILON, tile_size.x);
+
+	if (dy < 0.0f) {
+		// 向上：实心格子与斜坡的底面都是天花板
+		int first_row = toCell(position.y + EPSILON, tile_size.y) - 1;
+		int last_row = toCell(position.y + dy, tile_size.y);
+		for (int y = first_row; y >= last_row; --y) {
+			for (int x = left_column; x <= right_column; ++x) {
+				++result.cells_checked;
+				if (getCell(x, y).flags & (engine::map::TILE_FLAG_SOLID | engine::map::TILE_FLAG_SLOPE)) {
+					position.y = (y + 1) * tile_size.y;
+					result.hit_ceiling = true;
+					return;
+				}
+			}
+		}
+		position.y += dy;
+		return;
+	}
+
+	// 向下：从脚底所在行开始（斜坡表面可能在行中间），找到最高的合法落脚面
+	const float bottom = position.y + size.y;
+	const float target_bottom = bottom + dy;
+	const float center_x = position.x + size.x * 0.5f;
+	const int center_column = toCell(center_x, tile_size.x);
+	int first_row = toCell(bottom - EPSILON, tile_size.y);
+	int last_row = toCell(target_bottom, tile_size.y);
+
+	float landing = NO_SURFACE;
+	bool landing_on_slope = false;
+	for (int y = first_row; y <= last_row && landing == NO_SURFACE; ++y) {
+		for (int x = left_column; x <= right_column; ++x) {
+			++result.cells_checked;
+			const engine::map::TileProperties &cell = getCell(x, y);
+			float surface = NO_SURFACE;
+			bool slope = false;
+			if (cell.flags & engine::map::TILE_FLAG_SLOPE) {
+				// 斜坡只在碰撞框中心所在的列取样，允许向上推回 step_height 以内的穿透
+				if (x != center_column) {
+					continue;
+				}
+				surface = getSlopeSurface(x, y, center_x);
+				if (surface < bottom - options.step_height) {
+					continue;
+				}
+				slope = true;
+			} else if ((cell.flags & engine::map::TILE_FLAG_SOLID) || isPlatformTop(x, y, options)) {
+				// 单向平台只在移动前位于其上方时阻挡
+				surface = y * tile_size.y;
+				if (surface < bottom - EPSILON) {
+					continue;
+				}
+			} else {
+				continue;
+			}
+			if (surface <= target_bottom && surface < landing) {
+				landing = surface;
+				landing_on_slope = slope;
+			}
+		}
+	}
+
+	if (landing != NO_SURFACE) {
+		position.y = landing - size.y;
+		result.on_ground = true;
+		result.on_slope = landing_on_slope;
+		return;
+	}
+	position.y += dy;
+}
+
+} // namespace engine::physics
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "../map/tile_map.h"
+#include "../utils/math.h"
+
+namespace engine::physics {
+
+/// @brief 一次移动的附加条件
+struct TileMoveOptions {
+	bool was_on_ground = false; ///< @brief 上一步是否着地，着地时启用台阶攀升与下坡吸附
+	bool drop_through = false; ///< @brief 穿过单向平台（含梯子顶端）
+	bool climbing = false; ///< @brief 正在攀爬，梯子顶端不阻挡
+	float step_height = -1.0f; ///< @brief 可直接跨上的高度（像素），负数表示半个图块
+	float snap_distance = -1.0f; ///< @brief 下坡时向下吸附的最大距离（像素），负数表示半个图块
+};
+
+/// @brief 一次移动的结果
+struct TileMoveResult {
+	glm::vec2 position = glm::vec2(0.0f); ///< @brief 碰撞框解算后的左上角
+	bool on_ground = false;
+	bool on_slope = false;
+	bool hit_ceiling = false;
+	bool hit_left = false;
+	bool hit_right = false;
+	bool on_ladder = false; ///< @brief 碰撞框与梯子区域重叠
+	bool in_hazard = false; ///< @brief 碰撞框与伤害区域重叠
+	int cells_checked = 0; ///< @brief 本次检查的格子数量，用于性能诊断
+};
+
+/**
+ * @brief 瓦片碰撞网格：把图层中每个格子的碰撞属性编译为每格 4 字节的标志/斜坡高度数组。
+ *
+ * move() 按轴分离的扫掠 AABB 解算：先水平、后垂直，每个方向只检查运动实际跨越的格子列/行，
+ * 开销与跨越的格子数成正比，与关卡大小无关。
+ * 斜坡高度以半个图块为单位（0..2），表示格子左/右边缘处的地面高度（从格子底部向上）。
+ */
+class TileCollisionGrid final {
+private:
+	int width = 0;
+	int height = 0;
+	glm::vec2 tile_size = glm::vec2(16.0f);
+	std::vector<engine::map::TileProperties> cells; ///< @brief 行优先，水平翻转的斜坡已交换左右高度
+
+public:
+	/**
+	 * @brief 从地图的指定瓦片图层构建网格
+	 *
+	 * @param map 已加载的地图（需要已构建 tile_properties）。
+	 * @param layer_name 碰撞图层名称，找不到时网格为空（所有格子都可通过）。
+	 */
+	explicit TileCollisionGrid(const engine::map::TileMap &map, std::string_view layer_name = "main");
+
+	/**
+	 * @brief 移动一个碰撞框并解算与网格的碰撞
+	 *
+	 * @param box 碰撞框（世界坐标）。
+	 * @param displacement 本步位移。
+	 */
+	[[nodiscard]] TileMoveResult move(const engine::utils::Rect &box, const glm::vec2 &displacement, const TileMoveOptions &options = {}) const;
+
+	/// @brief 碰撞框覆盖的格子中是否存在任一指定标志
+	[[nodiscard]] bool overlaps(const engine::utils::Rect &box, Uint16 flags) const;
+
+	/// @brief 获取格子属性，越界时返回空格子
+	[[nodiscard]] const engine::map::TileProperties &getCell(int x, int y) const;
+
+	/// @brief 斜坡格子在世界坐标 x 处的地面 y 坐标
+	[[nodiscard]] float getSlopeSurface(int x, int y, float world_x) const;
+
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+	const glm::vec2 &getTileSize() const { return tile_size; }
+
+private:
+	void sweepX(glm::vec2 &position, const glm::vec2 &size, float dx, const TileMoveOptions &options, TileMoveResult &result) const;
+	void sweepY(glm::vec2 &position, const glm::vec2 &size, float dy, const TileMoveOptions &options, TileMoveResult &result) const;
+
+	/// @brief 格子在进入边一侧对水平运动构成的地面高度（y 坐标），不阻挡时返回 +inf
+	float getBlockingSurface(int x, int y, bool moving_right) const;
+	bool isPlatformTop(int x, int y, const TileMoveOptions &options) const; ///< @brief 单向平台或梯子顶端
+};
+
+} // namespace engine::physics
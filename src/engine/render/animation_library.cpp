@@ -0,0 +1,178 @@
+#include "animation_library.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../map/tile_map.h"
+#include "../resource/asset_archive.h"
+
+namespace engine::render {
+
+Uint16 AnimationLibrary::addClip(std::string_view name, std::span<const SDL_FRect> rects, std::span<const float> durations_ms, bool loop) {
+	if (auto it = clip_names.find(name); it != clip_names.end()) {
+		return it->second;
+	}
+	if (rects.empty() || rects.size() != durations_ms.size() || rects.size() > std::numeric_limits<Uint16>::max()) {
+		spdlog::warn("AnimationLibrary: invalid frame data for clip '{}'.", name);
+		return INVALID_CLIP;
+	}
+	if (clips.size() >= INVALID_CLIP) {
+		spdlog::error("AnimationLibrary: too many clips, '{}' dropped.", name);
+		return INVALID_CLIP;
+	}
+
+	AnimationClip clip;
+	clip.first_frame = static_cast<Uint32>(frame_rects.size());
+	clip.frame_count = static_cast<Uint16>(rects.size());
+	clip.loop = loop;
+	frame_rects.insert(frame_rects.end(), rects.begin(), rects.end());
+	for (float duration_ms : durations_ms) {
+		float seconds = std::max(duration_ms, MIN_FRAME_DURATION_MS) / 1000.0f;
+		frame_durations.push_back(seconds);
+		clip.duration += seconds;
+	}
+
+	Uint16 index = static_cast<Uint16>(clips.size());
+	clips.push_back(clip);
+	clip_names.emplace(std::string(name), index);
+	return index;
+}
+
+Uint16 AnimationLibrary::compileSheet(std::string_view sheet, const nlohmann::json &clips_json, glm::vec2 frame_size) {
+	if (auto it = default_clips.find(sheet); it != default_clips.end()) {
+		return it->second;
+	}
+	if (frame_size.x <= 0.0f || frame_size.y <= 0.0f) {
+		return INVALID_CLIP;
+	}
+
+	nlohmann::json definitions;
+	try {
+		// Tiled 的自定义属性只能是字符串，内容本身是一段 JSON
+		definitions = clips_json.is_string() ? nlohmann::json::parse(clips_json.get<std::string>()) : clips_json;
+	} catch (const nlohmann::json::exception &e) {
+		spdlog::warn("AnimationLibrary: failed to parse clips for '{}': {}", sheet, e.what());
+		return INVALID_CLIP;
+	}
+	if (!definitions.is_object() || definitions.empty()) {
+		spdlog::warn("AnimationLibrary: no clips defined for '{}'.", sheet);
+		return INVALID_CLIP;
+	}
+
+	Uint16 default_clip = INVALID_CLIP;
+	std::vector<SDL_FRect> rects;
+	std::vector<float> durations;
+	for (const auto &[clip_name, definition] : definitions.items()) {
+		if (!definition.is_object() || !definition.contains("frames") || !definition["frames"].is_array()) {
+			spdlog::warn("AnimationLibrary: clip '{}' of '{}' has no frame list.", clip_name, sheet);
+			continue;
+		}
+		float row = definition.value("row", 0.0f);
+		float duration_ms = definition.value("duration", DEFAULT_FRAME_DURATION_MS);
+		rects.clear();
+		durations.clear();
+		for (const auto &column : definition["frames"]) {
+			if (!column.is_number()) {
+				continue;
+			}
+			rects.push_back({ column.get<float>() * frame_size.x, row * frame_size.y, frame_size.x, frame_size.y });
+			durations.push_back(duration_ms);
+		}
+
+		Uint16 clip = addClip(makeClipName(sheet, clip_name), rects, durations, definition.value("loop", true));
+		if (clip != INVALID_CLIP && (default_clip == INVALID_CLIP || clip_name == "idle")) {
+			default_clip = clip;
+		}
+	}
+
+	default_clips.emplace(std::string(sheet), default_clip);
+	return default_clip;
+}
+
+Uint16 AnimationLibrary::compileTileAnimation(const engine::map::TileMap &tile_map, const engine::map::TileInfo &info) {
+	if (!info.tileset || !info.data || info.data->animation.empty() || info.tileset->image.empty()) {
+		return INVALID_CLIP;
+	}
+	std::string name = makeClipName(info.tileset->image, "tile" + std::to_string(info.local_id));
+	if (Uint16 clip = findClip(name); clip != INVALID_CLIP) {
+		return clip;
+	}
+
+	std::vector<SDL_FRect> rects;
+	std::vector<float> durations;
+	rects.reserve(info.data->animation.size());
+	durations.reserve(info.data->animation.size());
+	for (const engine::map::TileAnimationFrame &frame : info.data->animation) {
+		auto frame_info = tile_map.resolveGid(info.tileset->firstgid + static_cast<Uint32>(frame.tile_id));
+		if (!frame_info) {
+			spdlog::warn("AnimationLibrary: animation of tile {} in '{}' references missing tile {}.", info.local_id, info.tileset->name, frame.tile_id);
+			return INVALID_CLIP;
+		}
+		rects.push_back(frame_info->source_rect);
+		durations.push_back(static_cast<float>(frame.duration_ms));
+	}
+	return addClip(name, rects, durations);
+}
+
+int AnimationLibrary::loadClipFile(const std::string &path, const engine::resource::AssetArchive *archive) {
+	nlohmann::json json;
+	try {
+		if (const engine::resource::pak::EntryRecord *entry = archive ? archive->find(path) : nullptr) {
+			auto bytes = archive->getStoredBytes(*entry);
+			const char *begin = reinterpret_cast<const char *>(bytes.data());
+			json = nlohmann::json::parse(begin, begin + bytes.size());
+		} else {
+			std::ifstream file(path);
+			if (!file) {
+				spdlog::error("AnimationLibrary: failed to open clip file '{}'.", path);
+				return 0;
+			}
+			file >> json;
+		}
+	} catch (const nlohmann::json::exception &e) {
+		spdlog::error("AnimationLibrary: failed to parse clip file '{}': {}", path, e.what());
+		return 0;
+	}
+	if (!json.is_object()) {
+		spdlog::error("AnimationLibrary: clip file '{}' must contain an object.", path);
+		return 0;
+	}
+
+	int compiled = 0;
+	for (const auto &[sheet, definition] : json.items()) {
+		if (!definition.is_object() || !definition.contains("clips")) {
+			spdlog::warn("AnimationLibrary: sheet '{}' in '{}' has no clips.", sheet, path);
+			continue;
+		}
+		glm::vec2 frame_size(definition.value("frame_width", 0.0f), definition.value("frame_height", 0.0f));
+		if (compileSheet(sheet, definition["clips"], frame_size) != INVALID_CLIP) {
+			++compiled;
+		}
+	}
+	spdlog::debug("AnimationLibrary: '{}' compiled {} sheets ({} clips, {} frames total).", path, compiled, clips.size(), frame_rects.size());
+	return compiled;
+}
+
+Uint16 AnimationLibrary::findClip(std::string_view name) const {
+	auto it = clip_names.find(name);
+	return it != clip_names.end() ? it->second : INVALID_CLIP;
+}
+
+Uint16 AnimationLibrary::findClip(std::string_view sheet, std::string_view clip) const {
+	return findClip(makeClipName(sheet, clip));
+}
+
+std::string AnimationLibrary::makeClipName(std::string_view sheet, std::string_view clip) {
+	std::string name;
+	name.reserve(sheet.size() + clip.size() + 1);
+	name.append(sheet);
+	name.push_back('#');
+	name.append(clip);
+	return name;
+}
+
+} // namespace engine::render
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL3/SDL_rect.h>
+#include <glm/vec2.hpp>
+#include <nlohmann/json_fwd.hpp>
+
+#include "../utils/string_hash.h"
+
+namespace engine::resource {
+class AssetArchive;
+}
+
+namespace engine::map {
+class TileMap;
+struct TileInfo;
+} // namespace engine::map
+
+namespace engine::render {
+
+/// @brief 编译后的动画片段，指向 AnimationLibrary 帧表中连续的一段
+struct AnimationClip {
+	Uint32 first_frame = 0; ///< @brief 在帧表中的起始下标
+	Uint16 frame_count = 0;
+	bool loop = true;
+	float duration = 0.0f; ///< @brief 所有帧时长之和（秒）
+};
+
+/**
+ * @brief 动画片段库：所有片段在加载时编译一次，帧矩形与帧时长分别存放在两张扁平表中
+ *
+ * 实体只保存片段下标、当前帧与剩余时间（ecs::Animation，8 字节），AnimationSystem 每帧一次批量推进，
+ * 直接从帧表取源矩形写入精灵，运行时不再解析 JSON，也不产生任何按对象的堆分配。
+ *
+ * 片段名为 "<精灵表路径>#<片段名>"，来源有三种：
+ * - 图块的 "animation" 自定义属性（JSON 字符串，{"idle": {"row": 0, "frames": [0, 1, 2], "duration": 100}, ...}）；
+ * - Tiled 原生的图块动画数组（仅单图图块集，帧矩形取自同一张图片）；
+ * - 独立的 JSON 片段文件（约定扩展名 .anim.json，asset_packer 会打包），{"<精灵表路径>": {"frame_width": 33, "frame_height": 32, "clips": {...}}, ...}。
+ * duration 为每帧毫秒数，缺省 100；loop 缺省为 true。
+ */
+class AnimationLibrary final {
+public:
+	static constexpr Uint16 INVALID_CLIP = 0xFFFF;
+	static constexpr float DEFAULT_FRAME_DURATION_MS = 100.0f;
+	static constexpr float MIN_FRAME_DURATION_MS = 1.0f; ///< @brief 防止零时长帧让推进循环无法结束
+
+private:
+	using NameMap = std::unordered_map<std::string, Uint16, engine::utils::StringHash, std::equal_to<>>;
+
+	std::vector<SDL_FRect> frame_rects;
+	std::vector<float> frame_durations; ///< @brief 秒
+	std::vector<AnimationClip> clips;
+	NameMap clip_names; ///< @brief "<精灵表>#<片段>" -> 片段下标
+	NameMap default_clips; ///< @brief 精灵表 -> 默认片段（"idle"，没有则为第一个）
+
+public:
+	AnimationLibrary() = default;
+
+	AnimationLibrary(const AnimationLibrary &) = delete;
+	AnimationLibrary &operator=(const AnimationLibrary &) = delete;
+	AnimationLibrary(AnimationLibrary &&) = delete;
+	AnimationLibrary &operator=(AnimationLibrary &&) = delete;
+
+	/// @brief 添加一个片段，重名时返回已有片段；rects 与 durations_ms 长度必须相同且非空，否则返回 INVALID_CLIP
+	Uint16 addClip(std::string_view name, std::span<const SDL_FRect> rects, std::span<const float> durations_ms, bool loop = true);
+
+	/**
+	 * @brief 编译一张按行排列的精灵表的所有片段
+	 * @param sheet 精灵表（纹理）路径，作为片段名前缀
+	 * @param clips_json 片段定义，可以是对象，也可以是内容为 JSON 的字符串（Tiled 自定义属性）
+	 * @param frame_size 每帧大小
+	 * @return 默认片段，失败返回 INVALID_CLIP；同一精灵表重复编译时直接返回之前的结果
+	 */
+	Uint16 compileSheet(std::string_view sheet, const nlohmann::json &clips_json, glm::vec2 frame_size);
+
+	/// @brief 编译 Tiled 原生图块动画（帧来自同一图块集的其它图块），图片集合类图块集不支持，返回 INVALID_CLIP
+	Uint16 compileTileAnimation(const engine::map::TileMap &tile_map, const engine::map::TileInfo &info);
+
+	/// @brief 读取 JSON 片段文件（优先从资源包），返回成功编译的精灵表数量
+	int loadClipFile(const std::string &path, const engine::resource::AssetArchive *archive = nullptr);
+
+	/// @brief 按完整名称查找片段，不存在返回 INVALID_CLIP
+	[[nodiscard]] Uint16 findClip(std::string_view name) const;
+	[[nodiscard]] Uint16 findClip(std::string_view sheet, std::string_view clip) const;
+	[[nodiscard]] static std::string makeClipName(std::string_view sheet, std::string_view clip);
+
+	[[nodiscard]] const AnimationClip &getClip(Uint16 clip) const { return clips[clip]; }
+	[[nodiscard]] const SDL_FRect &getFrameRect(Uint16 clip, Uint16 frame) const { return frame_rects[clips[clip].first_frame + frame]; }
+	[[nodiscard]] std::span<const AnimationClip> getClips() const { return clips; }
+	[[nodiscard]] std::span<const SDL_FRect> getFrameRects() const { return frame_rects; }
+	[[nodiscard]] std::span<const float> getFrameDurations() const { return frame_durations; }
+	[[nodiscard]] size_t getClipCount() const { return clips.size(); }
+	[[nodiscard]] size_t getFrameCount() const { return frame_rects.size(); }
+};
+
+} // namespace engine::render
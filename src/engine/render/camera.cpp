@@ -1,7 +1,16 @@
 #include "camera.h"
 #include "../utils/math.h"
+#include <bit>
 #include <spdlog/spdlog.h>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ENGINE_CAMERA_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_CAMERA_SSE2 1
+#endif
+
 namespace engine::render {
 
 Camera::Camera(const glm::vec2 &viewport_size, const glm::vec2 &position, const std::optional<engine::utils::Rect> limit_bounds) :
@@ -63,6 +72,101 @@ glm::vec2 Camera::screenToWorld(const glm::vec2 &screen_pos) const {
 	return screen_pos + position;
 }
 
+size_t Camera::cullToScreen(const ScreenCullInput &input, std::vector<Uint32> &visible_indices, std::vector<SDL_FRect> &screen_rects) const {
+	const size_t count = input.x.size();
+	if (visible_indices.size() < count) {
+		visible_indices.resize(count);
+	}
+	if (screen_rects.size() < count) {
+		screen_rects.resize(count);
+	}
+
+	const bool has_parallax = !input.parallax_x.empty() && !input.parallax_y.empty();
+	const float *xs = input.x.data();
+	const float *ys = input.y.data();
+	const float *ws = input.width.data();
+	const float *hs = input.height.data();
+	const float *pxs = input.parallax_x.data();
+	const float *pys = input.parallax_y.data();
+	size_t visible = 0;
+	size_t i = 0;
+
+	// 向量部分：一次变换并测试若干个矩形，整组不可见时只花几条指令；可见的再按掩码逐个写出
+#if defined(ENGINE_CAMERA_AVX)
+	constexpr size_t LANES = 8;
+	const __m256 camera_x = _mm256_set1_ps(position.x);
+	const __m256 camera_y = _mm256_set1_ps(position.y);
+	const __m256 viewport_w = _mm256_set1_ps(viewport_size.x);
+	const __m256 viewport_h = _mm256_set1_ps(viewport_size.y);
+	const __m256 zero = _mm256_setzero_ps();
+	alignas(32) float screen_x[LANES];
+	alignas(32) float screen_y[LANES];
+	for (; i + LANES <= count; i += LANES) {
+		__m256 offset_x = has_parallax ? _mm256_mul_ps(camera_x, _mm256_loadu_ps(pxs + i)) : camera_x;
+		__m256 offset_y = has_parallax ? _mm256_mul_ps(camera_y, _mm256_loadu_ps(pys + i)) : camera_y;
+		__m256 sx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), offset_x);
+		__m256 sy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), offset_y);
+		__m256 inside = _mm256_and_ps(
+				_mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(sx, _mm256_loadu_ps(ws + i)), zero, _CMP_GE_OQ), _mm256_cmp_ps(sx, viewport_w, _CMP_LE_OQ)),
+				_mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(sy, _mm256_loadu_ps(hs + i)), zero, _CMP_GE_OQ), _mm256_cmp_ps(sy, viewport_h, _CMP_LE_OQ)));
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(inside));
+		if (mask == 0) {
+			continue;
+		}
+		_mm256_store_ps(screen_x, sx);
+		_mm256_store_ps(screen_y, sy);
+		for (; mask != 0; mask &= mask - 1) {
+			unsigned lane = static_cast<unsigned>(std::countr_zero(mask));
+			visible_indices[visible] = static_cast<Uint32>(i + lane);
+			screen_rects[visible] = SDL_FRect{ screen_x[lane], screen_y[lane], ws[i + lane], hs[i + lane] };
+			++visible;
+		}
+	}
+#elif defined(ENGINE_CAMERA_SSE2)
+	constexpr size_t LANES = 4;
+	const __m128 camera_x = _mm_set1_ps(position.x);
+	const __m128 camera_y = _mm_set1_ps(position.y);
+	const __m128 viewport_w = _mm_set1_ps(viewport_size.x);
+	const __m128 viewport_h = _mm_set1_ps(viewport_size.y);
+	const __m128 zero = _mm_setzero_ps();
+	alignas(16) float screen_x[LANES];
+	alignas(16) float screen_y[LANES];
+	for (; i + LANES <= count; i += LANES) {
+		__m128 offset_x = has_parallax ? _mm_mul_ps(camera_x, _mm_loadu_ps(pxs + i)) : camera_x;
+		__m128 offset_y = has_parallax ? _mm_mul_ps(camera_y, _mm_loadu_ps(pys + i)) : camera_y;
+		__m128 sx = _mm_sub_ps(_mm_loadu_ps(xs + i), offset_x);
+		__m128 sy = _mm_sub_ps(_mm_loadu_ps(ys + i), offset_y);
+		__m128 inside = _mm_and_ps(
+				_mm_and_ps(_mm_cmpge_ps(_mm_add_ps(sx, _mm_loadu_ps(ws + i)), zero), _mm_cmple_ps(sx, viewport_w)),
+				_mm_and_ps(_mm_cmpge_ps(_mm_add_ps(sy, _mm_loadu_ps(hs + i)), zero), _mm_cmple_ps(sy, viewport_h)));
+		unsigned mask = static_cast<unsigned>(_mm_movemask_ps(inside));
+		if (mask == 0) {
+			continue;
+		}
+		_mm_store_ps(screen_x, sx);
+		_mm_store_ps(screen_y, sy);
+		for (; mask != 0; mask &= mask - 1) {
+			unsigned lane = static_cast<unsigned>(std::countr_zero(mask));
+			visible_indices[visible] = static_cast<Uint32>(i + lane);
+			screen_rects[visible] = SDL_FRect{ screen_x[lane], screen_y[lane], ws[i + lane], hs[i + lane] };
+			++visible;
+		}
+	}
+#endif
+
+	// 标量部分：剩余元素，或不支持 SIMD 的平台上的全部元素（判定与 Renderer 的视口裁剪一致）
+	for (; i < count; ++i) {
+		float sx = xs[i] - position.x * (has_parallax ? pxs[i] : 1.0f);
+		float sy = ys[i] - position.y * (has_parallax ? pys[i] : 1.0f);
+		if (sx + ws[i] >= 0.0f && sx <= viewport_size.x && sy + hs[i] >= 0.0f && sy <= viewport_size.y) {
+			visible_indices[visible] = static_cast<Uint32>(i);
+			screen_rects[visible] = SDL_FRect{ sx, sy, ws[i], hs[i] };
+			++visible;
+		}
+	}
+	return visible;
+}
+
 glm::vec2 Camera::getViewportSize() const {
 	return viewport_size;
 }
@@ -1,11 +1,31 @@
 #pragma once
 
 #include <optional>
+#include <span>
+#include <vector>
+
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_stdinc.h>
 
 #include "../utils/math.h"
 
 namespace engine::render {
 
+/**
+ * @brief 批量变换与裁剪的输入（SoA），各数组长度相同
+ *
+ * x / y 为世界坐标中的左上角，width / height 为屏幕上的尺寸。
+ * parallax_x / parallax_y 为空表示滚动因子为 1（普通世界物体）。
+ */
+struct ScreenCullInput {
+	std::span<const float> x;
+	std::span<const float> y;
+	std::span<const float> width;
+	std::span<const float> height;
+	std::span<const float> parallax_x;
+	std::span<const float> parallax_y;
+};
+
 class Camera final {
 private:
 	glm::vec2 viewport_size;
@@ -22,6 +42,15 @@ public:
 	glm::vec2 worldToScreenWithParallax(const glm::vec2 &world_pos, const glm::vec2 &scroll_factor) const; ///< @brief 世界坐标转屏幕坐标，考虑视差滚动
 	glm::vec2 screenToWorld(const glm::vec2 &screen_pos) const;
 
+	/**
+	 * @brief 批量世界坐标转屏幕坐标并做视口裁剪（SSE/AVX 向量化，不支持时退化为标量循环）
+	 *
+	 * 可见元素的索引与屏幕矩形按输入顺序紧凑写入 visible_indices / screen_rects 的前 N 项。
+	 * 两个输出数组只增不减（跨帧复用容量），N 之后的内容无意义。
+	 * @return 可见元素数量 N。
+	 */
+	size_t cullToScreen(const ScreenCullInput &input, std::vector<Uint32> &visible_indices, std::vector<SDL_FRect> &screen_rects) const;
+
 	void setPosition(const glm::vec2 &position);
 	void setLimitBounds(const engine::utils::Rect &bounds);
 
@@ -0,0 +1,485 @@
+#include "particle_system.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <span>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../debug/profiler.h"
+#include "../resource/asset_archive.h"
+#include "../resource/resource_manager.h"
+#include "camera.h"
+#include "renderer.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ENGINE_PARTICLES_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_PARTICLES_SSE2 1
+#endif
+
+namespace engine::render {
+
+namespace {
+
+constexpr float MIN_LIFETIME = 0.01f; ///< @brief 寿命下限（秒），避免 1 / 寿命溢出
+constexpr float DEGREES_TO_RADIANS = 3.14159265358979f / 180.0f;
+
+/// @brief 读取标量或 [min, max] 数组，标量表示两端相同
+glm::vec2 readRange(const nlohmann::json &json, const char *key, glm::vec2 fallback) {
+	auto it = json.find(key);
+	if (it == json.end()) {
+		return fallback;
+	}
+	if (it->is_number()) {
+		return glm::vec2(it->get<float>());
+	}
+	if (it->is_array() && it->size() == 2 && (*it)[0].is_number() && (*it)[1].is_number()) {
+		return glm::vec2((*it)[0].get<float>(), (*it)[1].get<float>());
+	}
+	return fallback;
+}
+
+SDL_FColor readColor(const nlohmann::json &json, const char *key, SDL_FColor fallback) {
+	auto it = json.find(key);
+	if (it == json.end() || !it->is_array() || it->size() < 3) {
+		return fallback;
+	}
+	float alpha = it->size() > 3 ? (*it)[3].get<float>() : 1.0f;
+	return SDL_FColor{ (*it)[0].get<float>(), (*it)[1].get<float>(), (*it)[2].get<float>(), alpha };
+}
+
+float lerp(float a, float b, float t) {
+	return a + (b - a) * t;
+}
+
+} // namespace
+
+ParticleSystem::ParticleSystem(engine::resource::ResourceManager &resource_manager, size_t capacity) :
+		resource_manager(resource_manager), capacity(capacity) {
+	for (std::vector<float> *array : { &xs, &ys, &vxs, &vys, &axs, &ays, &drags, &ages, &age_rates }) {
+		array->resize(capacity);
+	}
+	kinds.resize(capacity);
+	emitters.reserve(MAX_EMITTERS);
+
+	// 每个四边形的顶点顺序为左上、右上、右下、左下，与 Renderer 的合批一致
+	quad_indices.resize(capacity * 6);
+	for (size_t quad = 0; quad < capacity; ++quad) {
+		const int base = static_cast<int>(quad * 4);
+		int *indices = quad_indices.data() + quad * 6;
+		indices[0] = base;
+		indices[1] = base + 1;
+		indices[2] = base + 2;
+		indices[3] = base;
+		indices[4] = base + 2;
+		indices[5] = base + 3;
+	}
+	spdlog::trace("ParticleSystem created with capacity {}.", capacity);
+}
+
+int ParticleSystem::loadEffects(const std::string &path) {
+	nlohmann::json json;
+	try {
+		const engine::resource::AssetArchive *archive = resource_manager.getArchive();
+		if (const engine::resource::pak::EntryRecord *entry = archive ? archive->find(path) : nullptr) {
+			auto bytes = archive->getStoredBytes(*entry);
+			const char *begin = reinterpret_cast<const char *>(bytes.data());
+			json = nlohmann::json::parse(begin, begin + bytes.size());
+		} else {
+			std::ifstream file(path);
+			if (!file) {
+				spdlog::error("ParticleSystem: failed to open effect file '{}'.", path);
+				return 0;
+			}
+			file >> json;
+		}
+
+		if (!json.is_object()) {
+			spdlog::error("ParticleSystem: effect file '{}' must contain an object.", path);
+			return 0;
+		}
+		int loaded = 0;
+		for (const auto &[name, definition] : json.items()) {
+			if (!definition.is_object() || !definition.contains("texture")) {
+				spdlog::warn("ParticleSystem: effect '{}' in '{}' has no texture.", name, path);
+				continue;
+			}
+			ParticleEffectConfig config;
+			config.name = name;
+			config.texture = definition["texture"].get<std::string>();
+			if (auto source = definition.find("source"); source != definition.end() && source->is_array() && source->size() == 4) {
+				config.source = { (*source)[0].get<float>(), (*source)[1].get<float>(), (*source)[2].get<float>(), (*source)[3].get<float>() };
+			}
+			config.frames = std::max(1, definition.value("frames", config.frames));
+			config.burst = std::max(0, definition.value("burst", config.burst));
+			config.rate = std::max(0.0f, definition.value("rate", config.rate));
+			config.lifetime = readRange(definition, "lifetime", config.lifetime);
+			config.speed = readRange(definition, "speed", config.speed);
+			config.direction = definition.value("direction", config.direction);
+			config.spread = definition.value("spread", config.spread);
+			config.offset = readRange(definition, "offset", config.offset);
+			config.gravity = readRange(definition, "gravity", config.gravity);
+			config.drag = std::max(0.0f, definition.value("drag", config.drag));
+			config.scale = readRange(definition, "scale", config.scale);
+			config.color_start = readColor(definition, "color_start", config.color_start);
+			config.color_end = readColor(definition, "color_end", config.color_start);
+			if (addEffect(config) != INVALID_EFFECT) {
+				++loaded;
+			}
+		}
+		spdlog::debug("ParticleSystem: loaded {} effect(s) from '{}' ({} texture group(s)).", loaded, path, groups.size());
+		return loaded;
+	} catch (const nlohmann::json::exception &e) {
+		spdlog::error("ParticleSystem: failed to parse effect file '{}': {}", path, e.what());
+		return 0;
+	}
+}
+
+ParticleSystem::EffectId ParticleSystem::addEffect(const ParticleEffectConfig &config) {
+	if (EffectId existing = findEffect(config.name); existing != INVALID_EFFECT) {
+		spdlog::warn("ParticleSystem: effect '{}' is already registered.", config.name);
+		return existing;
+	}
+	if (effects.size() >= INVALID_EFFECT) {
+		spdlog::error("ParticleSystem: too many effects, '{}' dropped.", config.name);
+		return INVALID_EFFECT;
+	}
+
+	auto handle = resource_manager.loadTextureHandle(config.texture);
+	glm::vec2 image_size = resource_manager.getTextureSize(handle);
+	if (!handle.isValid() || image_size.x <= 0.0f || image_size.y <= 0.0f) {
+		spdlog::error("ParticleSystem: failed to load texture '{}' for effect '{}'.", config.texture, config.name);
+		return INVALID_EFFECT;
+	}
+
+	Effect effect;
+	effect.config = config;
+	if (effect.config.source.w <= 0.0f || effect.config.source.h <= 0.0f) {
+		effect.config.source = { 0.0f, 0.0f, image_size.x, image_size.y };
+	}
+	effect.frame_size = glm::vec2(effect.config.source.w / static_cast<float>(effect.config.frames), effect.config.source.h);
+
+	auto group = std::find_if(groups.begin(), groups.end(), [&](const TextureGroup &candidate) { return candidate.path == config.texture; });
+	if (group == groups.end()) {
+		TextureGroup &created = groups.emplace_back();
+		created.path = config.texture;
+		created.handle = handle;
+		group = groups.end() - 1;
+	}
+	effect.group = static_cast<Uint16>(group - groups.begin());
+
+	effect_first_uv.push_back(static_cast<Uint32>(frame_uvs.size()));
+	frame_uvs.resize(frame_uvs.size() + static_cast<size_t>(effect.config.frames));
+	effects.push_back(std::move(effect));
+	return static_cast<EffectId>(effects.size() - 1);
+}
+
+ParticleSystem::EffectId ParticleSystem::findEffect(std::string_view name) const {
+	for (size_t i = 0; i < effects.size(); ++i) {
+		if (effects[i].config.name == name) {
+			return static_cast<EffectId>(i);
+		}
+	}
+	return INVALID_EFFECT;
+}
+
+void ParticleSystem::emit(EffectId effect, const glm::vec2 &position, int count) {
+	if (effect >= effects.size()) {
+		return;
+	}
+	const Effect &definition = effects[effect];
+	spawn(definition, effect, position, count < 0 ? definition.config.burst : count);
+}
+
+ParticleSystem::EmitterId ParticleSystem::startEmitter(EffectId effect, const glm::vec2 &position) {
+	if (effect >= effects.size()) {
+		return INVALID_EMITTER;
+	}
+	auto slot = std::find_if(emitters.begin(), emitters.end(), [](const Emitter &emitter) { return !emitter.active; });
+	if (slot == emitters.end()) {
+		if (emitters.size() >= MAX_EMITTERS) {
+			spdlog::warn("ParticleSystem: emitter limit ({}) reached.", MAX_EMITTERS);
+			return INVALID_EMITTER;
+		}
+		emitters.emplace_back();
+		slot = emitters.end() - 1;
+	}
+	slot->effect = effect;
+	slot->position = position;
+	slot->accumulator = 0.0f;
+	slot->active = true;
+	// 低 8 位为槽位，其余为代数，停止后旧 id 自动失效
+	return (slot->generation << 8) | static_cast<EmitterId>(slot - emitters.begin());
+}
+
+void ParticleSystem::moveEmitter(EmitterId emitter, const glm::vec2 &position) {
+	size_t index = emitter & 0xFFu;
+	if (index < emitters.size() && emitters[index].active && emitters[index].generation == (emitter >> 8)) {
+		emitters[index].position = position;
+	}
+}
+
+void ParticleSystem::stopEmitter(EmitterId emitter) {
+	size_t index = emitter & 0xFFu;
+	if (index < emitters.size() && emitters[index].active && emitters[index].generation == (emitter >> 8)) {
+		emitters[index].active = false;
+		emitters[index].generation = (emitters[index].generation + 1) & 0xFFFFFFu;
+	}
+}
+
+void ParticleSystem::update(float delta_time) {
+	PROFILE_SCOPE("ParticleSystem::update");
+	for (Emitter &emitter : emitters) {
+		if (!emitter.active) {
+			continue;
+		}
+		const Effect &effect = effects[emitter.effect];
+		emitter.accumulator += effect.config.rate * delta_time;
+		int count = static_cast<int>(emitter.accumulator);
+		emitter.accumulator -= static_cast<float>(count);
+		spawn(effect, emitter.effect, emitter.position, count);
+	}
+	integrate(delta_time);
+	compact();
+}
+
+void ParticleSystem::spawn(const Effect &effect, EffectId id, const glm::vec2 &position, int count) {
+	const ParticleEffectConfig &config = effect.config;
+	for (int n = 0; n < count; ++n) {
+		if (live == capacity) {
+			dropped += count - n;
+			return;
+		}
+		const float angle = (config.direction + (random01() - 0.5f) * config.spread) * DEGREES_TO_RADIANS;
+		const float speed = lerp(config.speed.x, config.speed.y, random01());
+		const float lifetime = std::max(MIN_LIFETIME, lerp(config.lifetime.x, config.lifetime.y, random01()));
+		const size_t i = live++;
+		xs[i] = position.x + (random01() * 2.0f - 1.0f) * config.offset.x;
+		ys[i] = position.y + (random01() * 2.0f - 1.0f) * config.offset.y;
+		vxs[i] = std::cos(angle) * speed;
+		vys[i] = std::sin(angle) * speed;
+		axs[i] = config.gravity.x;
+		ays[i] = config.gravity.y;
+		drags[i] = config.drag;
+		ages[i] = 0.0f;
+		age_rates[i] = 1.0f / lifetime;
+		kinds[i] = id;
+		++emitted;
+	}
+}
+
+void ParticleSystem::integrate(float delta_time) {
+	const size_t count = live;
+	float *x = xs.data();
+	float *y = ys.data();
+	float *vx = vxs.data();
+	float *vy = vys.data();
+	const float *ax = axs.data();
+	const float *ay = ays.data();
+	const float *drag = drags.data();
+	float *age = ages.data();
+	const float *age_rate = age_rates.data();
+
+	size_t i = 0;
+#if defined(ENGINE_PARTICLES_AVX)
+	constexpr size_t LANES = 8;
+	const __m256 dt = _mm256_set1_ps(delta_time);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 zero = _mm256_setzero_ps();
+	for (; i + LANES <= count; i += LANES) {
+		__m256 damping = _mm256_max_ps(zero, _mm256_sub_ps(one, _mm256_mul_ps(_mm256_loadu_ps(drag + i), dt)));
+		__m256 new_vx = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(vx + i), _mm256_mul_ps(_mm256_loadu_ps(ax + i), dt)), damping);
+		__m256 new_vy = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(vy + i), _mm256_mul_ps(_mm256_loadu_ps(ay + i), dt)), damping);
+		_mm256_storeu_ps(vx + i, new_vx);
+		_mm256_storeu_ps(vy + i, new_vy);
+		_mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(new_vx, dt)));
+		_mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(new_vy, dt)));
+		_mm256_storeu_ps(age + i, _mm256_add_ps(_mm256_loadu_ps(age + i), _mm256_mul_ps(_mm256_loadu_ps(age_rate + i), dt)));
+	}
+#elif defined(ENGINE_PARTICLES_SSE2)
+	constexpr size_t LANES = 4;
+	const __m128 dt = _mm_set1_ps(delta_time);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + LANES <= count; i += LANES) {
+		__m128 damping = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(drag + i), dt)));
+		__m128 new_vx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vx + i), _mm_mul_ps(_mm_loadu_ps(ax + i), dt)), damping);
+		__m128 new_vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(_mm_loadu_ps(ay + i), dt)), damping);
+		_mm_storeu_ps(vx + i, new_vx);
+		_mm_storeu_ps(vy + i, new_vy);
+		_mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(new_vx, dt)));
+		_mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(new_vy, dt)));
+		_mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), _mm_mul_ps(_mm_loadu_ps(age_rate + i), dt)));
+	}
+#endif
+
+	// 标量部分：剩余元素，或不支持 SIMD 的平台上的全部元素
+	for (; i < count; ++i) {
+		const float damping = std::max(0.0f, 1.0f - drag[i] * delta_time);
+		vx[i] = (vx[i] + ax[i] * delta_time) * damping;
+		vy[i] = (vy[i] + ay[i] * delta_time) * damping;
+		x[i] += vx[i] * delta_time;
+		y[i] += vy[i] * delta_time;
+		age[i] += age_rate[i] * delta_time;
+	}
+}
+
+void ParticleSystem::compact() {
+	size_t i = 0;
+	while (i < live) {
+		if (ages[i] < 1.0f) {
+			++i;
+			continue;
+		}
+		// 与最后一个存活粒子交换（它可能同样已死亡，下一轮会继续检查位置 i）
+		const size_t last = --live;
+		if (i != last) {
+			xs[i] = xs[last];
+			ys[i] = ys[last];
+			vxs[i] = vxs[last];
+			vys[i] = vys[last];
+			axs[i] = axs[last];
+			ays[i] = ays[last];
+			drags[i] = drags[last];
+			ages[i] = ages[last];
+			age_rates[i] = age_rates[last];
+			kinds[i] = kinds[last];
+		}
+	}
+}
+
+void ParticleSystem::refreshFrameUvs() {
+	for (TextureGroup &group : groups) {
+		// 纹理可能被按预算淘汰后重新加载，句柄失效时按路径重新解析
+		group.texture = resource_manager.getTexture(group.handle);
+		if (!group.texture) {
+			group.handle = resource_manager.loadTextureHandle(group.path);
+			group.texture = resource_manager.getTexture(group.handle);
+		}
+	}
+
+	for (size_t e = 0; e < effects.size(); ++e) {
+		const Effect &effect = effects[e];
+		const TextureGroup &group = groups[effect.group];
+		float texture_w = 0.0f, texture_h = 0.0f;
+		if (!group.texture || !SDL_GetTextureSize(group.texture, &texture_w, &texture_h) || texture_w <= 0.0f || texture_h <= 0.0f) {
+			continue;
+		}
+		// 图片在纹理中的区域：独立纹理为整张纹理，图集图片为图集页中的子矩形
+		const SDL_FRect region = resource_manager.getTextureRegion(group.handle);
+		const SDL_FRect &source = effect.config.source;
+		FrameUv *uvs = frame_uvs.data() + effect_first_uv[e];
+		for (int frame = 0; frame < effect.config.frames; ++frame) {
+			const float left = region.x + source.x + static_cast<float>(frame) * effect.frame_size.x;
+			const float top = region.y + source.y;
+			uvs[frame] = { left / texture_w, top / texture_h, (left + effect.frame_size.x) / texture_w, (top + effect.frame_size.y) / texture_h };
+		}
+	}
+}
+
+void ParticleSystem::draw(Renderer &renderer, const Camera &camera) {
+	PROFILE_SCOPE("ParticleSystem::draw");
+	drawn = 0;
+	batches = 0;
+	if (live == 0) {
+		return;
+	}
+	refreshFrameUvs();
+
+	// 先统计每组的粒子数，保证顶点缓冲足够大（只在超过历史峰值时增长）
+	for (TextureGroup &group : groups) {
+		group.vertex_count = 0;
+	}
+	for (size_t i = 0; i < live; ++i) {
+		groups[effects[kinds[i]].group].vertex_count += 4;
+	}
+	for (TextureGroup &group : groups) {
+		if (group.vertices.size() < group.vertex_count) {
+			group.vertices.resize(group.vertex_count);
+		}
+		group.vertex_count = 0;
+	}
+
+	const glm::vec2 camera_position = camera.getPosition();
+	const glm::vec2 viewport = camera.getViewportSize();
+	for (size_t i = 0; i < live; ++i) {
+		const Effect &effect = effects[kinds[i]];
+		TextureGroup &group = groups[effect.group];
+		if (!group.texture) {
+			continue;
+		}
+		const ParticleEffectConfig &config = effect.config;
+		const float t = std::min(ages[i], 1.0f);
+		const float scale = lerp(config.scale.x, config.scale.y, t);
+		const float half_w = effect.frame_size.x * scale * 0.5f;
+		const float half_h = effect.frame_size.y * scale * 0.5f;
+		const float center_x = xs[i] - camera_position.x;
+		const float center_y = ys[i] - camera_position.y;
+		if (center_x + half_w < 0.0f || center_x - half_w > viewport.x || center_y + half_h < 0.0f || center_y - half_h > viewport.y) {
+			continue;
+		}
+
+		const int frame = std::min(config.frames - 1, static_cast<int>(t * static_cast<float>(config.frames)));
+		const FrameUv &uv = frame_uvs[effect_first_uv[kinds[i]] + static_cast<size_t>(frame)];
+		const SDL_FColor color = {
+			lerp(config.color_start.r, config.color_end.r, t),
+			lerp(config.color_start.g, config.color_end.g, t),
+			lerp(config.color_start.b, config.color_end.b, t),
+			lerp(config.color_start.a, config.color_end.a, t),
+		};
+
+		SDL_Vertex *vertex = group.vertices.data() + group.vertex_count;
+		vertex[0] = { { center_x - half_w, center_y - half_h }, color, { uv.u0, uv.v0 } };
+		vertex[1] = { { center_x + half_w, center_y - half_h }, color, { uv.u1, uv.v0 } };
+		vertex[2] = { { center_x + half_w, center_y + half_h }, color, { uv.u1, uv.v1 } };
+		vertex[3] = { { center_x - half_w, center_y + half_h }, color, { uv.u0, uv.v1 } };
+		group.vertex_count += 4;
+	}
+
+	for (const TextureGroup &group : groups) {
+		if (group.vertex_count == 0) {
+			continue;
+		}
+		const size_t quads = group.vertex_count / 4;
+		renderer.drawGeometry(group.texture, std::span<const SDL_Vertex>(group.vertices.data(), group.vertex_count),
+				std::span<const int>(quad_indices.data(), quads * 6));
+		drawn += static_cast<int>(quads);
+		++batches;
+	}
+}
+
+void ParticleSystem::clear() {
+	live = 0;
+	for (Emitter &emitter : emitters) {
+		if (emitter.active) {
+			emitter.active = false;
+			emitter.generation = (emitter.generation + 1) & 0xFFFFFFu;
+		}
+	}
+}
+
+ParticleStats ParticleSystem::getStats() const {
+	ParticleStats stats;
+	stats.live = static_cast<int>(live);
+	stats.capacity = static_cast<int>(capacity);
+	stats.emitted = emitted;
+	stats.dropped = dropped;
+	stats.drawn = drawn;
+	stats.batches = batches;
+	return stats;
+}
+
+float ParticleSystem::random01() {
+	// xorshift32：足够用于视觉效果，且不依赖 <random> 引擎的状态大小
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return static_cast<float>(random_state >> 8) * (1.0f / 16777216.0f);
+}
+
+} // namespace engine::render
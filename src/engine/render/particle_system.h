@@ -0,0 +1,176 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_render.h>
+#include <glm/vec2.hpp>
+
+#include "../resource/texture_handle.h"
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::render {
+
+class Camera;
+class Renderer;
+
+/**
+ * @brief 一种粒子效果的参数，来自效果文件（*.fx.json）
+ *
+ * 角度以度为单位，0 指向右方，-90 指向上方。粒子的贴图帧按年龄从 frames 帧中顺序选取，
+ * 帧在 source 矩形内横向排列；source 为空时使用整张纹理。
+ */
+struct ParticleEffectConfig {
+	std::string name;
+	std::string texture;
+	SDL_FRect source = { 0, 0, 0, 0 };
+	int frames = 1;
+	int burst = 1; ///< @brief 每次 emit() 产生的粒子数
+	float rate = 0.0f; ///< @brief 持续发射器每秒产生的粒子数
+	glm::vec2 lifetime = glm::vec2(0.5f); ///< @brief 寿命范围 [min, max]（秒）
+	glm::vec2 speed = glm::vec2(0.0f); ///< @brief 初速度范围 [min, max]（像素/秒）
+	float direction = -90.0f;
+	float spread = 360.0f; ///< @brief 以 direction 为中心的发射角度范围
+	glm::vec2 offset = glm::vec2(0.0f); ///< @brief 出生位置在 [-offset, offset] 内随机偏移
+	glm::vec2 gravity = glm::vec2(0.0f); ///< @brief 加速度（像素/秒²）
+	float drag = 0.0f; ///< @brief 每秒速度衰减比例
+	glm::vec2 scale = glm::vec2(1.0f); ///< @brief 出生与消亡时相对一帧大小的缩放 [start, end]
+	SDL_FColor color_start = { 1.0f, 1.0f, 1.0f, 1.0f };
+	SDL_FColor color_end = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+/// @brief 粒子系统的统计
+struct ParticleStats {
+	int live = 0;
+	int capacity = 0;
+	int emitted = 0; ///< @brief 累计产生的粒子数
+	int dropped = 0; ///< @brief 池满后丢弃的粒子数（累计）
+	int drawn = 0; ///< @brief 上一次 draw() 提交的粒子数（已裁剪）
+	int batches = 0; ///< @brief 上一次 draw() 的几何体提交次数（每张纹理一次）
+};
+
+/**
+ * @brief 固定容量、结构数组（SoA）布局的粒子系统
+ *
+ * 所有粒子的位置、速度、加速度、阻尼与归一化年龄分别存放在连续的 float 数组中，积分与老化用 SIMD 一次处理多个粒子；
+ * 死亡的粒子用末尾的粒子填补，存活粒子始终紧凑排列在数组前部。容量在构造时一次性分配，之后的发射、更新与绘制都不分配内存
+ * （每张纹理的顶点缓冲按峰值增长一次后复用）。
+ *
+ * 绘制时粒子按效果所用的纹理分组，每组展开为一个顶点缓冲，通过 Renderer::drawGeometry 一次提交。
+ */
+class ParticleSystem final {
+public:
+	using EffectId = Uint16;
+	using EmitterId = Uint32;
+	static constexpr EffectId INVALID_EFFECT = 0xFFFF;
+	static constexpr EmitterId INVALID_EMITTER = 0xFFFFFFFF;
+	static constexpr size_t MAX_EMITTERS = 256;
+
+private:
+	/// @brief 编译后的效果：运行时只读，按下标访问
+	struct Effect {
+		ParticleEffectConfig config;
+		Uint16 group = 0; ///< @brief 所属纹理组
+		glm::vec2 frame_size = glm::vec2(0.0f);
+	};
+
+	/// @brief 共享同一纹理的效果，绘制时合并为一个顶点缓冲
+	struct TextureGroup {
+		std::string path;
+		engine::resource::TextureHandle handle;
+		SDL_Texture *texture = nullptr; ///< @brief 本次绘制解析到的纹理
+		std::vector<SDL_Vertex> vertices; ///< @brief 跨帧复用，只在峰值增长时分配
+		size_t vertex_count = 0;
+	};
+
+	/// @brief 一帧的归一化纹理坐标
+	struct FrameUv {
+		float u0 = 0.0f;
+		float v0 = 0.0f;
+		float u1 = 0.0f;
+		float v1 = 0.0f;
+	};
+
+	/// @brief 持续发射器
+	struct Emitter {
+		EffectId effect = INVALID_EFFECT;
+		glm::vec2 position = glm::vec2(0.0f);
+		float accumulator = 0.0f; ///< @brief 不足一个粒子的发射量
+		Uint32 generation = 0;
+		bool active = false;
+	};
+
+	engine::resource::ResourceManager &resource_manager;
+
+	std::vector<Effect> effects;
+	std::vector<TextureGroup> groups;
+	std::vector<FrameUv> frame_uvs; ///< @brief 按效果展开的各帧纹理坐标，绘制前刷新
+	std::vector<Uint32> effect_first_uv; ///< @brief 效果在 frame_uvs 中的起始下标
+	std::vector<Emitter> emitters;
+	std::vector<int> quad_indices; ///< @brief 所有纹理组共用的四边形索引，按容量一次生成
+
+	// SoA 粒子池，[0, live) 为存活粒子
+	size_t capacity = 0;
+	size_t live = 0;
+	std::vector<float> xs; ///< @brief 中心位置
+	std::vector<float> ys;
+	std::vector<float> vxs;
+	std::vector<float> vys;
+	std::vector<float> axs;
+	std::vector<float> ays;
+	std::vector<float> drags;
+	std::vector<float> ages; ///< @brief 归一化年龄，>= 1 时死亡
+	std::vector<float> age_rates; ///< @brief 1 / 寿命
+	std::vector<EffectId> kinds;
+
+	Uint32 random_state = 0x9E3779B9u;
+	int emitted = 0;
+	int dropped = 0;
+	int drawn = 0;
+	int batches = 0;
+
+public:
+	ParticleSystem(engine::resource::ResourceManager &resource_manager, size_t capacity);
+
+	ParticleSystem(const ParticleSystem &) = delete;
+	ParticleSystem &operator=(const ParticleSystem &) = delete;
+	ParticleSystem(ParticleSystem &&) = delete;
+	ParticleSystem &operator=(ParticleSystem &&) = delete;
+
+	/// @brief 读取效果文件（优先从资源包），返回成功注册的效果数量
+	int loadEffects(const std::string &path);
+	/// @brief 注册一个效果并加载其纹理，同名效果已存在时返回已有的效果；纹理无效时返回 INVALID_EFFECT
+	EffectId addEffect(const ParticleEffectConfig &config);
+	[[nodiscard]] EffectId findEffect(std::string_view name) const;
+
+	/// @brief 在 position 处一次性发射 count 个粒子（< 0 时使用效果的 burst），池满时丢弃多余的粒子
+	void emit(EffectId effect, const glm::vec2 &position, int count = -1);
+
+	/// @brief 创建按效果 rate 持续发射的发射器，发射器数量达到上限时返回 INVALID_EMITTER
+	EmitterId startEmitter(EffectId effect, const glm::vec2 &position);
+	void moveEmitter(EmitterId emitter, const glm::vec2 &position);
+	void stopEmitter(EmitterId emitter); ///< @brief 停止发射，已发射的粒子继续走完寿命
+
+	/// @brief 持续发射、积分、老化并压缩存活粒子
+	void update(float delta_time);
+
+	/// @brief 按纹理分组展开可见粒子的顶点并提交，顶点缓冲需保持到 Renderer::present()
+	void draw(Renderer &renderer, const Camera &camera);
+
+	void clear(); ///< @brief 清除所有粒子与发射器
+	[[nodiscard]] ParticleStats getStats() const;
+	[[nodiscard]] size_t getLiveCount() const { return live; }
+
+private:
+	void spawn(const Effect &effect, EffectId id, const glm::vec2 &position, int count);
+	void integrate(float delta_time); ///< @brief 积分速度与位置、推进年龄（SIMD）
+	void compact(); ///< @brief 用末尾粒子填补死亡粒子
+	void refreshFrameUvs(); ///< @brief 解析各组纹理，并按纹理当前所在的区域（可能位于图集页中）重新计算各帧纹理坐标
+	float random01();
+};
+
+} // namespace engine::render
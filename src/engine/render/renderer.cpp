@@ -1,10 +1,13 @@
 #include "renderer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 #include <SDL3/SDL.h>
 #include <spdlog/spdlog.h>
 
+#include "../debug/profiler.h"
 #include "../resource/resource_manager.h"
 #include "camera.h"
 #include "sprite.h"
@@ -26,7 +29,16 @@ Renderer::Renderer(SDL_Renderer *sdl_renderer, engine::resource::ResourceManager
 }
 
 void Renderer::drawSprite(const Camera &camera, const Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scale, double angle) {
-	auto texture = resource_manager->getTexture(sprite.getTextureId());
+	// 应用相机变换
+	glm::vec2 position_screen = camera.worldToScreen(position);
+
+	// 已知源矩形时先做视口裁剪，视口外的精灵无需解析纹理
+	const auto &known_rect = sprite.getSourceRect();
+	if (known_rect.has_value() && !isRectInViewport(camera, SDL_FRect{ position_screen.x, position_screen.y, known_rect->w * scale.x, known_rect->h * scale.y })) {
+		return;
+	}
+
+	auto texture = resolveTexture(sprite);
 	if (!texture) {
 		spdlog::error("Failed to get texture for ID {}", sprite.getTextureId());
 		return;
@@ -38,9 +50,6 @@ void Renderer::drawSprite(const Camera &camera, const Sprite &sprite, const glm:
 		return;
 	}
 
-	// 应用相机变换
-	glm::vec2 position_screen = camera.worldToScreen(position);
-
 	// 计算目标矩形，注意 position 是精灵的左上角坐标
 	float scaled_w = src_rect.value().w * scale.x;
 	float scaled_h = src_rect.value().h * scale.y;
@@ -51,19 +60,32 @@ void Renderer::drawSprite(const Camera &camera, const Sprite &sprite, const glm:
 		scaled_h
 	};
 
-	if (!isRectInViewport(camera, dest_rect)) { // 视口裁剪：如果精灵超出视口，则不绘制
-		// spdlog::info("精灵超出视口范围，ID: {}", sprite.getTextureId());
+	if (!known_rect.has_value() && !isRectInViewport(camera, dest_rect)) { // 视口裁剪：如果精灵超出视口，则不绘制
 		return;
 	}
 
 	// 执行绘制(默认旋转中心为精灵的中心点)
-	if (!SDL_RenderTextureRotated(renderer, texture, &src_rect.value(), &dest_rect, angle, NULL, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
-		spdlog::error("Failed to render rotated texture (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
+	submitQuad(texture, src_rect.value(), dest_rect, angle, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE, sprite.getTextureId());
+}
+
+void Renderer::drawSpriteScreen(const Sprite &sprite, const SDL_FRect &dest_rect, double angle) {
+	auto texture = resolveTexture(sprite);
+	if (!texture) {
+		spdlog::error("Failed to get texture for ID {}", sprite.getTextureId());
+		return;
+	}
+
+	auto src_rect = getSpriteSrcRect(sprite);
+	if (!src_rect.has_value()) {
+		spdlog::error("Failed to get sprite source rect for ID {}", sprite.getTextureId());
+		return;
 	}
+
+	submitQuad(texture, src_rect.value(), dest_rect, angle, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE, sprite.getTextureId());
 }
 
 void Renderer::drawParallax(const Camera &camera, const Sprite &sprite, const glm::vec2 &position, const glm::vec2 &scroll_factor, const glm::bvec2 &repeat, const glm::vec2 &scale) {
-	auto texture = resource_manager->getTexture(sprite.getTextureId());
+	auto texture = resolveTexture(sprite);
 	if (!texture) {
 		spdlog::error("Failed to get texture for ID {}", sprite.getTextureId());
 		return;
@@ -104,16 +126,13 @@ void Renderer::drawParallax(const Camera &camera, const Sprite &sprite, const gl
 	for (float y = start.y; y < stop.y; y += scaled_tex_h) {
 		for (float x = start.x; x < stop.x; x += scaled_tex_w) {
 			SDL_FRect dest_rect = { x, y, scaled_tex_w, scaled_tex_h };
-			if (!SDL_RenderTexture(renderer, texture, nullptr, &dest_rect)) {
-				spdlog::error("Failed to render parallax texture (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
-				return;
-			}
+			submitQuad(texture, src_rect.value(), dest_rect, 0.0, SDL_FLIP_NONE, sprite.getTextureId());
 		}
 	}
 }
 
 void Renderer::drawUISprite(const Sprite &sprite, const glm::vec2 &position, const std::optional<glm::vec2> &size) {
-	auto texture = resource_manager->getTexture(sprite.getTextureId());
+	auto texture = resolveTexture(sprite);
 	if (!texture) {
 		spdlog::error("Failed to get texture for ID {}", sprite.getTextureId());
 		return;
@@ -135,9 +154,7 @@ void Renderer::drawUISprite(const Sprite &sprite, const glm::vec2 &position, con
 	}
 
 	// 执行绘制(未考虑UI旋转)
-	if (!SDL_RenderTextureRotated(renderer, texture, &src_rect.value(), &dest_rect, 0.0, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
-		spdlog::error("Failed to render UI Sprite (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
-	}
+	submitQuad(texture, src_rect.value(), dest_rect, 0.0, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE, sprite.getTextureId());
 }
 
 void Renderer::setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
@@ -159,30 +176,59 @@ void Renderer::clearScreen() {
 }
 
 void Renderer::present() {
+	flush();
+	PROFILE_SCOPE("Renderer::present");
 	SDL_RenderPresent(renderer);
 }
 
+void Renderer::flush() {
+	PROFILE_SCOPE("Renderer::flush");
+	if (batching_enabled) {
+		flushBatches();
+	}
+}
+
+void Renderer::setBatchingEnabled(bool enabled) {
+	if (batching_enabled && !enabled) {
+		flushBatches(); // 关闭前先把已记录的命令画出去，避免丢帧
+	}
+	batching_enabled = enabled;
+	spdlog::trace("Renderer batching {}", enabled ? "enabled" : "disabled");
+}
+
+SDL_Texture *Renderer::resolveTexture(const Sprite &sprite) {
+	// 快速路径：句柄有效时为 O(1) 数组访问，无哈希、无分配
+	SDL_Texture *texture = resource_manager->getTexture(sprite.getTextureHandle());
+	if (texture) {
+		return texture;
+	}
+
+	// 句柄尚未解析或已失效（纹理被卸载或按预算淘汰），按路径重新解析一次并缓存
+	auto handle = resource_manager->loadTextureHandle(sprite.getTextureId());
+	sprite.setTextureHandle(handle);
+	return resource_manager->getTexture(handle);
+}
+
 std::optional<SDL_FRect> Renderer::getSpriteSrcRect(const Sprite &sprite) {
-	SDL_Texture *texture = resource_manager->getTexture(sprite.getTextureId());
-	if (!texture) {
-		spdlog::error("Failed to get texture for ID {}", sprite.getTextureId());
+	// 图片在其纹理中的区域（调用前已由 resolveTexture 解析句柄）；独立纹理为整张纹理，图集图片为图集页中的子矩形
+	SDL_FRect region = resource_manager->getTextureRegion(sprite.getTextureHandle());
+	if (region.w <= 0 || region.h <= 0) {
+		spdlog::error("Failed to get texture size for ID {}", sprite.getTextureId());
 		return std::nullopt;
 	}
 
 	auto src_rect = sprite.getSourceRect();
-	if (src_rect.has_value()) { // 如果Sprite中存在指定rect，则判断尺寸是否有效
+	if (src_rect.has_value()) { // 如果Sprite中存在指定rect，则判断尺寸是否有效，并换算到纹理区域内
 		if (src_rect.value().w <= 0 || src_rect.value().h <= 0) {
 			spdlog::error("Failed to get valid source rect size for ID {}", sprite.getTextureId());
 			return std::nullopt;
 		}
-		return src_rect;
-	} else { // 否则获取纹理尺寸并返回整个纹理大小
-		SDL_FRect result = { 0, 0, 0, 0 };
-		if (!SDL_GetTextureSize(texture, &result.w, &result.h)) {
-			spdlog::error("Failed to get texture size for ID {}", sprite.getTextureId());
-			return std::nullopt;
+		if (!resource_manager->isTextureReady(sprite.getTextureHandle())) { // 异步加载中：保持精灵尺寸，平铺占位纹理
+			return SDL_FRect{ 0, 0, src_rect->w, src_rect->h };
 		}
-		return result;
+		return SDL_FRect{ region.x + src_rect->x, region.y + src_rect->y, src_rect->w, src_rect->h };
+	} else { // 否则返回整个图片区域
+		return region;
 	}
 }
 
@@ -192,4 +238,192 @@ bool Renderer::isRectInViewport(const Camera &camera, const SDL_FRect &rect) {
 			rect.y + rect.h >= 0 && rect.y <= viewport_size.y;
 }
 
+void Renderer::drawTexture(SDL_Texture *texture, const SDL_FRect &src_rect, const SDL_FRect &dest_rect, double angle, SDL_FlipMode flip) {
+	if (!texture) {
+		return;
+	}
+	submitQuad(texture, src_rect, dest_rect, angle, flip, "<raw texture>");
+}
+
+void Renderer::drawGeometry(SDL_Texture *texture, std::span<const SDL_Vertex> vertices, std::span<const int> indices) {
+	if (!texture || vertices.empty() || indices.empty()) {
+		return;
+	}
+	if (!batching_enabled) {
+		if (!SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()))) {
+			spdlog::error("Failed to render geometry: {}", SDL_GetError());
+		}
+		return;
+	}
+	geometry_commands.push_back({ texture, vertices, indices, current_layer, static_cast<Uint32>(geometry_commands.size()) });
+}
+
+void Renderer::drawText(std::string_view text, std::string_view font_path, int font_size, const glm::vec2 &position, const SDL_FColor &color) {
+	if (text.empty()) {
+		return;
+	}
+	const engine::resource::TextLayout *layout = resource_manager->getTextLayout(font_path, font_size, text);
+	if (!layout) {
+		spdlog::error("Failed to lay out text with font {} ({}pt)", font_path, font_size);
+		return;
+	}
+
+	const float origin_x = std::round(position.x);
+	const float origin_y = std::round(position.y);
+	for (const auto &glyph : layout->glyphs) {
+		SDL_FRect dest_rect = { origin_x + glyph.dest_rect.x, origin_y + glyph.dest_rect.y, glyph.dest_rect.w, glyph.dest_rect.h };
+		submitQuad(glyph.texture, glyph.src_rect, dest_rect, 0.0, SDL_FLIP_NONE, font_path, color);
+	}
+}
+
+void Renderer::submitQuad(SDL_Texture *texture, const SDL_FRect &src_rect, const SDL_FRect &dest_rect, double angle, SDL_FlipMode flip, std::string_view texture_id, const SDL_FColor &color) {
+	if (!batching_enabled) {
+		const bool tinted = color.r != 1.0f || color.g != 1.0f || color.b != 1.0f || color.a != 1.0f;
+		if (tinted) {
+			SDL_SetTextureColorModFloat(texture, color.r, color.g, color.b);
+			SDL_SetTextureAlphaModFloat(texture, color.a);
+		}
+		if (!SDL_RenderTextureRotated(renderer, texture, &src_rect, &dest_rect, angle, nullptr, flip)) {
+			spdlog::error("Failed to render texture (ID: {}): {}", texture_id, SDL_GetError());
+		}
+		if (tinted) { // 纹理（图集页）被多处共享，画完恢复
+			SDL_SetTextureColorModFloat(texture, 1.0f, 1.0f, 1.0f);
+			SDL_SetTextureAlphaModFloat(texture, 1.0f);
+		}
+		return;
+	}
+
+	DrawCommand command;
+	command.texture = texture;
+	command.src_rect = src_rect;
+	command.dest_rect = dest_rect;
+	command.angle = static_cast<float>(angle);
+	command.layer = current_layer;
+	command.order = static_cast<Uint32>(draw_commands.size());
+	command.flip = flip;
+	command.color = color;
+	draw_commands.push_back(command);
+}
+
+void Renderer::flushBatches() {
+	PROFILE_SCOPE("Renderer::flushBatches");
+	last_batch_stats = {};
+	if (draw_commands.empty() && geometry_commands.empty()) {
+		return;
+	}
+
+	// 先按层，再按纹理排序；order 作为最后的比较键，使排序结果稳定
+	std::sort(draw_commands.begin(), draw_commands.end(), [](const DrawCommand &a, const DrawCommand &b) {
+		if (a.layer != b.layer) {
+			return a.layer < b.layer;
+		}
+		if (a.texture != b.texture) {
+			return a.texture < b.texture;
+		}
+		return a.order < b.order;
+	});
+	std::sort(geometry_commands.begin(), geometry_commands.end(), [](const GeometryCommand &a, const GeometryCommand &b) {
+		return a.layer != b.layer ? a.layer < b.layer : a.order < b.order;
+	});
+
+	size_t next_geometry = 0;
+	size_t run_begin = 0;
+	while (run_begin < draw_commands.size()) {
+		const DrawCommand &first = draw_commands[run_begin];
+		flushGeometry(next_geometry, first.layer); // 较低层的几何体先画
+		size_t run_end = run_begin + 1;
+		while (run_end < draw_commands.size() && draw_commands[run_end].layer == first.layer && draw_commands[run_end].texture == first.texture) {
+			++run_end;
+		}
+
+		float texture_w = 0.0f, texture_h = 0.0f;
+		if (!SDL_GetTextureSize(first.texture, &texture_w, &texture_h) || texture_w <= 0.0f || texture_h <= 0.0f) {
+			spdlog::error("Failed to get texture size for batch: {}", SDL_GetError());
+			run_begin = run_end;
+			continue;
+		}
+
+		batch_vertices.clear();
+		batch_indices.clear();
+		for (size_t i = run_begin; i < run_end; ++i) {
+			appendQuadVertices(draw_commands[i], texture_w, texture_h);
+		}
+
+		if (!SDL_RenderGeometry(renderer, first.texture, batch_vertices.data(), static_cast<int>(batch_vertices.size()),
+					batch_indices.data(), static_cast<int>(batch_indices.size()))) {
+			spdlog::error("Failed to render sprite batch: {}", SDL_GetError());
+		}
+		++last_batch_stats.draw_calls;
+		run_begin = run_end;
+	}
+	flushGeometry(next_geometry, std::nullopt);
+
+	last_batch_stats.sprite_count = static_cast<int>(draw_commands.size());
+	last_batch_stats.saved_draw_calls = std::max(0, last_batch_stats.sprite_count - last_batch_stats.draw_calls);
+	draw_commands.clear();
+	geometry_commands.clear();
+}
+
+void Renderer::flushGeometry(size_t &next, std::optional<int> before_layer) {
+	if (next >= geometry_commands.size()) {
+		return; // 每层都会调用一次，没有几何体时不记录分析区间
+	}
+	PROFILE_SCOPE("Renderer::flushGeometry");
+	for (; next < geometry_commands.size() && (!before_layer || geometry_commands[next].layer < *before_layer); ++next) {
+		const GeometryCommand &command = geometry_commands[next];
+		if (!SDL_RenderGeometry(renderer, command.texture, command.vertices.data(), static_cast<int>(command.vertices.size()),
+					command.indices.data(), static_cast<int>(command.indices.size()))) {
+			spdlog::error("Failed to render geometry batch: {}", SDL_GetError());
+		}
+		++last_batch_stats.draw_calls;
+	}
+}
+
+
+void Renderer::appendQuadVertices(const DrawCommand &command, float texture_w, float texture_h) {
+	// 纹理坐标
+	float u0 = command.src_rect.x / texture_w;
+	float v0 = command.src_rect.y / texture_h;
+	float u1 = (command.src_rect.x + command.src_rect.w) / texture_w;
+	float v1 = (command.src_rect.y + command.src_rect.h) / texture_h;
+	if (command.flip & SDL_FLIP_HORIZONTAL) { // 水平翻转：交换左右纹理坐标
+		std::swap(u0, u1);
+	}
+	if (command.flip & SDL_FLIP_VERTICAL) { // 垂直翻转：交换上下纹理坐标
+		std::swap(v0, v1);
+	}
+
+	// 以目标矩形中心为原点的四个角（左上、右上、右下、左下）
+	const float half_w = command.dest_rect.w * 0.5f;
+	const float half_h = command.dest_rect.h * 0.5f;
+	const float center_x = command.dest_rect.x + half_w;
+	const float center_y = command.dest_rect.y + half_h;
+	const float corner_x[4] = { -half_w, half_w, half_w, -half_w };
+	const float corner_y[4] = { -half_h, -half_h, half_h, half_h };
+	const float corner_u[4] = { u0, u1, u1, u0 };
+	const float corner_v[4] = { v0, v0, v1, v1 };
+
+	// 与 SDL_RenderTextureRotated 一致：屏幕坐标系（y 向下）中正角度为顺时针
+	float cos_a = 1.0f, sin_a = 0.0f;
+	if (command.angle != 0.0f) {
+		const float radians = command.angle * 3.14159265358979f / 180.0f;
+		cos_a = std::cos(radians);
+		sin_a = std::sin(radians);
+	}
+
+	const int base = static_cast<int>(batch_vertices.size());
+	for (int i = 0; i < 4; ++i) {
+		SDL_Vertex vertex;
+		vertex.position.x = center_x + corner_x[i] * cos_a - corner_y[i] * sin_a;
+		vertex.position.y = center_y + corner_x[i] * sin_a + corner_y[i] * cos_a;
+		vertex.color = command.color;
+		vertex.tex_coord = { corner_u[i], corner_v[i] };
+		batch_vertices.push_back(vertex);
+	}
+	const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int index : quad_indices) {
+		batch_indices.push_back(base + index);
+	}
+}
+
 } // namespace engine::render
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
 
+#include <SDL3/SDL_render.h>
 #include <glm/glm.hpp>
 
 
@@ -18,11 +22,49 @@ namespace engine::render {
 
 class Camera;
 
+/**
+ * @brief 批处理模式下一帧的绘制统计
+ */
+struct BatchStats {
+	int sprite_count = 0; ///< @brief 本帧记录的精灵（四边形）数量
+	int draw_calls = 0; ///< @brief 实际提交的 SDL_RenderGeometry 次数
+	int saved_draw_calls = 0; ///< @brief 相比逐精灵绘制节省的调用次数
+};
+
 class Renderer final {
 private:
+	/// @brief 批处理模式下记录的一条绘制命令，在 present() 时统一排序提交
+	struct DrawCommand {
+		SDL_Texture *texture = nullptr;
+		SDL_FRect src_rect = { 0, 0, 0, 0 }; ///< @brief 源矩形（像素）
+		SDL_FRect dest_rect = { 0, 0, 0, 0 };
+		float angle = 0.0f; ///< @brief 旋转角度（度，顺时针），绕目标矩形中心
+		int layer = 0;
+		Uint32 order = 0; ///< @brief 记录顺序，保证同层同纹理的精灵保持提交顺序
+		SDL_FlipMode flip = SDL_FLIP_NONE;
+		SDL_FColor color = { 1.0f, 1.0f, 1.0f, 1.0f }; ///< @brief 顶点色，用于文字着色
+	};
+
+	/// @brief 批处理模式下记录的一段调用方提供的几何体，只保存视图，不拷贝顶点
+	struct GeometryCommand {
+		SDL_Texture *texture = nullptr;
+		std::span<const SDL_Vertex> vertices;
+		std::span<const int> indices;
+		int layer = 0;
+		Uint32 order = 0;
+	};
+
 	SDL_Renderer *renderer = nullptr; ///< @brief 指向 SDL_Renderer 的非拥有指针
 	engine::resource::ResourceManager *resource_manager = nullptr; ///< @brief 指向 ResourceManager 的非拥有指针
 
+	bool batching_enabled = false; ///< @brief 是否启用延迟批处理
+	int current_layer = 0; ///< @brief 新记录命令所属的层，层越大越靠上
+	std::vector<DrawCommand> draw_commands; ///< @brief 当前帧的命令列表（跨帧复用容量）
+	std::vector<GeometryCommand> geometry_commands; ///< @brief 当前帧的几何体命令（跨帧复用容量）
+	std::vector<SDL_Vertex> batch_vertices; ///< @brief 合批顶点缓冲（跨帧复用容量）
+	std::vector<int> batch_indices; ///< @brief 合批索引缓冲（跨帧复用容量）
+	BatchStats last_batch_stats; ///< @brief 上一次 present() 的批处理统计
+
 public:
 	/**
 	 * @brief 构造函数
@@ -44,6 +86,14 @@ public:
 	void drawSprite(const Camera &camera, const Sprite &sprite, const glm::vec2 &position,
 			const glm::vec2 &scale = { 1.0f, 1.0f }, double angle = 0.0f);
 
+	/**
+	 * @brief 绘制一个已变换到屏幕坐标、已完成裁剪的精灵（配合 Camera::cullToScreen 使用）
+	 *
+	 * @param dest_rect 屏幕坐标中的目标矩形，不再做视口裁剪。
+	 * @param angle 旋转角度（度）。
+	 */
+	void drawSpriteScreen(const Sprite &sprite, const SDL_FRect &dest_rect, double angle = 0.0f);
+
 	// @brief 绘制视差滚动背景
     //
 	// @param sprite 包含纹理ID、源矩形和翻转状态的 Sprite 对象。
@@ -62,7 +112,44 @@ public:
 	 */
 	void drawUISprite(const Sprite &sprite, const glm::vec2 &position, const std::optional<glm::vec2> &size = std::nullopt);
 
-	void present(); ///< @brief 更新屏幕，包装 SDL_RenderPresent 函数
+	/**
+	 * @brief 在屏幕坐标中绘制一个已解析的纹理区域（如预烘焙的瓦片区块），参与批处理
+	 *
+	 * @param texture 纹理，为 nullptr 时忽略。
+	 * @param src_rect 纹理中的源矩形（像素）。
+	 * @param dest_rect 屏幕坐标中的目标矩形。
+	 * @param angle 绕目标矩形中心的旋转角度（度，顺时针）。
+	 * @param flip 翻转方式，可组合水平与垂直翻转。
+	 */
+	void drawTexture(SDL_Texture *texture, const SDL_FRect &src_rect, const SDL_FRect &dest_rect, double angle = 0.0, SDL_FlipMode flip = SDL_FLIP_NONE);
+
+	/**
+	 * @brief 提交一段已在屏幕坐标中展开好的几何体（如粒子），整段一次 SDL_RenderGeometry
+	 *
+	 * 批处理模式下只记录视图，在同层的精灵之后提交，因此 vertices 与 indices 必须保持有效直到 present() / flush()。
+	 *
+	 * @param texture 纹理，为 nullptr 时忽略。
+	 * @param vertices 屏幕坐标顶点，tex_coord 为归一化纹理坐标。
+	 * @param indices 三角形索引。
+	 */
+	void drawGeometry(SDL_Texture *texture, std::span<const SDL_Vertex> vertices, std::span<const int> indices);
+
+	/**
+	 * @brief 在屏幕坐标中绘制一段文本（UTF-8，'\n' 换行）
+	 *
+	 * 字形来自每个字体各自的图集，排版结果按字符串缓存；批处理模式下同一字体的文本合并为一次几何提交，
+	 * 稳态下不会再调用 TTF 光栅化。
+	 *
+	 * @param font_path 字体文件路径。
+	 * @param font_size 字号（磅）。
+	 * @param position 屏幕坐标中文本的左上角，会取整到像素以保持位图字体清晰。
+	 * @param color 文字颜色。
+	 */
+	void drawText(std::string_view text, std::string_view font_path, int font_size, const glm::vec2 &position,
+			const SDL_FColor &color = { 1.0f, 1.0f, 1.0f, 1.0f });
+
+	void present(); ///< @brief 更新屏幕，包装 SDL_RenderPresent 函数；批处理模式下先提交本帧所有命令
+	void flush(); ///< @brief 立即提交已记录的批处理命令，之后可以直接用 SDL 绘制覆盖在其上的内容（如调试叠加层）
 	void clearScreen(); ///< @brief 清屏，包装 SDL_RenderClear 函数
 
 	void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255); ///< @brief 设置绘制颜色，包装 SDL_SetRenderDrawColor 函数，使用 Uint8 类型
@@ -70,14 +157,35 @@ public:
 
 	SDL_Renderer *getSDLRenderer() const { return renderer; } ///< @brief 获取底层的 SDL_Renderer 指针
 
+	/**
+	 * @brief 启用或关闭延迟批处理模式
+	 *
+	 * 启用后 drawSprite / drawParallax / drawUISprite 只记录命令，在 present() 时按层、再按纹理排序，
+	 * 共享同一纹理的连续精灵合并为一次 SDL_RenderGeometry 提交。
+	 * 注意：同一层内不同纹理的精灵之间不保证绘制顺序，需要严格遮挡关系的内容请放在不同层。
+	 */
+	void setBatchingEnabled(bool enabled);
+	bool isBatchingEnabled() const { return batching_enabled; }
+	void setLayer(int layer) { current_layer = layer; } ///< @brief 设置后续绘制命令所属的层（仅批处理模式下生效）
+	int getLayer() const { return current_layer; }
+	const BatchStats &getBatchStats() const { return last_batch_stats; } ///< @brief 获取上一帧的批处理统计
+
 	Renderer(const Renderer &) = delete;
 	Renderer &operator=(const Renderer &) = delete;
 	Renderer(Renderer &&) = delete;
 	Renderer &operator=(Renderer &&) = delete;
 
 private:
+	SDL_Texture *resolveTexture(const Sprite &sprite); ///< @brief 通过句柄解析精灵纹理，句柄无效时按路径解析一次并缓存到 Sprite
 	std::optional<SDL_FRect> getSpriteSrcRect(const Sprite &sprite); ///< @brief 获取精灵的源矩形，用于具体绘制。出现错误则返回std::nullopt并跳过绘制
 	bool isRectInViewport(const Camera &camera, const SDL_FRect &rect); ///< @brief 判断矩形是否在视口中，用于视口裁剪
+
+	/// @brief 绘制或记录一个纹理四边形
+	void submitQuad(SDL_Texture *texture, const SDL_FRect &src_rect, const SDL_FRect &dest_rect, double angle, SDL_FlipMode flip, std::string_view texture_id,
+			const SDL_FColor &color = { 1.0f, 1.0f, 1.0f, 1.0f });
+	void flushBatches(); ///< @brief 排序并提交本帧记录的所有命令
+	void flushGeometry(size_t &next, std::optional<int> before_layer); ///< @brief 按顺序提交层号小于 before_layer 的几何体命令，为空时提交剩余全部
+	void appendQuadVertices(const DrawCommand &command, float texture_w, float texture_h); ///< @brief 将一条命令展开为 4 个顶点与 6 个索引
 };
 
 } //namespace engine::render
\ No newline at end of file
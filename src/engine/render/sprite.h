@@ -5,6 +5,8 @@
 
 #include <SDL3/SDL_rect.h>
 
+#include "../resource/texture_handle.h"
+
 namespace engine::render {
 
 class Sprite final {
@@ -12,15 +14,25 @@ private:
 	std::string texture_id;
 	std::optional<SDL_FRect> source_rect;
 	bool is_flipped = false;
+	/// @brief 已解析的纹理句柄缓存。首次绘制时由 Renderer 按 texture_id 解析一次，之后 O(1) 访问
+	mutable engine::resource::TextureHandle texture_handle;
 
 public:
 	Sprite(const std::string &texture_id, const std::optional<SDL_FRect> &source_rect = std::nullopt, bool is_flipped = false) :
 			texture_id(texture_id), source_rect(source_rect), is_flipped(is_flipped) {}
 
+	/// @brief 使用已解析的句柄构造，texture_id 仅用于日志与句柄失效后的重新解析
+	Sprite(engine::resource::TextureHandle handle, const std::string &texture_id, const std::optional<SDL_FRect> &source_rect = std::nullopt, bool is_flipped = false) :
+			texture_id(texture_id), source_rect(source_rect), is_flipped(is_flipped), texture_handle(handle) {}
+
 	[[nodiscard]] const std::string &getTextureId() const {
 		return texture_id;
 	}
 
+	[[nodiscard]] engine::resource::TextureHandle getTextureHandle() const {
+		return texture_handle;
+	}
+
 	[[nodiscard]] const std::optional<SDL_FRect> &getSourceRect() const {
 		return source_rect;
 	}
@@ -31,6 +43,12 @@ public:
 
 	void setTextureId(const std::string &id) {
 		texture_id = id;
+		texture_handle = {}; // 路径改变，旧句柄作废
+	}
+
+	/// @brief 更新句柄缓存。句柄只是 texture_id 的解析结果，不改变 Sprite 的逻辑状态，因此允许在 const 对象上调用
+	void setTextureHandle(engine::resource::TextureHandle handle) const {
+		texture_handle = handle;
 	}
 
 	void setSourceRect(const std::optional<SDL_FRect> &rect) {
@@ -42,4 +60,4 @@ public:
 	}
 };
 
-} //namespace engine::render
\ No newline at end of file
+} //namespace engine::render
@@ -0,0 +1,317 @@
+#include "tile_map_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include "../debug/profiler.h"
+#include "../map/tile_map.h"
+#include "../resource/resource_manager.h"
+#include "camera.h"
+#include "renderer.h"
+
+namespace engine::render {
+
+TileMapRenderer::TileMapRenderer(Renderer *renderer, engine::resource::ResourceManager *resource_manager, const engine::map::TileMap *map, int chunk_tiles) :
+		renderer(renderer), resource_manager(resource_manager), map(map), chunk_tiles(chunk_tiles) {
+	if (!renderer || !resource_manager || !map) {
+		throw std::runtime_error("TileMapRenderer construction failed: Renderer, ResourceManager and TileMap must not be null.");
+	}
+	if (chunk_tiles <= 0 || map->tile_width <= 0 || map->tile_height <= 0) {
+		throw std::runtime_error("TileMapRenderer construction failed: invalid chunk or tile size.");
+	}
+
+	// 比格子大的图块以左下角对齐，会向右、向上越过相邻格子，烘焙区块时需要把这些邻居也画进来
+	glm::ivec2 max_image = map->getMaxTileImageSize();
+	overflow_tiles.x = (max_image.x + map->tile_width - 1) / map->tile_width - 1;
+	overflow_tiles.y = (max_image.y + map->tile_height - 1) / map->tile_height - 1;
+
+	const float chunk_w = static_cast<float>(chunk_tiles * map->tile_width);
+	const float chunk_h = static_cast<float>(chunk_tiles * map->tile_height);
+	for (const auto &layer : map->tile_layers) {
+		TileLayerChunks layer_chunks;
+		layer_chunks.layer = &layer;
+		layer_chunks.chunks_x = (layer.width + chunk_tiles - 1) / chunk_tiles;
+		layer_chunks.chunks_y = (layer.height + chunk_tiles - 1) / chunk_tiles;
+		layer_chunks.chunks.resize(static_cast<size_t>(layer_chunks.chunks_x) * layer_chunks.chunks_y);
+		for (int cy = 0; cy < layer_chunks.chunks_y; ++cy) {
+			for (int cx = 0; cx < layer_chunks.chunks_x; ++cx) {
+				Chunk &chunk = layer_chunks.chunks[static_cast<size_t>(cy) * layer_chunks.chunks_x + cx];
+				int tiles_w = std::min(chunk_tiles, layer.width - cx * chunk_tiles);
+				int tiles_h = std::min(chunk_tiles, layer.height - cy * chunk_tiles);
+				chunk.world_rect = { cx * chunk_w, cy * chunk_h, static_cast<float>(tiles_w * map->tile_width), static_cast<float>(tiles_h * map->tile_height) };
+			}
+		}
+		tile_layers.push_back(std::move(layer_chunks));
+	}
+
+	image_sprites.reserve(map->image_layers.size());
+	for (const auto &layer : map->image_layers) {
+		image_sprites.emplace_back(layer.image);
+	}
+	spdlog::trace("TileMapRenderer created for '{}' ({} tile layers, chunk size {} tiles).", map->path, tile_layers.size(), chunk_tiles);
+}
+
+void TileMapRenderer::update(float delta_time) {
+	animation_time_ms += delta_time * 1000.0f;
+}
+
+int TileMapRenderer::draw(const Camera &camera, int first_layer) {
+	PROFILE_SCOPE("TileMapRenderer::draw");
+	visible_chunk_count = 0;
+	int layer = first_layer;
+	for (const auto &layer_ref : map->layer_order) {
+		renderer->setLayer(layer++);
+		switch (layer_ref.type) {
+			case engine::map::LayerType::Tile:
+				if (map->tile_layers[layer_ref.index].visible) {
+					drawTileLayer(camera, tile_layers[layer_ref.index]);
+				}
+				break;
+			case engine::map::LayerType::Image: {
+				const auto &image_layer = map->image_layers[layer_ref.index];
+				if (image_layer.visible && !image_layer.image.empty()) {
+					renderer->drawParallax(camera, image_sprites[layer_ref.index], image_layer.offset, image_layer.parallax, image_layer.repeat);
+				}
+				break;
+			}
+			case engine::map::LayerType::Object: // 对象由游戏逻辑生成实体后绘制
+				break;
+		}
+	}
+	return layer;
+}
+
+void TileMapRenderer::invalidate() {
+	for (auto &layer_chunks : tile_layers) {
+		for (auto &chunk : layer_chunks.chunks) {
+			chunk.texture.reset();
+			chunk.dynamic_tiles.clear();
+			chunk.baked = false;
+			chunk.empty = true;
+		}
+	}
+}
+
+void TileMapRenderer::drawTileLayer(const Camera &camera, TileLayerChunks &layer_chunks) {
+	const engine::map::TileLayer &layer = *layer_chunks.layer;
+	const float chunk_w = static_cast<float>(chunk_tiles * map->tile_width);
+	const float chunk_h = static_cast<float>(chunk_tiles * map->tile_height);
+
+	// 直接由视口计算可见区块范围，不遍历全部区块
+	glm::vec2 view_min = camera.getPosition() - layer.offset;
+	glm::vec2 view_max = view_min + camera.getViewportSize();
+	int cx0 = std::max(0, static_cast<int>(std::floor(view_min.x / chunk_w)));
+	int cy0 = std::max(0, static_cast<int>(std::floor(view_min.y / chunk_h)));
+	int cx1 = std::min(layer_chunks.chunks_x - 1, static_cast<int>(std::floor(view_max.x / chunk_w)));
+	int cy1 = std::min(layer_chunks.chunks_y - 1, static_cast<int>(std::floor(view_max.y / chunk_h)));
+
+	for (int cy = cy0; cy <= cy1; ++cy) {
+		for (int cx = cx0; cx <= cx1; ++cx) {
+			Chunk &chunk = layer_chunks.chunks[static_cast<size_t>(cy) * layer_chunks.chunks_x + cx];
+			if (!chunk.baked) {
+				bakeChunk(layer_chunks, cx, cy, chunk);
+			}
+			if (!chunk.empty && chunk.texture) {
+				glm::vec2 screen = camera.worldToScreen(glm::vec2(chunk.world_rect.x, chunk.world_rect.y) + layer.offset);
+				SDL_FRect src_rect = { 0, 0, chunk.world_rect.w, chunk.world_rect.h };
+				SDL_FRect dest_rect = { screen.x, screen.y, chunk.world_rect.w, chunk.world_rect.h };
+				renderer->drawTexture(chunk.texture.get(), src_rect, dest_rect);
+				++visible_chunk_count;
+			}
+			for (const auto &tile : chunk.dynamic_tiles) {
+				drawDynamicTile(camera, layer, tile);
+			}
+		}
+	}
+}
+
+void TileMapRenderer::bakeChunk(const TileLayerChunks &layer_chunks, int chunk_x, int chunk_y, Chunk &chunk) {
+	PROFILE_SCOPE("TileMapRenderer::bakeChunk");
+	const engine::map::TileLayer &layer = *layer_chunks.layer;
+	SDL_Renderer *sdl_renderer = renderer->getSDLRenderer();
+
+	chunk.dynamic_tiles.clear();
+	chunk.empty = true;
+	chunk.baked = true;
+
+	const int col_begin = chunk_x * chunk_tiles;
+	const int row_begin = chunk_y * chunk_tiles;
+	const int col_end = std::min(layer.width, col_begin + chunk_tiles);
+	const int row_end = std::min(layer.height, row_begin + chunk_tiles);
+
+	// 先收集动画图块并判断区块是否为空（包括越界进来的大图块）
+	bool has_static_tiles = false;
+	for (int row = row_begin; row < std::min(layer.height, row_end + overflow_tiles.y); ++row) {
+		for (int col = std::max(0, col_begin - overflow_tiles.x); col < col_end; ++col) {
+			Uint32 gid = layer.getGid(col, row);
+			if ((gid & engine::map::TILE_GID_MASK) == 0) {
+				continue;
+			}
+			auto info = map->resolveGid(gid);
+			if (!info) {
+				continue;
+			}
+			bool home_cell = col >= col_begin && row < row_end;
+			if (info->data && !info->data->animation.empty()) {
+				if (home_cell) {
+					chunk.dynamic_tiles.push_back({ col, row, gid });
+				}
+				continue;
+			}
+			has_static_tiles = true;
+		}
+	}
+	if (!has_static_tiles) {
+		chunk.texture.reset();
+		return;
+	}
+
+	if (!chunk.texture) {
+		SDL_Texture *texture = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+				static_cast<int>(chunk.world_rect.w), static_cast<int>(chunk.world_rect.h));
+		if (!texture) {
+			spdlog::error("Failed to create chunk texture for layer '{}': {}", layer.name, SDL_GetError());
+			return;
+		}
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+		SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+		SDL_SetTextureAlphaModFloat(texture, layer.opacity);
+		chunk.texture.reset(texture);
+	}
+
+	// 切换渲染目标，直接调用 SDL 绘制（烘焙不经过 Renderer 的批处理）
+	SDL_Texture *previous_target = SDL_GetRenderTarget(sdl_renderer);
+	Uint8 r, g, b, a;
+	SDL_GetRenderDrawColor(sdl_renderer, &r, &g, &b, &a);
+	SDL_SetRenderTarget(sdl_renderer, chunk.texture.get());
+	SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 0);
+	SDL_RenderClear(sdl_renderer);
+
+	// 行优先绘制，与 Tiled 的 right-down 顺序一致，保证大图块在区块间的遮挡关系相同
+	const glm::vec2 origin(chunk.world_rect.x, chunk.world_rect.y);
+	bool any_pending = false;
+	for (int row = row_begin; row < std::min(layer.height, row_end + overflow_tiles.y); ++row) {
+		for (int col = std::max(0, col_begin - overflow_tiles.x); col < col_end; ++col) {
+			Uint32 gid = layer.getGid(col, row);
+			if ((gid & engine::map::TILE_GID_MASK) == 0) {
+				continue;
+			}
+			auto info = map->resolveGid(gid);
+			if (!info || (info->data && !info->data->animation.empty())) {
+				continue;
+			}
+
+			SDL_Texture *texture = nullptr;
+			SDL_FRect src_rect, dest_rect;
+			double angle = 0.0;
+			SDL_FlipMode flip = SDL_FLIP_NONE;
+			bool texture_pending = false;
+			if (!resolveTileQuad(gid, col, row, origin, texture, src_rect, dest_rect, angle, flip, texture_pending)) {
+				continue;
+			}
+			any_pending = any_pending || texture_pending;
+			if (!SDL_RenderTextureRotated(sdl_renderer, texture, &src_rect, &dest_rect, angle, nullptr, flip)) {
+				spdlog::error("Failed to bake tile {} in layer '{}': {}", gid & engine::map::TILE_GID_MASK, layer.name, SDL_GetError());
+			}
+		}
+	}
+
+	SDL_SetRenderTarget(sdl_renderer, previous_target);
+	SDL_SetRenderDrawColor(sdl_renderer, r, g, b, a);
+	chunk.empty = false;
+	// 只有仍在加载的纹理（烘焙进去的是占位图）才需要下次可见时重新烘焙；加载失败的占位图是最终结果
+	chunk.baked = !any_pending;
+}
+
+void TileMapRenderer::drawDynamicTile(const Camera &camera, const engine::map::TileLayer &layer, const DynamicTile &tile) {
+	auto info = map->resolveGid(tile.gid);
+	if (!info || !info->data || info->data->animation.empty()) {
+		return;
+	}
+
+	// 按累计时间选出当前帧
+	const auto &frames = info->data->animation;
+	int total_ms = 0;
+	for (const auto &frame : frames) {
+		total_ms += frame.duration_ms;
+	}
+	int frame_tile = frames.front().tile_id;
+	if (total_ms > 0) {
+		int t = static_cast<int>(std::fmod(animation_time_ms, static_cast<float>(total_ms)));
+		for (const auto &frame : frames) {
+			if (t < frame.duration_ms) {
+				frame_tile = frame.tile_id;
+				break;
+			}
+			t -= frame.duration_ms;
+		}
+	}
+	Uint32 frame_gid = (info->tileset->firstgid + static_cast<Uint32>(frame_tile)) | (tile.gid & ~engine::map::TILE_GID_MASK);
+
+	SDL_Texture *texture = nullptr;
+	SDL_FRect src_rect, dest_rect;
+	double angle = 0.0;
+	SDL_FlipMode flip = SDL_FLIP_NONE;
+	bool texture_pending = false;
+	glm::vec2 origin = -camera.worldToScreen(layer.offset); // 目标矩形直接落在屏幕坐标中
+	if (resolveTileQuad(frame_gid, tile.column, tile.row, origin, texture, src_rect, dest_rect, angle, flip, texture_pending)) {
+		renderer->drawTexture(texture, src_rect, dest_rect, angle, flip);
+	}
+}
+
+bool TileMapRenderer::resolveTileQuad(Uint32 gid, int column, int row, const glm::vec2 &origin, SDL_Texture *&texture, SDL_FRect &src_rect, SDL_FRect &dest_rect,
+		double &angle, SDL_FlipMode &flip, bool &texture_pending) {
+	auto info = map->resolveGid(gid);
+	if (!info) {
+		return false;
+	}
+
+	auto handle = resource_manager->getTextureHandle(info->image);
+	texture = resource_manager->getTexture(handle);
+	if (!texture) {
+		return false;
+	}
+	// 加载失败的纹理不会再变化（getTextureHandle 不重试），占位图就是最终结果，不算待加载
+	const bool loaded = resource_manager->isTextureReady(handle);
+	texture_pending = !loaded && !resource_manager->isTextureFailed(handle);
+	SDL_FRect region = resource_manager->getTextureRegion(handle);
+	src_rect = info->source_rect;
+	if (loaded) { // 换算到纹理（可能是图集页）中的区域
+		src_rect.x += region.x;
+		src_rect.y += region.y;
+	}
+
+	// 图块图片以格子左下角对齐（与 Tiled 一致）
+	dest_rect.x = static_cast<float>(column * map->tile_width) - origin.x;
+	dest_rect.y = static_cast<float>((row + 1) * map->tile_height) - info->source_rect.h - origin.y;
+	dest_rect.w = info->source_rect.w;
+	dest_rect.h = info->source_rect.h;
+
+	// Tiled 依次应用对角、水平、垂直翻转；换算为 SDL 的“先翻转后顺时针旋转”
+	int flip_bits = SDL_FLIP_NONE;
+	if (info->flip_diagonal) {
+		angle = 90.0;
+		if (info->flip_vertical) {
+			flip_bits |= SDL_FLIP_HORIZONTAL;
+		}
+		if (!info->flip_horizontal) {
+			flip_bits |= SDL_FLIP_VERTICAL;
+		}
+	} else {
+		angle = 0.0;
+		if (info->flip_horizontal) {
+			flip_bits |= SDL_FLIP_HORIZONTAL;
+		}
+		if (info->flip_vertical) {
+			flip_bits |= SDL_FLIP_VERTICAL;
+		}
+	}
+	flip = static_cast<SDL_FlipMode>(flip_bits);
+	return true;
+}
+
+} // namespace engine::render
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <SDL3/SDL_render.h>
+#include <glm/glm.hpp>
+
+#include "sprite.h"
+
+namespace engine::map {
+class TileMap;
+struct TileLayer;
+} // namespace engine::map
+
+namespace engine::resource {
+class ResourceManager;
+}
+
+namespace engine::render {
+
+class Camera;
+class Renderer;
+
+/**
+ * @brief 以区块为单位预烘焙并绘制 Tiled 地图
+ *
+ * 每个图块图层被切分为 chunk_tiles x chunk_tiles 的区块。静态区块在第一次进入视口时烘焙到一张渲染目标纹理中，
+ * 之后每帧只需一次绘制；只有与相机视口重叠的区块会被绘制。带 Tiled 动画的图块不参与烘焙，逐帧单独绘制。
+ * 图片图层按视差参数通过 Renderer::drawParallax 绘制。
+ *
+ * 注意：TileMap 的生命周期必须长于 TileMapRenderer。
+ */
+class TileMapRenderer final {
+private:
+	struct SDLTextureDeleter {
+		void operator()(SDL_Texture *texture) const {
+			if (texture) {
+				SDL_DestroyTexture(texture);
+			}
+		}
+	};
+
+	/// @brief 逐帧绘制的动画图块
+	struct DynamicTile {
+		int column;
+		int row;
+		Uint32 gid;
+	};
+
+	struct Chunk {
+		std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;
+		SDL_FRect world_rect = { 0, 0, 0, 0 }; ///< @brief 区块覆盖的世界矩形（不含图层偏移）
+		std::vector<DynamicTile> dynamic_tiles;
+		bool baked = false;
+		bool empty = true; ///< @brief 没有任何静态图块，不需要纹理
+	};
+
+	struct TileLayerChunks {
+		const engine::map::TileLayer *layer = nullptr;
+		int chunks_x = 0;
+		int chunks_y = 0;
+		std::vector<Chunk> chunks; ///< @brief 行优先
+	};
+
+	Renderer *renderer = nullptr;
+	engine::resource::ResourceManager *resource_manager = nullptr;
+	const engine::map::TileMap *map = nullptr;
+	int chunk_tiles = 16;
+	glm::ivec2 overflow_tiles = glm::ivec2(0); ///< @brief 大图块可越过的格子数（向右、向上）
+
+	std::vector<TileLayerChunks> tile_layers; ///< @brief 与 map->tile_layers 一一对应
+	std::vector<Sprite> image_sprites; ///< @brief 与 map->image_layers 一一对应
+	float animation_time_ms = 0.0f;
+	int visible_chunk_count = 0; ///< @brief 上一帧绘制的区块数
+
+public:
+	/**
+	 * @brief 构造函数
+	 *
+	 * @param renderer 指向有效的 Renderer 的指针。不能为空。
+	 * @param resource_manager 指向有效的 ResourceManager 的指针。不能为空。
+	 * @param map 要绘制的地图。不能为空。
+	 * @param chunk_tiles 区块边长（以图块为单位）。
+	 * @throws std::runtime_error 如果任一指针为 nullptr 或 chunk_tiles 无效。
+	 */
+	TileMapRenderer(Renderer *renderer, engine::resource::ResourceManager *resource_manager, const engine::map::TileMap *map, int chunk_tiles = 16);
+
+	void update(float delta_time); ///< @brief 推进图块动画时间
+
+	/**
+	 * @brief 按 Tiled 中的图层顺序绘制地图
+	 *
+	 * @param camera 相机。
+	 * @param first_layer 第一个地图图层使用的 Renderer 层，之后每个图层递增。
+	 * @return 地图之后第一个空闲的 Renderer 层。
+	 */
+	int draw(const Camera &camera, int first_layer = 0);
+
+	void invalidate(); ///< @brief 丢弃所有已烘焙的区块（如渲染目标丢失后），下次可见时重新烘焙
+	int getVisibleChunkCount() const { return visible_chunk_count; }
+
+	TileMapRenderer(const TileMapRenderer &) = delete;
+	TileMapRenderer &operator=(const TileMapRenderer &) = delete;
+	TileMapRenderer(TileMapRenderer &&) = delete;
+	TileMapRenderer &operator=(TileMapRenderer &&) = delete;
+
+private:
+	void drawTileLayer(const Camera &camera, TileLayerChunks &layer_chunks);
+	void bakeChunk(const TileLayerChunks &layer_chunks, int chunk_x, int chunk_y, Chunk &chunk);
+	void drawDynamicTile(const Camera &camera, const engine::map::TileLayer &layer, const DynamicTile &tile);
+	/**
+	 * @brief 解析 gid 的纹理、源矩形与翻转，计算出以格子左下角对齐的目标矩形（相对 origin），失败返回 false
+	 * @param texture_pending 纹理仍在加载、当前返回的是占位图时为 true（加载失败不算）
+	 */
+	bool resolveTileQuad(Uint32 gid, int column, int row, const glm::vec2 &origin, SDL_Texture *&texture, SDL_FRect &src_rect, SDL_FRect &dest_rect,
+			double &angle, SDL_FlipMode &flip, bool &texture_pending);
+};
+
+} // namespace engine::render
@@ -0,0 +1,361 @@
+#include "asset_archive.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <lz4.h>
+#include <lz4hc.h>
+#include <spdlog/spdlog.h>
+
+#include "../debug/profiler.h"
+#include "../utils/mapped_file.h"
+
+namespace engine::resource {
+
+// 记录按原样写入并原地读取，只支持小端平台
+static_assert(std::endian::native == std::endian::little, "Asset archive format requires a little-endian host.");
+
+namespace {
+
+using namespace pak;
+
+constexpr size_t BYTES_PER_PIXEL = 4;
+
+bool inBounds(Uint64 offset, Uint64 size, Uint64 file_size) {
+	return offset <= file_size && size <= file_size - offset;
+}
+
+} // namespace
+
+// --- AssetArchive ---
+
+AssetArchive::AssetArchive() = default;
+AssetArchive::~AssetArchive() = default;
+
+bool AssetArchive::open(const std::string &archive_path) {
+	PROFILE_SCOPE("AssetArchive::open");
+	close();
+	auto mapped = std::make_shared<engine::utils::MappedFile>();
+	if (!mapped->open(archive_path)) {
+		return false;
+	}
+	const Uint64 file_size = mapped->getSize();
+	if (file_size < sizeof(Header)) {
+		spdlog::error("Asset archive '{}' is too small.", archive_path);
+		return false;
+	}
+
+	Header header;
+	std::memcpy(&header, mapped->getData(), sizeof(Header));
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.file_size != file_size) {
+		spdlog::error("Asset archive '{}' has an invalid header or version (expected v{}).", archive_path, VERSION);
+		return false;
+	}
+	if (!inBounds(header.index_offset, static_cast<Uint64>(header.entry_count) * sizeof(EntryRecord), file_size) ||
+			header.index_offset % alignof(EntryRecord) != 0 || !inBounds(header.strings_offset, header.strings_size, file_size)) {
+		spdlog::error("Asset archive '{}' has a corrupt index.", archive_path);
+		return false;
+	}
+
+	const std::byte *base = mapped->getData();
+	std::span<const EntryRecord> records(reinterpret_cast<const EntryRecord *>(base + header.index_offset), header.entry_count);
+	std::string_view string_table(reinterpret_cast<const char *>(base + header.strings_offset), header.strings_size);
+
+	// 一次性校验所有条目，之后的读取不再做边界检查
+	std::string_view previous;
+	for (const EntryRecord &record : records) {
+		bool valid = inBounds(record.path, record.path_length, header.strings_size) && inBounds(record.offset, record.stored_size, file_size);
+		if (valid && record.type == static_cast<Uint32>(EntryType::Image)) {
+			valid = record.width > 0 && record.height > 0 &&
+					record.size == static_cast<Uint64>(record.width) * static_cast<Uint64>(record.height) * BYTES_PER_PIXEL;
+		} else if (valid) {
+			valid = record.type == static_cast<Uint32>(EntryType::Raw);
+		}
+		if (valid) {
+			// 只有图片会被压缩，原始条目总是可以原地读取
+			valid = record.flags == 0 ? record.stored_size == record.size : record.flags == FLAG_LZ4 && record.type == static_cast<Uint32>(EntryType::Image);
+		}
+		std::string_view entry_path = string_table.substr(record.path, record.path_length);
+		if (!valid || (!previous.empty() && entry_path <= previous)) {
+			spdlog::error("Asset archive '{}' has a corrupt entry '{}'.", archive_path, entry_path);
+			return false;
+		}
+		previous = entry_path;
+	}
+
+	file = std::move(mapped);
+	entries = records;
+	strings = string_table;
+	path = archive_path;
+	spdlog::debug("Mapped asset archive '{}': {} entries, {} bytes.", path, entries.size(), file_size);
+	return true;
+}
+
+void AssetArchive::close() {
+	entries = {};
+	strings = {};
+	path.clear();
+	file.reset();
+}
+
+size_t AssetArchive::getFileSize() const {
+	return file ? file->getSize() : 0;
+}
+
+const EntryRecord *AssetArchive::find(std::string_view entry_path) const {
+	auto it = std::lower_bound(entries.begin(), entries.end(), entry_path, [this](const EntryRecord &record, std::string_view value) {
+		return getEntryPath(record) < value;
+	});
+	if (it == entries.end() || getEntryPath(*it) != entry_path) {
+		return nullptr;
+	}
+	return &*it;
+}
+
+std::string_view AssetArchive::getEntryPath(const EntryRecord &entry) const {
+	return strings.substr(entry.path, entry.path_length);
+}
+
+std::span<const std::byte> AssetArchive::getStoredBytes(const EntryRecord &entry) const {
+	return { file->getData() + entry.offset, static_cast<size_t>(entry.stored_size) };
+}
+
+std::vector<std::string_view> AssetArchive::list(std::string_view prefix) const {
+	std::vector<std::string_view> result;
+	auto it = std::lower_bound(entries.begin(), entries.end(), prefix, [this](const EntryRecord &record, std::string_view value) {
+		return getEntryPath(record) < value;
+	});
+	for (; it != entries.end() && getEntryPath(*it).starts_with(prefix); ++it) {
+		result.push_back(getEntryPath(*it));
+	}
+	return result;
+}
+
+SDL_IOStream *AssetArchive::openIO(std::string_view entry_path) const {
+	const EntryRecord *entry = find(entry_path);
+	return entry ? openIO(*entry) : nullptr;
+}
+
+SDL_IOStream *AssetArchive::openIO(const EntryRecord &entry) const {
+	if (entry.flags & FLAG_LZ4) {
+		spdlog::error("Asset archive entry '{}' is compressed and cannot be streamed.", getEntryPath(entry));
+		return nullptr;
+	}
+	std::span<const std::byte> bytes = getStoredBytes(entry);
+	SDL_IOStream *io = SDL_IOFromConstMem(bytes.data(), bytes.size());
+	if (!io) {
+		spdlog::error("Failed to open '{}' from asset archive: {}", getEntryPath(entry), SDL_GetError());
+	}
+	return io;
+}
+
+bool AssetArchive::decodeImage(const EntryRecord &entry, std::byte *pixels, int pitch) const {
+	std::span<const std::byte> stored = getStoredBytes(entry);
+	const size_t row_bytes = static_cast<size_t>(entry.width) * BYTES_PER_PIXEL;
+	const bool packed = static_cast<size_t>(pitch) == row_bytes;
+
+	std::vector<std::byte> scratch;
+	const std::byte *source = stored.data();
+	if (entry.flags & FLAG_LZ4) {
+		// 紧密排列的目标直接解压，否则先解压到临时缓冲再逐行拷贝
+		std::byte *target = pixels;
+		if (!packed) {
+			scratch.resize(static_cast<size_t>(entry.size));
+			target = scratch.data();
+		}
+		int decoded = LZ4_decompress_safe(reinterpret_cast<const char *>(stored.data()), reinterpret_cast<char *>(target),
+				static_cast<int>(stored.size()), static_cast<int>(entry.size));
+		if (decoded != static_cast<int>(entry.size)) {
+			spdlog::error("Failed to decompress '{}' from asset archive.", getEntryPath(entry));
+			return false;
+		}
+		if (packed) {
+			return true;
+		}
+		source = scratch.data();
+	}
+
+	if (packed) {
+		std::memcpy(pixels, source, static_cast<size_t>(entry.size));
+	} else {
+		for (int y = 0; y < entry.height; ++y) {
+			std::memcpy(pixels + static_cast<size_t>(y) * pitch, source + y * row_bytes, row_bytes);
+		}
+	}
+	return true;
+}
+
+SDL_Surface *AssetArchive::loadSurface(std::string_view entry_path) const {
+	const EntryRecord *entry = find(entry_path);
+	if (!entry) {
+		return nullptr;
+	}
+	if (entry->type == static_cast<Uint32>(EntryType::Raw)) {
+		SDL_IOStream *io = openIO(*entry);
+		return io ? IMG_Load_IO(io, true) : nullptr;
+	}
+
+	SDL_Surface *surface = SDL_CreateSurface(entry->width, entry->height, SDL_PIXELFORMAT_RGBA32);
+	if (!surface) {
+		spdlog::error("Failed to create surface for '{}': {}", entry_path, SDL_GetError());
+		return nullptr;
+	}
+	if (!decodeImage(*entry, static_cast<std::byte *>(surface->pixels), surface->pitch)) {
+		SDL_DestroySurface(surface);
+		return nullptr;
+	}
+	return surface;
+}
+
+SDL_Texture *AssetArchive::loadTexture(SDL_Renderer *renderer, std::string_view entry_path) const {
+	const EntryRecord *entry = find(entry_path);
+	if (!entry) {
+		return nullptr;
+	}
+	if (entry->type == static_cast<Uint32>(EntryType::Raw)) {
+		SDL_IOStream *io = openIO(*entry);
+		return io ? IMG_LoadTexture_IO(renderer, io, true) : nullptr;
+	}
+
+	SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, entry->width, entry->height);
+	if (!texture) {
+		spdlog::error("Failed to create texture for '{}': {}", entry_path, SDL_GetError());
+		return nullptr;
+	}
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+	const int pitch = entry->width * static_cast<int>(BYTES_PER_PIXEL);
+	bool uploaded = false;
+	if (entry->flags & FLAG_LZ4) {
+		std::vector<std::byte> pixels(static_cast<size_t>(entry->size));
+		uploaded = decodeImage(*entry, pixels.data(), pitch) && SDL_UpdateTexture(texture, nullptr, pixels.data(), pitch);
+	} else {
+		// 未压缩的像素直接从映射内存上传
+		uploaded = SDL_UpdateTexture(texture, nullptr, getStoredBytes(*entry).data(), pitch);
+	}
+	if (!uploaded) {
+		spdlog::error("Failed to upload '{}' from asset archive: {}", entry_path, SDL_GetError());
+		SDL_DestroyTexture(texture);
+		return nullptr;
+	}
+	return texture;
+}
+
+// --- AssetArchiveWriter ---
+
+void AssetArchiveWriter::addFile(std::string entry_path, std::vector<std::byte> data) {
+	pending.push_back({ std::move(entry_path), EntryType::Raw, 0, 0, std::move(data) });
+}
+
+bool AssetArchiveWriter::addImage(std::string entry_path, SDL_Surface *surface) {
+	SDL_Surface *converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+	if (!converted) {
+		spdlog::error("Failed to convert '{}' to RGBA32: {}", entry_path, SDL_GetError());
+		return false;
+	}
+	const size_t row_bytes = static_cast<size_t>(converted->w) * BYTES_PER_PIXEL;
+	std::vector<std::byte> pixels(row_bytes * converted->h);
+	for (int y = 0; y < converted->h; ++y) {
+		std::memcpy(pixels.data() + y * row_bytes, static_cast<const std::byte *>(converted->pixels) + static_cast<size_t>(y) * converted->pitch, row_bytes);
+	}
+	pending.push_back({ std::move(entry_path), EntryType::Image, converted->w, converted->h, std::move(pixels) });
+	SDL_DestroySurface(converted);
+	return true;
+}
+
+bool AssetArchiveWriter::write(const std::string &output_path) {
+	std::sort(pending.begin(), pending.end(), [](const PendingEntry &a, const PendingEntry &b) { return a.path < b.path; });
+	auto duplicate = std::adjacent_find(pending.begin(), pending.end(), [](const PendingEntry &a, const PendingEntry &b) { return a.path == b.path; });
+	if (duplicate != pending.end()) {
+		spdlog::error("Asset archive entry '{}' was added twice.", duplicate->path);
+		return false;
+	}
+
+	std::ofstream out(output_path, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		spdlog::error("Failed to open '{}' for writing.", output_path);
+		return false;
+	}
+
+	Uint64 position = sizeof(Header);
+	auto pad = [&](Uint64 alignment) {
+		static constexpr char zeros[BLOB_ALIGNMENT] = {};
+		Uint64 padding = (alignment - position % alignment) % alignment;
+		out.write(zeros, static_cast<std::streamsize>(padding));
+		position += padding;
+	};
+	out.write(std::string(sizeof(Header), '\0').data(), sizeof(Header));
+
+	// 1. 数据块
+	std::vector<EntryRecord> records;
+	std::string string_table;
+	records.reserve(pending.size());
+	std::vector<char> compressed;
+	Uint64 raw_total = 0;
+	for (const PendingEntry &entry : pending) {
+		if (entry.data.size() > static_cast<size_t>(std::numeric_limits<int>::max()) || string_table.size() > std::numeric_limits<Uint32>::max()) {
+			spdlog::error("Asset archive entry '{}' is too large.", entry.path);
+			return false;
+		}
+		pad(BLOB_ALIGNMENT);
+		EntryRecord record{};
+		record.path = static_cast<Uint32>(string_table.size());
+		record.path_length = static_cast<Uint32>(entry.path.size());
+		record.type = static_cast<Uint32>(entry.type);
+		record.offset = position;
+		record.size = entry.data.size();
+		record.width = entry.width;
+		record.height = entry.height;
+		string_table += entry.path;
+
+		const char *data = reinterpret_cast<const char *>(entry.data.data());
+		size_t stored_size = entry.data.size();
+		if (compress_images && entry.type == EntryType::Image) {
+			const int source_size = static_cast<int>(entry.data.size());
+			compressed.resize(static_cast<size_t>(LZ4_compressBound(source_size)));
+			int compressed_size = LZ4_compress_HC(data, compressed.data(), source_size, static_cast<int>(compressed.size()), LZ4HC_CLEVEL_MAX);
+			// 收益太小时保留原始像素，这样运行时可以直接从映射内存上传
+			if (compressed_size > 0 && static_cast<size_t>(compressed_size) < entry.data.size() - entry.data.size() / 8) {
+				record.flags |= FLAG_LZ4;
+				data = compressed.data();
+				stored_size = static_cast<size_t>(compressed_size);
+			}
+		}
+		record.stored_size = stored_size;
+		out.write(data, static_cast<std::streamsize>(stored_size));
+		position += stored_size;
+		raw_total += entry.data.size();
+		records.push_back(record);
+	}
+
+	// 2. 索引与字符串表
+	pad(alignof(EntryRecord));
+	Header header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.entry_count = static_cast<Uint32>(records.size());
+	header.index_offset = position;
+	out.write(reinterpret_cast<const char *>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(EntryRecord)));
+	position += records.size() * sizeof(EntryRecord);
+	header.strings_offset = position;
+	header.strings_size = static_cast<Uint32>(string_table.size());
+	out.write(string_table.data(), static_cast<std::streamsize>(string_table.size()));
+	position += string_table.size();
+	header.file_size = position;
+
+	out.seekp(0);
+	out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+	if (!out) {
+		spdlog::error("Failed to write asset archive '{}'.", output_path);
+		return false;
+	}
+	spdlog::debug("Asset archive written to '{}': {} entries, {} bytes ({} bytes before compression).", output_path, records.size(), position, raw_total);
+	return true;
+}
+
+} // namespace engine::resource
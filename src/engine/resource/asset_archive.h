@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+struct SDL_IOStream;
+struct SDL_Renderer;
+struct SDL_Surface;
+struct SDL_Texture;
+
+namespace engine::utils {
+class MappedFile;
+}
+
+namespace engine::resource {
+
+/**
+ * @brief 资源包格式（.pak）
+ *
+ * 小端序，由离线工具 asset_packer 从 assets/ 目录生成。图片在打包时已解码为紧密排列的 RGBA32 像素，
+ * 可选 LZ4 压缩；字体、地图等其它文件按原样存储。
+ *
+ * 文件布局：Header，随后是 16 字节对齐的数据块，最后是按路径字典序排列的 EntryRecord 索引与字符串表。
+ * 运行时整个文件映射到内存，按路径二分查找，未压缩的数据直接原地读取。
+ */
+namespace pak {
+
+constexpr char MAGIC[4] = { 'S', 'P', 'A', 'K' };
+constexpr Uint32 VERSION = 1;
+constexpr Uint64 BLOB_ALIGNMENT = 16;
+
+enum class EntryType : Uint32 {
+	Raw = 0, ///< @brief 原始文件字节
+	Image = 1, ///< @brief 预解码的 RGBA32 像素，pitch = width * 4
+};
+
+constexpr Uint32 FLAG_LZ4 = 1u << 0; ///< @brief 数据块经过 LZ4 压缩
+
+struct Header {
+	char magic[4];
+	Uint32 version;
+	Uint64 file_size;
+	Uint64 index_offset; ///< @brief EntryRecord 数组
+	Uint64 strings_offset; ///< @brief 路径字符串拼接（不含 '\0'）
+	Uint32 entry_count;
+	Uint32 strings_size;
+};
+
+struct EntryRecord {
+	Uint32 path; ///< @brief 在字符串表中的偏移
+	Uint32 path_length;
+	Uint32 type; ///< @brief EntryType
+	Uint32 flags;
+	Uint64 offset; ///< @brief 数据块相对文件开头的偏移
+	Uint64 stored_size; ///< @brief 数据块在包内的大小（压缩后）
+	Uint64 size; ///< @brief 解压后的大小
+	Sint32 width; ///< @brief 仅图片有效
+	Sint32 height;
+};
+
+} // namespace pak
+
+/**
+ * @brief 只读资源包，通过内存映射按路径提供资源
+ *
+ * 路径与 ResourceManager 使用的一致（如 "assets/textures/UI/heart.png"）。包内找不到的路径由调用方回退到散文件，
+ * 开发时不生成资源包即可直接读取 assets/ 目录。open() 之后所有成员函数都是只读的，可以在解码线程中并发调用。
+ */
+class AssetArchive final {
+private:
+	std::shared_ptr<engine::utils::MappedFile> file;
+	std::span<const pak::EntryRecord> entries;
+	std::string_view strings;
+	std::string path;
+
+public:
+	AssetArchive();
+	~AssetArchive();
+
+	/// @brief 映射并校验资源包，失败返回 false（不抛异常）
+	[[nodiscard]] bool open(const std::string &archive_path);
+	void close();
+
+	[[nodiscard]] bool isOpen() const { return file != nullptr; }
+	[[nodiscard]] const std::string &getPath() const { return path; }
+	[[nodiscard]] size_t getEntryCount() const { return entries.size(); }
+	[[nodiscard]] size_t getFileSize() const;
+
+	/// @brief 二分查找条目，不存在返回 nullptr（不记录日志，便于调用方静默回退）
+	const pak::EntryRecord *find(std::string_view entry_path) const;
+	std::string_view getEntryPath(const pak::EntryRecord &entry) const;
+	/// @brief 条目在映射内存中的原始数据（可能是压缩后的）
+	std::span<const std::byte> getStoredBytes(const pak::EntryRecord &entry) const;
+	/// @brief 列出以 prefix 开头的所有条目路径（字典序），视图指向映射内存
+	std::vector<std::string_view> list(std::string_view prefix) const;
+
+	/// @brief 以只读内存流打开未压缩的条目，由调用方负责关闭；条目不存在或已压缩时返回 nullptr
+	SDL_IOStream *openIO(std::string_view entry_path) const;
+	SDL_IOStream *openIO(const pak::EntryRecord &entry) const;
+
+	/// @brief 创建条目的 RGBA32 表面（图片条目直接拷贝或解压像素，原始条目经 SDL_image 解码），调用方负责销毁
+	SDL_Surface *loadSurface(std::string_view entry_path) const;
+	/// @brief 创建纹理；未压缩的图片直接从映射内存上传，不经过中间表面
+	SDL_Texture *loadTexture(SDL_Renderer *renderer, std::string_view entry_path) const;
+
+	/// @brief 共享映射，供需要原地引用包内数据的对象（如二进制关卡）保持映射存活
+	const std::shared_ptr<engine::utils::MappedFile> &getBackingFile() const { return file; }
+
+	AssetArchive(const AssetArchive &) = delete;
+	AssetArchive &operator=(const AssetArchive &) = delete;
+	AssetArchive(AssetArchive &&) = delete;
+	AssetArchive &operator=(AssetArchive &&) = delete;
+
+private:
+	bool decodeImage(const pak::EntryRecord &entry, std::byte *pixels, int pitch) const; ///< @brief 把图片像素写入目标缓冲
+};
+
+/**
+ * @brief 生成资源包（离线工具使用）
+ */
+class AssetArchiveWriter final {
+private:
+	struct PendingEntry {
+		std::string path;
+		pak::EntryType type = pak::EntryType::Raw;
+		Sint32 width = 0;
+		Sint32 height = 0;
+		std::vector<std::byte> data;
+	};
+
+	std::vector<PendingEntry> pending;
+	bool compress_images = true;
+
+public:
+	explicit AssetArchiveWriter(bool compress_images = true) :
+			compress_images(compress_images) {}
+
+	void addFile(std::string entry_path, std::vector<std::byte> data); ///< @brief 原样存储
+	bool addImage(std::string entry_path, SDL_Surface *surface); ///< @brief 转换为 RGBA32 后存储像素，失败返回 false
+	size_t getEntryCount() const { return pending.size(); }
+
+	/// @brief 排序并写出资源包，成功返回 true
+	bool write(const std::string &output_path);
+};
+
+} // namespace engine::resource
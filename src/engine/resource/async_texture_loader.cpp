@@ -0,0 +1,112 @@
+#include "async_texture_loader.h"
+
+#include <SDL3/SDL_timer.h>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+
+#include "../debug/profiler.h"
+#include "asset_archive.h"
+
+namespace engine::resource {
+
+AsyncTextureLoader::AsyncTextureLoader(int worker_count, const AssetArchive *archive) :
+		archive(archive) {
+	if (worker_count < 1) {
+		worker_count = 1;
+	}
+	workers.reserve(worker_count);
+	for (int i = 0; i < worker_count; ++i) {
+		workers.emplace_back(&AsyncTextureLoader::workerLoop, this);
+	}
+	spdlog::trace("AsyncTextureLoader started with {} worker(s).", worker_count);
+}
+
+AsyncTextureLoader::~AsyncTextureLoader() {
+	{
+		std::lock_guard lock(request_mutex);
+		stopping = true;
+		requests.clear();
+	}
+	request_cv.notify_all();
+	for (auto &worker : workers) {
+		worker.join();
+	}
+
+	// 释放尚未被取走的解码结果
+	std::lock_guard lock(completed_mutex);
+	for (auto &image : completed) {
+		if (image.surface) {
+			SDL_DestroySurface(image.surface);
+		}
+	}
+	completed.clear();
+	spdlog::trace("AsyncTextureLoader stopped.");
+}
+
+void AsyncTextureLoader::enqueue(Uint32 slot_index, Uint32 slot_generation, std::string path) {
+	{
+		std::lock_guard lock(request_mutex);
+		requests.push_back({ slot_index, slot_generation, std::move(path) });
+	}
+	request_cv.notify_one();
+}
+
+bool AsyncTextureLoader::popCompleted(DecodedImage &out) {
+	std::lock_guard lock(completed_mutex);
+	if (completed.empty()) {
+		return false;
+	}
+	out = std::move(completed.front());
+	completed.pop_front();
+	return true;
+}
+
+size_t AsyncTextureLoader::getQueueDepth() {
+	std::lock_guard lock(request_mutex);
+	return requests.size();
+}
+
+size_t AsyncTextureLoader::getReadyCount() {
+	std::lock_guard lock(completed_mutex);
+	return completed.size();
+}
+
+void AsyncTextureLoader::workerLoop() {
+	PROFILE_THREAD_NAME("Texture decode");
+	while (true) {
+		Request request;
+		{
+			std::unique_lock lock(request_mutex);
+			request_cv.wait(lock, [this] { return stopping || !requests.empty(); });
+			if (stopping) {
+				return;
+			}
+			request = std::move(requests.front());
+			requests.pop_front();
+		}
+
+		// 磁盘读取与 PNG 解码（或资源包中的像素解压）都在这里完成，不占用主线程
+		Uint64 start = SDL_GetTicksNS();
+		SDL_Surface *surface = nullptr;
+		{
+			PROFILE_SCOPE("AsyncTextureLoader::decode");
+			if (archive) {
+				surface = archive->loadSurface(request.path);
+			}
+			if (!surface) {
+				surface = IMG_Load(request.path.c_str());
+			}
+		}
+		Uint64 elapsed = SDL_GetTicksNS() - start;
+		if (!surface) {
+			spdlog::error("Async decode failed for '{}': {}", request.path, SDL_GetError());
+		}
+		total_decode_ns.fetch_add(elapsed, std::memory_order_relaxed);
+		decoded_count.fetch_add(1, std::memory_order_relaxed);
+
+		std::lock_guard lock(completed_mutex);
+		completed.push_back({ request.slot_index, request.slot_generation, std::move(request.path), surface });
+	}
+}
+
+} // namespace engine::resource
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL3/SDL_surface.h>
+
+namespace engine::resource {
+
+class AssetArchive;
+
+/**
+ * @brief 异步纹理加载统计
+ */
+struct AsyncLoadStats {
+	size_t queue_depth = 0; ///< @brief 等待解码的请求数
+	size_t ready_count = 0; ///< @brief 已解码、等待主线程上传的数量
+	Uint64 decoded_count = 0; ///< @brief 累计解码完成数
+	Uint64 uploaded_count = 0; ///< @brief 累计上传完成数
+	double total_decode_ms = 0.0; ///< @brief 累计解码耗时（各工作线程之和）
+	double total_upload_ms = 0.0; ///< @brief 累计上传耗时
+	double last_frame_upload_ms = 0.0; ///< @brief 最近一帧的上传耗时
+};
+
+/**
+ * @brief 单个纹理的加载耗时，用于启动报告
+ */
+struct TextureLoadTiming {
+	std::string path;
+	double decode_ms = 0.0; ///< @brief 工作线程上的读取与解码耗时
+	double upload_ms = 0.0; ///< @brief 主线程上创建纹理的耗时
+	size_t bytes = 0; ///< @brief 上传后的显存占用，失败为 0
+};
+
+/**
+ * @brief 在工作线程池中把图片解码为 SDL_Surface，通过完成队列交还主线程
+ *
+ * 仅负责 CPU 端解码；创建 SDL_Texture 必须在渲染线程完成，由 TextureManager 按时间预算上传。
+ */
+class AsyncTextureLoader final {
+public:
+	/// @brief 解码结果，surface 为 nullptr 表示解码失败。所有权随结果转移给取走它的一方
+	struct DecodedImage {
+		Uint32 slot_index = 0;
+		Uint32 slot_generation = 0;
+		std::string path;
+		SDL_Surface *surface = nullptr;
+	};
+
+private:
+	struct Request {
+		Uint32 slot_index;
+		Uint32 slot_generation;
+		std::string path;
+	};
+
+	const AssetArchive *archive = nullptr; ///< @brief 非拥有，包内的图片直接解压为表面，其它路径从磁盘解码
+	std::vector<std::thread> workers;
+	std::deque<Request> requests; ///< @brief 待解码请求，受 request_mutex 保护
+	std::deque<DecodedImage> completed; ///< @brief 已解码结果，受 completed_mutex 保护
+	std::mutex request_mutex;
+	std::mutex completed_mutex;
+	std::condition_variable request_cv;
+	bool stopping = false;
+
+	std::atomic<Uint64> decoded_count = 0;
+	std::atomic<Uint64> total_decode_ns = 0;
+
+public:
+	AsyncTextureLoader(int worker_count, const AssetArchive *archive = nullptr);
+	~AsyncTextureLoader();
+
+	void enqueue(Uint32 slot_index, Uint32 slot_generation, std::string path); ///< @brief 提交一个解码请求（线程安全）
+	bool popCompleted(DecodedImage &out); ///< @brief 取出一个解码结果，队列为空返回 false（线程安全）
+
+	size_t getQueueDepth();
+	size_t getReadyCount();
+	Uint64 getDecodedCount() const { return decoded_count.load(std::memory_order_relaxed); }
+	double getTotalDecodeMs() const { return static_cast<double>(total_decode_ns.load(std::memory_order_relaxed)) / 1000000.0; }
+
+	AsyncTextureLoader(const AsyncTextureLoader &) = delete;
+	AsyncTextureLoader &operator=(const AsyncTextureLoader &) = delete;
+	AsyncTextureLoader(AsyncTextureLoader &&) = delete;
+	AsyncTextureLoader &operator=(AsyncTextureLoader &&) = delete;
+
+private:
+	void workerLoop();
+};
+
+} // namespace engine::resource
@@ -0,0 +1,213 @@
+#include "audio_decoder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+#include <SDL3/SDL_stdinc.h>
+#include <spdlog/spdlog.h>
+#include <vorbis/vorbisfile.h>
+
+#define DR_MP3_IMPLEMENTATION
+#include <dr_mp3.h>
+
+#include "../debug/profiler.h"
+
+namespace engine::resource {
+
+namespace {
+
+/// @brief WAV：SDL 一次性读入并转换为 F32，之后从内存中读取
+class WavDecoder final : public AudioDecoder {
+private:
+	std::vector<float> samples;
+	Uint64 position = 0;
+
+public:
+	bool open(const std::string &file_path) {
+		SDL_AudioSpec source_spec;
+		Uint8 *data = nullptr;
+		Uint32 length = 0;
+		if (!SDL_LoadWAV(file_path.c_str(), &source_spec, &data, &length)) {
+			spdlog::error("Failed to load WAV '{}': {}", file_path, SDL_GetError());
+			return false;
+		}
+		spec = { SDL_AUDIO_F32, source_spec.channels, source_spec.freq };
+		Uint8 *converted = nullptr;
+		int converted_length = 0;
+		bool ok = SDL_ConvertAudioSamples(&source_spec, data, static_cast<int>(length), &spec, &converted, &converted_length);
+		SDL_free(data);
+		if (!ok) {
+			spdlog::error("Failed to convert WAV '{}': {}", file_path, SDL_GetError());
+			return false;
+		}
+		samples.resize(static_cast<size_t>(converted_length) / sizeof(float));
+		std::memcpy(samples.data(), converted, samples.size() * sizeof(float));
+		SDL_free(converted);
+		total_frames = samples.size() / static_cast<size_t>(spec.channels);
+		return true;
+	}
+
+	size_t read(float *out, size_t frames) override {
+		size_t count = static_cast<size_t>(std::min<Uint64>(frames, total_frames - position));
+		std::memcpy(out, samples.data() + position * spec.channels, count * spec.channels * sizeof(float));
+		position += count;
+		return count;
+	}
+
+	bool seek(Uint64 frame) override {
+		position = std::min(frame, total_frames);
+		return true;
+	}
+};
+
+class Mp3Decoder final : public AudioDecoder {
+private:
+	drmp3 mp3{};
+	bool initialized = false;
+
+public:
+	~Mp3Decoder() override {
+		if (initialized) {
+			drmp3_uninit(&mp3);
+		}
+	}
+
+	bool open(const std::string &file_path) {
+		if (!drmp3_init_file(&mp3, file_path.c_str(), nullptr)) {
+			spdlog::error("Failed to open MP3 '{}'.", file_path);
+			return false;
+		}
+		initialized = true;
+		spec = { SDL_AUDIO_F32, static_cast<int>(mp3.channels), static_cast<int>(mp3.sampleRate) };
+		total_frames = drmp3_get_pcm_frame_count(&mp3);
+		drmp3_seek_to_pcm_frame(&mp3, 0); // 计算帧数会把解码位置移到结尾
+		return true;
+	}
+
+	size_t read(float *out, size_t frames) override {
+		return static_cast<size_t>(drmp3_read_pcm_frames_f32(&mp3, frames, out));
+	}
+
+	bool seek(Uint64 frame) override {
+		return drmp3_seek_to_pcm_frame(&mp3, frame);
+	}
+};
+
+class VorbisDecoder final : public AudioDecoder {
+private:
+	OggVorbis_File file{};
+	bool initialized = false;
+
+public:
+	~VorbisDecoder() override {
+		if (initialized) {
+			ov_clear(&file);
+		}
+	}
+
+	bool open(const std::string &file_path) {
+		if (ov_fopen(file_path.c_str(), &file) != 0) {
+			spdlog::error("Failed to open OGG '{}'.", file_path);
+			return false;
+		}
+		initialized = true;
+		const vorbis_info *info = ov_info(&file, -1);
+		spec = { SDL_AUDIO_F32, info->channels, static_cast<int>(info->rate) };
+		ogg_int64_t total = ov_pcm_total(&file, -1);
+		total_frames = total > 0 ? static_cast<Uint64>(total) : 0;
+		return true;
+	}
+
+	size_t read(float *out, size_t frames) override {
+		// vorbisfile 输出按声道分开的平面数据，这里交错写入
+		size_t done = 0;
+		while (done < frames) {
+			float **planes = nullptr;
+			int bitstream = 0;
+			long count = ov_read_float(&file, &planes, static_cast<int>(std::min<size_t>(frames - done, 4096)), &bitstream);
+			if (count <= 0) {
+				break; // 结尾或错误（OV_HOLE 等可恢复错误也在这里结束本次读取）
+			}
+			for (long i = 0; i < count; ++i) {
+				for (int c = 0; c < spec.channels; ++c) {
+					out[(done + static_cast<size_t>(i)) * spec.channels + c] = planes[c][i];
+				}
+			}
+			done += static_cast<size_t>(count);
+		}
+		return done;
+	}
+
+	bool seek(Uint64 frame) override {
+		return ov_pcm_seek(&file, static_cast<ogg_int64_t>(frame)) == 0;
+	}
+};
+
+template <typename Decoder>
+std::unique_ptr<AudioDecoder> openAs(const std::string &file_path) {
+	auto decoder = std::make_unique<Decoder>();
+	if (!decoder->open(file_path) || decoder->getSpec().channels <= 0 || decoder->getSpec().freq <= 0) {
+		return nullptr;
+	}
+	return decoder;
+}
+
+} // namespace
+
+std::unique_ptr<AudioDecoder> AudioDecoder::open(const std::string &file_path) {
+	std::string extension = std::filesystem::path(file_path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	if (extension == ".wav") {
+		return openAs<WavDecoder>(file_path);
+	}
+	if (extension == ".mp3") {
+		return openAs<Mp3Decoder>(file_path);
+	}
+	if (extension == ".ogg") {
+		return openAs<VorbisDecoder>(file_path);
+	}
+	spdlog::error("Unsupported audio format '{}' for '{}'.", extension, file_path);
+	return nullptr;
+}
+
+bool decodeAudioFile(const std::string &file_path, const SDL_AudioSpec &target, std::vector<float> &samples) {
+	PROFILE_SCOPE("decodeAudioFile");
+	auto decoder = AudioDecoder::open(file_path);
+	if (!decoder) {
+		return false;
+	}
+
+	const SDL_AudioSpec &source = decoder->getSpec();
+	std::vector<float> decoded;
+	if (decoder->getTotalFrames() > 0) {
+		decoded.reserve(static_cast<size_t>(decoder->getTotalFrames()) * source.channels);
+	}
+	constexpr size_t BLOCK_FRAMES = 4096;
+	std::vector<float> block(BLOCK_FRAMES * source.channels);
+	while (size_t frames = decoder->read(block.data(), BLOCK_FRAMES)) {
+		decoded.insert(decoded.end(), block.begin(), block.begin() + static_cast<std::ptrdiff_t>(frames * source.channels));
+	}
+	if (decoded.empty()) {
+		spdlog::error("Audio file '{}' contains no samples.", file_path);
+		return false;
+	}
+
+	if (source.channels == target.channels && source.freq == target.freq) {
+		samples = std::move(decoded);
+		return true;
+	}
+	Uint8 *converted = nullptr;
+	int converted_length = 0;
+	if (!SDL_ConvertAudioSamples(&source, reinterpret_cast<const Uint8 *>(decoded.data()), static_cast<int>(decoded.size() * sizeof(float)), &target, &converted, &converted_length)) {
+		spdlog::error("Failed to convert audio '{}': {}", file_path, SDL_GetError());
+		return false;
+	}
+	samples.resize(static_cast<size_t>(converted_length) / sizeof(float));
+	std::memcpy(samples.data(), converted, samples.size() * sizeof(float));
+	SDL_free(converted);
+	return true;
+}
+
+} // namespace engine::resource
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_audio.h>
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::resource {
+
+/**
+ * @brief 音频文件解码器：按需逐块输出交错的 F32 PCM（文件原始的采样率与声道数）
+ *
+ * 支持 WAV（SDL）、MP3（dr_mp3）与 OGG Vorbis（libvorbisfile），按扩展名选择实现。
+ * 既用于一次性解码短音效，也用于流式播放音乐。
+ */
+class AudioDecoder {
+protected:
+	SDL_AudioSpec spec = { SDL_AUDIO_F32, 0, 0 };
+	Uint64 total_frames = 0; ///< @brief 0 表示未知
+
+public:
+	virtual ~AudioDecoder() = default;
+
+	/// @brief 打开文件，格式不支持或文件损坏时返回 nullptr
+	static std::unique_ptr<AudioDecoder> open(const std::string &file_path);
+
+	/// @brief 读取最多 frames 帧到 out（容量至少 frames * 声道数），返回实际帧数，0 表示已到结尾
+	virtual size_t read(float *out, size_t frames) = 0;
+
+	/// @brief 跳转到指定帧
+	virtual bool seek(Uint64 frame) = 0;
+
+	const SDL_AudioSpec &getSpec() const { return spec; }
+	Uint64 getTotalFrames() const { return total_frames; }
+
+	AudioDecoder(const AudioDecoder &) = delete;
+	AudioDecoder &operator=(const AudioDecoder &) = delete;
+	AudioDecoder(AudioDecoder &&) = delete;
+	AudioDecoder &operator=(AudioDecoder &&) = delete;
+
+protected:
+	AudioDecoder() = default;
+};
+
+/**
+ * @brief 完整解码一个音频文件并转换为目标格式（用于音效缓存）
+ *
+ * @param target 目标格式，format 必须为 SDL_AUDIO_F32。
+ * @param samples 输出的交错样本。
+ * @return 成功返回 true。
+ */
+[[nodiscard]] bool decodeAudioFile(const std::string &file_path, const SDL_AudioSpec &target, std::vector<float> &samples);
+
+} // namespace engine::resource
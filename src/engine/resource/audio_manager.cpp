@@ -0,0 +1,508 @@
+#include "audio_manager.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <SDL3/SDL_timer.h>
+#include <spdlog/spdlog.h>
+
+#include "../debug/profiler.h"
+#include "audio_decoder.h"
+
+namespace engine::resource {
+
+namespace {
+
+constexpr SDL_AudioSpec MIX_SPEC = { SDL_AUDIO_F32, AudioManager::MIX_CHANNELS, AudioManager::MIX_FREQUENCY };
+constexpr int BYTES_PER_FRAME = static_cast<int>(sizeof(float)) * AudioManager::MIX_CHANNELS;
+constexpr auto MUSIC_POLL_INTERVAL = std::chrono::milliseconds(40); ///< @brief 远小于 MusicStream 的缓冲时长，解码线程按此间隔补充缓冲
+
+Uint64 secondsToFrames(double seconds) {
+	return static_cast<Uint64>(std::max(0.0, seconds) * AudioManager::MIX_FREQUENCY);
+}
+
+} // namespace
+
+AudioManager::AudioManager() {
+	stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &MIX_SPEC, &AudioManager::audioCallback, this);
+	if (!stream) {
+		spdlog::warn("AudioManager: failed to open audio device ({}), running silent.", SDL_GetError());
+		return;
+	}
+	SDL_AudioSpec device_spec;
+	if (!SDL_GetAudioDeviceFormat(SDL_GetAudioStreamDevice(stream), &device_spec, &device_buffer_frames)) {
+		device_buffer_frames = 0;
+	}
+	music_thread = std::thread(&AudioManager::musicThreadLoop, this);
+	SDL_ResumeAudioStreamDevice(stream);
+	spdlog::trace("AudioManager opened audio device, device buffer {} frames.", device_buffer_frames);
+}
+
+AudioManager::~AudioManager() {
+	// 先关闭设备，确保回调不再运行，之后才能释放缓冲区
+	if (stream) {
+		SDL_DestroyAudioStream(stream);
+		stream = nullptr;
+	}
+	if (music_thread.joinable()) {
+		{
+			std::lock_guard lock(music_mutex);
+			music_stopping = true;
+		}
+		music_cv.notify_one();
+		music_thread.join();
+	}
+}
+
+const SoundBuffer *AudioManager::loadSound(std::string_view file_path) {
+	if (const SoundBuffer *existing = getSound(file_path)) {
+		return existing;
+	}
+	PROFILE_SCOPE("AudioManager::loadSound");
+	auto sound = std::make_unique<SoundBuffer>();
+	sound->path = std::string(file_path);
+	if (!decodeAudioFile(sound->path, MIX_SPEC, sound->samples)) {
+		return nullptr;
+	}
+	if (sound->samples.size() < MIX_CHANNELS) {
+		spdlog::warn("Sound '{}' contains no samples.", sound->path); // 空缓冲区循环播放会让混音陷入死循环
+		return nullptr;
+	}
+	sound->frame_count = static_cast<Uint32>(sound->samples.size() / MIX_CHANNELS);
+	spdlog::debug("Loaded sound '{}': {} frames ({:.2f}s).", sound->path, sound->frame_count, static_cast<double>(sound->frame_count) / MIX_FREQUENCY);
+	const SoundBuffer *result = sound.get();
+	sounds.emplace(sound->path, std::move(sound));
+	return result;
+}
+
+const SoundBuffer *AudioManager::getSound(std::string_view file_path) {
+	auto it = sounds.find(std::string(file_path));
+	return it != sounds.end() ? it->second.get() : nullptr;
+}
+
+void AudioManager::unloadSound(std::string_view file_path) {
+	auto it = sounds.find(std::string(file_path));
+	if (it == sounds.end()) {
+		spdlog::warn("Attempted to unload sound '{}' which is not loaded.", file_path);
+		return;
+	}
+	releaseSound(std::move(it->second));
+	sounds.erase(it);
+}
+
+void AudioManager::clearSounds() {
+	for (auto &[path, sound] : sounds) {
+		releaseSound(std::move(sound));
+	}
+	sounds.clear();
+}
+
+void AudioManager::releaseSound(std::unique_ptr<SoundBuffer> sound) {
+	if (!stream) {
+		return; // 静音模式没有音频线程引用缓冲区
+	}
+	PendingRelease pending{ std::move(sound), 0 };
+	Command command;
+	command.type = CommandType::ReleaseSound;
+	command.sound = pending.sound.get();
+	command.value = next_release_sequence;
+	if (sendCommand(command)) {
+		pending.sequence = next_release_sequence++;
+	}
+	pending_releases.push_back(std::move(pending));
+}
+
+VoiceHandle AudioManager::playSound(std::string_view file_path, const SoundParams &params) {
+	const SoundBuffer *sound = loadSound(file_path);
+	if (!sound || !stream) {
+		return {};
+	}
+	Command command;
+	command.type = CommandType::Play;
+	command.sound = sound;
+	command.voice_id = next_voice_id;
+	command.volume = params.volume;
+	command.pan = std::clamp(params.pan, -1.0f, 1.0f);
+	command.priority = params.priority;
+	command.loop = params.loop;
+	command.value = SDL_GetTicksNS();
+	if (!sendCommand(command)) {
+		return {};
+	}
+	next_voice_id = next_voice_id == 0xFFFFFFFFu ? 1 : next_voice_id + 1;
+	return { command.voice_id };
+}
+
+void AudioManager::stopVoice(VoiceHandle voice) {
+	if (voice.isValid()) {
+		sendCommand({ .type = CommandType::Stop, .voice_id = voice.id });
+	}
+}
+
+void AudioManager::stopAllSounds() {
+	sendCommand({ .type = CommandType::StopAll });
+}
+
+void AudioManager::setVoiceVolume(VoiceHandle voice, float volume) {
+	if (voice.isValid()) {
+		sendCommand({ .type = CommandType::SetVoiceVolume, .voice_id = voice.id, .volume = volume });
+	}
+}
+
+void AudioManager::setSoundVolume(float volume) {
+	sendCommand({ .type = CommandType::SetSoundVolume, .volume = std::max(0.0f, volume) });
+}
+
+void AudioManager::setVoiceLimit(int limit) {
+	sendCommand({ .type = CommandType::SetVoiceLimit, .value = static_cast<Uint64>(std::clamp(limit, 1, MAX_VOICES)) });
+}
+
+bool AudioManager::playMusic(std::string_view file_path, const MusicParams &params) {
+	if (!stream) {
+		return false;
+	}
+	// 解码器在解码线程里打开，这里不做文件 I/O
+	auto music = std::make_unique<MusicStream>(std::string(file_path), params, MIX_SPEC);
+	if (!sendCommand({ .type = CommandType::PlayMusic, .value = secondsToFrames(params.fade_seconds), .music = music.get() })) {
+		return false;
+	}
+	{
+		std::lock_guard lock(music_mutex);
+		music_streams.push_back(std::move(music));
+		music_wakeup = true;
+	}
+	music_cv.notify_one();
+	return true;
+}
+
+void AudioManager::stopMusic(double fade_seconds) {
+	sendCommand({ .type = CommandType::StopMusic, .value = secondsToFrames(fade_seconds) });
+}
+
+void AudioManager::setMusicVolume(float volume) {
+	sendCommand({ .type = CommandType::SetMusicVolume, .volume = std::max(0.0f, volume) });
+}
+
+bool AudioManager::sendCommand(const Command &command) {
+	if (!stream) {
+		return false;
+	}
+	if (!commands.push(command)) {
+		++commands_dropped;
+		return false;
+	}
+	return true;
+}
+
+void AudioManager::update() {
+	if (pending_releases.empty()) {
+		return;
+	}
+	// 重试之前没能入队的释放命令，再释放音频线程已经确认的缓冲区
+	for (PendingRelease &pending : pending_releases) {
+		if (pending.sequence == 0) {
+			Command command;
+			command.type = CommandType::ReleaseSound;
+			command.sound = pending.sound.get();
+			command.value = next_release_sequence;
+			if (sendCommand(command)) {
+				pending.sequence = next_release_sequence++;
+			}
+		}
+	}
+	Uint64 processed = processed_release_sequence.load(std::memory_order_acquire);
+	std::erase_if(pending_releases, [processed](const PendingRelease &pending) { return pending.sequence != 0 && pending.sequence <= processed; });
+}
+
+AudioStats AudioManager::getStats() const {
+	AudioStats stats;
+	stats.active_voices = active_voices.load(std::memory_order_relaxed);
+	stats.device_buffer_frames = device_buffer_frames;
+	stats.voices_started = voices_started.load(std::memory_order_relaxed);
+	stats.voices_stolen = voices_stolen.load(std::memory_order_relaxed);
+	stats.voices_dropped = voices_dropped.load(std::memory_order_relaxed);
+	stats.commands_dropped = commands_dropped;
+	Uint64 count = latency_count.load(std::memory_order_relaxed);
+	stats.last_latency_ms = static_cast<double>(latency_last_ns.load(std::memory_order_relaxed)) / 1e6;
+	stats.max_latency_ms = static_cast<double>(latency_max_ns.load(std::memory_order_relaxed)) / 1e6;
+	stats.average_latency_ms = count > 0 ? static_cast<double>(latency_total_ns.load(std::memory_order_relaxed)) / 1e6 / static_cast<double>(count) : 0.0;
+	stats.music_underruns = music_underruns.load(std::memory_order_relaxed);
+	stats.music_buffered_ms = static_cast<double>(music_buffered_frames.load(std::memory_order_relaxed)) * 1000.0 / MIX_FREQUENCY;
+	return stats;
+}
+
+// --- 音乐解码线程 ---
+
+void AudioManager::musicThreadLoop() {
+	PROFILE_THREAD_NAME("Music Decoder");
+	std::vector<MusicStream *> active;
+	std::vector<std::unique_ptr<MusicStream>> finished;
+	std::unique_lock lock(music_mutex);
+	while (!music_stopping) {
+		// 持锁时只交接列表，解码（包括首次打开文件）在锁外进行，playMusic 不会因此阻塞主线程。
+		// 只有本线程从 music_streams 中移除元素，所以复制出的裸指针在解锁后仍然有效
+		for (auto &music : music_streams) {
+			if (music->isReleased()) {
+				finished.push_back(std::move(music));
+			}
+		}
+		std::erase(music_streams, nullptr);
+		active.clear();
+		for (const auto &music : music_streams) {
+			active.push_back(music.get());
+		}
+		music_wakeup = false;
+		lock.unlock();
+
+		finished.clear(); // 关闭解码器与文件同样不占用锁
+		for (MusicStream *music : active) {
+			if (!music->isReleased()) {
+				music->fill();
+			}
+		}
+
+		lock.lock();
+		music_cv.wait_for(lock, MUSIC_POLL_INTERVAL, [this] { return music_stopping || music_wakeup; });
+	}
+}
+
+// --- 音频线程 ---
+
+void SDLCALL AudioManager::audioCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int /*total_amount*/) {
+	auto *self = static_cast<AudioManager *>(userdata);
+	self->processCommands();
+
+	int frames = additional_amount / BYTES_PER_FRAME;
+	int queued_frames = SDL_GetAudioStreamQueued(stream) / BYTES_PER_FRAME;
+	while (frames > 0) {
+		int block = std::min(frames, MIX_BLOCK_FRAMES);
+		self->mixBlock(self->mix_buffer.data(), block, queued_frames);
+		SDL_PutAudioStreamData(stream, self->mix_buffer.data(), block * BYTES_PER_FRAME);
+		frames -= block;
+		queued_frames += block;
+	}
+}
+
+void AudioManager::processCommands() {
+	Command command;
+	while (commands.pop(command)) {
+		switch (command.type) {
+			case CommandType::Play:
+				startVoice(command);
+				break;
+			case CommandType::Stop:
+				for (Voice &voice : voices) {
+					if (voice.sound && voice.id == command.voice_id) {
+						voice.sound = nullptr;
+					}
+				}
+				break;
+			case CommandType::StopAll:
+				for (Voice &voice : voices) {
+					voice.sound = nullptr;
+				}
+				break;
+			case CommandType::SetVoiceVolume:
+				for (Voice &voice : voices) {
+					if (voice.sound && voice.id == command.voice_id) {
+						voice.volume = command.volume;
+					}
+				}
+				break;
+			case CommandType::SetSoundVolume:
+				sound_volume = command.volume;
+				break;
+			case CommandType::SetVoiceLimit:
+				voice_limit = static_cast<int>(command.value);
+				for (int i = voice_limit; i < MAX_VOICES; ++i) {
+					voices[i].sound = nullptr;
+				}
+				break;
+			case CommandType::ReleaseSound:
+				for (Voice &voice : voices) {
+					if (voice.sound == command.sound) {
+						voice.sound = nullptr;
+					}
+				}
+				processed_release_sequence.store(command.value, std::memory_order_release);
+				break;
+			case CommandType::PlayMusic:
+				startMusic(command.music, command.value);
+				break;
+			case CommandType::StopMusic:
+				if (music_pending) {
+					music_pending->release();
+					music_pending = nullptr;
+				}
+				stopMusicVoices(command.value);
+				break;
+			case CommandType::SetMusicVolume:
+				music_volume = command.volume;
+				break;
+		}
+	}
+}
+
+void AudioManager::startVoice(const Command &command) {
+	// 优先使用空闲声部；用尽时抢占优先级最低（同级取最早开始）的声部
+	Voice *target = nullptr;
+	for (int i = 0; i < voice_limit; ++i) {
+		Voice &voice = voices[i];
+		if (!voice.sound) {
+			target = &voice;
+			break;
+		}
+		if (!target || voice.priority < target->priority || (voice.priority == target->priority && voice.start_order < target->start_order)) {
+			target = &voice;
+		}
+	}
+	if (target->sound) {
+		if (target->priority > command.priority) {
+			voices_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		voices_stolen.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	target->sound = command.sound;
+	target->id = command.voice_id;
+	target->position = 0;
+	target->volume = command.volume;
+	target->pan = command.pan;
+	target->priority = command.priority;
+	target->loop = command.loop;
+	target->latency_pending = true;
+	target->trigger_ns = command.value;
+	target->start_order = start_counter++;
+	voices_started.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioManager::mixBlock(float *out, int frames, int queued_frames) {
+	std::fill(out, out + static_cast<size_t>(frames) * MIX_CHANNELS, 0.0f);
+
+	int active = 0;
+	for (int v = 0; v < voice_limit; ++v) {
+		Voice &voice = voices[v];
+		if (!voice.sound) {
+			continue;
+		}
+		if (voice.latency_pending) {
+			recordLatency(voice.trigger_ns, queued_frames);
+			voice.latency_pending = false;
+		}
+
+		// 线性声像：居中时左右增益都为 1
+		const float gain = voice.volume * sound_volume;
+		const float gain_left = gain * std::min(1.0f, 1.0f - voice.pan);
+		const float gain_right = gain * std::min(1.0f, 1.0f + voice.pan);
+		const SoundBuffer &sound = *voice.sound;
+
+		int written = 0;
+		while (written < frames) {
+			int count = std::min(frames - written, static_cast<int>(sound.frame_count - voice.position));
+			const float *source = sound.samples.data() + static_cast<size_t>(voice.position) * MIX_CHANNELS;
+			float *destination = out + static_cast<size_t>(written) * MIX_CHANNELS;
+			for (int i = 0; i < count; ++i) {
+				destination[i * 2] += source[i * 2] * gain_left;
+				destination[i * 2 + 1] += source[i * 2 + 1] * gain_right;
+			}
+			written += count;
+			voice.position += static_cast<Uint32>(count);
+			if (voice.position >= sound.frame_count) {
+				if (!voice.loop) {
+					voice.sound = nullptr;
+					break;
+				}
+				voice.position = 0;
+			}
+		}
+		if (voice.sound) {
+			++active;
+		}
+	}
+	active_voices.store(active, std::memory_order_relaxed);
+
+	// 新曲目预填充完成后才开始交叉淡化，避免一开始就读空缓冲区
+	if (music_pending && music_pending->isReady() && music_pending->isExhausted()) {
+		music_pending->release(); // 打开或解码失败，保留正在播放的曲目
+		music_pending = nullptr;
+	}
+	if (music_pending && music_pending->isReady()) {
+		Uint64 fade_frames = music_pending_fade_frames;
+		stopMusicVoices(fade_frames);
+		float step = fade_frames > 0 ? 1.0f / static_cast<float>(fade_frames) : 1.0f;
+		music_current = { music_pending, fade_frames > 0 ? 0.0f : 1.0f, step };
+		music_pending = nullptr;
+	}
+	mixMusic(music_current, out, frames);
+	mixMusic(music_fading, out, frames);
+	music_buffered_frames.store(music_current.stream ? music_current.stream->getBufferedFrames() : 0, std::memory_order_relaxed);
+
+	for (int i = 0; i < frames * MIX_CHANNELS; ++i) {
+		out[i] = std::clamp(out[i], -1.0f, 1.0f);
+	}
+}
+
+void AudioManager::startMusic(MusicStream *music, Uint64 fade_frames) {
+	if (music_pending) {
+		music_pending->release(); // 连续切换时，还没开始播放的曲目直接丢弃
+	}
+	music_pending = music;
+	music_pending_fade_frames = fade_frames;
+}
+
+void AudioManager::stopMusicVoices(Uint64 fade_frames) {
+	if (music_fading.stream) {
+		music_fading.stream->release();
+		music_fading.stream = nullptr;
+	}
+	if (!music_current.stream) {
+		return;
+	}
+	if (fade_frames == 0 || music_current.gain <= 0.0f) {
+		music_current.stream->release();
+	} else {
+		// 从当前增益开始淡出，正在淡入的曲目被打断时不会跳变
+		music_fading = { music_current.stream, music_current.gain, -music_current.gain / static_cast<float>(fade_frames) };
+	}
+	music_current.stream = nullptr;
+}
+
+void AudioManager::mixMusic(MusicVoice &voice, float *out, int frames) {
+	if (!voice.stream) {
+		return;
+	}
+	size_t count = voice.stream->read(music_buffer.data(), static_cast<size_t>(frames));
+	if (count < static_cast<size_t>(frames) && !voice.stream->isDecodeFinished()) {
+		music_underruns.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	float gain = voice.gain;
+	for (size_t i = 0; i < count; ++i) {
+		gain = std::clamp(gain + voice.gain_step, 0.0f, 1.0f);
+		out[i * 2] += music_buffer[i * 2] * gain * music_volume;
+		out[i * 2 + 1] += music_buffer[i * 2 + 1] * gain * music_volume;
+	}
+	voice.gain = gain;
+
+	bool faded_out = voice.gain_step < 0.0f && voice.gain <= 0.0f;
+	if (faded_out || voice.stream->isExhausted()) {
+		voice.stream->release();
+		voice.stream = nullptr;
+	}
+}
+
+void AudioManager::recordLatency(Uint64 trigger_ns, int queued_frames) {
+	// 触发到混音的等待 + 之前已排队的样本 + 设备缓冲，近似为这一声真正被听到的延迟
+	Uint64 now = SDL_GetTicksNS();
+	Uint64 buffered_ns = static_cast<Uint64>(queued_frames + device_buffer_frames) * 1000000000ull / MIX_FREQUENCY;
+	Uint64 latency = (now > trigger_ns ? now - trigger_ns : 0) + buffered_ns;
+	latency_last_ns.store(latency, std::memory_order_relaxed);
+	latency_total_ns.fetch_add(latency, std::memory_order_relaxed);
+	latency_count.fetch_add(1, std::memory_order_relaxed);
+	if (latency > latency_max_ns.load(std::memory_order_relaxed)) {
+		latency_max_ns.store(latency, std::memory_order_relaxed);
+	}
+}
+
+} // namespace engine::resource
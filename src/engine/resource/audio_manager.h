@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL3/SDL_audio.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include "../utils/spsc_queue.h"
+#include "music_stream.h"
+
+namespace engine::resource {
+
+/// @brief 已解码并转换为混音格式的音效
+struct SoundBuffer {
+	std::string path;
+	std::vector<float> samples; ///< @brief 交错的立体声 F32
+	Uint32 frame_count = 0;
+};
+
+/// @brief 播放参数
+struct SoundParams {
+	float volume = 1.0f;
+	float pan = 0.0f; ///< @brief -1 = 左，0 = 居中，1 = 右
+	int priority = 0; ///< @brief 声部用尽时，只能抢占优先级不高于自己的声部
+	bool loop = false;
+};
+
+/// @brief 正在播放的声部句柄，id 为 0 表示无效（如命令队列已满）
+struct VoiceHandle {
+	Uint32 id = 0;
+
+	[[nodiscard]] bool isValid() const { return id != 0; }
+	bool operator==(const VoiceHandle &other) const = default;
+};
+
+/// @brief 音频统计，延迟为从 play 调用到样本进入设备缓冲末尾的估计值
+struct AudioStats {
+	int active_voices = 0;
+	int device_buffer_frames = 0;
+	Uint64 voices_started = 0;
+	Uint64 voices_stolen = 0; ///< @brief 抢占了其它声部的次数
+	Uint64 voices_dropped = 0; ///< @brief 因优先级不足而没有播放的次数
+	Uint64 commands_dropped = 0; ///< @brief 命令队列已满而丢弃的命令数
+	double last_latency_ms = 0.0;
+	double average_latency_ms = 0.0;
+	double max_latency_ms = 0.0;
+	Uint64 music_underruns = 0; ///< @brief 音乐缓冲区被读空（解码跟不上）的次数
+	double music_buffered_ms = 0.0; ///< @brief 当前曲目已缓冲的时长
+};
+
+/**
+ * @brief 音效管理：解码缓存 + SDL_AudioStream 回调中的软件混音
+ *
+ * 游戏线程只通过单生产者单消费者的无锁命令队列与音频线程通信，play / stop 不会阻塞。
+ * 音效卸载时缓冲区先交给音频线程确认不再引用，之后才在 update() 中释放。
+ * 音乐不进入缓存，由专门的解码线程流式解码（见 MusicStream），切换曲目时交叉淡化。
+ * 没有可用的音频设备时（如无头基准）进入静音模式，接口照常工作但不产生声音。
+ */
+class AudioManager final {
+	friend class ResourceManager;
+
+public:
+	static constexpr int MAX_VOICES = 32;
+	static constexpr int MIX_CHANNELS = 2;
+	static constexpr int MIX_FREQUENCY = 48000;
+
+private:
+	enum class CommandType : Uint8 {
+		Play,
+		Stop,
+		StopAll,
+		SetVoiceVolume,
+		SetSoundVolume,
+		SetVoiceLimit,
+		ReleaseSound,
+		PlayMusic,
+		StopMusic,
+		SetMusicVolume,
+	};
+
+	/// @brief 主线程 -> 音频线程的命令（可平凡复制）
+	struct Command {
+		CommandType type = CommandType::Play;
+		bool loop = false;
+		Uint32 voice_id = 0;
+		int priority = 0;
+		float volume = 1.0f;
+		float pan = 0.0f;
+		const SoundBuffer *sound = nullptr;
+		Uint64 value = 0; ///< @brief Play：触发时间（ns）；ReleaseSound：释放序号；SetVoiceLimit：声部数；Play/StopMusic：淡化帧数
+		MusicStream *music = nullptr;
+	};
+
+	/// @brief 音频线程独占的声部状态
+	struct Voice {
+		const SoundBuffer *sound = nullptr; ///< @brief 为 nullptr 表示空闲
+		Uint32 id = 0;
+		Uint32 position = 0; ///< @brief 当前帧
+		float volume = 1.0f;
+		float pan = 0.0f;
+		int priority = 0;
+		bool loop = false;
+		bool latency_pending = false; ///< @brief 首次混音时记录触发延迟
+		Uint64 trigger_ns = 0;
+		Uint64 start_order = 0;
+	};
+
+	/// @brief 音频线程中播放的一路音乐及其淡化增益
+	struct MusicVoice {
+		MusicStream *stream = nullptr;
+		float gain = 1.0f;
+		float gain_step = 0.0f; ///< @brief 每帧的增益变化量
+	};
+
+	struct PendingRelease {
+		std::unique_ptr<SoundBuffer> sound;
+		Uint64 sequence = 0; ///< @brief 0 表示释放命令尚未成功入队
+	};
+
+	static constexpr int MIX_BLOCK_FRAMES = 1024;
+
+	SDL_AudioStream *stream = nullptr; ///< @brief 为 nullptr 表示静音模式
+	int device_buffer_frames = 0;
+
+	// 主线程状态
+	std::unordered_map<std::string, std::unique_ptr<SoundBuffer>> sounds;
+	std::vector<PendingRelease> pending_releases;
+	Uint32 next_voice_id = 1;
+	Uint64 next_release_sequence = 1;
+	Uint64 commands_dropped = 0;
+	engine::utils::SpscQueue<Command, 256> commands;
+	std::vector<std::unique_ptr<MusicStream>> music_streams; ///< @brief 主线程追加，解码线程遍历并销毁已释放的流，受 music_mutex 保护
+
+	// 音乐解码线程
+	std::thread music_thread;
+	std::mutex music_mutex;
+	std::condition_variable music_cv;
+	bool music_stopping = false;
+	bool music_wakeup = false;
+
+	// 音频线程状态
+	std::array<Voice, MAX_VOICES> voices{};
+	std::array<float, MIX_BLOCK_FRAMES * MIX_CHANNELS> mix_buffer{};
+	int voice_limit = MAX_VOICES;
+	float sound_volume = 1.0f;
+	Uint64 start_counter = 0;
+	std::array<float, MIX_BLOCK_FRAMES * MIX_CHANNELS> music_buffer{};
+	MusicStream *music_pending = nullptr; ///< @brief 等待预填充完成的新曲目
+	Uint64 music_pending_fade_frames = 0;
+	MusicVoice music_current;
+	MusicVoice music_fading; ///< @brief 交叉淡化中淡出的旧曲目
+	float music_volume = 1.0f;
+
+	// 音频线程写、主线程读的统计
+	std::atomic<Uint64> processed_release_sequence = 0;
+	std::atomic<int> active_voices = 0;
+	std::atomic<Uint64> voices_started = 0;
+	std::atomic<Uint64> voices_stolen = 0;
+	std::atomic<Uint64> voices_dropped = 0;
+	std::atomic<Uint64> latency_last_ns = 0;
+	std::atomic<Uint64> latency_max_ns = 0;
+	std::atomic<Uint64> latency_total_ns = 0;
+	std::atomic<Uint64> latency_count = 0;
+	std::atomic<Uint64> music_underruns = 0;
+	std::atomic<size_t> music_buffered_frames = 0;
+
+public:
+	AudioManager(); ///< @brief 打开默认播放设备，失败时进入静音模式（不抛出异常）
+	~AudioManager();
+
+	AudioManager(const AudioManager &) = delete;
+	AudioManager &operator=(const AudioManager &) = delete;
+	AudioManager(AudioManager &&) = delete;
+	AudioManager &operator=(AudioManager &&) = delete;
+
+private:
+	const SoundBuffer *loadSound(std::string_view file_path);
+	const SoundBuffer *getSound(std::string_view file_path);
+	void unloadSound(std::string_view file_path);
+	void clearSounds();
+
+	VoiceHandle playSound(std::string_view file_path, const SoundParams &params);
+	void stopVoice(VoiceHandle voice);
+	void stopAllSounds();
+	void setVoiceVolume(VoiceHandle voice, float volume);
+	void setSoundVolume(float volume);
+	void setVoiceLimit(int limit);
+	AudioStats getStats() const;
+
+	bool playMusic(std::string_view file_path, const MusicParams &params);
+	void stopMusic(double fade_seconds);
+	void setMusicVolume(float volume);
+
+	void update(); ///< @brief 主线程每帧调用：释放音频线程已确认不再引用的缓冲区
+
+	bool sendCommand(const Command &command);
+	void releaseSound(std::unique_ptr<SoundBuffer> sound);
+
+	// --- 音乐解码线程 ---
+	void musicThreadLoop();
+
+	// --- 音频线程 ---
+	static void SDLCALL audioCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount);
+	void processCommands();
+	void startVoice(const Command &command);
+	void mixBlock(float *out, int frames, int queued_frames);
+	void recordLatency(Uint64 trigger_ns, int queued_frames);
+	void startMusic(MusicStream *stream, Uint64 fade_frames);
+	void stopMusicVoices(Uint64 fade_frames);
+	void mixMusic(MusicVoice &voice, float *out, int frames);
+};
+
+} // namespace engine::resource
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::resource {
+
+/// @brief 缓存的内存预算：超出预算时，按最近最少使用的顺序淘汰至少 idle_frames 帧未被访问、且未被固定的条目
+struct CacheBudget {
+	size_t budget_bytes = 0; ///< @brief 0 表示不限
+	Uint32 idle_frames = 600; ///< @brief 条目至少闲置这么多帧才允许淘汰（至少为 1，保证本帧已记录的绘制命令不会失效）
+};
+
+/// @brief 单个缓存的驻留统计
+struct CacheStats {
+	size_t entries = 0;
+	size_t bytes = 0; ///< @brief 估算的内存占用（纹理为 宽 × 高 × 每像素字节数）
+	size_t budget_bytes = 0;
+	size_t pinned = 0;
+	Uint64 hits = 0;
+	Uint64 misses = 0;
+	Uint64 evictions = 0;
+
+	[[nodiscard]] double getHitRate() const { return hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0; }
+};
+
+/// @brief ResourceManager 汇总的缓存统计
+struct ResourceCacheStats {
+	CacheStats textures;
+	CacheStats fonts;
+};
+
+} // namespace engine::resource
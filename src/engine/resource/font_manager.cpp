@@ -1,10 +1,16 @@
 #include "font_manager.h"
+#include <algorithm>
+#include <filesystem>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
+#include "../debug/profiler.h"
+#include "asset_archive.h"
+
 namespace engine::resource {
 
-FontManager::FontManager() {
+FontManager::FontManager(SDL_Renderer *renderer) :
+		renderer(renderer) {
 	if (!TTF_WasInit() && !TTF_Init()) {
 		throw std::runtime_error("FontManager error: TTF_Init failed: " + std::string(SDL_GetError()));
 	}
@@ -21,35 +27,54 @@ FontManager::~FontManager() {
 }
 
 TTF_Font *FontManager::loadFont(std::string_view file_path, int point_size) {
+	PROFILE_SCOPE("FontManager::loadFont");
 	if (point_size <= 0) {
 		spdlog::error("Failed to load font '{}': invalid point size {}.", file_path, point_size);
 		return nullptr;
 	}
 
-	FontKey key = { std::string(file_path), point_size };
-
-	auto it = fonts.find(key);
+	auto it = fonts.find(FontKeyView(file_path, point_size));
 	if (it != fonts.end()) {
-		return it->second.get();
+		++cache_hits;
+		it->second.last_used_frame = current_frame;
+		return it->second.font.get();
 	}
+	++cache_misses;
 
 	spdlog::debug("Loading font: {} ({}pt)", file_path, point_size);
-	TTF_Font *raw_font = TTF_OpenFont(file_path.data(), point_size);
+	std::string path(file_path); // string_view 不保证以 '\0' 结尾
+	TTF_Font *raw_font = nullptr;
+	size_t file_bytes = 0;
+	if (const pak::EntryRecord *packed = archive ? archive->find(path) : nullptr) {
+		// 字体数据留在映射内存中，TTF 按需读取，不再拷贝整个文件
+		if (SDL_IOStream *io = archive->openIO(*packed)) {
+			raw_font = TTF_OpenFontIO(io, true, static_cast<float>(point_size));
+			file_bytes = static_cast<size_t>(packed->size);
+		}
+	}
 	if (!raw_font) {
-		spdlog::error("Failed to load font '{}' ({}pt): {}", file_path, point_size, SDL_GetError());
-		return nullptr;
+		raw_font = TTF_OpenFont(path.c_str(), point_size);
+		if (!raw_font) {
+			spdlog::error("Failed to load font '{}' ({}pt): {}", file_path, point_size, SDL_GetError());
+			return nullptr;
+		}
+		std::error_code ec;
+		auto size = std::filesystem::file_size(path, ec);
+		file_bytes = ec ? 0 : static_cast<size_t>(size);
 	}
 
-	fonts.emplace(key, std::unique_ptr<TTF_Font, SDLFontDeleter>(raw_font));
+	FontEntry entry{ std::unique_ptr<TTF_Font, SDLFontDeleter>(raw_font), nullptr, file_bytes, 0, current_frame };
+	fonts.emplace(FontKey(std::move(path), point_size), std::move(entry));
 	spdlog::debug("Successfully loaded and cached font: {} ({}pt)", file_path, point_size);
 	return raw_font;
 }
 
 TTF_Font *FontManager::getFont(std::string_view file_path, int point_size) {
-	FontKey key = { std::string(file_path), point_size };
-	auto it = fonts.find(key);
+	auto it = fonts.find(FontKeyView(file_path, point_size));
 	if (it != fonts.end()) {
-		return it->second.get();
+		++cache_hits;
+		it->second.last_used_frame = current_frame;
+		return it->second.font.get();
 	}
 
 	spdlog::warn("Font '{}' ({}pt) is not in cache, attempting to load.", file_path, point_size);
@@ -57,8 +82,7 @@ TTF_Font *FontManager::getFont(std::string_view file_path, int point_size) {
 }
 
 void FontManager::unloadFont(std::string_view file_path, int point_size) {
-	FontKey key = { std::string(file_path), point_size };
-	auto it = fonts.find(key);
+	auto it = fonts.find(FontKeyView(file_path, point_size));
 	if (it != fonts.end()) {
 		spdlog::debug("Unloading font: {} ({}pt)", file_path, point_size);
 		fonts.erase(it); // unique_ptr 会处理 TTF_CloseFont
@@ -74,4 +98,101 @@ void FontManager::clearFonts() {
 	}
 }
 
+const TextLayout *FontManager::getTextLayout(std::string_view file_path, int point_size, std::string_view text) {
+	auto it = fonts.find(FontKeyView(file_path, point_size));
+	if (it == fonts.end()) {
+		if (!loadFont(file_path, point_size)) {
+			return nullptr;
+		}
+		it = fonts.find(FontKeyView(file_path, point_size));
+	}
+	FontEntry &entry = it->second;
+	entry.last_used_frame = current_frame;
+	if (!entry.glyph_atlas) {
+		if (!renderer) {
+			spdlog::error("FontManager: cannot draw text with '{}' ({}pt) without a renderer.", file_path, point_size);
+			return nullptr;
+		}
+		entry.glyph_atlas = std::make_unique<GlyphAtlas>(renderer, entry.font.get());
+	}
+	return &entry.glyph_atlas->getLayout(text);
+}
+
+void FontManager::setBudget(const CacheBudget &new_budget) {
+	budget = new_budget;
+	budget.idle_frames = std::max<Uint32>(budget.idle_frames, 1);
+}
+
+void FontManager::trim() {
+	++current_frame;
+	if (budget.budget_bytes == 0) {
+		return;
+	}
+	size_t total_bytes = 0;
+	for (const auto &[key, entry] : fonts) {
+		total_bytes += entry.getBytes();
+	}
+	if (total_bytes <= budget.budget_bytes) {
+		return;
+	}
+
+	// 字体数量很少，直接收集候选并按最近使用时间排序
+	std::vector<decltype(fonts)::iterator> candidates;
+	for (auto it = fonts.begin(); it != fonts.end(); ++it) {
+		if (it->second.pin_count == 0 && current_frame - it->second.last_used_frame >= budget.idle_frames) {
+			candidates.push_back(it);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) { return a->second.last_used_frame < b->second.last_used_frame; });
+	for (auto it : candidates) {
+		if (total_bytes <= budget.budget_bytes) {
+			break;
+		}
+		spdlog::debug("Evicting idle font: {} ({}pt)", it->first.first, it->first.second);
+		total_bytes -= it->second.getBytes();
+		fonts.erase(it);
+		++evictions;
+	}
+}
+
+bool FontManager::pinFont(std::string_view file_path, int point_size) {
+	auto it = fonts.find(FontKeyView(file_path, point_size));
+	if (it == fonts.end()) {
+		return false;
+	}
+	++it->second.pin_count;
+	return true;
+}
+
+void FontManager::unpinFont(std::string_view file_path, int point_size) {
+	auto it = fonts.find(FontKeyView(file_path, point_size));
+	if (it != fonts.end() && it->second.pin_count > 0) {
+		--it->second.pin_count;
+	}
+}
+
+CacheStats FontManager::getCacheStats() const {
+	CacheStats stats;
+	stats.entries = fonts.size();
+	for (const auto &[key, entry] : fonts) {
+		stats.bytes += entry.getBytes();
+		stats.pinned += entry.pin_count > 0 ? 1 : 0;
+	}
+	stats.budget_bytes = budget.budget_bytes;
+	stats.hits = cache_hits;
+	stats.misses = cache_misses;
+	stats.evictions = evictions;
+	return stats;
+}
+
+TextCacheStats FontManager::getTextCacheStats() const {
+	TextCacheStats stats;
+	for (const auto &[key, entry] : fonts) {
+		if (entry.glyph_atlas) {
+			entry.glyph_atlas->addStats(stats);
+		}
+	}
+	return stats;
+}
+
 } // namespace engine::resource
\ No newline at end of file
@@ -10,16 +10,30 @@
 
 #include <SDL3_ttf/SDL_ttf.h>
 
+#include "cache_stats.h"
+#include "glyph_atlas.h"
+
 namespace engine::resource {
 
+class AssetArchive;
+
 using FontKey = std::pair<std::string, int>;
+using FontKeyView = std::pair<std::string_view, int>;
 
+/// @brief 字体键的透明哈希：混合两个哈希值（单纯异或会让相同字号的路径哈希互相抵消），可直接用 FontKeyView 查找
 struct FontKeyHash {
-	std::size_t operator()(const FontKey &key) const {
-		std::hash<std::string> string_hasher;
-		std::hash<int> int_hasher;
-		return string_hasher(key.first) ^ int_hasher(key.second);
+	using is_transparent = void;
+	std::size_t operator()(FontKeyView key) const {
+		std::size_t seed = std::hash<std::string_view>{}(key.first);
+		seed ^= std::hash<int>{}(key.second) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+		return seed;
 	}
+	std::size_t operator()(const FontKey &key) const { return (*this)(FontKeyView(key.first, key.second)); }
+};
+
+struct FontKeyEqual {
+	using is_transparent = void;
+	bool operator()(FontKeyView a, FontKeyView b) const { return a == b; }
 };
 
 class FontManager final {
@@ -35,11 +49,29 @@ private:
 		}
 	};
 
-	std::unordered_map<FontKey, std::unique_ptr<TTF_Font, SDLFontDeleter>, FontKeyHash> fonts;
+	struct FontEntry {
+		std::unique_ptr<TTF_Font, SDLFontDeleter> font;
+		std::unique_ptr<GlyphAtlas> glyph_atlas; ///< @brief 第一次绘制文本时创建，先于字体销毁
+		size_t file_bytes = 0; ///< @brief 字体文件大小，作为字体本身内存占用的估算
+		Uint32 pin_count = 0; ///< @brief 大于 0 时不会被预算淘汰
+		Uint64 last_used_frame = 0;
+
+		size_t getBytes() const { return file_bytes + (glyph_atlas ? glyph_atlas->getMemoryBytes() : 0); }
+	};
+
+	std::unordered_map<FontKey, FontEntry, FontKeyHash, FontKeyEqual> fonts;
+	SDL_Renderer *renderer = nullptr; ///< @brief 创建字形图集页所用，非拥有
+	const AssetArchive *archive = nullptr; ///< @brief 已挂载的资源包（非拥有），字体直接从映射内存打开
+
+	CacheBudget budget;
+	Uint64 current_frame = 0;
+	Uint64 cache_hits = 0;
+	Uint64 cache_misses = 0;
+	Uint64 evictions = 0;
 
 public:
 
-	FontManager();
+	explicit FontManager(SDL_Renderer *renderer);
 
 	~FontManager();
 
@@ -49,10 +81,22 @@ public:
 	FontManager &operator=(FontManager &&) = delete;
 
 private:
+	void setArchive(const AssetArchive *new_archive) { archive = new_archive; } ///< @brief 资源包必须比所有从中打开的字体存活更久
+
 	TTF_Font *loadFont(std::string_view file_path, int point_size);
 	TTF_Font *getFont(std::string_view file_path, int point_size);
 	void unloadFont(std::string_view file_path, int point_size);
 	void clearFonts();
+
+	const TextLayout *getTextLayout(std::string_view file_path, int point_size, std::string_view text);
+	TextCacheStats getTextCacheStats() const;
+
+	void setBudget(const CacheBudget &new_budget);
+	/// @brief 每帧调用一次：推进帧计数，超出预算时淘汰闲置且未固定的字体（连同其字形图集）
+	void trim();
+	bool pinFont(std::string_view file_path, int point_size); ///< @brief 固定已加载的字体使其不被淘汰（可嵌套）
+	void unpinFont(std::string_view file_path, int point_size);
+	CacheStats getCacheStats() const;
 };
 
 } //namespace engine::resource
\ No newline at end of file
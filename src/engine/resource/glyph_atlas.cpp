@@ -0,0 +1,168 @@
+#include "glyph_atlas.h"
+
+#include <algorithm>
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <spdlog/spdlog.h>
+
+#include "../debug/profiler.h"
+
+namespace engine::resource {
+
+namespace {
+constexpr int GLYPH_PADDING = 1; ///< @brief 字形之间留空，避免线性过滤时采样到相邻字形
+} // namespace
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer *renderer, TTF_Font *font) :
+		renderer(renderer), font(font) {}
+
+const TextLayout &GlyphAtlas::getLayout(std::string_view text) {
+	if (auto it = layouts.find(text); it != layouts.end()) {
+		++layout_hits;
+		return it->second;
+	}
+
+	PROFILE_SCOPE("GlyphAtlas::layout");
+	++layout_misses;
+	if (layouts.size() >= MAX_CACHED_LAYOUTS) {
+		layouts.clear();
+	}
+
+	TextLayout layout;
+	const float line_skip = static_cast<float>(TTF_GetFontLineSkip(font));
+	const float line_height = static_cast<float>(TTF_GetFontHeight(font));
+	float pen_x = 0.0f;
+	float pen_y = 0.0f;
+	Uint32 previous = 0;
+	const char *cursor = text.data();
+	size_t remaining = text.size();
+	while (remaining > 0) {
+		Uint32 codepoint = SDL_StepUTF8(&cursor, &remaining);
+		if (codepoint == 0) {
+			break;
+		}
+		if (codepoint == '\n') {
+			pen_x = 0.0f;
+			pen_y += line_skip;
+			previous = 0;
+			continue;
+		}
+		if (codepoint == '\r') {
+			continue;
+		}
+
+		int kerning = 0;
+		if (previous != 0 && TTF_GetGlyphKerning(font, previous, codepoint, &kerning)) {
+			pen_x += static_cast<float>(kerning);
+		}
+		const Glyph &glyph = getGlyph(codepoint);
+		if (glyph.texture) {
+			layout.glyphs.push_back({ glyph.texture, glyph.src_rect, { pen_x, pen_y, glyph.src_rect.w, glyph.src_rect.h } });
+		}
+		pen_x += glyph.advance;
+		layout.size.x = std::max(layout.size.x, pen_x);
+		previous = codepoint;
+	}
+	layout.size.y = pen_y + line_height;
+
+	return layouts.emplace(std::string(text), std::move(layout)).first->second;
+}
+
+const GlyphAtlas::Glyph &GlyphAtlas::getGlyph(Uint32 codepoint) {
+	if (auto it = glyphs.find(codepoint); it != glyphs.end()) {
+		return it->second;
+	}
+
+	Glyph glyph;
+	int min_x = 0, max_x = 0, min_y = 0, max_y = 0, advance = 0;
+	if (TTF_GetGlyphMetrics(font, codepoint, &min_x, &max_x, &min_y, &max_y, &advance)) {
+		glyph.advance = static_cast<float>(advance);
+	}
+
+	// 字形表面为整行高度、基线已对齐，排版时直接放在行顶即可
+	SDL_Surface *surface = TTF_RenderGlyph_Blended(font, codepoint, SDL_Color{ 255, 255, 255, 255 });
+	if (surface) {
+		if (surface->w > 0 && surface->h > 0) {
+			if (surface->format != SDL_PIXELFORMAT_ARGB8888) {
+				SDL_Surface *converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888);
+				SDL_DestroySurface(surface);
+				surface = converted;
+			}
+			if (surface && !packGlyph(surface, glyph)) {
+				spdlog::warn("GlyphAtlas: failed to pack glyph U+{:04X}.", codepoint);
+			}
+		}
+		if (surface) {
+			SDL_DestroySurface(surface);
+		}
+		++glyphs_rasterized;
+	}
+	return glyphs.emplace(codepoint, glyph).first->second;
+}
+
+bool GlyphAtlas::packGlyph(SDL_Surface *surface, Glyph &glyph) {
+	if (surface->w + GLYPH_PADDING > PAGE_SIZE || surface->h + GLYPH_PADDING > PAGE_SIZE) {
+		return false;
+	}
+	if (cursor_x + surface->w + GLYPH_PADDING > PAGE_SIZE) { // 换到下一行
+		cursor_x = 0;
+		cursor_y += row_height;
+		row_height = 0;
+	}
+	if (pages.empty() || cursor_y + surface->h + GLYPH_PADDING > PAGE_SIZE) { // 当前页已满
+		if (!addPage()) {
+			return false;
+		}
+	}
+
+	SDL_Rect rect = { cursor_x, cursor_y, surface->w, surface->h };
+	SDL_Texture *page = pages.back().get();
+	if (!SDL_UpdateTexture(page, &rect, surface->pixels, surface->pitch)) {
+		spdlog::error("GlyphAtlas: failed to upload glyph: {}", SDL_GetError());
+		return false;
+	}
+	glyph.texture = page;
+	glyph.src_rect = { static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(rect.w), static_cast<float>(rect.h) };
+	cursor_x += surface->w + GLYPH_PADDING;
+	row_height = std::max(row_height, surface->h + GLYPH_PADDING);
+	return true;
+}
+
+bool GlyphAtlas::addPage() {
+	SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE);
+	if (!texture) {
+		spdlog::error("GlyphAtlas: failed to create atlas page: {}", SDL_GetError());
+		return false;
+	}
+	// 新纹理内容未定义，先整体清为透明
+	std::vector<Uint32> clear_pixels(static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE, 0);
+	SDL_UpdateTexture(texture, nullptr, clear_pixels.data(), PAGE_SIZE * static_cast<int>(sizeof(Uint32)));
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+	pages.emplace_back(texture);
+	cursor_x = 0;
+	cursor_y = 0;
+	row_height = 0;
+	spdlog::debug("GlyphAtlas: created page {} ({}x{}).", pages.size(), PAGE_SIZE, PAGE_SIZE);
+	return true;
+}
+
+size_t GlyphAtlas::getMemoryBytes() const {
+	size_t bytes = pages.size() * PAGE_SIZE * PAGE_SIZE * sizeof(Uint32);
+	bytes += glyphs.size() * (sizeof(Uint32) + sizeof(Glyph));
+	for (const auto &[text, layout] : layouts) {
+		bytes += text.capacity() + sizeof(TextLayout) + layout.glyphs.capacity() * sizeof(GlyphQuad);
+	}
+	return bytes;
+}
+
+void GlyphAtlas::addStats(TextCacheStats &stats) const {
+	stats.glyphs_rasterized += glyphs_rasterized;
+	stats.layout_hits += layout_hits;
+	stats.layout_misses += layout_misses;
+	stats.cached_layouts += layouts.size();
+	stats.atlas_pages += static_cast<int>(pages.size());
+}
+
+} // namespace engine::resource
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL3/SDL_render.h>
+#include <glm/vec2.hpp>
+
+#include "../utils/string_hash.h"
+
+struct TTF_Font;
+
+namespace engine::resource {
+
+/// @brief 排版结果中的一个字形四边形
+struct GlyphQuad {
+	SDL_Texture *texture = nullptr; ///< @brief 字形所在的图集页
+	SDL_FRect src_rect = { 0, 0, 0, 0 }; ///< @brief 图集页中的源矩形
+	SDL_FRect dest_rect = { 0, 0, 0, 0 }; ///< @brief 相对文本左上角的目标矩形
+};
+
+/// @brief 一段已排版的文本，绘制时只需平移各字形四边形
+struct TextLayout {
+	std::vector<GlyphQuad> glyphs;
+	glm::vec2 size = { 0.0f, 0.0f };
+};
+
+/// @brief 字形图集与排版缓存的统计（所有字体之和）
+struct TextCacheStats {
+	Uint64 glyphs_rasterized = 0; ///< @brief 累计光栅化的字形数，稳态下不应再增长
+	Uint64 layout_hits = 0;
+	Uint64 layout_misses = 0;
+	size_t cached_layouts = 0;
+	int atlas_pages = 0;
+};
+
+/**
+ * @brief 单个字体（路径 + 字号）的字形图集与排版缓存
+ *
+ * 字形在第一次用到时用 TTF_RenderGlyph_Blended 光栅化为白色，按行（shelf）打包进图集页，颜色在绘制时由顶点色调制。
+ * 排版结果按字符串缓存，重复出现的 HUD 文本在稳态下既不光栅化也不重新排版。
+ */
+class GlyphAtlas final {
+public:
+	static constexpr int PAGE_SIZE = 512;
+	static constexpr size_t MAX_CACHED_LAYOUTS = 512; ///< @brief 超出后整体清空，防止不断变化的文本（如计时器）无限增长
+
+private:
+	struct SDLTextureDeleter {
+		void operator()(SDL_Texture *texture) const {
+			if (texture) {
+				SDL_DestroyTexture(texture);
+			}
+		}
+	};
+
+	struct Glyph {
+		SDL_Texture *texture = nullptr; ///< @brief 为 nullptr 表示不可见（如空格）或光栅化失败
+		SDL_FRect src_rect = { 0, 0, 0, 0 };
+		float advance = 0.0f;
+	};
+
+	SDL_Renderer *renderer = nullptr;
+	TTF_Font *font = nullptr;
+
+	std::vector<std::unique_ptr<SDL_Texture, SDLTextureDeleter>> pages;
+	int cursor_x = 0; ///< @brief 当前行的下一个空闲位置
+	int cursor_y = 0;
+	int row_height = 0;
+
+	std::unordered_map<Uint32, Glyph> glyphs; ///< @brief 码点 -> 字形
+	std::unordered_map<std::string, TextLayout, engine::utils::StringHash, std::equal_to<>> layouts;
+
+	Uint64 glyphs_rasterized = 0;
+	Uint64 layout_hits = 0;
+	Uint64 layout_misses = 0;
+
+public:
+	GlyphAtlas(SDL_Renderer *renderer, TTF_Font *font);
+
+	GlyphAtlas(const GlyphAtlas &) = delete;
+	GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+	GlyphAtlas(GlyphAtlas &&) = delete;
+	GlyphAtlas &operator=(GlyphAtlas &&) = delete;
+
+	/// @brief 获取文本（UTF-8，'\n' 换行）的排版结果，未缓存时排版并光栅化缺少的字形
+	const TextLayout &getLayout(std::string_view text);
+
+	void addStats(TextCacheStats &stats) const; ///< @brief 把本字体的统计累加到 stats
+	size_t getMemoryBytes() const; ///< @brief 图集页与排版缓存的估算内存占用
+
+private:
+	const Glyph &getGlyph(Uint32 codepoint);
+	bool packGlyph(SDL_Surface *surface, Glyph &glyph); ///< @brief 把字形表面拷贝进图集页，页满时新建一页
+	bool addPage();
+};
+
+} // namespace engine::resource
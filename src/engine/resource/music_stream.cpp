@@ -0,0 +1,119 @@
+#include "music_stream.h"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "../debug/profiler.h"
+#include "audio_decoder.h"
+
+namespace engine::resource {
+
+MusicStream::MusicStream(std::string path, const MusicParams &params, const SDL_AudioSpec &target_spec) :
+		path(std::move(path)), params(params), target_spec(target_spec), ring(BUFFER_FRAMES * static_cast<size_t>(target_spec.channels)) {}
+
+MusicStream::~MusicStream() {
+	if (converter) {
+		SDL_DestroyAudioStream(converter);
+	}
+}
+
+bool MusicStream::open() {
+	PROFILE_SCOPE("MusicStream::open");
+	decoder = AudioDecoder::open(path);
+	if (!decoder) {
+		return false;
+	}
+	const SDL_AudioSpec &source = decoder->getSpec();
+	converter = SDL_CreateAudioStream(&source, &target_spec);
+	if (!converter) {
+		spdlog::error("Failed to create audio converter for music '{}': {}", path, SDL_GetError());
+		return false;
+	}
+
+	Uint64 total = decoder->getTotalFrames();
+	loop_start_frame = static_cast<Uint64>(std::max(0.0, params.loop_start) * source.freq);
+	loop_end_frame = static_cast<Uint64>(std::max(0.0, params.loop_end) * source.freq);
+	if (total > 0) {
+		loop_end_frame = loop_end_frame > 0 ? std::min(loop_end_frame, total) : total;
+	}
+	if (loop_end_frame > 0 && loop_start_frame >= loop_end_frame) {
+		spdlog::warn("Music '{}': loop start {:.2f}s is past the loop end, looping from the beginning.", path, params.loop_start);
+		loop_start_frame = 0;
+	}
+
+	decode_buffer.resize(DECODE_CHUNK_FRAMES * static_cast<size_t>(source.channels));
+	convert_buffer.resize(DECODE_CHUNK_FRAMES * static_cast<size_t>(target_spec.channels));
+	spdlog::debug("Streaming music '{}': {} Hz, {} channel(s), loop {} [{}, {}).", path, source.freq, source.channels, params.loop, loop_start_frame, loop_end_frame);
+	return true;
+}
+
+void MusicStream::fill() {
+	if (decode_finished.load(std::memory_order_relaxed)) {
+		return;
+	}
+	if (!opened) {
+		opened = true;
+		if (!open()) {
+			finish();
+			return;
+		}
+	}
+
+	PROFILE_SCOPE("MusicStream::fill");
+	const size_t channels = static_cast<size_t>(target_spec.channels);
+	const int bytes_per_frame = static_cast<int>(channels * sizeof(float));
+	while (size_t space_frames = ring.space() / channels) {
+		// 先把重采样器里已有的输出搬进环形缓冲区，不够再解码下一块
+		int wanted = static_cast<int>(std::min(space_frames, DECODE_CHUNK_FRAMES)) * bytes_per_frame;
+		int got = SDL_GetAudioStreamData(converter, convert_buffer.data(), wanted);
+		if (got > 0) {
+			ring.write(convert_buffer.data(), static_cast<size_t>(got) / sizeof(float));
+			continue;
+		}
+		if (flushed) {
+			finish();
+			return;
+		}
+		if (!decodeChunk()) {
+			SDL_FlushAudioStream(converter); // 取出重采样器里剩余的尾部样本
+			flushed = true;
+		}
+	}
+	ready.store(true, std::memory_order_release);
+}
+
+bool MusicStream::decodeChunk() {
+	size_t frames = DECODE_CHUNK_FRAMES;
+	if (loop_end_frame > 0) {
+		frames = static_cast<size_t>(std::min<Uint64>(frames, loop_end_frame - std::min(position, loop_end_frame)));
+	}
+	size_t got = frames > 0 ? decoder->read(decode_buffer.data(), frames) : 0;
+	if (got == 0) {
+		// 到达循环终点：只移动解码位置，不清空重采样器，前后两段样本因此无缝衔接
+		if (!params.loop || position == loop_start_frame || !decoder->seek(loop_start_frame)) {
+			return false;
+		}
+		position = loop_start_frame;
+		return true;
+	}
+	position += got;
+	const int bytes = static_cast<int>(got * static_cast<size_t>(decoder->getSpec().channels) * sizeof(float));
+	if (!SDL_PutAudioStreamData(converter, decode_buffer.data(), bytes)) {
+		spdlog::error("Failed to convert music '{}': {}", path, SDL_GetError());
+		return false;
+	}
+	return true;
+}
+
+void MusicStream::finish() {
+	decode_finished.store(true, std::memory_order_release);
+	ready.store(true, std::memory_order_release);
+}
+
+size_t MusicStream::read(float *out, size_t frames) {
+	const size_t channels = static_cast<size_t>(target_spec.channels);
+	return ring.read(out, frames * channels) / channels;
+}
+
+} // namespace engine::resource
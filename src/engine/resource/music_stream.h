@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_audio.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include "../utils/spsc_ring_buffer.h"
+
+namespace engine::resource {
+
+class AudioDecoder;
+
+/// @brief 音乐播放参数
+struct MusicParams {
+	bool loop = true;
+	double loop_start = 0.0; ///< @brief 循环起点（秒），循环时从结尾无缝跳回这里
+	double loop_end = 0.0; ///< @brief 循环终点（秒），0 表示文件结尾
+	double fade_seconds = 1.0; ///< @brief 与正在播放的曲目交叉淡化的时长，0 表示直接切换
+};
+
+/**
+ * @brief 流式播放的音乐：解码线程边解码边经 SDL_AudioStream 重采样，写入无锁 PCM 环形缓冲区，音频线程从中读出
+ *
+ * 整首曲目不会完整解码进内存，每个流只缓冲 BUFFER_FRAMES 帧（48 kHz 下约 340 ms）。
+ * 解码器在解码线程第一次 fill() 时才打开，主线程 playMusic 不做任何文件 I/O。
+ * 循环时解码器跳回循环起点，而重采样器的状态保持连续，因此循环点没有间隙。
+ */
+class MusicStream final {
+public:
+	static constexpr size_t BUFFER_FRAMES = 16384;
+
+private:
+	static constexpr size_t DECODE_CHUNK_FRAMES = 4096;
+
+	std::string path;
+	MusicParams params;
+	SDL_AudioSpec target_spec;
+
+	// 解码线程状态
+	std::unique_ptr<AudioDecoder> decoder;
+	SDL_AudioStream *converter = nullptr; ///< @brief 源格式 -> 混音格式
+	std::vector<float> decode_buffer;
+	std::vector<float> convert_buffer;
+	Uint64 position = 0; ///< @brief 解码器当前帧（源采样率）
+	Uint64 loop_start_frame = 0;
+	Uint64 loop_end_frame = 0; ///< @brief 0 表示读到文件结尾
+	bool opened = false;
+	bool flushed = false;
+
+	engine::utils::SpscRingBuffer<float> ring;
+	std::atomic<bool> ready = false; ///< @brief 缓冲区已预填满（或解码已结束），可以开始播放
+	std::atomic<bool> decode_finished = false; ///< @brief 不会再有新的样本写入
+	std::atomic<bool> released = false; ///< @brief 音频线程已不再引用，解码线程可以销毁
+
+public:
+	MusicStream(std::string path, const MusicParams &params, const SDL_AudioSpec &target_spec);
+	~MusicStream();
+
+	MusicStream(const MusicStream &) = delete;
+	MusicStream &operator=(const MusicStream &) = delete;
+	MusicStream(MusicStream &&) = delete;
+	MusicStream &operator=(MusicStream &&) = delete;
+
+	/// @brief 解码线程调用：把环形缓冲区尽量填满
+	void fill();
+
+	/// @brief 音频线程调用：读出最多 frames 帧混音格式的样本，返回实际帧数
+	size_t read(float *out, size_t frames);
+
+	/// @brief 音频线程调用：标记不再引用本流
+	void release() { released.store(true, std::memory_order_release); }
+
+	bool isReady() const { return ready.load(std::memory_order_acquire); }
+	bool isReleased() const { return released.load(std::memory_order_acquire); }
+	/// @brief 解码结束且缓冲区已读空
+	bool isExhausted() const { return decode_finished.load(std::memory_order_acquire) && ring.size() == 0; }
+	bool isDecodeFinished() const { return decode_finished.load(std::memory_order_acquire); }
+	size_t getBufferedFrames() const { return ring.size() / static_cast<size_t>(target_spec.channels); }
+	const std::string &getPath() const { return path; }
+
+private:
+	bool open();
+	bool decodeChunk(); ///< @brief 解码一块送入重采样器，没有更多数据时返回 false
+	void finish();
+};
+
+} // namespace engine::resource
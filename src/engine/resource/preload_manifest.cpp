@@ -0,0 +1,59 @@
+#include "preload_manifest.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "asset_archive.h"
+
+namespace engine::resource {
+
+std::optional<PreloadManifest> PreloadManifest::load(const std::string &path, const AssetArchive *archive) {
+	nlohmann::json json;
+	try {
+		if (const pak::EntryRecord *entry = archive ? archive->find(path) : nullptr) {
+			auto bytes = archive->getStoredBytes(*entry);
+			const char *begin = reinterpret_cast<const char *>(bytes.data());
+			json = nlohmann::json::parse(begin, begin + bytes.size());
+		} else {
+			std::ifstream file(path);
+			if (!file) {
+				return std::nullopt;
+			}
+			file >> json;
+		}
+
+		PreloadManifest manifest;
+		manifest.level = json.value("level", "");
+		manifest.textures = json.value("textures", std::vector<std::string>{});
+		return manifest;
+	} catch (const nlohmann::json::exception &e) {
+		spdlog::warn("Failed to parse preload manifest '{}': {}", path, e.what());
+		return std::nullopt;
+	}
+}
+
+bool PreloadManifest::save(const std::string &path) const {
+	nlohmann::json json = {
+		{ "level", level },
+		{ "textures", textures },
+	};
+	std::ofstream file(path);
+	if (!file) {
+		spdlog::error("Failed to open '{}' for writing.", path);
+		return false;
+	}
+	file << json.dump(4);
+	spdlog::debug("Preload manifest written to '{}' ({} textures).", path, textures.size());
+	return true;
+}
+
+std::string PreloadManifest::getManifestPath(std::string_view level_path) {
+	std::filesystem::path manifest(level_path);
+	manifest.replace_extension(".preload.json");
+	return manifest.generic_string();
+}
+
+} // namespace engine::resource
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::resource {
+
+class AssetArchive;
+
+/**
+ * @brief 关卡预加载清单（<关卡名>.preload.json）
+ *
+ * 由 level_baker 根据 .tmj 的图片图层和引用的图块集生成，列出关卡用到的所有纹理。
+ * 启动时先读清单即可开始并行解码，不必等地图解析完成。
+ */
+struct PreloadManifest {
+	std::string level; ///< @brief 生成清单的地图路径
+	std::vector<std::string> textures; ///< @brief 已规范化、已排序的纹理路径
+
+	/// @brief 读取清单（优先从资源包），不存在或解析失败返回 std::nullopt
+	static std::optional<PreloadManifest> load(const std::string &path, const AssetArchive *archive = nullptr);
+	bool save(const std::string &path) const;
+
+	/// @brief 关卡文件对应的清单路径，如 assets/maps/level1.tmj -> assets/maps/level1.preload.json
+	static std::string getManifestPath(std::string_view level_path);
+};
+
+} // namespace engine::resource
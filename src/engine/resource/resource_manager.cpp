@@ -1,8 +1,14 @@
 #include "resource_manager.h"
 
+#include <filesystem>
+
 #include <spdlog/spdlog.h>
 
+#include "../debug/profiler.h"
+#include "asset_archive.h"
+#include "audio_manager.h"
 #include "font_manager.h"
+#include "texture_atlas.h"
 #include "texture_manager.h"
 
 
@@ -10,7 +16,8 @@ namespace engine::resource {
 
 ResourceManager::ResourceManager(SDL_Renderer *renderer) {
 	texture_manager = std::make_unique<TextureManager>(renderer);
-	font_manager = std::make_unique<FontManager>();
+	font_manager = std::make_unique<FontManager>(renderer);
+	audio_manager = std::make_unique<AudioManager>();
 }
 
 ResourceManager::~ResourceManager() = default;
@@ -18,18 +25,46 @@ ResourceManager::~ResourceManager() = default;
 void ResourceManager::clear() {
 	texture_manager->clearTextures();
 	font_manager->clearFonts();
+	audio_manager->clearSounds();
 	spdlog::trace("ResourceManager cleared all resources.");
 }
 
-SDL_Texture *ResourceManager::loadTexture(const std::string &filePath) {
-	return texture_manager->loadTexture(filePath);
+bool ResourceManager::mountArchive(const std::string &archive_path) {
+	if (archive) {
+		spdlog::warn("Asset archive '{}' is already mounted, ignoring '{}'.", archive->getPath(), archive_path);
+		return false;
+	}
+	std::error_code ec;
+	if (!std::filesystem::is_regular_file(archive_path, ec)) {
+		spdlog::info("Asset archive '{}' not found, loading loose files.", archive_path);
+		return false;
+	}
+	auto mounted = std::make_unique<AssetArchive>();
+	if (!mounted->open(archive_path)) {
+		spdlog::warn("Failed to mount asset archive '{}', loading loose files.", archive_path);
+		return false;
+	}
+	archive = std::move(mounted);
+	texture_manager->setArchive(archive.get());
+	font_manager->setArchive(archive.get());
+	spdlog::info("Mounted asset archive '{}' ({} entries, {:.1f} MB).", archive_path, archive->getEntryCount(),
+			static_cast<double>(archive->getFileSize()) / (1024.0 * 1024.0));
+	return true;
 }
-SDL_Texture *ResourceManager::getTexture(const std::string &filePath) {
-	return texture_manager->getTexture(filePath);
+
+const AssetArchive *ResourceManager::getArchive() const {
+	return archive.get();
 }
 
-void ResourceManager::unloadTexture(const std::string &filePath) {
-	texture_manager->unloadTexture(filePath);
+SDL_Texture *ResourceManager::loadTexture(std::string_view file_path) {
+	return texture_manager->loadTexture(file_path);
+}
+SDL_Texture *ResourceManager::getTexture(std::string_view file_path) {
+	return texture_manager->getTexture(file_path);
+}
+
+void ResourceManager::unloadTexture(std::string_view file_path) {
+	texture_manager->unloadTexture(file_path);
 }
 
 void ResourceManager::clearTextures() {
@@ -37,6 +72,90 @@ void ResourceManager::clearTextures() {
 	spdlog::trace("ResourceManager cleared all textures.");
 }
 
+TextureHandle ResourceManager::loadTextureHandle(std::string_view file_path) {
+	return texture_manager->loadTextureHandle(file_path);
+}
+TextureHandle ResourceManager::getTextureHandle(std::string_view file_path) {
+	return texture_manager->getTextureHandle(file_path);
+}
+SDL_Texture *ResourceManager::getTexture(TextureHandle handle) const {
+	return texture_manager->getTexture(handle);
+}
+glm::vec2 ResourceManager::getTextureSize(TextureHandle handle) const {
+	return texture_manager->getTextureSize(handle);
+}
+SDL_FRect ResourceManager::getTextureRegion(TextureHandle handle) const {
+	return texture_manager->getTextureRegion(handle);
+}
+
+TextureHandle ResourceManager::loadTextureAsync(std::string_view file_path) {
+	return texture_manager->loadTextureAsync(file_path);
+}
+bool ResourceManager::isTextureReady(TextureHandle handle) const {
+	return texture_manager->isTextureReady(handle);
+}
+bool ResourceManager::isTextureFailed(TextureHandle handle) const {
+	return texture_manager->isTextureFailed(handle);
+}
+void ResourceManager::setAsyncUploadBudget(double milliseconds) {
+	texture_manager->setAsyncUploadBudget(milliseconds);
+}
+void ResourceManager::setAsyncWorkerCount(int count) {
+	texture_manager->setAsyncWorkerCount(count);
+}
+AsyncLoadStats ResourceManager::getAsyncLoadStats() const {
+	return texture_manager->getAsyncLoadStats();
+}
+
+size_t ResourceManager::beginPreload(const std::vector<std::string> &paths, engine::core::JobSystem &jobs) {
+	return texture_manager->beginPreload(paths, jobs);
+}
+std::vector<TextureLoadTiming> ResourceManager::finishPreload() {
+	return texture_manager->finishPreload();
+}
+
+void ResourceManager::update() {
+	texture_manager->processAsyncUploads();
+	texture_manager->trim();
+	font_manager->trim();
+	audio_manager->update();
+}
+
+void ResourceManager::setTextureBudget(const CacheBudget &budget) {
+	texture_manager->setBudget(budget);
+}
+void ResourceManager::setFontBudget(const CacheBudget &budget) {
+	font_manager->setBudget(budget);
+}
+bool ResourceManager::pinTexture(TextureHandle handle) {
+	return texture_manager->pinTexture(handle);
+}
+void ResourceManager::unpinTexture(TextureHandle handle) {
+	texture_manager->unpinTexture(handle);
+}
+bool ResourceManager::pinFont(std::string_view file_path, int point_size) {
+	return font_manager->pinFont(file_path, point_size);
+}
+void ResourceManager::unpinFont(std::string_view file_path, int point_size) {
+	font_manager->unpinFont(file_path, point_size);
+}
+ResourceCacheStats ResourceManager::getCacheStats() const {
+	return { texture_manager->getCacheStats(), font_manager->getCacheStats() };
+}
+
+bool ResourceManager::buildTextureAtlas(const AtlasConfig &config) {
+	PROFILE_SCOPE("ResourceManager::buildTextureAtlas");
+	TextureAtlas atlas(config, archive.get());
+	if (!atlas.build()) {
+		return false;
+	}
+	if (!config.manifest_path.empty()) {
+		atlas.saveManifest(config.manifest_path);
+	}
+	texture_manager->addAtlas(atlas);
+	return true;
+}
+
 TTF_Font *ResourceManager::loadFont(std::string_view file_path, int point_size) {
 	return font_manager->loadFont(file_path, point_size);
 }
@@ -50,5 +169,52 @@ void ResourceManager::clearFonts() {
 	font_manager->clearFonts();
 	spdlog::trace("ResourceManager cleared all fonts.");
 }
+const TextLayout *ResourceManager::getTextLayout(std::string_view font_path, int point_size, std::string_view text) {
+	return font_manager->getTextLayout(font_path, point_size, text);
+}
+TextCacheStats ResourceManager::getTextCacheStats() const {
+	return font_manager->getTextCacheStats();
+}
+
+bool ResourceManager::loadSound(std::string_view file_path) {
+	return audio_manager->loadSound(file_path) != nullptr;
+}
+void ResourceManager::unloadSound(std::string_view file_path) {
+	audio_manager->unloadSound(file_path);
+}
+void ResourceManager::clearSounds() {
+	audio_manager->clearSounds();
+	spdlog::trace("ResourceManager cleared all sounds.");
+}
+VoiceHandle ResourceManager::playSound(std::string_view file_path, const SoundParams &params) {
+	return audio_manager->playSound(file_path, params);
+}
+void ResourceManager::stopSound(VoiceHandle voice) {
+	audio_manager->stopVoice(voice);
+}
+void ResourceManager::stopAllSounds() {
+	audio_manager->stopAllSounds();
+}
+void ResourceManager::setSoundVolume(VoiceHandle voice, float volume) {
+	audio_manager->setVoiceVolume(voice, volume);
+}
+void ResourceManager::setSoundVolume(float volume) {
+	audio_manager->setSoundVolume(volume);
+}
+void ResourceManager::setVoiceLimit(int limit) {
+	audio_manager->setVoiceLimit(limit);
+}
+AudioStats ResourceManager::getAudioStats() const {
+	return audio_manager->getStats();
+}
+bool ResourceManager::playMusic(std::string_view file_path, const MusicParams &params) {
+	return audio_manager->playMusic(file_path, params);
+}
+void ResourceManager::stopMusic(double fade_seconds) {
+	audio_manager->stopMusic(fade_seconds);
+}
+void ResourceManager::setMusicVolume(float volume) {
+	audio_manager->setMusicVolume(volume);
+}
 
-} //namespace engine::resource
\ No newline at end of file
+} //namespace engine::resource
@@ -2,20 +2,39 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "async_texture_loader.h"
+#include "audio_manager.h"
+#include "cache_stats.h"
+#include "glyph_atlas.h"
+#include "texture_handle.h"
+
+namespace engine::core {
+class JobSystem;
+}
 
 struct SDL_Renderer;
 struct SDL_Texture;
+struct SDL_FRect;
 struct TTF_Font;
 
 namespace engine::resource {
 
 class TextureManager;
 class FontManager;
+class AssetArchive;
+struct AtlasConfig;
 
 class ResourceManager {
 private:
+	std::unique_ptr<AssetArchive> archive; // declared first so it outlives fonts opened from its mapped memory
 	std::unique_ptr<TextureManager> texture_manager;
 	std::unique_ptr<FontManager> font_manager;
+	std::unique_ptr<AudioManager> audio_manager;
 
 public:
 	explicit ResourceManager(SDL_Renderer *renderer);
@@ -28,15 +47,75 @@ public:
 	ResourceManager(ResourceManager &&) = delete;
 	ResourceManager &operator=(ResourceManager &&) = delete;
 
+	// Packed asset archive: mount before loading anything; paths missing from the archive fall back to loose files
+	bool mountArchive(const std::string &archive_path);
+	const AssetArchive *getArchive() const; // nullptr when no archive is mounted
+
 	// Unified interface for resource management
-	SDL_Texture *loadTexture(const std::string &filePath);
-	SDL_Texture *getTexture(const std::string &filePath);
-	void unloadTexture(const std::string &filePath);
+	SDL_Texture *loadTexture(std::string_view file_path);
+	SDL_Texture *getTexture(std::string_view file_path);
+	void unloadTexture(std::string_view file_path);
 	void clearTextures();
 
+	// Handle-based texture access: resolve a path once, then look up in O(1) on the draw path
+	TextureHandle loadTextureHandle(std::string_view file_path);
+	TextureHandle getTextureHandle(std::string_view file_path);
+	SDL_Texture *getTexture(TextureHandle handle) const;
+	glm::vec2 getTextureSize(TextureHandle handle) const;
+	SDL_FRect getTextureRegion(TextureHandle handle) const; // sub-rect of the image inside its (possibly atlas) texture
+
+	// Asynchronous loading: decode on worker threads, upload on the main thread under a per-frame budget
+	TextureHandle loadTextureAsync(std::string_view file_path);
+	bool isTextureReady(TextureHandle handle) const; // false while loading and after a failed load
+	bool isTextureFailed(TextureHandle handle) const; // the load failed; draws fall back to the placeholder until reloaded
+	void setAsyncUploadBudget(double milliseconds);
+	void setAsyncWorkerCount(int count);
+	AsyncLoadStats getAsyncLoadStats() const;
+
+	// Batch preload (e.g. a level's manifest): decode in parallel on the job system, then upload everything in one go.
+	// Slots exist right away (placeholder until uploaded), so lookups during the batch don't load twice.
+	size_t beginPreload(const std::vector<std::string> &paths, engine::core::JobSystem &jobs);
+	std::vector<TextureLoadTiming> finishPreload(); // waits for the decodes, uploads, returns per-texture timings
+
+	void update(); // per-frame housekeeping (async uploads, budget eviction), call once per frame on the main thread
+
+	// Memory budgets: idle, unpinned textures/fonts are evicted least-recently-used first once a cache is over budget.
+	// Texture handles are weak (generational), so an evicted texture simply reloads on next use; pin what must stay resident.
+	void setTextureBudget(const CacheBudget &budget);
+	void setFontBudget(const CacheBudget &budget);
+	bool pinTexture(TextureHandle handle);
+	void unpinTexture(TextureHandle handle);
+	bool pinFont(std::string_view file_path, int point_size);
+	void unpinFont(std::string_view file_path, int point_size);
+	ResourceCacheStats getCacheStats() const;
+
+	// Pack loose images into atlas pages; packed paths then resolve to atlas regions transparently
+	bool buildTextureAtlas(const AtlasConfig &config);
+
 	TTF_Font *loadFont(std::string_view file_path, int point_size);
 	TTF_Font *getFont(std::string_view file_path, int point_size);
 	void unloadFont(std::string_view file_path, int point_size);
 	void clearFonts();
+
+	// Text: laid-out runs cached per font and string, glyphs rasterised once into per-font atlas pages
+	const TextLayout *getTextLayout(std::string_view font_path, int point_size, std::string_view text);
+	TextCacheStats getTextCacheStats() const;
+
+	// Sound effects: decoded once into a PCM cache, mixed on the audio thread; play/stop never block
+	bool loadSound(std::string_view file_path);
+	void unloadSound(std::string_view file_path);
+	void clearSounds();
+	VoiceHandle playSound(std::string_view file_path, const SoundParams &params = {});
+	void stopSound(VoiceHandle voice);
+	void stopAllSounds();
+	void setSoundVolume(VoiceHandle voice, float volume);
+	void setSoundVolume(float volume); // sound-effect bus volume
+	void setVoiceLimit(int limit);
+	AudioStats getAudioStats() const;
+
+	// Music: streamed from disk on a decode thread, crossfades when a new track starts
+	bool playMusic(std::string_view file_path, const MusicParams &params = {});
+	void stopMusic(double fade_seconds = 1.0);
+	void setMusicVolume(float volume); // music bus volume
 };
 } //namespace engine::resource
\ No newline at end of file
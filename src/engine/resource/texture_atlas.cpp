@@ -0,0 +1,301 @@
+#include "texture_atlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <SDL3_image/SDL_image.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "asset_archive.h"
+
+namespace engine::resource {
+
+// --- SkylinePacker ---
+
+SkylinePacker::SkylinePacker(int width, int height) :
+		width(width), height(height) {
+	skyline.push_back({ 0, 0, width });
+}
+
+std::optional<SDL_Rect> SkylinePacker::insert(int rect_width, int rect_height) {
+	int best_bottom = height + 1;
+	int best_width = width + 1;
+	size_t best_index = skyline.size();
+	SDL_Rect best_rect = { 0, 0, rect_width, rect_height };
+
+	for (size_t i = 0; i < skyline.size(); ++i) {
+		int y = fit(i, rect_width, rect_height);
+		if (y < 0) {
+			continue;
+		}
+		// 优先底边最低，其次选择更窄的线段，减少浪费
+		int bottom = y + rect_height;
+		if (bottom < best_bottom || (bottom == best_bottom && skyline[i].width < best_width)) {
+			best_bottom = bottom;
+			best_width = skyline[i].width;
+			best_index = i;
+			best_rect.x = skyline[i].x;
+			best_rect.y = y;
+		}
+	}
+
+	if (best_index == skyline.size()) {
+		return std::nullopt;
+	}
+	addLevel(best_index, best_rect);
+	return best_rect;
+}
+
+int SkylinePacker::fit(size_t index, int rect_width, int rect_height) const {
+	int x = skyline[index].x;
+	if (x + rect_width > width) {
+		return -1;
+	}
+	int width_left = rect_width;
+	int y = skyline[index].y;
+	while (width_left > 0) {
+		y = std::max(y, skyline[index].y);
+		if (y + rect_height > height) {
+			return -1;
+		}
+		width_left -= skyline[index].width;
+		++index;
+	}
+	return y;
+}
+
+void SkylinePacker::addLevel(size_t index, const SDL_Rect &rect) {
+	skyline.insert(skyline.begin() + index, Node{ rect.x, rect.y + rect.h, rect.w });
+
+	// 新线段覆盖了其右侧的若干线段，截短或删除它们
+	for (size_t i = index + 1; i < skyline.size(); ++i) {
+		const Node &previous = skyline[i - 1];
+		int previous_right = previous.x + previous.width;
+		if (skyline[i].x >= previous_right) {
+			break;
+		}
+		int shrink = previous_right - skyline[i].x;
+		skyline[i].x += shrink;
+		skyline[i].width -= shrink;
+		if (skyline[i].width > 0) {
+			break;
+		}
+		skyline.erase(skyline.begin() + i);
+		--i;
+	}
+	merge();
+}
+
+void SkylinePacker::merge() {
+	for (size_t i = 0; i + 1 < skyline.size();) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		} else {
+			++i;
+		}
+	}
+}
+
+// --- TextureAtlas ---
+
+TextureAtlas::TextureAtlas(AtlasConfig config, const AssetArchive *archive) :
+		config(std::move(config)), archive(archive) {}
+
+bool TextureAtlas::build() {
+	namespace fs = std::filesystem;
+
+	// 1. 收集图片路径（资源包与散文件取并集，排序保证每次打包结果一致）
+	std::vector<std::string> files;
+	for (const auto &directory : config.directories) {
+		bool found = false;
+		if (archive) {
+			std::string prefix = normalizePath(directory);
+			if (!prefix.ends_with('/')) {
+				prefix += '/';
+			}
+			for (std::string_view packed : archive->list(prefix)) {
+				if (packed.ends_with(".png")) {
+					files.emplace_back(packed);
+					found = true;
+				}
+			}
+		}
+		std::error_code ec;
+		if (!fs::is_directory(directory, ec)) {
+			if (!found) {
+				spdlog::warn("Atlas source directory '{}' does not exist, skipping.", directory);
+			}
+			continue;
+		}
+		for (const auto &entry : fs::recursive_directory_iterator(directory, ec)) {
+			if (entry.is_regular_file() && entry.path().extension() == ".png") {
+				files.push_back(normalizePath(entry.path().generic_string()));
+			}
+		}
+	}
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+
+	// 2. 加载并统一转换为 RGBA32
+	struct PendingImage {
+		std::string path;
+		SurfacePtr surface;
+	};
+	std::vector<PendingImage> images;
+	const int border = config.extrude * 2 + config.padding;
+	for (const auto &file : files) {
+		SDL_Surface *loaded = archive ? archive->loadSurface(file) : nullptr;
+		if (!loaded) {
+			loaded = IMG_Load(file.c_str());
+		}
+		if (!loaded) {
+			spdlog::warn("Atlas failed to load '{}': {}", file, SDL_GetError());
+			continue;
+		}
+		SurfacePtr converted(SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32));
+		SDL_DestroySurface(loaded);
+		if (!converted) {
+			spdlog::warn("Atlas failed to convert '{}': {}", file, SDL_GetError());
+			continue;
+		}
+		if (converted->w + border > config.page_size || converted->h + border > config.page_size) {
+			spdlog::warn("Image '{}' ({}x{}) does not fit an atlas page of {}px, it will be loaded standalone.",
+					file, converted->w, converted->h, config.page_size);
+			continue;
+		}
+		images.push_back({ file, std::move(converted) });
+	}
+	if (images.empty()) {
+		spdlog::warn("No images were packed into the texture atlas.");
+		return false;
+	}
+
+	// 3. 按高度降序打包，skyline 算法对此顺序最友好
+	std::sort(images.begin(), images.end(), [](const PendingImage &a, const PendingImage &b) {
+		if (a.surface->h != b.surface->h) {
+			return a.surface->h > b.surface->h;
+		}
+		return a.surface->w > b.surface->w;
+	});
+
+	std::vector<SkylinePacker> packers;
+	for (auto &image : images) {
+		std::optional<SDL_Rect> cell;
+		size_t page_index = 0;
+		for (; page_index < packers.size(); ++page_index) {
+			cell = packers[page_index].insert(image.surface->w + border, image.surface->h + border);
+			if (cell) {
+				break;
+			}
+		}
+		if (!cell) { // 现有页都放不下，开一张新页
+			SurfacePtr page(SDL_CreateSurface(config.page_size, config.page_size, SDL_PIXELFORMAT_RGBA32));
+			if (!page) {
+				spdlog::error("Failed to create atlas page: {}", SDL_GetError());
+				return false;
+			}
+			SDL_FillSurfaceRect(page.get(), nullptr, 0);
+			pages.push_back(std::move(page));
+			packers.emplace_back(config.page_size, config.page_size);
+			page_index = packers.size() - 1;
+			cell = packers.back().insert(image.surface->w + border, image.surface->h + border);
+		}
+
+		int x = cell->x + config.extrude;
+		int y = cell->y + config.extrude;
+		blitWithExtrude(pages[page_index].get(), image.surface.get(), x, y);
+
+		AtlasRegion region;
+		region.page = static_cast<int>(page_index);
+		region.rect = { static_cast<float>(x), static_cast<float>(y), static_cast<float>(image.surface->w), static_cast<float>(image.surface->h) };
+		regions.emplace(image.path, region);
+	}
+
+	spdlog::info("Texture atlas built: {} images packed into {} page(s) of {}px.", regions.size(), pages.size(), config.page_size);
+	return true;
+}
+
+bool TextureAtlas::saveManifest(const std::string &file_path) const {
+	nlohmann::json manifest;
+	manifest["page_size"] = config.page_size;
+	manifest["padding"] = config.padding;
+	manifest["extrude"] = config.extrude;
+	manifest["pages"] = pages.size();
+
+	// 按路径排序输出，便于比较不同版本的清单
+	std::vector<std::string> paths;
+	paths.reserve(regions.size());
+	for (const auto &[path, region] : regions) {
+		paths.push_back(path);
+	}
+	std::sort(paths.begin(), paths.end());
+
+	auto &entries = manifest["regions"];
+	entries = nlohmann::json::object();
+	for (const auto &path : paths) {
+		const AtlasRegion &region = regions.at(path);
+		entries[path] = {
+			{ "page", region.page },
+			{ "x", region.rect.x },
+			{ "y", region.rect.y },
+			{ "w", region.rect.w },
+			{ "h", region.rect.h },
+		};
+	}
+
+	std::ofstream file(file_path);
+	if (!file) {
+		spdlog::error("Failed to open atlas manifest for writing: {}", file_path);
+		return false;
+	}
+	file << manifest.dump(4);
+	spdlog::debug("Atlas manifest written to {}", file_path);
+	return true;
+}
+
+std::string TextureAtlas::normalizePath(std::string_view file_path) {
+	// 非 Windows 平台上 '\\' 不是分隔符，lexically_normal 不会处理，先统一替换
+	std::string path(file_path);
+	std::replace(path.begin(), path.end(), '\\', '/');
+	return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+void TextureAtlas::blitWithExtrude(SDL_Surface *page, SDL_Surface *image, int x, int y) const {
+	// 两者均为 RGBA32，直接逐行拷贝像素，不做任何混合
+	auto page_pixel = [page](int px, int py) {
+		return static_cast<Uint32 *>(page->pixels) + static_cast<size_t>(py) * (page->pitch / 4) + px;
+	};
+
+	SDL_LockSurface(page);
+	SDL_LockSurface(image);
+
+	for (int row = 0; row < image->h; ++row) {
+		const auto *src = static_cast<const Uint8 *>(image->pixels) + static_cast<size_t>(row) * image->pitch;
+		std::memcpy(page_pixel(x, y + row), src, static_cast<size_t>(image->w) * 4);
+	}
+
+	// 左右挤出：每一行复制首尾像素
+	for (int row = 0; row < image->h; ++row) {
+		Uint32 left = *page_pixel(x, y + row);
+		Uint32 right = *page_pixel(x + image->w - 1, y + row);
+		for (int e = 1; e <= config.extrude; ++e) {
+			*page_pixel(x - e, y + row) = left;
+			*page_pixel(x + image->w - 1 + e, y + row) = right;
+		}
+	}
+	// 上下挤出：复制已含左右挤出边的首尾行（同时填好四个角）
+	const size_t row_bytes = static_cast<size_t>(image->w + config.extrude * 2) * 4;
+	for (int e = 1; e <= config.extrude; ++e) {
+		std::memcpy(page_pixel(x - config.extrude, y - e), page_pixel(x - config.extrude, y), row_bytes);
+		std::memcpy(page_pixel(x - config.extrude, y + image->h - 1 + e), page_pixel(x - config.extrude, y + image->h - 1), row_bytes);
+	}
+
+	SDL_UnlockSurface(image);
+	SDL_UnlockSurface(page);
+}
+
+} // namespace engine::resource
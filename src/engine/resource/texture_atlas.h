@@ -0,0 +1,117 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <SDL3/SDL_surface.h>
+
+namespace engine::resource {
+
+class AssetArchive;
+
+/**
+ * @brief 图集构建参数
+ */
+struct AtlasConfig {
+	int page_size = 1024; ///< @brief 图集页的边长（像素）
+	int padding = 1; ///< @brief 相邻图片（含挤出边）之间的空白像素
+	int extrude = 1; ///< @brief 图片边缘向外复制的像素数，防止最近邻采样在接缝处取到相邻图片
+	std::vector<std::string> directories = { ///< @brief 需要打包的目录（递归搜索 .png）
+		"assets/textures/Props",
+		"assets/textures/Actors",
+		"assets/textures/Items",
+		"assets/textures/FX",
+		"assets/textures/UI",
+	};
+	std::string manifest_path; ///< @brief 非空时将清单写入该 JSON 文件
+};
+
+/**
+ * @brief 原始图片在图集中的位置
+ */
+struct AtlasRegion {
+	int page = 0; ///< @brief 所在图集页索引
+	SDL_FRect rect = { 0, 0, 0, 0 }; ///< @brief 在图集页中的子矩形（不含挤出边）
+};
+
+/**
+ * @brief Skyline（Bottom-Left）矩形装箱器
+ *
+ * 维护一条由水平线段组成的“天际线”，每次把矩形放在使其底边最低的位置。
+ */
+class SkylinePacker final {
+private:
+	struct Node {
+		int x;
+		int y;
+		int width;
+	};
+
+	int width = 0;
+	int height = 0;
+	std::vector<Node> skyline;
+
+public:
+	SkylinePacker(int width, int height);
+
+	/// @brief 放入一个矩形，成功返回其左上角位置与尺寸，放不下返回 std::nullopt
+	std::optional<SDL_Rect> insert(int rect_width, int rect_height);
+
+private:
+	int fit(size_t index, int rect_width, int rect_height) const; ///< @brief 矩形以第 index 段为起点能放置的 y 坐标，放不下返回 -1
+	void addLevel(size_t index, const SDL_Rect &rect);
+	void merge();
+};
+
+/**
+ * @brief 启动时构建的纹理图集
+ *
+ * 将若干目录下的零散 PNG 打包进少量图集页（CPU 端 SDL_Surface），并记录原路径到图集子矩形的清单。
+ * 构建完成后交给 TextureManager 上传为纹理，原路径会被透明地解析到图集区域。
+ */
+class TextureAtlas final {
+private:
+	struct SDLSurfaceDeleter {
+		void operator()(SDL_Surface *surface) const {
+			if (surface) {
+				SDL_DestroySurface(surface);
+			}
+		}
+	};
+	using SurfacePtr = std::unique_ptr<SDL_Surface, SDLSurfaceDeleter>;
+
+	AtlasConfig config;
+	const AssetArchive *archive = nullptr; ///< @brief 非空时优先从资源包读取预解码的像素
+	std::vector<SurfacePtr> pages;
+	std::unordered_map<std::string, AtlasRegion> regions; ///< @brief 规范化路径 -> 图集区域
+
+public:
+	explicit TextureAtlas(AtlasConfig config, const AssetArchive *archive = nullptr);
+
+	/// @brief 加载并打包所有图片，至少打包了一张图片时返回 true
+	[[nodiscard]] bool build();
+
+	/// @brief 将清单（页尺寸及每个路径对应的页与子矩形）写入 JSON 文件
+	bool saveManifest(const std::string &file_path) const;
+
+	const std::vector<SurfacePtr> &getPages() const { return pages; }
+	const std::unordered_map<std::string, AtlasRegion> &getRegions() const { return regions; }
+	const AtlasConfig &getConfig() const { return config; }
+
+	/// @brief 规范化资源路径（消除 ./、../ 与重复分隔符，'\\' 统一为 '/'），保证不同来源的同一文件得到同一个键
+	static std::string normalizePath(std::string_view file_path);
+
+	TextureAtlas(const TextureAtlas &) = delete;
+	TextureAtlas &operator=(const TextureAtlas &) = delete;
+	TextureAtlas(TextureAtlas &&) = default;
+	TextureAtlas &operator=(TextureAtlas &&) = default;
+
+private:
+	void blitWithExtrude(SDL_Surface *page, SDL_Surface *image, int x, int y) const; ///< @brief 将图片拷贝到页的 (x, y)，并向四周复制边缘像素
+};
+
+} // namespace engine::resource
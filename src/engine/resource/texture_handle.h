@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+
+namespace engine::resource {
+
+/**
+ * @brief 纹理句柄：指向 TextureManager 槽位数组的代际索引
+ *
+ * 由 ResourceManager 在加载时一次性发放，之后解析为 O(1) 的数组访问，不涉及哈希与内存分配。
+ * 纹理被卸载后槽位的代数递增，旧句柄随之失效（解析得到 nullptr），不会误指向新纹理。
+ */
+struct TextureHandle {
+	static constexpr Uint32 INVALID_INDEX = 0xFFFFFFFFu;
+
+	Uint32 index = INVALID_INDEX; ///< @brief 槽位索引
+	Uint32 generation = 0; ///< @brief 槽位代数，槽位复用时递增
+
+	[[nodiscard]] bool isValid() const { return index != INVALID_INDEX; }
+
+	bool operator==(const TextureHandle &other) const = default;
+};
+
+} // namespace engine::resource
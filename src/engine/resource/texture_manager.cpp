@@ -1,10 +1,27 @@
 #include "texture_manager.h"
 
+#include <algorithm>
+#include <array>
+
+#include <SDL3/SDL_timer.h>
 #include <SDL3_image/SDL_image.h>
 #include <spdlog/spdlog.h>
 
+#include "../core/job_system.h"
+#include "../debug/profiler.h"
+#include "asset_archive.h"
+#include "texture_atlas.h"
+
 namespace engine::resource {
 
+namespace {
+
+size_t getTextureBytes(SDL_Texture* texture) {
+    return texture ? static_cast<size_t>(texture->w) * static_cast<size_t>(texture->h) * SDL_BYTESPERPIXEL(texture->format) : 0;
+}
+
+} // namespace
+
 TextureManager::TextureManager(SDL_Renderer *renderer) : renderer_(renderer) {
     if (!renderer_) {
         spdlog::error("SDL_Renderer is null. TextureManager cannot be initialized.");
@@ -13,77 +30,545 @@ TextureManager::TextureManager(SDL_Renderer *renderer) : renderer_(renderer) {
     spdlog::trace("TextureManager initialized successfully.");
 }
 
+TextureManager::~TextureManager() {
+    if (preload_counter && preload_jobs) {
+        preload_jobs->wait(*preload_counter);
+    }
+    for (auto &item : preload_items) {
+        if (item.surface) {
+            SDL_DestroySurface(item.surface);
+        }
+    }
+}
+
 
 SDL_Texture* TextureManager::loadTexture(std::string_view file_path) {
-    auto it = textures.find(std::string(file_path));
-    if (it != textures.end()) {
-        return it->second.get();
+    return getTexture(loadTextureHandle(file_path));
+}
+
+SDL_Texture* TextureManager::getTexture(std::string_view file_path) {
+    return getTexture(getTextureHandle(file_path));
+}
+
+glm::vec2 TextureManager::getTextureSize(std::string_view file_path) {
+    TextureHandle handle = getTextureHandle(file_path);
+    if (!handle.isValid()) {
+        spdlog::error("Failed to get texture: {}", file_path);
+        return glm::vec2(0);
     }
+    return getTextureSize(handle);
+}
 
-    // if the texture is not found, load it
-    SDL_Texture* raw_texture = IMG_LoadTexture(renderer_, file_path.data());
+void TextureManager::unloadTexture(std::string_view file_path) {
+    auto it = findPath(file_path);
+    if (it != path_to_slot.end()) {
+        spdlog::debug("Unloading texture: {}", file_path);
+        Uint32 index = it->second;
+        path_to_slot.erase(it);
+        releaseSlot(index);
+    } else {
+        spdlog::warn("Attempting to unload a non-existent texture: {}", file_path);
+    }
+}
 
-    // When loading a texture, set the texture scaling mode to nearest neighbor (this is essential, otherwise there will be edge gaps/blurriness in TileLayer rendering)
-    if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
-        spdlog::warn("Cannot set texture scale mode for '{}': {}", file_path, SDL_GetError());
+void TextureManager::clearTextures() {
+    if (!path_to_slot.empty()) {
+        spdlog::debug("Clearing all {} cached textures.", path_to_slot.size());
+        for (const auto &[path, index] : path_to_slot) {
+            releaseSlot(index);
+        }
+        path_to_slot.clear();
+    }
+    for (const auto &page : atlas_pages) {
+        total_bytes -= getTextureBytes(page.get());
+    }
+    atlas_pages.clear();
+}
+
+void TextureManager::addAtlas(const TextureAtlas &atlas) {
+    // upload every page first; a region on a failed page falls back to standalone loading
+    std::vector<SDL_Texture*> page_textures;
+    for (const auto &page : atlas.getPages()) {
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, page.get());
+        if (!texture) {
+            spdlog::error("Failed to upload atlas page: {}", SDL_GetError());
+            page_textures.push_back(nullptr);
+            continue;
+        }
+        // keep the same nearest neighbor sampling as standalone textures; the extruded borders prevent bleeding at seams
+        if (!SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST)) {
+            spdlog::warn("Cannot set texture scale mode for atlas page: {}", SDL_GetError());
+        }
+        atlas_pages.emplace_back(texture);
+        page_textures.push_back(texture);
+        total_bytes += getTextureBytes(texture);
+    }
+
+    for (const auto &[path, region] : atlas.getRegions()) {
+        SDL_Texture* page_texture = page_textures[region.page];
+        if (!page_texture) {
+            continue;
+        }
+        auto it = path_to_slot.find(path);
+        if (it != path_to_slot.end()) { // the atlas region replaces an already loaded standalone texture
+            releaseSlot(it->second);
+            path_to_slot.erase(it);
+        }
+
+        Uint32 index = allocateSlot();
+        TextureSlot &slot = slots[index];
+        slot.texture = page_texture;
+        slot.region = region.rect;
+        slot.path = path;
+        path_to_slot.emplace(path, index);
     }
+    spdlog::debug("Registered {} atlas regions on {} page(s).", atlas.getRegions().size(), page_textures.size());
+}
 
+TextureHandle TextureManager::loadTextureHandle(std::string_view file_path) {
+    auto it = findPathForLoad(file_path);
+    if (it != path_to_slot.end()) {
+        ++cache_hits;
+        slots[it->second].last_used_frame = current_frame;
+        return { it->second, slots[it->second].generation };
+    }
+    ++cache_misses;
+
+    // if the texture is not found, load it: pre-decoded pixels from the archive first, then the loose file
+    // (the normalized std::string is both the cache key and a null-terminated path for SDL)
+    PROFILE_SCOPE("TextureManager::loadTexture");
+    std::string path = TextureAtlas::normalizePath(file_path);
+    SDL_Texture* raw_texture = archive_ ? archive_->loadTexture(renderer_, path) : nullptr;
+    if (!raw_texture) {
+        raw_texture = IMG_LoadTexture(renderer_, path.c_str());
+    }
     if (!raw_texture) {
         spdlog::error("Failed to load texture: '{}': {}", file_path, SDL_GetError());
-        return nullptr;
+        return {};
+    }
+
+    // When loading a texture, set the texture scaling mode to nearest neighbor (this is essential, otherwise there will be edge gaps/blurriness in TileLayer rendering)
+    if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
+        spdlog::warn("Cannot set texture scale mode for '{}': {}", file_path, SDL_GetError());
     }
 
-    textures.emplace(file_path, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
+    Uint32 index = allocateSlot();
+    TextureSlot &slot = slots[index];
+    slot.owned_texture.reset(raw_texture);
+    slot.texture = raw_texture;
+    slot.region = { 0, 0, 0, 0 };
+    if (!SDL_GetTextureSize(raw_texture, &slot.region.w, &slot.region.h)) {
+        spdlog::warn("Failed to query texture size: '{}': {}", file_path, SDL_GetError());
+    }
+    slot.path = path;
+    slot.bytes = getTextureBytes(raw_texture);
+    slot.last_used_frame = current_frame;
+    total_bytes += slot.bytes;
+    path_to_slot.emplace(std::move(path), index);
     spdlog::debug("Successfully loaded and cached texture: {}", file_path);
 
-    return raw_texture;
+    return { index, slot.generation };
 }
 
-SDL_Texture* TextureManager::getTexture(std::string_view file_path) {
-    auto it = textures.find(std::string(file_path));
-    if (it != textures.end()) {
-        return it->second.get();
+TextureHandle TextureManager::getTextureHandle(std::string_view file_path) {
+    auto it = findPath(file_path);
+    if (it != path_to_slot.end()) {
+        ++cache_hits;
+        slots[it->second].last_used_frame = current_frame;
+        return { it->second, slots[it->second].generation };
     }
 
     // if the texture is not found, try to load it
     spdlog::warn("Texture '{}' not found in cache, trying to load.", file_path);
-    return loadTexture(file_path);
+    return loadTextureHandle(file_path);
 }
 
-glm::vec2 TextureManager::getTextureSize(std::string_view file_path) {
-    // get the texture from cache or load it
-    SDL_Texture* texture = getTexture(file_path);
+SDL_Texture* TextureManager::getTexture(TextureHandle handle) const {
+    const TextureSlot *slot = resolveSlot(handle);
+    return slot ? slot->texture : nullptr;
+}
+
+glm::vec2 TextureManager::getTextureSize(TextureHandle handle) const {
+    const TextureSlot *slot = resolveSlot(handle);
+    return slot ? glm::vec2(slot->region.w, slot->region.h) : glm::vec2(0);
+}
+
+SDL_FRect TextureManager::getTextureRegion(TextureHandle handle) const {
+    const TextureSlot *slot = resolveSlot(handle);
+    return slot ? slot->region : SDL_FRect{ 0, 0, 0, 0 };
+}
+
+TextureHandle TextureManager::loadTextureAsync(std::string_view file_path) {
+    auto it = findPathForLoad(file_path);
+    if (it != path_to_slot.end()) {
+        ++cache_hits;
+        slots[it->second].last_used_frame = current_frame;
+        return { it->second, slots[it->second].generation };
+    }
+
+    SDL_Texture* placeholder = getPlaceholderTexture();
+    if (!placeholder) {
+        spdlog::warn("No placeholder texture available, loading '{}' synchronously.", file_path);
+        return loadTextureHandle(file_path);
+    }
+    if (!async_loader) {
+        async_loader = std::make_unique<AsyncTextureLoader>(async_worker_count, archive_);
+    }
+
+    Uint32 index = allocatePendingSlot(file_path, placeholder);
+    TextureSlot &slot = slots[index];
+    ++cache_misses;
+    async_loader->enqueue(index, slot.generation, slot.path);
+    spdlog::debug("Queued async texture load: {}", file_path);
+
+    return { index, slot.generation };
+}
+
+void TextureManager::processAsyncUploads() {
+    PROFILE_SCOPE("TextureManager::processAsyncUploads");
+    last_frame_upload_ns = 0;
+    if (!async_loader) {
+        return;
+    }
+
+    const Uint64 budget_ns = static_cast<Uint64>(upload_budget_ms * 1000000.0);
+    const Uint64 frame_start = SDL_GetTicksNS();
+    AsyncTextureLoader::DecodedImage image;
+    // always upload at least one image per frame so a tiny budget still makes progress
+    while (async_loader->popCompleted(image)) {
+        Uint64 start = SDL_GetTicksNS();
+        bool slot_alive = image.slot_index < slots.size() && slots[image.slot_index].generation == image.slot_generation;
+        if (!slot_alive) {
+            spdlog::debug("Discarding async texture '{}', it was unloaded while loading.", image.path);
+        } else if (!image.surface) {
+            // keep the placeholder so draws don't retry the failing load every frame
+            markFailed(image.slot_index);
+        } else if (uploadSurface(image.slot_index, image.surface, image.path)) {
+            ++uploaded_count;
+        }
+        if (image.surface) {
+            SDL_DestroySurface(image.surface);
+        }
+
+        Uint64 now = SDL_GetTicksNS();
+        last_frame_upload_ns += now - start;
+        if (now - frame_start >= budget_ns) {
+            break;
+        }
+    }
+    total_upload_ns += last_frame_upload_ns;
+}
+
+size_t TextureManager::beginPreload(const std::vector<std::string> &paths, engine::core::JobSystem &jobs) {
+    PROFILE_SCOPE("TextureManager::beginPreload");
+    SDL_Texture* placeholder = getPlaceholderTexture();
+    if (!placeholder) {
+        spdlog::warn("No placeholder texture available, preloading {} texture(s) synchronously.", paths.size());
+        for (const auto &path : paths) {
+            loadTextureHandle(path);
+        }
+        return 0;
+    }
+    if (preload_jobs && preload_jobs != &jobs) {
+        finishPreload(); // a batch is tied to one job system
+    }
+    if (!preload_counter) {
+        preload_counter = std::make_unique<engine::core::JobCounter>();
+    }
+    preload_jobs = &jobs;
+
+    size_t queued = 0;
+    for (const auto &path : paths) {
+        if (findPathForLoad(path) != path_to_slot.end()) {
+            continue; // already resident, an atlas region, or loading
+        }
+        Uint32 index = allocatePendingSlot(path, placeholder);
+        ++cache_misses;
+        PreloadItem &item = preload_items.emplace_back();
+        item.slot_index = index;
+        item.slot_generation = slots[index].generation;
+        item.path = slots[index].path;
+
+        // each job owns exactly one item, so the workers never share writes
+        PreloadItem *target = &item;
+        const AssetArchive *archive = archive_;
+        jobs.run([target, archive] {
+            PROFILE_SCOPE("TextureManager::preloadDecode");
+            Uint64 start = SDL_GetTicksNS();
+            SDL_Surface* surface = archive ? archive->loadSurface(target->path) : nullptr;
+            if (!surface) {
+                surface = IMG_Load(target->path.c_str());
+            }
+            if (!surface) {
+                spdlog::error("Preload decode failed for '{}': {}", target->path, SDL_GetError());
+            }
+            target->surface = surface;
+            target->decode_ns = SDL_GetTicksNS() - start;
+        }, preload_counter.get());
+        ++queued;
+    }
+    spdlog::debug("Queued {} texture(s) for preload ({} requested).", queued, paths.size());
+    return queued;
+}
+
+std::vector<TextureLoadTiming> TextureManager::finishPreload() {
+    std::vector<TextureLoadTiming> timings;
+    if (!preload_jobs) {
+        return timings;
+    }
+
+    PROFILE_SCOPE("TextureManager::finishPreload");
+    preload_jobs->wait(*preload_counter);
+    timings.reserve(preload_items.size());
+    for (auto &item : preload_items) {
+        TextureLoadTiming timing;
+        timing.path = item.path;
+        timing.decode_ms = static_cast<double>(item.decode_ns) / 1000000.0;
+        bool slot_alive = item.slot_index < slots.size() && slots[item.slot_index].generation == item.slot_generation;
+        if (!slot_alive) {
+            spdlog::debug("Discarding preloaded texture '{}', it was unloaded while loading.", item.path);
+        } else if (!item.surface) {
+            markFailed(item.slot_index); // keep the placeholder, same as a failed async load
+        } else {
+            Uint64 start = SDL_GetTicksNS();
+            if (uploadSurface(item.slot_index, item.surface, item.path)) {
+                timing.bytes = slots[item.slot_index].bytes;
+            }
+            timing.upload_ms = static_cast<double>(SDL_GetTicksNS() - start) / 1000000.0;
+        }
+        if (item.surface) {
+            SDL_DestroySurface(item.surface);
+        }
+        timings.push_back(std::move(timing));
+    }
+    preload_items.clear();
+    preload_jobs = nullptr;
+    spdlog::debug("Preloaded {} texture(s).", timings.size());
+    return timings;
+}
+
+bool TextureManager::isTextureReady(TextureHandle handle) const {
+    const TextureSlot *slot = resolveSlot(handle);
+    return slot && !slot->pending && !slot->failed;
+}
+
+bool TextureManager::isTextureFailed(TextureHandle handle) const {
+    const TextureSlot *slot = resolveSlot(handle);
+    return slot && slot->failed;
+}
+
+AsyncLoadStats TextureManager::getAsyncLoadStats() const {
+    AsyncLoadStats stats;
+    if (async_loader) {
+        stats.queue_depth = async_loader->getQueueDepth();
+        stats.ready_count = async_loader->getReadyCount();
+        stats.decoded_count = async_loader->getDecodedCount();
+        stats.total_decode_ms = async_loader->getTotalDecodeMs();
+    }
+    stats.uploaded_count = uploaded_count;
+    stats.total_upload_ms = static_cast<double>(total_upload_ns) / 1000000.0;
+    stats.last_frame_upload_ms = static_cast<double>(last_frame_upload_ns) / 1000000.0;
+    return stats;
+}
+
+SDL_Texture* TextureManager::getPlaceholderTexture() {
+    if (placeholder_texture) {
+        return placeholder_texture.get();
+    }
+
+    // 16x16 magenta/black checkerboard, 4px cells
+    constexpr int size = 16;
+    std::array<Uint8, size * size * 4> pixels{};
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            bool magenta = ((x / 4) + (y / 4)) % 2 == 0;
+            Uint8 *pixel = &pixels[(y * size + x) * 4];
+            pixel[0] = magenta ? 255 : 0;
+            pixel[1] = 0;
+            pixel[2] = magenta ? 255 : 0;
+            pixel[3] = 255;
+        }
+    }
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, size, size);
     if (!texture) {
-        spdlog::error("Failed to get texture: {}", file_path);
-        return glm::vec2(0);
+        spdlog::error("Failed to create placeholder texture: {}", SDL_GetError());
+        return nullptr;
     }
+    if (!SDL_UpdateTexture(texture, nullptr, pixels.data(), size * 4)) {
+        spdlog::error("Failed to fill placeholder texture: {}", SDL_GetError());
+    }
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    placeholder_texture.reset(texture);
+    total_bytes += getTextureBytes(texture);
+    return texture;
+}
 
-    // query the texture size
-    glm::vec2 size;
-    if (!SDL_GetTextureSize(texture, &size.x, &size.y)) {
-        spdlog::error("Failed to query texture size: {}", file_path);
-        return glm::vec2(0);
+TextureManager::PathMap::iterator TextureManager::findPath(std::string_view file_path) {
+    auto it = path_to_slot.find(file_path);
+    if (it != path_to_slot.end()) {
+        return it;
     }
-    return size;
+    // keys are normalized (atlas regions included); only a miss pays for normalizing the caller's spelling
+    std::string normalized = TextureAtlas::normalizePath(file_path);
+    return normalized == file_path ? it : path_to_slot.find(normalized);
 }
 
-void TextureManager::unloadTexture(std::string_view file_path) {
-    auto it = textures.find(std::string(file_path));
-    if (it != textures.end()) {
-        spdlog::debug("Unloading texture: {}", file_path);
-        textures.erase(it);
-    } else {
-        spdlog::warn("Attempting to unload a non-existent texture: {}", file_path);
+TextureManager::PathMap::iterator TextureManager::findPathForLoad(std::string_view file_path) {
+    auto it = findPath(file_path);
+    if (it != path_to_slot.end() && slots[it->second].failed) {
+        // an explicit load retries a failed texture (e.g. after the file was fixed); old handles become invalid
+        spdlog::debug("Retrying previously failed texture: {}", file_path);
+        Uint32 index = it->second;
+        path_to_slot.erase(it);
+        releaseSlot(index);
+        return path_to_slot.end();
     }
+    return it;
 }
 
-void TextureManager::clearTextures() {
-    if (!textures.empty()) {
-        spdlog::debug("Clearing all {} cached textures.", textures.size());
-        textures.clear();
+const TextureManager::TextureSlot* TextureManager::resolveSlot(TextureHandle handle) const {
+    if (handle.index >= slots.size()) {
+        return nullptr;
+    }
+    const TextureSlot &slot = slots[handle.index];
+    if (slot.generation != handle.generation || !slot.texture) {
+        return nullptr;
+    }
+    slot.last_used_frame = current_frame;
+    return &slot;
+}
+
+void TextureManager::setBudget(const CacheBudget &new_budget) {
+    budget = new_budget;
+    budget.idle_frames = std::max<Uint32>(budget.idle_frames, 1);
+}
+
+void TextureManager::trim() {
+    ++current_frame;
+    if (budget.budget_bytes == 0 || total_bytes <= budget.budget_bytes) {
+        return;
+    }
+
+    PROFILE_SCOPE("TextureManager::trim");
+    // only idle, unpinned standalone textures can go; atlas regions share pages and pending slots are still owned by the loader
+    eviction_candidates.clear();
+    for (const auto &[path, index] : path_to_slot) {
+        const TextureSlot &slot = slots[index];
+        if (slot.owned_texture && !slot.pending && slot.pin_count == 0 && current_frame - slot.last_used_frame >= budget.idle_frames) {
+            eviction_candidates.push_back(index);
+        }
+    }
+    std::sort(eviction_candidates.begin(), eviction_candidates.end(), [this](Uint32 a, Uint32 b) {
+        return slots[a].last_used_frame < slots[b].last_used_frame;
+    });
+
+    size_t evicted = 0;
+    for (Uint32 index : eviction_candidates) {
+        if (total_bytes <= budget.budget_bytes) {
+            break;
+        }
+        path_to_slot.erase(path_to_slot.find(slots[index].path));
+        releaseSlot(index);
+        ++evicted;
+    }
+    evictions += evicted;
+    if (evicted > 0) {
+        spdlog::debug("Evicted {} idle texture(s), {:.2f} MB resident (budget {:.2f} MB).", evicted,
+                static_cast<double>(total_bytes) / (1024.0 * 1024.0), static_cast<double>(budget.budget_bytes) / (1024.0 * 1024.0));
     }
 }
 
+bool TextureManager::pinTexture(TextureHandle handle) {
+    if (!resolveSlot(handle)) {
+        return false;
+    }
+    ++slots[handle.index].pin_count;
+    return true;
+}
+
+void TextureManager::unpinTexture(TextureHandle handle) {
+    if (resolveSlot(handle) && slots[handle.index].pin_count > 0) {
+        --slots[handle.index].pin_count;
+    }
+}
 
+CacheStats TextureManager::getCacheStats() const {
+    CacheStats stats;
+    stats.entries = path_to_slot.size();
+    stats.bytes = total_bytes;
+    stats.budget_bytes = budget.budget_bytes;
+    stats.pinned = static_cast<size_t>(std::count_if(slots.begin(), slots.end(), [](const TextureSlot &slot) { return slot.pin_count > 0; }));
+    stats.hits = cache_hits;
+    stats.misses = cache_misses;
+    stats.evictions = evictions;
+    return stats;
+}
+
+Uint32 TextureManager::allocateSlot() {
+    if (!free_slots.empty()) {
+        Uint32 index = free_slots.back();
+        free_slots.pop_back();
+        return index;
+    }
+    slots.emplace_back();
+    return static_cast<Uint32>(slots.size() - 1);
+}
+
+Uint32 TextureManager::allocatePendingSlot(std::string_view file_path, SDL_Texture* placeholder) {
+    // the slot is usable right away and resolves to the placeholder until the upload finishes
+    Uint32 index = allocateSlot();
+    TextureSlot &slot = slots[index];
+    slot.texture = placeholder;
+    slot.region = { 0, 0, 0, 0 };
+    SDL_GetTextureSize(placeholder, &slot.region.w, &slot.region.h);
+    slot.path = TextureAtlas::normalizePath(file_path);
+    slot.pending = true;
+    slot.last_used_frame = current_frame;
+    path_to_slot.emplace(slot.path, index);
+    return index;
+}
+
+bool TextureManager::uploadSurface(Uint32 index, SDL_Surface* surface, std::string_view file_path) {
+    TextureSlot &slot = slots[index];
+    slot.pending = false;
+    SDL_Texture* raw_texture = SDL_CreateTextureFromSurface(renderer_, surface);
+    if (!raw_texture) {
+        // keep the placeholder so draws don't retry the failing load every frame
+        spdlog::error("Failed to upload texture '{}': {}", file_path, SDL_GetError());
+        markFailed(index);
+        return false;
+    }
+    if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
+        spdlog::warn("Cannot set texture scale mode for '{}': {}", file_path, SDL_GetError());
+    }
+    slot.owned_texture.reset(raw_texture);
+    slot.texture = raw_texture;
+    slot.region = { 0, 0, static_cast<float>(surface->w), static_cast<float>(surface->h) };
+    slot.bytes = getTextureBytes(raw_texture);
+    total_bytes += slot.bytes;
+    return true;
+}
+
+void TextureManager::markFailed(Uint32 index) {
+    TextureSlot &slot = slots[index];
+    slot.pending = false;
+    slot.failed = true;
+}
+
+void TextureManager::releaseSlot(Uint32 index) {
+    TextureSlot &slot = slots[index];
+    total_bytes -= slot.bytes;
+    slot.bytes = 0;
+    slot.pin_count = 0;
+    slot.owned_texture.reset();
+    slot.texture = nullptr;
+    slot.region = { 0, 0, 0, 0 };
+    slot.path.clear();
+    slot.pending = false;
+    slot.failed = false;
+    ++slot.generation; // invalidate all outstanding handles to this slot
+    free_slots.push_back(index);
+}
 
-} // namespace engine::resource
\ No newline at end of file
+} // namespace engine::resource
@@ -1,14 +1,31 @@
 #pragma once
 
+#include <deque>
+#include <functional>
 #include <memory>
-#include <unordered_map>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <SDL3/SDL_render.h>
 #include <glm/vec2.hpp>
 
+#include "async_texture_loader.h"
+#include "cache_stats.h"
+#include "texture_handle.h"
+#include "../utils/string_hash.h"
+
+namespace engine::core {
+class JobCounter;
+class JobSystem;
+}
+
 namespace engine::resource {
 
+class AssetArchive;
+class TextureAtlas;
+
 class TextureManager final {
 
 friend class ResourceManager;
@@ -22,12 +39,65 @@ private:
 		}
 	};
 
-	std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> textures;
+	using TexturePtr = std::unique_ptr<SDL_Texture, SDLTextureDeleter>;
+
+	// 纹理槽位，TextureHandle 的 index 指向这里
+	struct TextureSlot {
+		TexturePtr owned_texture; ///< @brief 独立加载的纹理；图集区域为空
+		SDL_Texture *texture = nullptr; ///< @brief 实际绘制用的纹理（owned_texture 或图集页）
+		SDL_FRect region = { 0, 0, 0, 0 }; ///< @brief 图片在 texture 中的子矩形，独立纹理即整张纹理
+		std::string path;
+		Uint32 generation = 1; ///< @brief 从 1 开始，默认构造的句柄（代数 0）永远无效
+		bool pending = false; ///< @brief 异步加载尚未完成，此时 texture 指向占位纹理
+		bool failed = false; ///< @brief 解码或上传失败，texture 仍指向占位纹理作为绘制回退；显式重新加载时重试
+		size_t bytes = 0; ///< @brief owned_texture 的内存占用，图集区域为 0（图集页单独计入）
+		Uint32 pin_count = 0; ///< @brief 大于 0 时不会被预算淘汰
+		mutable Uint64 last_used_frame = 0; ///< @brief 最近一次解析句柄的帧，用于 LRU 淘汰
+	};
+
+	std::vector<TextureSlot> slots; ///< @brief 稠密槽位数组
+	std::vector<TexturePtr> atlas_pages; ///< @brief 图集页纹理，被多个槽位共享
+	std::vector<Uint32> free_slots; ///< @brief 已释放、可复用的槽位索引
+	using PathMap = std::unordered_map<std::string, Uint32, engine::utils::StringHash, std::equal_to<>>;
+	PathMap path_to_slot; ///< @brief 规范化路径到槽位的索引，仅在解析句柄时使用
 
 	SDL_Renderer *renderer_ = nullptr;
+	const AssetArchive *archive_ = nullptr; ///< @brief 已挂载的资源包（非拥有），包内没有的路径回退到散文件
+
+	// --- 异步加载 ---
+	TexturePtr placeholder_texture; ///< @brief 异步加载完成前绘制的棋盘格占位纹理（首次异步请求时创建）
+	double upload_budget_ms = 2.0; ///< @brief 每帧用于上传纹理的时间预算
+	int async_worker_count = 2; ///< @brief 解码线程数，在第一次异步请求前设置才生效
+	Uint64 uploaded_count = 0;
+	Uint64 total_upload_ns = 0;
+	Uint64 last_frame_upload_ns = 0;
+
+	// --- 批量预加载 ---
+	struct PreloadItem {
+		Uint32 slot_index = 0;
+		Uint32 slot_generation = 0;
+		std::string path;
+		SDL_Surface *surface = nullptr; ///< @brief 由解码任务写入，finishPreload 时取走
+		Uint64 decode_ns = 0;
+	};
+	std::deque<PreloadItem> preload_items; ///< @brief 进行中的批次；deque 追加时不会移动已有元素，解码任务可以安全地写入
+	std::unique_ptr<engine::core::JobCounter> preload_counter;
+	engine::core::JobSystem *preload_jobs = nullptr; ///< @brief 执行当前批次的任务系统，批次结束前必须存活
+
+	// --- 内存预算 ---
+	CacheBudget budget;
+	Uint64 current_frame = 0;
+	size_t total_bytes = 0; ///< @brief 所有独立纹理、图集页与占位纹理的占用之和
+	Uint64 cache_hits = 0;
+	Uint64 cache_misses = 0;
+	Uint64 evictions = 0;
+	std::vector<Uint32> eviction_candidates; ///< @brief trim() 复用的临时数组
+
+	std::unique_ptr<AsyncTextureLoader> async_loader; ///< @brief 最后声明，保证先于槽位销毁（先停止工作线程）
 
 public:
 	explicit TextureManager(SDL_Renderer *renderer);
+	~TextureManager(); ///< @brief 等待进行中的预加载任务结束，避免它们写入已销毁的批次
 
 	TextureManager(const TextureManager &) = delete;
 	TextureManager &operator=(const TextureManager &) = delete;
@@ -40,6 +110,62 @@ private:
 	glm::vec2 getTextureSize(std::string_view file_path);
 	void unloadTexture(std::string_view file_path);
 	void clearTextures();
+
+	/// @brief 挂载资源包，应在加载任何纹理之前调用（已创建的异步解码线程不会感知）
+	void setArchive(const AssetArchive *archive) { archive_ = archive; }
+
+	TextureHandle loadTextureHandle(std::string_view file_path); ///< @brief 加载（或命中缓存）并返回句柄，失败返回无效句柄
+	TextureHandle getTextureHandle(std::string_view file_path); ///< @brief 查找句柄，未缓存时尝试加载
+	SDL_Texture *getTexture(TextureHandle handle) const; ///< @brief O(1) 解析句柄，句柄失效返回 nullptr
+	glm::vec2 getTextureSize(TextureHandle handle) const; ///< @brief 原始图片尺寸（图集区域即子矩形尺寸）
+	SDL_FRect getTextureRegion(TextureHandle handle) const; ///< @brief 图片在其纹理中的子矩形，句柄失效返回空矩形
+
+	/// @brief 异步加载：立即返回句柄（先解析为占位纹理），解码在工作线程完成，上传在 processAsyncUploads 中进行
+	TextureHandle loadTextureAsync(std::string_view file_path);
+	void processAsyncUploads(); ///< @brief 在预算时间内上传已解码的图片，每帧在主线程调用一次
+	bool isTextureReady(TextureHandle handle) const; ///< @brief 句柄有效且纹理已加载完成（加载中或失败时为 false）
+	bool isTextureFailed(TextureHandle handle) const; ///< @brief 句柄有效但加载失败，绘制时使用占位纹理
+	AsyncLoadStats getAsyncLoadStats() const;
+	void setAsyncUploadBudget(double milliseconds) { upload_budget_ms = milliseconds; }
+	void setAsyncWorkerCount(int count) { async_worker_count = count; }
+	SDL_Texture *getPlaceholderTexture(); ///< @brief 获取（必要时创建）占位纹理
+
+	/**
+	 * @brief 批量预加载：为未缓存的路径立即分配待定槽位（解析为占位纹理），在任务系统上并行解码
+	 *
+	 * 可以多次调用追加到同一批次，已缓存或已在加载中的路径会被跳过。返回本次新加入的数量。
+	 */
+	size_t beginPreload(const std::vector<std::string> &paths, engine::core::JobSystem &jobs);
+	/// @brief 等待批次解码完成（期间主线程参与解码），然后一次性上传所有纹理，返回每个纹理的耗时
+	std::vector<TextureLoadTiming> finishPreload();
+	bool isPreloading() const { return !preload_items.empty(); }
+
+	/// @brief 设置内存预算，下一次 trim() 时生效
+	void setBudget(const CacheBudget &new_budget);
+	/**
+	 * @brief 每帧调用一次：推进帧计数，超出预算时淘汰闲置的独立纹理
+	 *
+	 * 句柄是带代数的弱引用，被淘汰纹理的旧句柄解析为 nullptr，Sprite 会按路径重新加载；
+	 * 需要常驻的纹理用 pinTexture 固定。图集页与加载中的纹理不参与淘汰。
+	 */
+	void trim();
+	bool pinTexture(TextureHandle handle); ///< @brief 固定纹理使其不被淘汰（可嵌套），句柄无效返回 false
+	void unpinTexture(TextureHandle handle);
+	CacheStats getCacheStats() const;
+
+	/// @brief 上传图集页，并将图集中的原路径注册为指向图集区域的槽位（覆盖同路径的独立纹理）
+	void addAtlas(const TextureAtlas &atlas);
+
+	const TextureSlot *resolveSlot(TextureHandle handle) const; ///< @brief 校验索引与代数，返回槽位或 nullptr
+	/// @brief 先按原字符串查找（不分配），未命中且路径不规范时再按规范化路径查找
+	PathMap::iterator findPath(std::string_view file_path);
+	/// @brief 查找已缓存的路径；失败的槽位被释放并视为未命中，使显式加载可以重试
+	PathMap::iterator findPathForLoad(std::string_view file_path);
+	Uint32 allocateSlot(); ///< @brief 取一个空闲槽位，必要时扩容
+	Uint32 allocatePendingSlot(std::string_view file_path, SDL_Texture *placeholder); ///< @brief 分配解析为占位纹理的待定槽位并登记路径
+	bool uploadSurface(Uint32 index, SDL_Surface *surface, std::string_view file_path); ///< @brief 把解码结果上传到待定槽位，失败时标记为失败并保留占位纹理
+	void markFailed(Uint32 index); ///< @brief 结束待定状态并标记失败
+	void releaseSlot(Uint32 index); ///< @brief 销毁槽位中的纹理，代数递增并放回空闲列表
 };
 
-} //namespace engine::resource
\ No newline at end of file
+} //namespace engine::resource
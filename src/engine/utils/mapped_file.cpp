@@ -0,0 +1,110 @@
+#include "mapped_file.h"
+
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::utils {
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string &path) {
+	close();
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		spdlog::error("Failed to open '{}' for mapping (error {}).", path, GetLastError());
+		return false;
+	}
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+		spdlog::error("Cannot map empty or unreadable file '{}'.", path);
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		spdlog::error("Failed to create file mapping for '{}' (error {}).", path, GetLastError());
+		CloseHandle(file);
+		return false;
+	}
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		spdlog::error("Failed to map view of '{}' (error {}).", path, GetLastError());
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	file_handle = file;
+	mapping_handle = mapping;
+	data = static_cast<const std::byte *>(view);
+	size = static_cast<size_t>(file_size.QuadPart);
+	return true;
+}
+
+void MappedFile::close() {
+	if (data) {
+		UnmapViewOfFile(data);
+		data = nullptr;
+	}
+	if (mapping_handle) {
+		CloseHandle(mapping_handle);
+		mapping_handle = nullptr;
+	}
+	if (file_handle) {
+		CloseHandle(file_handle);
+		file_handle = nullptr;
+	}
+	size = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string &path) {
+	close();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		spdlog::error("Failed to open '{}' for mapping.", path);
+		return false;
+	}
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+		spdlog::error("Cannot map empty or unreadable file '{}'.", path);
+		::close(fd);
+		return false;
+	}
+	void *view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd); // 映射建立后文件描述符即可关闭
+	if (view == MAP_FAILED) {
+		spdlog::error("Failed to mmap '{}'.", path);
+		return false;
+	}
+	data = static_cast<const std::byte *>(view);
+	size = static_cast<size_t>(file_stat.st_size);
+	return true;
+}
+
+void MappedFile::close() {
+	if (data) {
+		munmap(const_cast<std::byte *>(data), size);
+		data = nullptr;
+	}
+	size = 0;
+}
+
+#endif
+
+} // namespace engine::utils
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace engine::utils {
+
+/**
+ * @brief 只读内存映射文件（RAII）
+ *
+ * 打开后整个文件映射到进程地址空间，由操作系统按需调页，数据可原地读取而无需拷贝。
+ */
+class MappedFile final {
+private:
+	const std::byte *data = nullptr;
+	size_t size = 0;
+#ifdef _WIN32
+	void *file_handle = nullptr;
+	void *mapping_handle = nullptr;
+#endif
+
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	/// @brief 映射文件，失败返回 false（不抛异常），之前映射的文件会先被关闭
+	[[nodiscard]] bool open(const std::string &path);
+	void close();
+
+	[[nodiscard]] bool isOpen() const { return data != nullptr; }
+	[[nodiscard]] const std::byte *getData() const { return data; }
+	[[nodiscard]] size_t getSize() const { return size; }
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	MappedFile(MappedFile &&) = delete;
+	MappedFile &operator=(MappedFile &&) = delete;
+};
+
+} // namespace engine::utils
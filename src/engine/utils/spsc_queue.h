@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+namespace engine::utils {
+
+/**
+ * @brief 单生产者单消费者的无锁环形队列，容量固定，push / pop 都不会阻塞或分配内存
+ *
+ * 只允许一个线程调用 push、另一个线程调用 pop（如主线程向音频线程发送命令）。
+ */
+template <typename T, size_t Capacity>
+class SpscQueue final {
+	static_assert(std::has_single_bit(Capacity), "SpscQueue capacity must be a power of two.");
+	static_assert(std::is_trivially_copyable_v<T>, "SpscQueue items must be trivially copyable.");
+
+private:
+	static constexpr size_t MASK = Capacity - 1;
+
+	alignas(64) std::atomic<size_t> head = 0; ///< @brief 下一个读取位置，只由消费者写
+	alignas(64) std::atomic<size_t> tail = 0; ///< @brief 下一个写入位置，只由生产者写
+	std::array<T, Capacity> items{};
+
+public:
+	/// @brief 生产者调用，队列已满时返回 false
+	bool push(const T &item) {
+		size_t current_tail = tail.load(std::memory_order_relaxed);
+		if (current_tail - head.load(std::memory_order_acquire) == Capacity) {
+			return false;
+		}
+		items[current_tail & MASK] = item;
+		tail.store(current_tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// @brief 消费者调用，队列为空时返回 false
+	bool pop(T &item) {
+		size_t current_head = head.load(std::memory_order_relaxed);
+		if (current_head == tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		item = items[current_head & MASK];
+		head.store(current_head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// @brief 近似的元素数量（另一端可能同时在修改）
+	size_t size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+	static constexpr size_t capacity() { return Capacity; }
+};
+
+} // namespace engine::utils
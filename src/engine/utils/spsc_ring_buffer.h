@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace engine::utils {
+
+/**
+ * @brief 单生产者单消费者的无锁采样环形缓冲区，容量在构造时确定（向上取整到 2 的幂）
+ *
+ * 与 SpscQueue 逐个传递命令不同，这里按块批量读写（如解码线程写入 PCM、音频线程读出），
+ * 一次 write / read 最多两段 memcpy，不会阻塞或分配内存。
+ */
+template <typename T>
+class SpscRingBuffer final {
+	static_assert(std::is_trivially_copyable_v<T>, "SpscRingBuffer items must be trivially copyable.");
+
+private:
+	alignas(64) std::atomic<size_t> head = 0; ///< @brief 下一个读取位置，只由消费者写
+	alignas(64) std::atomic<size_t> tail = 0; ///< @brief 下一个写入位置，只由生产者写
+	std::unique_ptr<T[]> items;
+	size_t mask = 0;
+
+public:
+	explicit SpscRingBuffer(size_t capacity) :
+			items(std::make_unique<T[]>(std::bit_ceil(std::max<size_t>(capacity, 1)))), mask(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1) {}
+
+	SpscRingBuffer(const SpscRingBuffer &) = delete;
+	SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+	SpscRingBuffer(SpscRingBuffer &&) = delete;
+	SpscRingBuffer &operator=(SpscRingBuffer &&) = delete;
+
+	/// @brief 生产者调用，写入尽可能多的元素，返回实际写入数量
+	size_t write(const T *data, size_t count) {
+		size_t current_tail = tail.load(std::memory_order_relaxed);
+		count = std::min(count, capacity() - (current_tail - head.load(std::memory_order_acquire)));
+		size_t offset = current_tail & mask;
+		size_t first = std::min(count, capacity() - offset);
+		std::memcpy(items.get() + offset, data, first * sizeof(T));
+		std::memcpy(items.get(), data + first, (count - first) * sizeof(T));
+		tail.store(current_tail + count, std::memory_order_release);
+		return count;
+	}
+
+	/// @brief 消费者调用，读出尽可能多的元素，返回实际读出数量
+	size_t read(T *data, size_t count) {
+		size_t current_head = head.load(std::memory_order_relaxed);
+		count = std::min(count, tail.load(std::memory_order_acquire) - current_head);
+		size_t offset = current_head & mask;
+		size_t first = std::min(count, capacity() - offset);
+		std::memcpy(data, items.get() + offset, first * sizeof(T));
+		std::memcpy(data + first, items.get(), (count - first) * sizeof(T));
+		head.store(current_head + count, std::memory_order_release);
+		return count;
+	}
+
+	/// @brief 可读数量的近似值（另一端可能同时在修改）
+	size_t size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+	/// @brief 可写数量的近似值
+	size_t space() const { return capacity() - size(); }
+	size_t capacity() const { return mask + 1; }
+};
+
+} // namespace engine::utils
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace engine::utils {
+
+/**
+ * @brief 透明字符串哈希，配合 std::equal_to<> 作为 unordered 容器的哈希，
+ * 允许直接用 string_view / 字面量查找而无需构造临时 std::string
+ */
+struct StringHash {
+	using is_transparent = void;
+	std::size_t operator()(std::string_view value) const {
+		return std::hash<std::string_view>{}(value);
+	}
+};
+
+} // namespace engine::utils
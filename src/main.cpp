@@ -1,11 +1,17 @@
 #include "engine/core/game_app.h"
 #include <spdlog/spdlog.h>
 
-int main() {
+#ifdef ENGINE_ALLOC_TRACKING
+#include "engine/memory/allocation_tracker.h"
+ENGINE_DEFINE_ALLOCATION_HOOKS();
+#endif
+
+int main(int argc, char *argv[]) {
 
 	spdlog::set_level(spdlog::level::trace);
 
 	engine::core::GameApp app;
+	app.setCommandLine(engine::core::CommandLine::parse(argc, argv));
 	app.run();
 	return 0;
 }
\ No newline at end of file
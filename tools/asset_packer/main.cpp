@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+
+#include "../../src/engine/resource/asset_archive.h"
+#include "../../src/engine/resource/texture_atlas.h"
+
+namespace {
+
+// 预解码为 RGBA 像素的图片；音频仍从磁盘流式解码，配置与存档需要可写，均不打包
+constexpr std::string_view IMAGE_EXTENSIONS[] = { ".png", ".jpg", ".jpeg", ".bmp" };
+constexpr std::string_view RAW_EXTENSIONS[] = { ".ttf", ".otf", ".tmj", ".tsj", ".lvl" }; // 以及关卡预加载清单 *.preload.json、动画片段文件 *.anim.json 与粒子效果文件 *.fx.json
+
+bool hasExtension(const std::filesystem::path &path, std::span<const std::string_view> extensions) {
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+}
+
+bool readFile(const std::filesystem::path &path, std::vector<std::byte> &out) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	out.resize(bytes.size());
+	std::memcpy(out.data(), bytes.data(), bytes.size());
+	return true;
+}
+
+} // namespace
+
+// 离线资源打包工具：asset_packer <assets_dir> <output.pak> [--no-compress]
+// 条目路径与运行时一致（如 assets/textures/UI/heart.png），请在项目根目录运行
+int main(int argc, char *argv[]) {
+	if (argc < 3 || argc > 4 || (argc == 4 && std::strcmp(argv[3], "--no-compress") != 0)) {
+		spdlog::error("Usage: asset_packer <assets_dir> <output.pak> [--no-compress]");
+		return 1;
+	}
+	namespace fs = std::filesystem;
+	const fs::path input = argv[1];
+	const std::string output = argv[2];
+	const bool compress = argc != 4;
+
+	std::error_code ec;
+	if (!fs::is_directory(input, ec)) {
+		spdlog::error("'{}' is not a directory.", argv[1]);
+		return 1;
+	}
+
+	engine::resource::AssetArchiveWriter writer(compress);
+	size_t image_count = 0;
+	for (const auto &entry : fs::recursive_directory_iterator(input, ec)) {
+		if (!entry.is_regular_file()) {
+			continue;
+		}
+		std::string entry_path = engine::resource::TextureAtlas::normalizePath(entry.path().generic_string());
+		if (hasExtension(entry.path(), IMAGE_EXTENSIONS)) {
+			SDL_Surface *surface = IMG_Load(entry.path().string().c_str());
+			if (!surface) {
+				spdlog::error("Failed to decode '{}': {}", entry_path, SDL_GetError());
+				return 1;
+			}
+			bool added = writer.addImage(entry_path, surface);
+			SDL_DestroySurface(surface);
+			if (!added) {
+				return 1;
+			}
+			++image_count;
+		} else if (hasExtension(entry.path(), RAW_EXTENSIONS) || entry_path.ends_with(".preload.json") || entry_path.ends_with(".anim.json") || entry_path.ends_with(".fx.json")) {
+			std::vector<std::byte> bytes;
+			if (!readFile(entry.path(), bytes)) {
+				spdlog::error("Failed to read '{}'.", entry_path);
+				return 1;
+			}
+			writer.addFile(entry_path, std::move(bytes));
+		}
+	}
+	if (ec) {
+		spdlog::error("Failed to scan '{}': {}", argv[1], ec.message());
+		return 1;
+	}
+
+	const size_t entry_count = writer.getEntryCount();
+	if (!writer.write(output)) {
+		return 1;
+	}
+
+	// 回读校验，确保产物可以被运行时挂载
+	engine::resource::AssetArchive archive;
+	if (!archive.open(output) || archive.getEntryCount() != entry_count) {
+		spdlog::error("Verification of '{}' failed.", output);
+		return 1;
+	}
+	spdlog::info("Packed {} entries ({} images{}) from '{}' -> '{}' ({} bytes).", entry_count, image_count,
+			compress ? ", LZ4" : "", argv[1], output, archive.getFileSize());
+	return 0;
+}
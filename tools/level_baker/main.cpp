@@ -0,0 +1,39 @@
+#include <spdlog/spdlog.h>
+
+#include "../../src/engine/map/baked_level.h"
+#include "../../src/engine/map/map_loader.h"
+#include "../../src/engine/map/tile_map.h"
+#include "../../src/engine/resource/preload_manifest.h"
+
+// 离线关卡烘焙工具：level_baker <input.tmj> <output.lvl>
+// 同时在输出旁写出预加载清单（<output>.preload.json），列出关卡引用的所有纹理
+int main(int argc, char *argv[]) {
+	if (argc != 3) {
+		spdlog::error("Usage: level_baker <input.tmj> <output.lvl>");
+		return 1;
+	}
+
+	auto map = engine::map::MapLoader::load(argv[1]);
+	if (!map) {
+		spdlog::error("Failed to load map '{}'.", argv[1]);
+		return 1;
+	}
+	if (!engine::map::BakedLevelWriter::write(*map, argv[2])) {
+		return 1;
+	}
+
+	// 回读校验，确保产物可以被运行时加载
+	auto baked = engine::map::BakedLevelLoader::load(argv[2]);
+	if (!baked || baked->tile_layers.size() != map->tile_layers.size()) {
+		spdlog::error("Verification of '{}' failed.", argv[2]);
+		return 1;
+	}
+
+	engine::resource::PreloadManifest manifest{ argv[1], map->collectImagePaths() };
+	std::string manifest_path = engine::resource::PreloadManifest::getManifestPath(argv[2]);
+	if (!manifest.save(manifest_path)) {
+		return 1;
+	}
+	spdlog::info("Baked '{}' -> '{}' (+ {}, {} textures).", argv[1], argv[2], manifest_path, manifest.textures.size());
+	return 0;
+}
@@ -2,12 +2,59 @@ add_rules("mode.debug", "mode.release")
 
 set_rundir("$(projectdir)")
 
-add_requires("nlohmann_json", "spdlog", "glm", "libsdl3", "libsdl3_image", "libsdl3_ttf")
+add_requires("nlohmann_json", "spdlog", "glm", "libsdl3", "libsdl3_image", "libsdl3_ttf", "dr_mp3", "libvorbis", "lz4")
 
 set_languages("c++20")
 
+-- 分析器区间在 debug 模式下默认开启，release 需要 xmake f --profiler=y
+option("profiler")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Enable profiling zones and the profiler overlay in release builds")
+option_end()
+
+-- 替换全局 operator new，按子系统统计每帧的堆分配次数与字节数，退出时输出汇总 (xmake f --alloc_tracking=y)
+option("alloc_tracking")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Count heap allocations per frame and per subsystem in the game")
+option_end()
+
+target("engine")
+    set_kind("static")
+    add_packages("nlohmann_json", "spdlog", "glm", "libsdl3", "libsdl3_image", "libsdl3_ttf", {public = true})
+    add_packages("dr_mp3", "libvorbis", "lz4") -- 音频解码与资源包解压只在引擎内部使用
+    add_files("src/engine/**.cpp")
+    if is_plat("linux") then
+        add_syslinks("pthread", {public = true})
+    end
+    if is_mode("debug") or has_config("profiler") then
+        add_defines("ENGINE_PROFILE_ENABLED", {public = true})
+    end
+
 target("platformer")
     set_kind("binary")
-    add_packages("nlohmann_json", "spdlog", "glm", "libsdl3", "libsdl3_image", "libsdl3_ttf")
-    add_files("src/**.cpp")
-    
\ No newline at end of file
+    add_deps("engine")
+    add_files("src/main.cpp")
+    if has_config("alloc_tracking") then
+        add_defines("ENGINE_ALLOC_TRACKING")
+    end
+
+-- 离线工具：把 Tiled 地图烘焙为二进制关卡 (xmake run level_baker in.tmj out.lvl)
+target("level_baker")
+    set_kind("binary")
+    add_deps("engine")
+    add_files("tools/level_baker/*.cpp")
+
+-- 离线工具：把 assets/ 打包为资源包，图片预解码为 RGBA 像素并用 LZ4 压缩 (xmake run asset_packer assets assets.pak)
+target("asset_packer")
+    set_kind("binary")
+    add_deps("engine")
+    add_files("tools/asset_packer/*.cpp")
+
+-- 无头基准：离屏视频驱动 + 软件渲染器，结果输出为 JSON 并与基线比较 (xmake run bench)
+target("bench")
+    set_kind("binary")
+    set_default(false)
+    add_deps("engine")
+    add_files("bench/*.cpp")